@@ -0,0 +1,138 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    angularVelocityBench
+    The log map finite differences of quatAngularVelocity (angular
+    velocity and acceleration from two neighbouring samples), and one
+    frame of playback through VelocityHistory: storing the frame, finding
+    the two frames before it and differencing against them. The second is
+    what the node costs per frame besides attribute access when nothing
+    has to be evaluated at other times.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/angularVelocity.h"
+#include "core/quatBatch.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+namespace
+{
+    // Distinct frames of input cycled through by the playback benchmark.
+    const size_t kFrameCount = 16;
+
+    struct VelocityOutputs
+    {
+        std::vector<double> velocity[3];
+        std::vector<double> acceleration[3];
+
+        explicit VelocityOutputs(size_t count)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                velocity[c].resize(count);
+                acceleration[c].resize(count);
+            }
+        }
+
+        VectorArrayView velocityView()
+        {
+            VectorArrayView result = { velocity[0].data(), velocity[1].data(), velocity[2].data() };
+            return result;
+        }
+
+        VectorArrayView accelerationView()
+        {
+            VectorArrayView result = { acceleration[0].data(), acceleration[1].data(), acceleration[2].data() };
+            return result;
+        }
+    };
+
+    void velocityArgs(benchmark::internal::Benchmark *b)
+    {
+        b->ArgNames({ "n", "simd" });
+        b->ArgsProduct({
+            benchmark::CreateRange(1, 100000, 10),
+            { kSimdScalar, kSimdSSE2, kSimdAVX2, kSimdAVX512 }
+        });
+    }
+}
+
+static void BM_AngularVelocity(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+
+    QuatArray previous, current, next;
+    bench::randomQuats(previous, count);
+    bench::randomQuats(current, count);
+    bench::randomQuats(next, count);
+
+    VelocityOutputs out(count);
+
+    for (auto _ : state)
+    {
+        angularVelocityBatch(current.view(), previous.view(), -1.0, next.view(), 1.0, kVelocityParent, out.velocityView(), out.accelerationView(), count);
+
+        benchmark::DoNotOptimize(out.velocity[0].data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_AngularVelocity)->Apply(velocityArgs);
+
+static void BM_AngularVelocityPlayback(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+
+    std::vector<QuatArray> frames(kFrameCount);
+
+    for (size_t f = 0; f < kFrameCount; f++)
+        bench::randomQuats(frames[f], count);
+
+    VelocityHistory history;
+    VelocityOutputs out(count);
+
+    double frame = 0.0;
+
+    for (size_t f = 0; f < 2; f++, frame += 1.0)
+        history.store(frame, frames[f].view(), count);
+
+    for (auto _ : state)
+    {
+        ConstQuatArrayView input = frames[(size_t) frame % kFrameCount].view();
+        ConstQuatArrayView before, further;
+
+        history.store(frame, input, count);
+
+        if (!history.find(frame - 1.0, before) || !history.find(frame - 2.0, further))
+        {
+            state.SkipWithError("playback missed the history");
+            return;
+        }
+
+        angularVelocityBatch(input, before, -1.0, further, -2.0, kVelocityParent, out.velocityView(), out.accelerationView(), count);
+
+        benchmark::DoNotOptimize(out.velocity[0].data());
+        benchmark::ClobberMemory();
+
+        frame += 1.0;
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_AngularVelocityPlayback)->Apply(velocityArgs);
@@ -0,0 +1,181 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    benchUtils
+    Input generators and reporting helpers shared by the quatExtras_bench
+    suites. Inputs are seeded so every run measures the same data.
+
+    Every benchmark reports
+        items_per_second    operations per second
+        time/op             seconds per operation (printed as ns/us/...)
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_BENCH_UTILS_H
+#define QUAT_EXTRAS_BENCH_UTILS_H
+
+#include "core/cpuFeatures.h"
+#include "core/quatBatch.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+    // Element counts from 1 to 10^7 in powers of ten.
+    const int kMinCount = 1;
+    const int kMaxCount = 10000000;
+
+    inline std::mt19937& rng()
+    {
+        static std::mt19937 generator(0x5eed);
+        return generator;
+    }
+
+    template <class T>
+    inline void randomQuats(quatExtras::QuatArrayT<T> &result, size_t count)
+    {
+        std::normal_distribution<double> normal;
+
+        result.resize(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            double x = normal(rng()), y = normal(rng()), z = normal(rng()), w = normal(rng());
+            double k = 1.0 / std::sqrt(x * x + y * y + z * z + w * w);
+
+            result.set(i, T(x * k), T(y * k), T(z * k), T(w * k));
+        }
+    }
+
+    template <class T>
+    inline void randomDoubles(std::vector<T> &result, size_t count, double low, double high)
+    {
+        std::uniform_real_distribution<double> uniform(low, high);
+
+        result.resize(count);
+
+        for (size_t i = 0; i < count; i++)
+            result[i] = T(uniform(rng()));
+    }
+
+    inline void randomShorts(std::vector<short> &result, size_t count, short low, short high)
+    {
+        std::uniform_int_distribution<int> uniform(low, high);
+
+        result.resize(count);
+
+        for (size_t i = 0; i < count; i++)
+            result[i] = (short) uniform(rng());
+    }
+
+    /*
+        Records throughput for count operations per iteration.
+    */
+    inline void setThroughput(benchmark::State &state, size_t count)
+    {
+        state.SetItemsProcessed((int64_t) state.iterations() * (int64_t) count);
+        state.counters["time/op"] = benchmark::Counter(
+            (double) state.iterations() * (double) count,
+            benchmark::Counter::kIsRate | benchmark::Counter::kInvert
+        );
+    }
+
+    /*
+        Pins the batch kernels to the level in the benchmark's second
+        argument. Returns false, and skips the benchmark, if the CPU does not
+        support it.
+    */
+    inline bool useSimdLevel(benchmark::State &state)
+    {
+        quatExtras::SimdLevel requested = (quatExtras::SimdLevel) state.range(1);
+
+        if (quatExtras::setBatchSimdLevel(requested) != requested)
+        {
+            state.SkipWithError("instruction set not supported on this CPU");
+            return false;
+        }
+
+        state.SetLabel(quatExtras::simdLevelName(requested));
+        return true;
+    }
+
+    /*
+        Sets the math backend in the benchmark's third argument and labels
+        the benchmark with it and the SIMD level. Restores the previous
+        backend when it goes out of scope.
+    */
+    class ScopedMathBackend
+    {
+    public:
+        explicit ScopedMathBackend(benchmark::State &state) :
+            previous_(quatExtras::defaultMathBackend())
+        {
+            quatExtras::MathBackend backend = (quatExtras::MathBackend) state.range(2);
+            quatExtras::setDefaultMathBackend(backend);
+
+            state.SetLabel(std::string(quatExtras::simdLevelName(quatExtras::batchSimdLevel())) + " " + quatExtras::mathBackendName(backend));
+        }
+
+        ~ScopedMathBackend()
+        {
+            quatExtras::setDefaultMathBackend(previous_);
+        }
+
+    private:
+        quatExtras::MathBackend previous_;
+    };
+
+    /*
+        Registers element counts 1..10^7 crossed with every SIMD level.
+    */
+    inline void batchArgs(benchmark::internal::Benchmark *b)
+    {
+        b->ArgNames({ "n", "simd" });
+        b->ArgsProduct({
+            benchmark::CreateRange(kMinCount, kMaxCount, 10),
+            { quatExtras::kSimdScalar, quatExtras::kSimdSSE2, quatExtras::kSimdAVX2, quatExtras::kSimdAVX512 }
+        });
+    }
+
+    /*
+        Element counts crossed with every SIMD level and slerp mode.
+    */
+    inline void slerpModeArgs(benchmark::internal::Benchmark *b)
+    {
+        b->ArgNames({ "n", "simd", "mode" });
+        b->ArgsProduct({
+            benchmark::CreateRange(kMinCount, kMaxCount, 10),
+            { quatExtras::kSimdScalar, quatExtras::kSimdSSE2, quatExtras::kSimdAVX2, quatExtras::kSimdAVX512 },
+            { quatExtras::kSlerpExact, quatExtras::kSlerpNlerp, quatExtras::kSlerpFast }
+        });
+    }
+
+    /*
+        Element counts crossed with every SIMD level and math backend.
+    */
+    inline void mathBackendArgs(benchmark::internal::Benchmark *b)
+    {
+        b->ArgNames({ "n", "simd", "math" });
+        b->ArgsProduct({
+            benchmark::CreateRange(kMinCount, kMaxCount, 10),
+            { quatExtras::kSimdScalar, quatExtras::kSimdSSE2, quatExtras::kSimdAVX2, quatExtras::kSimdAVX512 },
+            { quatExtras::kMathLibm, quatExtras::kMathPolynomial, quatExtras::kMathTable }
+        });
+    }
+
+    inline void scalarArgs(benchmark::internal::Benchmark *b)
+    {
+        b->ArgName("n");
+        b->RangeMultiplier(10)->Range(kMinCount, kMaxCount);
+    }
+}
+
+#endif
@@ -0,0 +1,54 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    computeStatsBench
+    Overhead of the ComputeTimer every node wraps its compute in, with
+    collection disabled and enabled. The threaded runs check that counting
+    does not slow down as more evaluation threads record at once.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/computeStats.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace quatExtras;
+
+namespace
+{
+    const int kMaxThreads = 8;
+
+    int benchType()
+    {
+        static int type = registerStatsType("bench");
+        return type;
+    }
+}
+
+static void BM_ComputeTimer(benchmark::State &state)
+{
+    bool enabled = state.range(0) != 0;
+    int type = benchType();
+
+    InstanceStats instance;
+
+    if (state.thread_index() == 0)
+        setStatsEnabled(enabled);
+
+    for (auto _ : state)
+    {
+        ComputeTimer timer(type, &instance);
+        timer.setElements(1);
+        timer.cacheHit();
+    }
+
+    if (state.thread_index() == 0)
+        setStatsEnabled(false);
+
+    bench::setThroughput(state, 1);
+}
+BENCHMARK(BM_ComputeTimer)->ArgName("enabled")->Arg(0)->Arg(1)->ThreadRange(1, kMaxThreads)->UseRealTime();
@@ -0,0 +1,247 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    dqSkinBench
+    Dual quaternion skinning (core/dqSkin.h) of 10^5 to 10^6 vertex meshes,
+    each vertex weighted to kInfluences of kJoints joints. items_per_second
+    is vertices per second.
+
+    BM_DQSkinPoint      one dqSkinPoint per vertex, the scalar reference
+    BM_DQSkinBatch      dqSkinBatch over the whole mesh at each instruction
+                        set
+    BM_DQSkinParallel   dqSkinBatch in chunks split across all cores, as the
+                        quatExtrasDQSkin node runs it
+    BM_DQSkinJoints     building the joint dual quaternions from skinning
+                        matrices, done once per evaluation
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/dqSkin.h"
+#include "core/quatBatch.h"
+#include "core/taskScheduler.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+namespace
+{
+    const int kJoints = 100;
+    const int kInfluences = 4;
+
+    // Same chunking as the node.
+    const size_t kParallelGrain = 4096;
+
+    // Row-vector rigid matrices from random rotations and translations.
+    void randomMatrices(std::vector<double> &result, size_t count)
+    {
+        QuatArray rotation;
+        std::vector<double> translation;
+
+        bench::randomQuats(rotation, count);
+        bench::randomDoubles(translation, count * 3, -10.0, 10.0);
+
+        ConstQuatArrayView r = rotation.view();
+
+        result.assign(count * 16, 0.0);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            double x = r.x[i], y = r.y[i], z = r.z[i], w = r.w[i];
+            double *m = &result[i * 16];
+
+            m[0]  = 1.0 - 2.0 * (y * y + z * z);
+            m[1]  = 2.0 * (x * y + w * z);
+            m[2]  = 2.0 * (x * z - w * y);
+            m[4]  = 2.0 * (x * y - w * z);
+            m[5]  = 1.0 - 2.0 * (x * x + z * z);
+            m[6]  = 2.0 * (y * z + w * x);
+            m[8]  = 2.0 * (x * z + w * y);
+            m[9]  = 2.0 * (y * z - w * x);
+            m[10] = 1.0 - 2.0 * (x * x + y * y);
+            m[12] = translation[i * 3 + 0];
+            m[13] = translation[i * 3 + 1];
+            m[14] = translation[i * 3 + 2];
+            m[15] = 1.0;
+        }
+    }
+
+    struct SkinInputs
+    {
+        std::vector<double> matrices;
+        DualQuatArray joints;
+        SkinWeights weights;
+        std::vector<double> x, y, z;
+        std::vector<double> outX, outY, outZ;
+
+        explicit SkinInputs(size_t count)
+        {
+            randomMatrices(matrices, kJoints);
+            joints.resize(kJoints);
+
+            for (int j = 0; j < kJoints; j++)
+                joints.set(j, reinterpret_cast<const double (*)[4]>(&matrices[j * 16]));
+
+            // Neighbouring joints, as on a limb, with random weights.
+            std::vector<double> weight;
+            bench::randomDoubles(weight, count * kInfluences, 0.0, 1.0);
+
+            std::uniform_int_distribution<int> firstJoint(0, kJoints - kInfluences);
+            int influence[kInfluences];
+
+            weights.clear(kInfluences);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                int first = firstJoint(bench::rng());
+
+                for (int k = 0; k < kInfluences; k++)
+                    influence[k] = first + k;
+
+                weights.addVertex(i, influence, &weight[i * kInfluences], kInfluences);
+            }
+
+            bench::randomDoubles(x, count, -10.0, 10.0);
+            bench::randomDoubles(y, count, -10.0, 10.0);
+            bench::randomDoubles(z, count, -10.0, 10.0);
+
+            outX.resize(count);
+            outY.resize(count);
+            outZ.resize(count);
+        }
+
+        ConstVectorArrayView points(size_t begin) const
+        {
+            ConstVectorArrayView result = { x.data() + begin, y.data() + begin, z.data() + begin };
+            return result;
+        }
+
+        VectorArrayView out(size_t begin)
+        {
+            VectorArrayView result = { outX.data() + begin, outY.data() + begin, outZ.data() + begin };
+            return result;
+        }
+    };
+
+    void meshArgs(benchmark::internal::Benchmark *b)
+    {
+        b->ArgNames({ "n", "simd" });
+        b->ArgsProduct({
+            { 100000, 300000, 1000000 },
+            { kSimdScalar, kSimdSSE2, kSimdAVX2, kSimdAVX512 }
+        });
+        b->Unit(benchmark::kMillisecond);
+    }
+
+    void meshScalarArgs(benchmark::internal::Benchmark *b)
+    {
+        b->ArgName("n");
+        b->Arg(100000)->Arg(300000)->Arg(1000000);
+        b->Unit(benchmark::kMillisecond);
+    }
+}
+
+static void BM_DQSkinPoint(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    SkinInputs in(count);
+
+    ConstDualQuatArrayView joints = in.joints.view();
+    ConstSkinWeightsView weights = in.weights.view();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            unsigned begin = weights.offset[i];
+            double point[3] = { in.x[i], in.y[i], in.z[i] };
+            double out[3];
+
+            dqSkinPoint(joints, weights.influence + begin, weights.weight + begin, weights.offset[i + 1] - begin, point, out);
+
+            in.outX[i] = out[0];
+            in.outY[i] = out[1];
+            in.outZ[i] = out[2];
+        }
+
+        benchmark::DoNotOptimize(in.outX.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_DQSkinPoint)->Apply(meshScalarArgs);
+
+static void BM_DQSkinBatch(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    SkinInputs in(count);
+
+    for (auto _ : state)
+    {
+        dqSkinBatch(in.joints.view(), in.weights.view(), in.points(0), in.out(0), count);
+
+        benchmark::DoNotOptimize(in.outX.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_DQSkinBatch)->Apply(meshArgs);
+
+static void BM_DQSkinParallel(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    SkinInputs in(count);
+
+    RangeTask skin = [&](size_t begin, size_t end) {
+        dqSkinBatch(in.joints.view(), in.weights.view(begin), in.points(begin), in.out(begin), end - begin);
+    };
+
+    for (auto _ : state)
+    {
+        parallelFor(count, kParallelGrain, skin);
+
+        benchmark::DoNotOptimize(in.outX.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+    state.counters["threads"] = (double) schedulerThreadCount();
+}
+BENCHMARK(BM_DQSkinParallel)->Apply(meshArgs)->UseRealTime();
+
+static void BM_DQSkinJoints(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+
+    std::vector<double> matrices;
+    randomMatrices(matrices, count);
+
+    DualQuatArray joints;
+    joints.resize(count);
+
+    for (auto _ : state)
+    {
+        for (size_t j = 0; j < count; j++)
+            joints.set(j, reinterpret_cast<const double (*)[4]>(&matrices[j * 16]));
+
+        benchmark::DoNotOptimize(joints.view().real.w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_DQSkinJoints)->Arg(kJoints)->Arg(1000)->ArgName("n");
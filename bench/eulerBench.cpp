@@ -0,0 +1,206 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    eulerBench
+    Euler to quaternion conversions, one element per call with the rotate
+    order looked up per element (quatMath.h), against the batch kernels
+    with one kernel per rotate order (quatBatch.h). Run for a cyclic and an
+    anti-cyclic order.
+
+    MEulerRotation::asQuaternion needs the Maya libraries, so the
+    per-element eulerToQuat, which computes the same thing the same way,
+    stands in for it here.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/quatBatch.h"
+#include "core/quatMath.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+namespace
+{
+    struct EulerInputs
+    {
+        std::vector<double> x, y, z;
+        std::vector<double> previousX, previousY, previousZ;
+        QuatArray quat;
+
+        explicit EulerInputs(size_t count)
+        {
+            bench::randomDoubles(x, count, -kPi, kPi);
+            bench::randomDoubles(y, count, -kPi, kPi);
+            bench::randomDoubles(z, count, -kPi, kPi);
+            bench::randomDoubles(previousX, count, -kPi, kPi);
+            bench::randomDoubles(previousY, count, -kPi, kPi);
+            bench::randomDoubles(previousZ, count, -kPi, kPi);
+            bench::randomQuats(quat, count);
+        }
+
+        VectorArrayView euler()
+        {
+            VectorArrayView view = { x.data(), y.data(), z.data() };
+            return view;
+        }
+
+        ConstVectorArrayView previous() const
+        {
+            ConstVectorArrayView view = { previousX.data(), previousY.data(), previousZ.data() };
+            return view;
+        }
+    };
+
+    void scalarOrderArgs(benchmark::internal::Benchmark *b)
+    {
+        b->ArgNames({ "n", "order" });
+        b->ArgsProduct({
+            benchmark::CreateRange(bench::kMinCount, bench::kMaxCount, 10),
+            { kRotateXYZ, kRotateZYX }
+        });
+    }
+
+    void batchOrderArgs(benchmark::internal::Benchmark *b)
+    {
+        b->ArgNames({ "n", "simd", "order" });
+        b->ArgsProduct({
+            benchmark::CreateRange(bench::kMinCount, bench::kMaxCount, 10),
+            { kSimdScalar, kSimdSSE2, kSimdAVX2, kSimdAVX512 },
+            { kRotateXYZ, kRotateZYX }
+        });
+    }
+}
+
+static void BM_EulerToQuatScalar(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    RotateOrder order = (RotateOrder) state.range(1);
+    EulerInputs in(count);
+
+    QuatArrayView q = in.quat.view();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            double euler[3] = { in.x[i], in.y[i], in.z[i] };
+            double quat[4];
+
+            eulerToQuat(euler, order, quat);
+
+            q.x[i] = quat[0];
+            q.y[i] = quat[1];
+            q.z[i] = quat[2];
+            q.w[i] = quat[3];
+        }
+
+        benchmark::DoNotOptimize(q.w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_EulerToQuatScalar)->Apply(scalarOrderArgs);
+
+static void BM_EulerToQuatBatch(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    RotateOrder order = (RotateOrder) state.range(2);
+    EulerInputs in(count);
+
+    for (auto _ : state)
+    {
+        eulerToQuatBatch(in.euler(), order, in.quat.view(), count);
+
+        benchmark::DoNotOptimize(in.quat.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_EulerToQuatBatch)->Apply(batchOrderArgs);
+
+static void BM_QuatToEulerScalar(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    RotateOrder order = (RotateOrder) state.range(1);
+    EulerInputs in(count);
+
+    ConstQuatArrayView q = in.quat.view();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            double quat[4] = { q.x[i], q.y[i], q.z[i], q.w[i] };
+            double euler[3];
+
+            quatToEuler(quat, order, euler);
+
+            in.x[i] = euler[0];
+            in.y[i] = euler[1];
+            in.z[i] = euler[2];
+        }
+
+        benchmark::DoNotOptimize(in.z.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_QuatToEulerScalar)->Apply(scalarOrderArgs);
+
+static void BM_QuatToEulerBatch(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    RotateOrder order = (RotateOrder) state.range(2);
+    EulerInputs in(count);
+
+    for (auto _ : state)
+    {
+        quatToEulerBatch(in.quat.view(), order, in.euler(), count);
+
+        benchmark::DoNotOptimize(in.z.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_QuatToEulerBatch)->Apply(batchOrderArgs);
+
+static void BM_EulerFilterBatch(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    RotateOrder order = (RotateOrder) state.range(2);
+    EulerInputs in(count);
+
+    std::vector<double> x(count), y(count), z(count);
+    VectorArrayView out = { x.data(), y.data(), z.data() };
+
+    for (auto _ : state)
+    {
+        eulerFilterBatch(in.euler(), in.previous(), order, out, count);
+
+        benchmark::DoNotOptimize(z.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_EulerFilterBatch)->Apply(batchOrderArgs);
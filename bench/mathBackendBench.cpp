@@ -0,0 +1,175 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    mathBackendBench
+    The kernels that take a MathBackend (quatBatch.h), run with each backend
+    at each instruction set: sin/cos and atan2 on their own, then exact
+    slerp and the axis-angle conversions in double and float. Compare the
+    libm, polynomial and table lines of the same n and simd. The inputs
+    match precisionBench, with spin so every slerp takes the exact path.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/quatBatch.h"
+#include "core/quatMath.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+namespace
+{
+    template <class T>
+    struct MathInputs
+    {
+        QuatArrayT<T> p;
+        QuatArrayT<T> q;
+        QuatArrayT<T> out;
+        std::vector<T> tween;
+        std::vector<short> spin;
+        std::vector<T> x, y, z, angle;
+        std::vector<unsigned char> nonZero;
+
+        explicit MathInputs(size_t count)
+        {
+            bench::randomQuats(p, count);
+            bench::randomQuats(q, count);
+            bench::randomDoubles(tween, count, 0.0, 1.0);
+            bench::randomShorts(spin, count, -1, 1);
+            bench::randomDoubles(x, count, -1.0, 1.0);
+            bench::randomDoubles(y, count, -1.0, 1.0);
+            bench::randomDoubles(z, count, -1.0, 1.0);
+            bench::randomDoubles(angle, count, -kPi, kPi);
+            out.resize(count);
+            nonZero.resize(count);
+        }
+
+        VectorArrayViewT<T> axis()
+        {
+            VectorArrayViewT<T> result = { x.data(), y.data(), z.data() };
+            return result;
+        }
+    };
+}
+
+static void BM_SinCosMath(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    bench::ScopedMathBackend backend(state);
+
+    size_t count = (size_t) state.range(0);
+    MathInputs<double> in(count);
+
+    for (auto _ : state)
+    {
+        sinCosBatch(in.angle.data(), in.x.data(), in.y.data(), count);
+
+        benchmark::DoNotOptimize(in.y.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_SinCosMath)->Apply(bench::mathBackendArgs);
+
+static void BM_Atan2Math(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    bench::ScopedMathBackend backend(state);
+
+    size_t count = (size_t) state.range(0);
+    MathInputs<double> in(count);
+
+    for (auto _ : state)
+    {
+        atan2Batch(in.x.data(), in.y.data(), in.angle.data(), count);
+
+        benchmark::DoNotOptimize(in.angle.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_Atan2Math)->Apply(bench::mathBackendArgs);
+
+template <class T>
+static void BM_SlerpMath(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    bench::ScopedMathBackend backend(state);
+
+    size_t count = (size_t) state.range(0);
+    MathInputs<T> in(count);
+
+    for (auto _ : state)
+    {
+        slerpBatch(in.p.view(), in.q.view(), in.tween.data(), in.spin.data(), in.out.view(), count);
+
+        benchmark::DoNotOptimize(in.out.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK_TEMPLATE(BM_SlerpMath, double)->Apply(bench::mathBackendArgs);
+BENCHMARK_TEMPLATE(BM_SlerpMath, float)->Apply(bench::mathBackendArgs);
+
+template <class T>
+static void BM_AxisAngleToQuatMath(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    bench::ScopedMathBackend backend(state);
+
+    size_t count = (size_t) state.range(0);
+    MathInputs<T> in(count);
+
+    for (auto _ : state)
+    {
+        axisAngleToQuatBatch(in.axis(), in.angle.data(), in.out.view(), count);
+
+        benchmark::DoNotOptimize(in.out.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK_TEMPLATE(BM_AxisAngleToQuatMath, double)->Apply(bench::mathBackendArgs);
+BENCHMARK_TEMPLATE(BM_AxisAngleToQuatMath, float)->Apply(bench::mathBackendArgs);
+
+template <class T>
+static void BM_QuatToAxisAngleMath(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    bench::ScopedMathBackend backend(state);
+
+    size_t count = (size_t) state.range(0);
+    MathInputs<T> in(count);
+
+    for (auto _ : state)
+    {
+        quatToAxisAngleBatch(in.p.view(), in.axis(), in.angle.data(), in.nonZero.data(), count);
+
+        benchmark::DoNotOptimize(in.angle.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK_TEMPLATE(BM_QuatToAxisAngleMath, double)->Apply(bench::mathBackendArgs);
+BENCHMARK_TEMPLATE(BM_QuatToAxisAngleMath, float)->Apply(bench::mathBackendArgs);
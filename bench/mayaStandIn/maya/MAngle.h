@@ -0,0 +1,44 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MANGLE_H
+#define MAYA_STAND_IN_MANGLE_H
+
+class MAngle
+{
+public:
+    enum Unit
+    {
+        kInvalid,
+        kRadians,
+        kDegrees,
+        kAngMinutes,
+        kAngSeconds,
+        kLast
+    };
+
+                    MAngle() : radians_(0.0) {}
+                    MAngle(double value, Unit unit = kRadians) : radians_(value * toRadians(unit)) {}
+
+    double          asRadians() const                       { return radians_; }
+    double          asDegrees() const                       { return radians_ / toRadians(kDegrees); }
+    double          as(Unit unit) const                     { return radians_ / toRadians(unit); }
+
+private:
+    static double   toRadians(Unit unit)
+                    {
+                        switch (unit)
+                        {
+                            case kDegrees:      return 3.14159265358979323846 / 180.0;
+                            case kAngMinutes:   return 3.14159265358979323846 / 10800.0;
+                            case kAngSeconds:   return 3.14159265358979323846 / 648000.0;
+                            default:            return 1.0;
+                        }
+                    }
+
+    double          radians_;
+};
+
+#endif
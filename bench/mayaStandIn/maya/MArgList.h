@@ -0,0 +1,31 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+
+#ifndef MAYA_STAND_IN_MARGLIST_H
+#define MAYA_STAND_IN_MARGLIST_H
+
+#include "MStatus.h"
+
+#include <vector>
+
+// Only numeric arguments, which is all quatArrayData reads.
+class MArgList
+{
+public:
+                    MArgList() {}
+
+    unsigned        length(MStatus *status = 0) const;
+
+    int             asInt(unsigned index, MStatus *status = 0) const;
+    double          asDouble(unsigned index, MStatus *status = 0) const;
+
+    MStatus         addArg(double arg);
+
+private:
+    std::vector<double> args_;
+};
+
+#endif
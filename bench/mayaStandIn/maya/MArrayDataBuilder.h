@@ -0,0 +1,37 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MARRAYDATABUILDER_H
+#define MAYA_STAND_IN_MARRAYDATABUILDER_H
+
+#include "MDataHandle.h"
+#include "MObject.h"
+#include "MStatus.h"
+
+#include <memory>
+
+class MDataBlock;
+
+// Elements for an array, set into it with MArrayDataHandle::set.
+class MArrayDataBuilder
+{
+public:
+                    MArrayDataBuilder(MDataBlock *data, const MObject &attribute, unsigned numElements, MStatus *status = 0);
+                    MArrayDataBuilder(const MObject &attribute, unsigned numElements, MStatus *status = 0);
+
+    MDataHandle     addElement(unsigned index, MStatus *status = 0);
+    MStatus         removeElement(unsigned index);
+    unsigned        elementCount(MStatus *status = 0) const;
+    MStatus         growArray(unsigned amount);
+
+private:
+    friend class MArrayDataHandle;
+
+                    MArrayDataBuilder();
+
+    std::shared_ptr<mayaStandIn::DataValue> array_;
+};
+
+#endif
@@ -0,0 +1,43 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MARRAYDATAHANDLE_H
+#define MAYA_STAND_IN_MARRAYDATAHANDLE_H
+
+#include "MArrayDataBuilder.h"
+#include "MDataHandle.h"
+#include "MStatus.h"
+
+// Elements are kept in logical index order, so physical i is the i-th
+// smallest index.
+class MArrayDataHandle
+{
+public:
+                    MArrayDataHandle(const MDataHandle &handle, MStatus *status = 0);
+
+    unsigned        elementCount(MStatus *status = 0);
+    unsigned        elementIndex(MStatus *status = 0);
+
+    MStatus         next();
+    MStatus         jumpToElement(unsigned logicalIndex);
+    MStatus         jumpToArrayElement(unsigned physicalIndex);
+
+    MDataHandle     inputValue(MStatus *status = 0);
+    MDataHandle     outputValue(MStatus *status = 0);
+
+    MStatus         set(MArrayDataBuilder &builder);
+    MArrayDataBuilder builder(MStatus *status = 0);
+
+    MStatus         setClean();
+    MStatus         setAllClean();
+
+private:
+    MDataHandle     current(MStatus *status);
+
+    mayaStandIn::DataValue *value_;
+    unsigned        current_;
+};
+
+#endif
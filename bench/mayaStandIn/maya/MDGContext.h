@@ -0,0 +1,20 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MDGCONTEXT_H
+#define MAYA_STAND_IN_MDGCONTEXT_H
+
+// Only the normal context; Maya's timed contexts need MTime.
+class MDGContext
+{
+public:
+                    MDGContext() {}
+
+    bool            isNormal() const    { return true; }
+
+    static const MDGContext fsNormal;
+};
+
+#endif
@@ -0,0 +1,55 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MDATABLOCK_H
+#define MAYA_STAND_IN_MDATABLOCK_H
+
+#include "MArrayDataHandle.h"
+#include "MDataHandle.h"
+#include "MDGContext.h"
+#include "MObject.h"
+#include "MPlug.h"
+#include "MStatus.h"
+
+#include <memory>
+
+/*
+    Values of one node's attributes, keyed by attribute and created with
+    their defaults on first access. Maya's data blocks come from the node;
+    the stand-in's are made by the caller, which sets the inputs through
+    inputValue and inputArrayValue before calling compute.
+*/
+class MDataBlock
+{
+public:
+                    MDataBlock();
+                    ~MDataBlock();
+
+    MDataHandle     inputValue(const MObject &attribute, MStatus *status = 0);
+    MDataHandle     inputValue(const MPlug &plug, MStatus *status = 0);
+    MDataHandle     outputValue(const MObject &attribute, MStatus *status = 0);
+    MDataHandle     outputValue(const MPlug &plug, MStatus *status = 0);
+
+    MArrayDataHandle inputArrayValue(const MObject &attribute, MStatus *status = 0);
+    MArrayDataHandle outputArrayValue(const MObject &attribute, MStatus *status = 0);
+
+    MStatus         setClean(const MObject &attribute);
+    MStatus         setClean(const MPlug &plug);
+    bool            isClean(const MObject &attribute, MStatus *status = 0);
+
+    const MDGContext& context(MStatus *status = 0);
+
+private:
+                    MDataBlock(const MDataBlock&);
+    MDataBlock&     operator=(const MDataBlock&);
+
+    MDataHandle     value(mayaStandIn::Attribute *attr, MStatus *status);
+
+    struct Values;
+    std::unique_ptr<Values> values_;
+    MDGContext      context_;
+};
+
+#endif
@@ -0,0 +1,68 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MDATAHANDLE_H
+#define MAYA_STAND_IN_MDATAHANDLE_H
+
+#include "MAngle.h"
+#include "MMatrix.h"
+#include "MObject.h"
+#include "MPxData.h"
+#include "MStatus.h"
+#include "MTypes.h"
+
+namespace mayaStandIn { struct DataValue; }
+
+/*
+    A value in an MDataBlock. Handles to the children of a double3 or
+    double4 point into the parent's value, so asDouble3, asDouble4 and the
+    children see the same numbers. A handle stays valid until the array
+    holding it is resized.
+*/
+class MDataHandle
+{
+public:
+                    MDataHandle();
+
+    bool            isNull() const;
+
+    double          asDouble() const;
+    float           asFloat() const;
+    short           asShort() const;
+    int             asInt() const;
+    bool            asBool() const;
+    MAngle          asAngle() const;
+    double3&        asDouble3();
+    double4&        asDouble4();
+    const MMatrix&  asMatrix() const;
+    MPxData*        asPluginData() const;
+
+    MDataHandle     child(const MObject &attribute);
+
+    void            setDouble(double value);
+    void            setFloat(float value);
+    void            setShort(short value);
+    void            setInt(int value);
+    void            setBool(bool value);
+    void            setMAngle(const MAngle &value);
+    void            set3Double(double x, double y, double z);
+    void            set4Double(double x, double y, double z, double w);
+    void            setMMatrix(const MMatrix &value);
+    MStatus         set(const MObject &data);
+
+    void            setClean();
+
+private:
+    friend class MArrayDataHandle;
+    friend class MArrayDataBuilder;
+    friend class MDataBlock;
+
+                    MDataHandle(mayaStandIn::DataValue *value, double *number);
+
+    mayaStandIn::DataValue *value_;
+    double          *number_;
+};
+
+#endif
@@ -0,0 +1,26 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MEVALUATIONNODE_H
+#define MAYA_STAND_IN_MEVALUATIONNODE_H
+
+#include "MObject.h"
+#include "MStatus.h"
+
+#include <vector>
+
+class MEvaluationNode
+{
+public:
+    bool            dirtyPlugExists(const MObject &attribute, MStatus *status = 0) const;
+
+    // Stand-in only: what the evaluation manager would have dirtied.
+    void            addDirtyPlug(const MObject &attribute)      { dirty_.push_back(attribute); }
+
+private:
+    std::vector<MObject> dirty_;
+};
+
+#endif
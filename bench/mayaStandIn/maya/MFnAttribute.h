@@ -0,0 +1,45 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MFNATTRIBUTE_H
+#define MAYA_STAND_IN_MFNATTRIBUTE_H
+
+#include "MObject.h"
+#include "MStatus.h"
+#include "MString.h"
+
+// The flags are kept but change nothing, except setArray.
+class MFnAttribute
+{
+public:
+                    MFnAttribute() : attr_(0) {}
+    explicit        MFnAttribute(const MObject &attribute, MStatus *status = 0);
+    virtual         ~MFnAttribute() {}
+
+    MObject         object(MStatus *status = 0) const   { if (status) *status = MS::kSuccess; return MObject(attr_); }
+    MStatus         setObject(const MObject &attribute) { attr_ = attribute.standInAttribute(); return MS::kSuccess; }
+
+    MString         name(MStatus *status = 0) const;
+    MString         shortName(MStatus *status = 0) const;
+
+    bool            isArray(MStatus *status = 0) const;
+
+    MStatus         setKeyable(bool state);
+    MStatus         setChannelBox(bool state);
+    MStatus         setStorable(bool state);
+    MStatus         setWritable(bool state);
+    MStatus         setReadable(bool state);
+    MStatus         setConnectable(bool state);
+    MStatus         setHidden(bool state);
+    MStatus         setCached(bool state);
+    MStatus         setArray(bool state);
+    MStatus         setIndexMatters(bool state);
+    MStatus         setUsesArrayDataBuilder(bool state);
+
+protected:
+    mayaStandIn::Attribute *attr_;
+};
+
+#endif
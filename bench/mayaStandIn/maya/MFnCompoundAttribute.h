@@ -0,0 +1,23 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MFNCOMPOUNDATTRIBUTE_H
+#define MAYA_STAND_IN_MFNCOMPOUNDATTRIBUTE_H
+
+#include "MFnAttribute.h"
+
+class MFnCompoundAttribute : public MFnAttribute
+{
+public:
+                    MFnCompoundAttribute() {}
+
+    MObject         create(const MString &fullName, const MString &briefName, MStatus *status = 0);
+
+    MStatus         addChild(const MObject &child);
+    unsigned        numChildren(MStatus *status = 0) const;
+    MObject         child(unsigned index, MStatus *status = 0) const;
+};
+
+#endif
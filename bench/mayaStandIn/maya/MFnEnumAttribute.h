@@ -0,0 +1,25 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MFNENUMATTRIBUTE_H
+#define MAYA_STAND_IN_MFNENUMATTRIBUTE_H
+
+#include "MFnAttribute.h"
+
+class MFnEnumAttribute : public MFnAttribute
+{
+public:
+                    MFnEnumAttribute() {}
+
+    MObject         create(const MString &fullName, const MString &briefName, short defaultValue = 0, MStatus *status = 0);
+
+    MStatus         addField(const MString &fieldName, short value);
+    MString         fieldName(short value, MStatus *status = 0) const;
+    short           fieldIndex(const MString &fieldName, MStatus *status = 0) const;
+
+    MStatus         setDefault(short value);
+};
+
+#endif
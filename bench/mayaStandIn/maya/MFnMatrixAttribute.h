@@ -0,0 +1,25 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MFNMATRIXATTRIBUTE_H
+#define MAYA_STAND_IN_MFNMATRIXATTRIBUTE_H
+
+#include "MFnAttribute.h"
+
+class MFnMatrixAttribute : public MFnAttribute
+{
+public:
+    enum Type
+    {
+        kFloat,
+        kDouble
+    };
+
+                    MFnMatrixAttribute() {}
+
+    MObject         create(const MString &fullName, const MString &briefName, Type matrixType = kDouble, MStatus *status = 0);
+};
+
+#endif
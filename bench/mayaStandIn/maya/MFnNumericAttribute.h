@@ -0,0 +1,32 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MFNNUMERICATTRIBUTE_H
+#define MAYA_STAND_IN_MFNNUMERICATTRIBUTE_H
+
+#include "MFnAttribute.h"
+#include "MFnNumericData.h"
+
+class MFnNumericAttribute : public MFnAttribute
+{
+public:
+                    MFnNumericAttribute() {}
+
+    MObject         create(const MString &fullName, const MString &briefName, MFnNumericData::Type unitType, double defaultValue = 0.0, MStatus *status = 0);
+
+    // A double2 or double3 of the given children.
+    MObject         create(const MString &fullName, const MString &briefName, const MObject &child1, const MObject &child2, const MObject &child3 = MObject::kNullObj, MStatus *status = 0);
+
+    // A double4 of the given children.
+    MObject         create(const MString &fullName, const MString &briefName, const MObject &child1, const MObject &child2, const MObject &child3, const MObject &child4, MStatus *status = 0);
+
+    MStatus         setDefault(double value);
+    MStatus         setMin(double value);
+    MStatus         setMax(double value);
+    MStatus         setSoftMin(double value);
+    MStatus         setSoftMax(double value);
+};
+
+#endif
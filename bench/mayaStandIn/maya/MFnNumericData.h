@@ -0,0 +1,39 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MFNNUMERICDATA_H
+#define MAYA_STAND_IN_MFNNUMERICDATA_H
+
+class MFnNumericData
+{
+public:
+    enum Type
+    {
+        kInvalid,
+        kBoolean,
+        kByte,
+        kChar,
+        kShort,
+        k2Short,
+        k3Short,
+        kLong,
+        kInt = kLong,
+        k2Long,
+        k2Int = k2Long,
+        k3Long,
+        k3Int = k3Long,
+        kFloat,
+        k2Float,
+        k3Float,
+        kDouble,
+        k2Double,
+        k3Double,
+        k4Double,
+        kAddr,
+        kLast
+    };
+};
+
+#endif
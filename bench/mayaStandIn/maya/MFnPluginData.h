@@ -0,0 +1,35 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+
+#ifndef MAYA_STAND_IN_MFNPLUGINDATA_H
+#define MAYA_STAND_IN_MFNPLUGINDATA_H
+
+#include "MObject.h"
+#include "MPxData.h"
+#include "MStatus.h"
+#include "MTypeId.h"
+
+class MFnPluginData
+{
+public:
+                    MFnPluginData() {}
+
+    // A new value of a type added with mayaStandIn::registerData.
+    MObject         create(const MTypeId &id, MStatus *status = 0);
+
+    MPxData*        data(MStatus *status = 0);
+
+private:
+    std::shared_ptr<MPxData> data_;
+};
+
+namespace mayaStandIn
+{
+    // What MFnPlugin::registerData does for MFnPluginData::create.
+    MStatus         registerData(const MTypeId &id, void *(*creator)());
+}
+
+#endif
@@ -0,0 +1,22 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+
+#ifndef MAYA_STAND_IN_MFNTYPEDATTRIBUTE_H
+#define MAYA_STAND_IN_MFNTYPEDATTRIBUTE_H
+
+#include "MFnAttribute.h"
+#include "MTypeId.h"
+
+class MFnTypedAttribute : public MFnAttribute
+{
+public:
+                    MFnTypedAttribute() {}
+
+    // Plug-in data only; the default is always empty.
+    MObject         create(const MString &fullName, const MString &briefName, const MTypeId &id, const MObject &defaultData = MObject::kNullObj, MStatus *status = 0);
+};
+
+#endif
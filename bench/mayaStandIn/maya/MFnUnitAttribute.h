@@ -0,0 +1,35 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MFNUNITATTRIBUTE_H
+#define MAYA_STAND_IN_MFNUNITATTRIBUTE_H
+
+#include "MFnAttribute.h"
+
+// Values are in internal units: radians for kAngle.
+class MFnUnitAttribute : public MFnAttribute
+{
+public:
+    enum Type
+    {
+        kInvalid,
+        kAngle,
+        kDistance,
+        kTime,
+        kLast
+    };
+
+                    MFnUnitAttribute() {}
+
+    MObject         create(const MString &fullName, const MString &briefName, Type unitType, double defaultValue = 0.0, MStatus *status = 0);
+
+    MStatus         setDefault(double value);
+    MStatus         setMin(double value);
+    MStatus         setMax(double value);
+    MStatus         setSoftMin(double value);
+    MStatus         setSoftMax(double value);
+};
+
+#endif
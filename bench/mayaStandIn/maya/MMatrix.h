@@ -0,0 +1,43 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MMATRIX_H
+#define MAYA_STAND_IN_MMATRIX_H
+
+// Row-vector layout, translation in the last row, as in Maya.
+class MMatrix
+{
+public:
+                    MMatrix()
+                    {
+                        for (unsigned r = 0; r < 4; r++)
+                            for (unsigned c = 0; c < 4; c++)
+                                matrix[r][c] = r == c ? 1.0 : 0.0;
+                    }
+
+    double          operator()(unsigned row, unsigned col) const    { return matrix[row][col]; }
+
+    MMatrix         operator*(const MMatrix &right) const
+                    {
+                        MMatrix result;
+
+                        for (unsigned r = 0; r < 4; r++)
+                        {
+                            for (unsigned c = 0; c < 4; c++)
+                            {
+                                result.matrix[r][c] = matrix[r][0] * right.matrix[0][c] + matrix[r][1] * right.matrix[1][c] +
+                                                      matrix[r][2] * right.matrix[2][c] + matrix[r][3] * right.matrix[3][c];
+                            }
+                        }
+
+                        return result;
+                    }
+
+    static const MMatrix identity;
+
+    double          matrix[4][4];
+};
+
+#endif
@@ -0,0 +1,38 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MOBJECT_H
+#define MAYA_STAND_IN_MOBJECT_H
+
+#include <memory>
+
+namespace mayaStandIn { struct Attribute; }
+
+class MPxData;
+
+// In the stand-in an MObject refers to an attribute or to plug-in data.
+class MObject
+{
+public:
+                    MObject() : attr_(0) {}
+    explicit        MObject(mayaStandIn::Attribute *attr) : attr_(attr) {}
+    explicit        MObject(const std::shared_ptr<MPxData> &data) : attr_(0), data_(data) {}
+
+    bool            isNull() const                          { return attr_ == 0 && !data_; }
+
+    bool            operator==(const MObject &other) const  { return attr_ == other.attr_ && data_ == other.data_; }
+    bool            operator!=(const MObject &other) const  { return !(*this == other); }
+
+    mayaStandIn::Attribute* standInAttribute() const        { return attr_; }
+    const std::shared_ptr<MPxData>& standInData() const     { return data_; }
+
+    static const MObject kNullObj;
+
+private:
+    mayaStandIn::Attribute *attr_;
+    std::shared_ptr<MPxData> data_;
+};
+
+#endif
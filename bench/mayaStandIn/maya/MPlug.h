@@ -0,0 +1,55 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MPLUG_H
+#define MAYA_STAND_IN_MPLUG_H
+
+#include "MObject.h"
+#include "MStatus.h"
+
+/*
+    An attribute with the logical index of its own element, if it is one,
+    and of its parent's element, if the parent is an array. Deeper nesting
+    is not kept.
+*/
+class MPlug
+{
+public:
+                    MPlug();
+                    MPlug(const MObject &node, const MObject &attribute);
+
+    bool            isNull(MStatus *status = 0) const;
+    MObject         attribute(MStatus *status = 0) const;
+
+    bool            isArray(MStatus *status = 0) const;
+    bool            isElement(MStatus *status = 0) const;
+    bool            isCompound(MStatus *status = 0) const;
+    bool            isChild(MStatus *status = 0) const;
+
+    unsigned        logicalIndex(MStatus *status = 0) const;
+    unsigned        numChildren(MStatus *status = 0) const;
+
+    MPlug           array(MStatus *status = 0) const;
+    MPlug           parent(MStatus *status = 0) const;
+    MPlug           child(unsigned index, MStatus *status = 0) const;
+    MPlug           child(const MObject &attribute, MStatus *status = 0) const;
+    MPlug           elementByLogicalIndex(unsigned logicalIndex, MStatus *status = 0) const;
+
+    bool            operator==(const MPlug &other) const;
+    bool            operator!=(const MPlug &other) const    { return !(*this == other); }
+    bool            operator==(const MObject &attribute) const;
+    bool            operator!=(const MObject &attribute) const  { return !(*this == attribute); }
+
+private:
+    friend class MDataBlock;
+
+                    MPlug(mayaStandIn::Attribute *attr, int logicalIndex, int parentIndex);
+
+    mayaStandIn::Attribute *attr_;
+    int             logicalIndex_;
+    int             parentIndex_;
+};
+
+#endif
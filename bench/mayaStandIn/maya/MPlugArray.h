@@ -0,0 +1,27 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MPLUGARRAY_H
+#define MAYA_STAND_IN_MPLUGARRAY_H
+
+#include "MPlug.h"
+
+#include <vector>
+
+class MPlugArray
+{
+public:
+    unsigned        length() const                      { return (unsigned) plugs_.size(); }
+    MPlug&          operator[](unsigned i)              { return plugs_[i]; }
+    const MPlug&    operator[](unsigned i) const        { return plugs_[i]; }
+
+    void            append(const MPlug &plug)           { plugs_.push_back(plug); }
+    void            clear()                             { plugs_.clear(); }
+
+private:
+    std::vector<MPlug> plugs_;
+};
+
+#endif
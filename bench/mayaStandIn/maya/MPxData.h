@@ -0,0 +1,33 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+
+#ifndef MAYA_STAND_IN_MPXDATA_H
+#define MAYA_STAND_IN_MPXDATA_H
+
+#include "MArgList.h"
+#include "MStatus.h"
+#include "MString.h"
+#include "MTypeId.h"
+
+#include <iostream>
+
+class MPxData
+{
+public:
+    virtual         ~MPxData() {}
+
+    virtual MStatus readASCII(const MArgList & /* args */, unsigned & /* lastElement */) { return MS::kNotImplemented; }
+    virtual MStatus readBinary(std::istream & /* in */, unsigned /* length */)          { return MS::kNotImplemented; }
+    virtual MStatus writeASCII(std::ostream & /* out */)                                { return MS::kNotImplemented; }
+    virtual MStatus writeBinary(std::ostream & /* out */)                               { return MS::kNotImplemented; }
+
+    virtual void    copy(const MPxData &other) = 0;
+
+    virtual MTypeId typeId() const = 0;
+    virtual MString name() const = 0;
+};
+
+#endif
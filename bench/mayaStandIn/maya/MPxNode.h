@@ -0,0 +1,51 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MPXNODE_H
+#define MAYA_STAND_IN_MPXNODE_H
+
+#include "MDataBlock.h"
+#include "MDGContext.h"
+#include "MEvaluationNode.h"
+#include "MObject.h"
+#include "MPlug.h"
+#include "MPlugArray.h"
+#include "MStatus.h"
+
+/*
+    Nothing calls these for the node: the caller drives compute,
+    setDependentsDirty and preEvaluation itself, in the order Maya would.
+*/
+class MPxNode
+{
+public:
+    enum Type
+    {
+        kDependNode,
+        kLocatorNode,
+        kDeformerNode
+    };
+
+    enum SchedulingType
+    {
+        kParallel,
+        kSerial,
+        kGloballySerial,
+        kUntrusted
+    };
+
+                            MPxNode() {}
+    virtual                 ~MPxNode() {}
+
+    virtual MStatus         compute(const MPlug &plug, MDataBlock &data);
+    virtual MStatus         setDependentsDirty(const MPlug &plug, MPlugArray &affectedPlugs);
+    virtual MStatus         preEvaluation(const MDGContext &context, const MEvaluationNode &evaluationNode);
+    virtual SchedulingType  schedulingType() const      { return kSerial; }
+
+    static MStatus          addAttribute(const MObject &attribute);
+    static MStatus          attributeAffects(const MObject &whenChanges, const MObject &isAffected);
+};
+
+#endif
@@ -0,0 +1,22 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MQUATERNION_H
+#define MAYA_STAND_IN_MQUATERNION_H
+
+class MQuaternion
+{
+public:
+                    MQuaternion() : x(0.0), y(0.0), z(0.0), w(1.0) {}
+                    MQuaternion(double xx, double yy, double zz, double ww) : x(xx), y(yy), z(zz), w(ww) {}
+                    MQuaternion(const double q[4]) : x(q[0]), y(q[1]), z(q[2]), w(q[3]) {}
+
+    double          operator[](unsigned i) const    { return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w)); }
+    double&         operator[](unsigned i)          { return i == 0 ? x : (i == 1 ? y : (i == 2 ? z : w)); }
+
+    double          x, y, z, w;
+};
+
+#endif
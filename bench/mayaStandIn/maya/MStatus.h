@@ -0,0 +1,74 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MSTATUS_H
+#define MAYA_STAND_IN_MSTATUS_H
+
+class MStatus
+{
+public:
+    enum MStatusCode
+    {
+        kSuccess = 0,
+        kFailure,
+        kInsufficientMemory,
+        kInvalidParameter,
+        kLicenseFailure,
+        kUnknownParameter,
+        kNotImplemented,
+        kNotFound,
+        kEndOfFile
+    };
+
+                    MStatus() : code_(kSuccess) {}
+                    MStatus(MStatusCode code) : code_(code) {}
+
+    MStatusCode     statusCode() const                      { return code_; }
+    bool            error() const                           { return code_ != kSuccess; }
+
+                    operator bool() const                   { return code_ == kSuccess; }
+
+    bool            operator==(const MStatus &other) const  { return code_ == other.code_; }
+    bool            operator!=(const MStatus &other) const  { return code_ != other.code_; }
+    bool            operator==(MStatusCode code) const      { return code_ == code; }
+    bool            operator!=(MStatusCode code) const      { return code_ != code; }
+
+private:
+    MStatusCode     code_;
+};
+
+inline bool operator==(MStatus::MStatusCode code, const MStatus &status) { return status == code; }
+inline bool operator!=(MStatus::MStatusCode code, const MStatus &status) { return status != code; }
+
+namespace MS
+{
+    typedef MStatus::MStatusCode MStatusCode;
+
+    const MStatusCode kSuccess          = MStatus::kSuccess;
+    const MStatusCode kFailure          = MStatus::kFailure;
+    const MStatusCode kInvalidParameter = MStatus::kInvalidParameter;
+    const MStatusCode kUnknownParameter = MStatus::kUnknownParameter;
+    const MStatusCode kNotImplemented   = MStatus::kNotImplemented;
+    const MStatusCode kNotFound         = MStatus::kNotFound;
+}
+
+// Maya's versions also print the error; the stand-in only returns it.
+#define CHECK_MSTATUS_AND_RETURN(_status, _retVal)      \
+    {                                                   \
+        MStatus _maya_status = (_status);               \
+        if (MStatus::kSuccess != _maya_status)          \
+            return (_retVal);                           \
+    }
+
+#define CHECK_MSTATUS_AND_RETURN_IT(_status)            \
+    CHECK_MSTATUS_AND_RETURN((_status), (_status))
+
+#define CHECK_MSTATUS(_status)                          \
+    {                                                   \
+        MStatus _maya_status = (_status);               \
+        (void) _maya_status;                            \
+    }
+
+#endif
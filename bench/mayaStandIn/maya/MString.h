@@ -0,0 +1,30 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MSTRING_H
+#define MAYA_STAND_IN_MSTRING_H
+
+#include <string>
+
+class MString
+{
+public:
+                    MString() {}
+                    MString(const char *chars) : s_(chars ? chars : "") {}
+
+    const char*     asChar() const                          { return s_.c_str(); }
+    unsigned        length() const                          { return (unsigned) s_.size(); }
+
+    MString         operator+(const MString &other) const   { MString result(*this); result.s_ += other.s_; return result; }
+    MString&        operator+=(const MString &other)        { s_ += other.s_; return *this; }
+
+    bool            operator==(const MString &other) const  { return s_ == other.s_; }
+    bool            operator!=(const MString &other) const  { return s_ != other.s_; }
+
+private:
+    std::string     s_;
+};
+
+#endif
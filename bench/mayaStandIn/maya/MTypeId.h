@@ -0,0 +1,23 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MTYPEID_H
+#define MAYA_STAND_IN_MTYPEID_H
+
+class MTypeId
+{
+public:
+                    MTypeId(unsigned id) : id_(id) {}
+
+    unsigned        id() const                              { return id_; }
+
+    bool            operator==(const MTypeId &other) const  { return id_ == other.id_; }
+    bool            operator!=(const MTypeId &other) const  { return id_ != other.id_; }
+
+private:
+    unsigned        id_;
+};
+
+#endif
@@ -0,0 +1,23 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MTYPES_H
+#define MAYA_STAND_IN_MTYPES_H
+
+// The version the stand-in follows, so the evaluation manager code paths
+// are compiled.
+#define MAYA_API_VERSION 201800
+
+typedef double  double2[2];
+typedef double  double3[3];
+typedef double  double4[4];
+typedef float   float2[2];
+typedef float   float3[3];
+typedef int     int2[2];
+typedef int     int3[3];
+typedef short   short2[2];
+typedef short   short3[3];
+
+#endif
@@ -0,0 +1,26 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#ifndef MAYA_STAND_IN_MVECTOR_H
+#define MAYA_STAND_IN_MVECTOR_H
+
+#include <cmath>
+
+class MVector
+{
+public:
+                    MVector() : x(0.0), y(0.0), z(0.0) {}
+                    MVector(double xx, double yy, double zz = 0.0) : x(xx), y(yy), z(zz) {}
+                    MVector(const double v[3]) : x(v[0]), y(v[1]), z(v[2]) {}
+
+    double          operator[](unsigned i) const    { return i == 0 ? x : (i == 1 ? y : z); }
+    double&         operator[](unsigned i)          { return i == 0 ? x : (i == 1 ? y : z); }
+
+    double          length() const                  { return std::sqrt(x * x + y * y + z * z); }
+
+    double          x, y, z;
+};
+
+#endif
@@ -0,0 +1,482 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "standInData.h"
+
+#include <maya/MDGContext.h>
+#include <maya/MEvaluationNode.h>
+#include <maya/MFnAttribute.h>
+#include <maya/MFnCompoundAttribute.h>
+#include <maya/MFnEnumAttribute.h>
+#include <maya/MFnMatrixAttribute.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnTypedAttribute.h>
+#include <maya/MFnUnitAttribute.h>
+#include <maya/MMatrix.h>
+#include <maya/MObject.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+
+#include <algorithm>
+
+using mayaStandIn::Attribute;
+
+const MObject MObject::kNullObj;
+const MMatrix MMatrix::identity;
+const MDGContext MDGContext::fsNormal;
+
+namespace mayaStandIn
+{
+    Attribute* createAttribute(const char *longName, const char *shortName, AttributeKind kind, int dataType, double defaultValue)
+    {
+        static std::vector<std::unique_ptr<Attribute> > attributes;
+
+        Attribute *attr = new Attribute();
+        attributes.push_back(std::unique_ptr<Attribute>(attr));
+
+        attr->longName = longName;
+        attr->shortName = shortName;
+        attr->kind = kind;
+        attr->dataType = dataType;
+        attr->defaultValue = defaultValue;
+        attr->array = false;
+        attr->parent = 0;
+        attr->childIndex = 0;
+
+        return attr;
+    }
+}
+
+namespace
+{
+    MStatus setStatus(MStatus *status, bool ok)
+    {
+        MStatus result = ok ? MS::kSuccess : MS::kFailure;
+
+        if (status)
+            *status = result;
+
+        return result;
+    }
+
+    void attachChild(Attribute *parent, Attribute *child)
+    {
+        child->parent = parent;
+        child->childIndex = (unsigned) parent->children.size();
+        parent->children.push_back(child);
+    }
+}
+
+
+/*---- MPlug ----*/
+
+MPlug::MPlug() :
+    attr_(0),
+    logicalIndex_(-1),
+    parentIndex_(-1)
+{
+}
+
+MPlug::MPlug(const MObject & /* node */, const MObject &attribute) :
+    attr_(attribute.standInAttribute()),
+    logicalIndex_(-1),
+    parentIndex_(-1)
+{
+}
+
+MPlug::MPlug(Attribute *attr, int logicalIndex, int parentIndex) :
+    attr_(attr),
+    logicalIndex_(logicalIndex),
+    parentIndex_(parentIndex)
+{
+}
+
+bool MPlug::isNull(MStatus *status) const
+{
+    setStatus(status, true);
+    return attr_ == 0;
+}
+
+MObject MPlug::attribute(MStatus *status) const
+{
+    setStatus(status, attr_ != 0);
+    return MObject(attr_);
+}
+
+bool MPlug::isArray(MStatus *status) const
+{
+    setStatus(status, attr_ != 0);
+    return attr_ && attr_->array && logicalIndex_ < 0;
+}
+
+bool MPlug::isElement(MStatus *status) const
+{
+    setStatus(status, attr_ != 0);
+    return logicalIndex_ >= 0;
+}
+
+bool MPlug::isCompound(MStatus *status) const
+{
+    setStatus(status, attr_ != 0);
+    return attr_ && !attr_->children.empty();
+}
+
+bool MPlug::isChild(MStatus *status) const
+{
+    setStatus(status, attr_ != 0);
+    return attr_ && attr_->parent;
+}
+
+unsigned MPlug::logicalIndex(MStatus *status) const
+{
+    setStatus(status, logicalIndex_ >= 0);
+    return logicalIndex_ >= 0 ? (unsigned) logicalIndex_ : 0;
+}
+
+unsigned MPlug::numChildren(MStatus *status) const
+{
+    setStatus(status, attr_ != 0);
+    return attr_ ? (unsigned) attr_->children.size() : 0;
+}
+
+MPlug MPlug::array(MStatus *status) const
+{
+    if (!setStatus(status, logicalIndex_ >= 0))
+        return MPlug();
+
+    return MPlug(attr_, -1, parentIndex_);
+}
+
+MPlug MPlug::parent(MStatus *status) const
+{
+    if (!setStatus(status, attr_ && attr_->parent))
+        return MPlug();
+
+    return MPlug(attr_->parent, parentIndex_, -1);
+}
+
+MPlug MPlug::child(unsigned index, MStatus *status) const
+{
+    if (!setStatus(status, attr_ && index < attr_->children.size()))
+        return MPlug();
+
+    return MPlug(attr_->children[index], -1, logicalIndex_);
+}
+
+MPlug MPlug::child(const MObject &attribute, MStatus *status) const
+{
+    Attribute *childAttr = attribute.standInAttribute();
+
+    if (!setStatus(status, attr_ && childAttr && childAttr->parent == attr_))
+        return MPlug();
+
+    return MPlug(childAttr, -1, logicalIndex_);
+}
+
+MPlug MPlug::elementByLogicalIndex(unsigned logicalIndex, MStatus *status) const
+{
+    if (!setStatus(status, attr_ && attr_->array && logicalIndex_ < 0))
+        return MPlug();
+
+    return MPlug(attr_, (int) logicalIndex, parentIndex_);
+}
+
+bool MPlug::operator==(const MPlug &other) const
+{
+    return attr_ == other.attr_ && logicalIndex_ == other.logicalIndex_ && parentIndex_ == other.parentIndex_;
+}
+
+bool MPlug::operator==(const MObject &attribute) const
+{
+    return attr_ != 0 && attr_ == attribute.standInAttribute();
+}
+
+
+/*---- MPxNode ----*/
+
+MStatus MPxNode::compute(const MPlug & /* plug */, MDataBlock & /* data */)
+{
+    return MS::kUnknownParameter;
+}
+
+MStatus MPxNode::setDependentsDirty(const MPlug & /* plug */, MPlugArray & /* affectedPlugs */)
+{
+    return MS::kSuccess;
+}
+
+MStatus MPxNode::preEvaluation(const MDGContext & /* context */, const MEvaluationNode & /* evaluationNode */)
+{
+    return MS::kSuccess;
+}
+
+MStatus MPxNode::addAttribute(const MObject &attribute)
+{
+    return setStatus(0, !attribute.isNull());
+}
+
+MStatus MPxNode::attributeAffects(const MObject &whenChanges, const MObject &isAffected)
+{
+    Attribute *source = whenChanges.standInAttribute();
+
+    if (!source || isAffected.isNull())
+        return MS::kInvalidParameter;
+
+    source->affects.push_back(isAffected.standInAttribute());
+    return MS::kSuccess;
+}
+
+
+/*---- MEvaluationNode ----*/
+
+bool MEvaluationNode::dirtyPlugExists(const MObject &attribute, MStatus *status) const
+{
+    setStatus(status, true);
+    return std::find(dirty_.begin(), dirty_.end(), attribute) != dirty_.end();
+}
+
+
+/*---- MFnAttribute ----*/
+
+MFnAttribute::MFnAttribute(const MObject &attribute, MStatus *status) :
+    attr_(attribute.standInAttribute())
+{
+    setStatus(status, attr_ != 0);
+}
+
+MString MFnAttribute::name(MStatus *status) const
+{
+    setStatus(status, attr_ != 0);
+    return attr_ ? MString(attr_->longName.c_str()) : MString();
+}
+
+MString MFnAttribute::shortName(MStatus *status) const
+{
+    setStatus(status, attr_ != 0);
+    return attr_ ? MString(attr_->shortName.c_str()) : MString();
+}
+
+bool MFnAttribute::isArray(MStatus *status) const
+{
+    setStatus(status, attr_ != 0);
+    return attr_ && attr_->array;
+}
+
+MStatus MFnAttribute::setKeyable(bool)              { return setStatus(0, attr_ != 0); }
+MStatus MFnAttribute::setChannelBox(bool)           { return setStatus(0, attr_ != 0); }
+MStatus MFnAttribute::setStorable(bool)             { return setStatus(0, attr_ != 0); }
+MStatus MFnAttribute::setWritable(bool)             { return setStatus(0, attr_ != 0); }
+MStatus MFnAttribute::setReadable(bool)             { return setStatus(0, attr_ != 0); }
+MStatus MFnAttribute::setConnectable(bool)          { return setStatus(0, attr_ != 0); }
+MStatus MFnAttribute::setHidden(bool)               { return setStatus(0, attr_ != 0); }
+MStatus MFnAttribute::setCached(bool)               { return setStatus(0, attr_ != 0); }
+MStatus MFnAttribute::setIndexMatters(bool)         { return setStatus(0, attr_ != 0); }
+MStatus MFnAttribute::setUsesArrayDataBuilder(bool) { return setStatus(0, attr_ != 0); }
+
+MStatus MFnAttribute::setArray(bool state)
+{
+    if (attr_)
+        attr_->array = state;
+
+    return setStatus(0, attr_ != 0);
+}
+
+
+/*---- MFnNumericAttribute ----*/
+
+MObject MFnNumericAttribute::create(const MString &fullName, const MString &briefName, MFnNumericData::Type unitType, double defaultValue, MStatus *status)
+{
+    attr_ = mayaStandIn::createAttribute(fullName.asChar(), briefName.asChar(), mayaStandIn::kNumericAttribute, unitType, defaultValue);
+
+    setStatus(status, true);
+    return MObject(attr_);
+}
+
+MObject MFnNumericAttribute::create(const MString &fullName, const MString &briefName, const MObject &child1, const MObject &child2, const MObject &child3, MStatus *status)
+{
+    MFnNumericData::Type type = child3.isNull() ? MFnNumericData::k2Double : MFnNumericData::k3Double;
+
+    attr_ = mayaStandIn::createAttribute(fullName.asChar(), briefName.asChar(), mayaStandIn::kNumericAttribute, type, 0.0);
+
+    attachChild(attr_, child1.standInAttribute());
+    attachChild(attr_, child2.standInAttribute());
+
+    if (!child3.isNull())
+        attachChild(attr_, child3.standInAttribute());
+
+    setStatus(status, true);
+    return MObject(attr_);
+}
+
+MObject MFnNumericAttribute::create(const MString &fullName, const MString &briefName, const MObject &child1, const MObject &child2, const MObject &child3, const MObject &child4, MStatus *status)
+{
+    attr_ = mayaStandIn::createAttribute(fullName.asChar(), briefName.asChar(), mayaStandIn::kNumericAttribute, MFnNumericData::k4Double, 0.0);
+
+    attachChild(attr_, child1.standInAttribute());
+    attachChild(attr_, child2.standInAttribute());
+    attachChild(attr_, child3.standInAttribute());
+    attachChild(attr_, child4.standInAttribute());
+
+    setStatus(status, true);
+    return MObject(attr_);
+}
+
+MStatus MFnNumericAttribute::setDefault(double value)
+{
+    if (attr_)
+        attr_->defaultValue = value;
+
+    return setStatus(0, attr_ != 0);
+}
+
+MStatus MFnNumericAttribute::setMin(double)     { return setStatus(0, attr_ != 0); }
+MStatus MFnNumericAttribute::setMax(double)     { return setStatus(0, attr_ != 0); }
+MStatus MFnNumericAttribute::setSoftMin(double) { return setStatus(0, attr_ != 0); }
+MStatus MFnNumericAttribute::setSoftMax(double) { return setStatus(0, attr_ != 0); }
+
+
+/*---- MFnUnitAttribute ----*/
+
+MObject MFnUnitAttribute::create(const MString &fullName, const MString &briefName, Type unitType, double defaultValue, MStatus *status)
+{
+    attr_ = mayaStandIn::createAttribute(fullName.asChar(), briefName.asChar(), mayaStandIn::kUnitAttribute, unitType, defaultValue);
+
+    setStatus(status, true);
+    return MObject(attr_);
+}
+
+MStatus MFnUnitAttribute::setDefault(double value)
+{
+    if (attr_)
+        attr_->defaultValue = value;
+
+    return setStatus(0, attr_ != 0);
+}
+
+MStatus MFnUnitAttribute::setMin(double)        { return setStatus(0, attr_ != 0); }
+MStatus MFnUnitAttribute::setMax(double)        { return setStatus(0, attr_ != 0); }
+MStatus MFnUnitAttribute::setSoftMin(double)    { return setStatus(0, attr_ != 0); }
+MStatus MFnUnitAttribute::setSoftMax(double)    { return setStatus(0, attr_ != 0); }
+
+
+/*---- MFnCompoundAttribute ----*/
+
+MObject MFnCompoundAttribute::create(const MString &fullName, const MString &briefName, MStatus *status)
+{
+    attr_ = mayaStandIn::createAttribute(fullName.asChar(), briefName.asChar(), mayaStandIn::kCompoundAttribute, 0, 0.0);
+
+    setStatus(status, true);
+    return MObject(attr_);
+}
+
+MStatus MFnCompoundAttribute::addChild(const MObject &child)
+{
+    Attribute *childAttr = child.standInAttribute();
+
+    if (!attr_ || !childAttr || childAttr->parent)
+        return MS::kInvalidParameter;
+
+    attachChild(attr_, childAttr);
+    return MS::kSuccess;
+}
+
+unsigned MFnCompoundAttribute::numChildren(MStatus *status) const
+{
+    setStatus(status, attr_ != 0);
+    return attr_ ? (unsigned) attr_->children.size() : 0;
+}
+
+MObject MFnCompoundAttribute::child(unsigned index, MStatus *status) const
+{
+    if (!setStatus(status, attr_ && index < attr_->children.size()))
+        return MObject();
+
+    return MObject(attr_->children[index]);
+}
+
+
+/*---- MFnEnumAttribute ----*/
+
+MObject MFnEnumAttribute::create(const MString &fullName, const MString &briefName, short defaultValue, MStatus *status)
+{
+    attr_ = mayaStandIn::createAttribute(fullName.asChar(), briefName.asChar(), mayaStandIn::kEnumAttribute, 0, defaultValue);
+
+    setStatus(status, true);
+    return MObject(attr_);
+}
+
+MStatus MFnEnumAttribute::addField(const MString &fieldName, short value)
+{
+    if (!attr_)
+        return MS::kFailure;
+
+    attr_->fields.push_back(std::make_pair(std::string(fieldName.asChar()), value));
+    return MS::kSuccess;
+}
+
+MString MFnEnumAttribute::fieldName(short value, MStatus *status) const
+{
+    if (attr_)
+    {
+        for (size_t i = 0; i < attr_->fields.size(); i++)
+        {
+            if (attr_->fields[i].second == value)
+            {
+                setStatus(status, true);
+                return MString(attr_->fields[i].first.c_str());
+            }
+        }
+    }
+
+    setStatus(status, false);
+    return MString();
+}
+
+short MFnEnumAttribute::fieldIndex(const MString &fieldName, MStatus *status) const
+{
+    if (attr_)
+    {
+        for (size_t i = 0; i < attr_->fields.size(); i++)
+        {
+            if (attr_->fields[i].first == fieldName.asChar())
+            {
+                setStatus(status, true);
+                return attr_->fields[i].second;
+            }
+        }
+    }
+
+    setStatus(status, false);
+    return 0;
+}
+
+MStatus MFnEnumAttribute::setDefault(short value)
+{
+    if (attr_)
+        attr_->defaultValue = value;
+
+    return setStatus(0, attr_ != 0);
+}
+
+
+/*---- MFnMatrixAttribute ----*/
+
+MObject MFnMatrixAttribute::create(const MString &fullName, const MString &briefName, Type matrixType, MStatus *status)
+{
+    attr_ = mayaStandIn::createAttribute(fullName.asChar(), briefName.asChar(), mayaStandIn::kMatrixAttribute, matrixType, 0.0);
+
+    setStatus(status, true);
+    return MObject(attr_);
+}
+
+
+/*---- MFnTypedAttribute ----*/
+
+MObject MFnTypedAttribute::create(const MString &fullName, const MString &briefName, const MTypeId &id, const MObject & /* defaultData */, MStatus *status)
+{
+    attr_ = mayaStandIn::createAttribute(fullName.asChar(), briefName.asChar(), mayaStandIn::kTypedAttribute, (int) id.id(), 0.0);
+
+    setStatus(status, true);
+    return MObject(attr_);
+}
@@ -0,0 +1,513 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "standInData.h"
+
+#include <maya/MArrayDataBuilder.h>
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MDataHandle.h>
+#include <maya/MFnPluginData.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+using mayaStandIn::Attribute;
+using mayaStandIn::DataValue;
+
+namespace
+{
+    MStatus setStatus(MStatus *status, bool ok)
+    {
+        MStatus result = ok ? MS::kSuccess : MS::kFailure;
+
+        if (status)
+            *status = result;
+
+        return result;
+    }
+
+    // What handles that failed refer to; written to and never read.
+    DataValue& nullValue()
+    {
+        static DataValue value;
+        return value;
+    }
+
+    typedef void *(*DataCreator)();
+
+    std::unordered_map<unsigned, DataCreator>& dataCreators()
+    {
+        static std::unordered_map<unsigned, DataCreator> creators;
+        return creators;
+    }
+}
+
+namespace mayaStandIn
+{
+    void DataValue::reset(const Attribute *attribute, bool element)
+    {
+        attr = attribute;
+        isArray = attribute->array && !element;
+
+        number[0] = attribute->defaultValue;
+        number[1] = 0.0;
+        number[2] = 0.0;
+        number[3] = 0.0;
+
+        matrix.reset();
+        pluginData.reset();
+        children.clear();
+        indices.clear();
+        elements.clear();
+
+        if (isArray)
+            return;
+
+        if (attribute->isNumericCompound())
+        {
+            for (size_t i = 0; i < attribute->children.size() && i < 4; i++)
+                number[i] = attribute->children[i]->defaultValue;
+        } else if (attribute->kind == kCompoundAttribute) {
+            children.resize(attribute->children.size());
+
+            for (size_t i = 0; i < children.size(); i++)
+                children[i].reset(attribute->children[i], false);
+        }
+    }
+
+    MStatus registerData(const MTypeId &id, void *(*creator)())
+    {
+        return setStatus(0, dataCreators().insert(std::make_pair(id.id(), creator)).second);
+    }
+
+    DataValue& DataValue::element(unsigned logicalIndex)
+    {
+        std::vector<unsigned>::iterator it = std::lower_bound(indices.begin(), indices.end(), logicalIndex);
+        size_t position = (size_t) (it - indices.begin());
+
+        if (it == indices.end() || *it != logicalIndex)
+        {
+            indices.insert(it, logicalIndex);
+            elements.insert(elements.begin() + (std::ptrdiff_t) position, DataValue());
+            elements[position].reset(attr, true);
+        }
+
+        return elements[position];
+    }
+}
+
+
+/*---- MDataHandle ----*/
+
+MDataHandle::MDataHandle() :
+    value_(&nullValue()),
+    number_(nullValue().number)
+{
+}
+
+MDataHandle::MDataHandle(DataValue *value, double *number) :
+    value_(value),
+    number_(number)
+{
+}
+
+bool MDataHandle::isNull() const            { return value_ == &nullValue(); }
+
+double MDataHandle::asDouble() const        { return *number_; }
+float MDataHandle::asFloat() const          { return (float) *number_; }
+short MDataHandle::asShort() const          { return (short) *number_; }
+int MDataHandle::asInt() const              { return (int) *number_; }
+bool MDataHandle::asBool() const            { return *number_ != 0.0; }
+MAngle MDataHandle::asAngle() const         { return MAngle(*number_, MAngle::kRadians); }
+double3& MDataHandle::asDouble3()           { return *reinterpret_cast<double3*>(value_->number); }
+double4& MDataHandle::asDouble4()           { return value_->number; }
+
+const MMatrix& MDataHandle::asMatrix() const
+{
+    return value_->matrix ? *value_->matrix : MMatrix::identity;
+}
+
+MPxData* MDataHandle::asPluginData() const
+{
+    return value_->pluginData.get();
+}
+
+MDataHandle MDataHandle::child(const MObject &attribute)
+{
+    const Attribute *attr = attribute.standInAttribute();
+
+    if (!attr || attr->parent != value_->attr || value_->isArray)
+        return MDataHandle();
+
+    if (value_->attr->isNumericCompound())
+        return MDataHandle(value_, &value_->number[attr->childIndex]);
+
+    DataValue &childValue = value_->children[attr->childIndex];
+    return MDataHandle(&childValue, childValue.number);
+}
+
+void MDataHandle::setDouble(double value)           { *number_ = value; }
+void MDataHandle::setFloat(float value)             { *number_ = value; }
+void MDataHandle::setShort(short value)             { *number_ = value; }
+void MDataHandle::setInt(int value)                 { *number_ = value; }
+void MDataHandle::setBool(bool value)               { *number_ = value ? 1.0 : 0.0; }
+void MDataHandle::setMAngle(const MAngle &value)    { *number_ = value.asRadians(); }
+
+void MDataHandle::set3Double(double x, double y, double z)
+{
+    value_->number[0] = x;
+    value_->number[1] = y;
+    value_->number[2] = z;
+}
+
+void MDataHandle::set4Double(double x, double y, double z, double w)
+{
+    value_->number[0] = x;
+    value_->number[1] = y;
+    value_->number[2] = z;
+    value_->number[3] = w;
+}
+
+void MDataHandle::setMMatrix(const MMatrix &value)
+{
+    value_->matrix = std::make_shared<const MMatrix>(value);
+}
+
+MStatus MDataHandle::set(const MObject &data)
+{
+    if (!data.standInData() || isNull())
+        return MS::kInvalidParameter;
+
+    value_->pluginData = data.standInData();
+    return MS::kSuccess;
+}
+
+void MDataHandle::setClean()
+{
+}
+
+
+/*---- MFnPluginData ----*/
+
+MObject MFnPluginData::create(const MTypeId &id, MStatus *status)
+{
+    std::unordered_map<unsigned, DataCreator>::const_iterator it = dataCreators().find(id.id());
+
+    if (!setStatus(status, it != dataCreators().end()))
+        return MObject();
+
+    data_.reset(static_cast<MPxData*>(it->second()));
+    return MObject(data_);
+}
+
+MPxData* MFnPluginData::data(MStatus *status)
+{
+    setStatus(status, data_ != nullptr);
+    return data_.get();
+}
+
+
+/*---- MArgList ----*/
+
+unsigned MArgList::length(MStatus *status) const
+{
+    setStatus(status, true);
+    return (unsigned) args_.size();
+}
+
+int MArgList::asInt(unsigned index, MStatus *status) const
+{
+    return (int) asDouble(index, status);
+}
+
+double MArgList::asDouble(unsigned index, MStatus *status) const
+{
+    return setStatus(status, index < args_.size()) ? args_[index] : 0.0;
+}
+
+MStatus MArgList::addArg(double arg)
+{
+    args_.push_back(arg);
+    return MS::kSuccess;
+}
+
+
+/*---- MArrayDataBuilder ----*/
+
+MArrayDataBuilder::MArrayDataBuilder() :
+    array_(std::make_shared<DataValue>())
+{
+}
+
+MArrayDataBuilder::MArrayDataBuilder(MDataBlock * /* data */, const MObject &attribute, unsigned numElements, MStatus *status) :
+    array_(std::make_shared<DataValue>())
+{
+    const Attribute *attr = attribute.standInAttribute();
+
+    if (!setStatus(status, attr && attr->array))
+        attr = nullValue().attr;
+
+    if (attr)
+    {
+        array_->reset(attr, false);
+        array_->indices.reserve(numElements);
+        array_->elements.reserve(numElements);
+    }
+}
+
+MArrayDataBuilder::MArrayDataBuilder(const MObject &attribute, unsigned numElements, MStatus *status) :
+    MArrayDataBuilder(0, attribute, numElements, status)
+{
+}
+
+MDataHandle MArrayDataBuilder::addElement(unsigned index, MStatus *status)
+{
+    if (!setStatus(status, array_->attr != 0))
+        return MDataHandle();
+
+    DataValue &element = array_->element(index);
+    return MDataHandle(&element, element.number);
+}
+
+MStatus MArrayDataBuilder::removeElement(unsigned index)
+{
+    std::vector<unsigned> &indices = array_->indices;
+    std::vector<unsigned>::iterator it = std::lower_bound(indices.begin(), indices.end(), index);
+
+    if (it == indices.end() || *it != index)
+        return MS::kInvalidParameter;
+
+    array_->elements.erase(array_->elements.begin() + (it - indices.begin()));
+    indices.erase(it);
+
+    return MS::kSuccess;
+}
+
+unsigned MArrayDataBuilder::elementCount(MStatus *status) const
+{
+    setStatus(status, true);
+    return (unsigned) array_->elements.size();
+}
+
+MStatus MArrayDataBuilder::growArray(unsigned amount)
+{
+    array_->indices.reserve(array_->indices.size() + amount);
+    array_->elements.reserve(array_->elements.size() + amount);
+
+    return MS::kSuccess;
+}
+
+
+/*---- MArrayDataHandle ----*/
+
+MArrayDataHandle::MArrayDataHandle(const MDataHandle &handle, MStatus *status) :
+    value_(handle.value_),
+    current_(0)
+{
+    if (!setStatus(status, value_->isArray))
+        value_ = &nullValue();
+}
+
+unsigned MArrayDataHandle::elementCount(MStatus *status)
+{
+    setStatus(status, true);
+    return (unsigned) value_->elements.size();
+}
+
+unsigned MArrayDataHandle::elementIndex(MStatus *status)
+{
+    if (!setStatus(status, current_ < value_->indices.size()))
+        return 0;
+
+    return value_->indices[current_];
+}
+
+MStatus MArrayDataHandle::next()
+{
+    if (current_ >= value_->elements.size())
+        return MS::kFailure;
+
+    current_++;
+    return current_ < value_->elements.size() ? MS::kSuccess : MS::kFailure;
+}
+
+MStatus MArrayDataHandle::jumpToElement(unsigned logicalIndex)
+{
+    const std::vector<unsigned> &indices = value_->indices;
+    std::vector<unsigned>::const_iterator it = std::lower_bound(indices.begin(), indices.end(), logicalIndex);
+
+    if (it == indices.end() || *it != logicalIndex)
+        return MS::kInvalidParameter;
+
+    current_ = (unsigned) (it - indices.begin());
+    return MS::kSuccess;
+}
+
+MStatus MArrayDataHandle::jumpToArrayElement(unsigned physicalIndex)
+{
+    if (physicalIndex >= value_->elements.size())
+        return MS::kInvalidParameter;
+
+    current_ = physicalIndex;
+    return MS::kSuccess;
+}
+
+MDataHandle MArrayDataHandle::current(MStatus *status)
+{
+    if (!setStatus(status, current_ < value_->elements.size()))
+        return MDataHandle();
+
+    DataValue &element = value_->elements[current_];
+    return MDataHandle(&element, element.number);
+}
+
+MDataHandle MArrayDataHandle::inputValue(MStatus *status)   { return current(status); }
+MDataHandle MArrayDataHandle::outputValue(MStatus *status)  { return current(status); }
+
+MStatus MArrayDataHandle::set(MArrayDataBuilder &builder)
+{
+    if (value_ == &nullValue() || builder.array_->attr != value_->attr)
+        return MS::kInvalidParameter;
+
+    value_->indices.swap(builder.array_->indices);
+    value_->elements.swap(builder.array_->elements);
+    current_ = 0;
+
+    return MS::kSuccess;
+}
+
+MArrayDataBuilder MArrayDataHandle::builder(MStatus *status)
+{
+    MArrayDataBuilder result;
+
+    if (setStatus(status, value_ != &nullValue()))
+        *result.array_ = *value_;
+
+    return result;
+}
+
+MStatus MArrayDataHandle::setClean()        { return MS::kSuccess; }
+MStatus MArrayDataHandle::setAllClean()     { return MS::kSuccess; }
+
+
+/*---- MDataBlock ----*/
+
+// Top-level attributes' values; children live inside their parent's.
+struct MDataBlock::Values
+{
+    std::unordered_map<const Attribute*, DataValue> byAttribute;
+};
+
+MDataBlock::MDataBlock() :
+    values_(new Values())
+{
+}
+
+MDataBlock::~MDataBlock()
+{
+}
+
+/*
+    The value of attr, through its parents. A child of an array element
+    has no single value, as in Maya; use the array's handle instead.
+*/
+MDataHandle MDataBlock::value(Attribute *attr, MStatus *status)
+{
+    if (!attr)
+    {
+        setStatus(status, false);
+        return MDataHandle();
+    }
+
+    if (!attr->parent)
+    {
+        std::unordered_map<const Attribute*, DataValue>::iterator it = values_->byAttribute.find(attr);
+
+        if (it == values_->byAttribute.end())
+        {
+            it = values_->byAttribute.insert(std::make_pair(attr, DataValue())).first;
+            it->second.reset(attr, false);
+        }
+
+        setStatus(status, true);
+        return MDataHandle(&it->second, it->second.number);
+    }
+
+    MDataHandle parent = value(attr->parent, status);
+
+    if (parent.isNull() || parent.value_->isArray)
+    {
+        setStatus(status, false);
+        return MDataHandle();
+    }
+
+    return parent.child(MObject(attr));
+}
+
+MDataHandle MDataBlock::inputValue(const MObject &attribute, MStatus *status)
+{
+    return value(attribute.standInAttribute(), status);
+}
+
+MDataHandle MDataBlock::outputValue(const MObject &attribute, MStatus *status)
+{
+    return value(attribute.standInAttribute(), status);
+}
+
+MDataHandle MDataBlock::inputValue(const MPlug &plug, MStatus *status)
+{
+    return outputValue(plug, status);
+}
+
+MDataHandle MDataBlock::outputValue(const MPlug &plug, MStatus *status)
+{
+    Attribute *attr = plug.attr_;
+
+    if (plug.logicalIndex_ < 0 && plug.parentIndex_ < 0)
+        return value(attr, status);
+
+    // An element, or a child of one.
+    Attribute *arrayAttr = plug.logicalIndex_ >= 0 ? attr : (attr ? attr->parent : 0);
+    int index = plug.logicalIndex_ >= 0 ? plug.logicalIndex_ : plug.parentIndex_;
+
+    MDataHandle arrayHandle = value(arrayAttr, status);
+
+    if (arrayHandle.isNull() || !arrayHandle.value_->isArray)
+    {
+        setStatus(status, false);
+        return MDataHandle();
+    }
+
+    DataValue &element = arrayHandle.value_->element((unsigned) index);
+    MDataHandle elementHandle(&element, element.number);
+
+    return attr == arrayAttr ? elementHandle : elementHandle.child(MObject(attr));
+}
+
+MArrayDataHandle MDataBlock::inputArrayValue(const MObject &attribute, MStatus *status)
+{
+    return MArrayDataHandle(value(attribute.standInAttribute(), status), status);
+}
+
+MArrayDataHandle MDataBlock::outputArrayValue(const MObject &attribute, MStatus *status)
+{
+    return MArrayDataHandle(value(attribute.standInAttribute(), status), status);
+}
+
+MStatus MDataBlock::setClean(const MObject &attribute)  { return setStatus(0, !attribute.isNull()); }
+MStatus MDataBlock::setClean(const MPlug &plug)         { return setStatus(0, !plug.isNull()); }
+
+bool MDataBlock::isClean(const MObject &attribute, MStatus *status)
+{
+    setStatus(status, !attribute.isNull());
+    return true;
+}
+
+const MDGContext& MDataBlock::context(MStatus *status)
+{
+    setStatus(status, true);
+    return context_;
+}
@@ -0,0 +1,106 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    mayaStandIn
+    A headless stand-in for the part of the Maya API that the benchmarked
+    nodes, nodeUtils and quatArrayData use, so their sources build unmodified into
+    quatExtras_nodeBench and compute can be driven without Maya. The
+    headers in maya/ declare the API; this file holds what is behind it.
+
+    Attribute is what an attribute MObject refers to. Attributes are made
+    by the MFn*Attribute create calls and live until the program exits,
+    like a node type's attributes do in Maya.
+
+    DataValue is one attribute's value in an MDataBlock: a number (three
+    for a double3, four for a double4), a matrix, plug-in data, a child
+    value per child of a compound, or the elements of an array in logical
+    index order.
+
+    The stand-in does no dirty propagation and no connections: the caller
+    sets the inputs, calls setDependentsDirty for each it changed, and
+    calls compute with the plug it wants.
+-----------------------------------------------------------------------------*/
+
+#ifndef MAYA_STAND_IN_DATA_H
+#define MAYA_STAND_IN_DATA_H
+
+#include <maya/MMatrix.h>
+#include <maya/MPxData.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mayaStandIn
+{
+    enum AttributeKind
+    {
+        kNumericAttribute,
+        kUnitAttribute,
+        kEnumAttribute,
+        kCompoundAttribute,
+        kMatrixAttribute,
+        kTypedAttribute
+    };
+
+    struct Attribute
+    {
+        std::string             longName;
+        std::string             shortName;
+        AttributeKind           kind;
+
+        // MFnNumericData::Type, MFnUnitAttribute::Type or MTypeId::id.
+        int                     dataType;
+        double                  defaultValue;
+
+        bool                    array;
+
+        Attribute               *parent;
+        unsigned                childIndex;
+        std::vector<Attribute*> children;
+
+        std::vector<Attribute*> affects;
+        std::vector<std::pair<std::string, short> > fields;
+
+        // A double2, double3 or double4, whose children share the parent's value.
+        bool                    isNumericCompound() const { return kind == kNumericAttribute && !children.empty(); }
+    };
+
+    // A new attribute, kept until exit.
+    Attribute* createAttribute(const char *longName, const char *shortName, AttributeKind kind, int dataType, double defaultValue);
+
+    struct DataValue
+    {
+        const Attribute         *attr;
+        bool                    isArray;
+
+        double                  number[4];
+
+        // Shared until set, since few values are matrices.
+        std::shared_ptr<const MMatrix> matrix;
+
+        // Shared with the MObject it was set from, as Maya does.
+        std::shared_ptr<MPxData> pluginData;
+
+        std::vector<DataValue>  children;
+
+        std::vector<unsigned>   indices;
+        std::vector<DataValue>  elements;
+
+        /*
+            Default value of attr: of one of its elements if element is
+            true, otherwise of the attribute as declared, which for an array
+            is empty.
+        */
+        void                    reset(const Attribute *attribute, bool element);
+
+        // Element at logicalIndex, added with its default if missing.
+        DataValue&              element(unsigned logicalIndex);
+    };
+}
+
+#endif
@@ -0,0 +1,347 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    nodeComputeBench
+    quatSlerp, axisAngleToQuat and quatToAxisAngle compute, end to end,
+    built from the unmodified node sources against the Maya API stand-in
+    in bench/mayaStandIn. Each operation sets the node's inputs through
+    the data block, dirties what changed, and calls compute for the output
+    plug, so handle and attribute access are timed along with the math.
+    Compare with BM_SlerpScalar, BM_SlerpCachedSetup,
+    BM_AxisAngleToQuatScalar and BM_QuatToAxisAngleScalar in
+    quatExtras_bench for the cost of the math alone.
+
+    BM_QuatSlerpNode runs with endpoints:0, where only the tween changes
+    and the node reuses its cached endpoint setup, and endpoints:1, where
+    both quaternions and the spin change on every compute.
+
+    Before timing, each benchmark checks the first outputs against the
+    quatMath functions and fails if they differ by more than kTolerance,
+    so math regressions show up here as well.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "axisAngleToQuat.h"
+#include "quatSlerp.h"
+#include "quatToAxisAngle.h"
+
+#include "core/quatBatch.h"
+#include "core/quatMath.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MDataHandle.h>
+#include <maya/MObject.h>
+#include <maya/MPlug.h>
+#include <maya/MPlugArray.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace quatExtras;
+
+// Registered by pluginMain.cpp in the plugin.
+MTypeId AxisAngleToQuatNode::NODE_ID(0x00126b3d);
+MTypeId QuatToAxisAngleNode::NODE_ID(0x00126b3e);
+MTypeId QuatSlerpNode::NODE_ID(0x00126b3f);
+
+MString AxisAngleToQuatNode::NODE_NAME("axisAngleToQuat");
+MString QuatToAxisAngleNode::NODE_NAME("quatToAxisAngle");
+MString QuatSlerpNode::NODE_NAME("quatSlerp");
+
+namespace
+{
+    const double kTolerance = 1e-12;
+
+    // Outputs checked against quatMath before timing.
+    const size_t kVerifyCount = 1000;
+
+    // Attributes are static, so each node type is initialized once.
+    template <class Node>
+    bool initializeNode()
+    {
+        static MStatus status = Node::initialize();
+        return status == MS::kSuccess;
+    }
+
+    MPlug plugFor(const MObject &attribute)
+    {
+        return MPlug(MObject::kNullObj, attribute);
+    }
+
+    template <unsigned N>
+    void setCompound(MDataBlock &data, const CompoundAttribute<N> &attr, const double value[N])
+    {
+        MDataHandle handle = data.inputValue(attr);
+        attr.set(handle, value);
+    }
+
+    template <unsigned N>
+    void getCompound(MDataBlock &data, const CompoundAttribute<N> &attr, double value[N])
+    {
+        MDataHandle handle = data.outputValue(attr);
+        attr.get(handle, value);
+    }
+
+    double maxDifference(const double *a, const double *b, unsigned count)
+    {
+        double result = 0.0;
+
+        for (unsigned k = 0; k < count; k++)
+            result = std::fmax(result, std::fabs(a[k] - b[k]));
+
+        return result;
+    }
+
+    void nodeArgs(benchmark::internal::Benchmark *b)
+    {
+        b->ArgName("n");
+        b->RangeMultiplier(10)->Range(1000, 1000000);
+    }
+
+    struct SlerpNodeInputs
+    {
+        QuatArray p;
+        QuatArray q;
+        std::vector<double> tween;
+        std::vector<short> spin;
+
+        explicit SlerpNodeInputs(size_t count)
+        {
+            bench::randomQuats(p, count);
+            bench::randomQuats(q, count);
+            bench::randomDoubles(tween, count, 0.0, 1.0);
+            bench::randomShorts(spin, count, -1, 1);
+        }
+
+        void get(size_t i, double a[4], double b[4]) const
+        {
+            ConstQuatArrayView pv = p.view();
+            ConstQuatArrayView qv = q.view();
+
+            a[0] = pv.x[i]; a[1] = pv.y[i]; a[2] = pv.z[i]; a[3] = pv.w[i];
+            b[0] = qv.x[i]; b[1] = qv.y[i]; b[2] = qv.z[i]; b[3] = qv.w[i];
+        }
+    };
+
+    /*
+        One quatSlerp evaluation: the inputs that change, the dirty
+        notifications Maya would send for them, then compute.
+    */
+    MStatus computeSlerp(QuatSlerpNode &node, MDataBlock &data, const SlerpNodeInputs &in, size_t i, bool changeEndpoints)
+    {
+        static MPlugArray affected;
+
+        if (changeEndpoints)
+        {
+            double p[4], q[4];
+            in.get(i, p, q);
+
+            setCompound(data, QuatSlerpNode::input1Quat_attr, p);
+            setCompound(data, QuatSlerpNode::input2Quat_attr, q);
+            data.inputValue(QuatSlerpNode::spin_attr).setShort(in.spin[i]);
+
+            node.setDependentsDirty(plugFor(QuatSlerpNode::input1Quat_attr), affected);
+            node.setDependentsDirty(plugFor(QuatSlerpNode::input2Quat_attr), affected);
+            node.setDependentsDirty(plugFor(QuatSlerpNode::spin_attr), affected);
+        }
+
+        data.inputValue(QuatSlerpNode::interpolationValue_attr).setDouble(in.tween[i]);
+        node.setDependentsDirty(plugFor(QuatSlerpNode::interpolationValue_attr), affected);
+
+        return node.compute(plugFor(QuatSlerpNode::outputQuat_attr), data);
+    }
+}
+
+static void BM_QuatSlerpNode(benchmark::State &state)
+{
+    if (!initializeNode<QuatSlerpNode>())
+    {
+        state.SkipWithError("quatSlerp initialize failed");
+        return;
+    }
+
+    size_t count = (size_t) state.range(0);
+    bool changeEndpoints = state.range(1) != 0;
+
+    SlerpNodeInputs in(count);
+
+    QuatSlerpNode node;
+    MDataBlock data;
+
+    // Endpoints of input 0 are the cached ones when only the tween changes.
+    size_t verifyCount = std::min(count, kVerifyCount);
+
+    for (size_t i = 0; i < verifyCount; i++)
+    {
+        size_t endpoints = changeEndpoints ? i : 0;
+
+        if (computeSlerp(node, data, in, i, changeEndpoints || i == 0) != MS::kSuccess)
+        {
+            state.SkipWithError("quatSlerp compute failed");
+            return;
+        }
+
+        double p[4], q[4], expected[4], actual[4];
+        in.get(endpoints, p, q);
+
+        slerp(p, q, in.tween[i], changeEndpoints ? in.spin[i] : in.spin[0], kSlerpExact, expected);
+        getCompound(data, QuatSlerpNode::outputQuat_attr, actual);
+
+        if (maxDifference(expected, actual, 4) > kTolerance)
+        {
+            state.SkipWithError("quatSlerp output differs from quatMath slerp");
+            return;
+        }
+    }
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+            computeSlerp(node, data, in, i, changeEndpoints);
+
+        benchmark::DoNotOptimize(data.outputValue(QuatSlerpNode::outputQuat_attr).child(QuatSlerpNode::outputQuat_attr.child(3)).asDouble());
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_QuatSlerpNode)->Apply([](benchmark::internal::Benchmark *b) {
+    b->ArgNames({ "n", "endpoints" });
+    b->ArgsProduct({ benchmark::CreateRange(1000, 1000000, 10), { 0, 1 } });
+});
+
+static void BM_AxisAngleToQuatNode(benchmark::State &state)
+{
+    if (!initializeNode<AxisAngleToQuatNode>())
+    {
+        state.SkipWithError("axisAngleToQuat initialize failed");
+        return;
+    }
+
+    size_t count = (size_t) state.range(0);
+
+    std::vector<double> axis, angle;
+    bench::randomDoubles(axis, count * 3, -1.0, 1.0);
+    bench::randomDoubles(angle, count, -kPi, kPi);
+
+    AxisAngleToQuatNode node;
+    MDataBlock data;
+    MPlugArray affected;
+
+    MPlug outputPlug = plugFor(AxisAngleToQuatNode::outputQuat_attr);
+
+    auto compute = [&](size_t i) {
+        setCompound(data, AxisAngleToQuatNode::inputAxis_attr, &axis[i * 3]);
+        data.inputValue(AxisAngleToQuatNode::inputAngle_attr).setMAngle(MAngle(angle[i], MAngle::kRadians));
+
+        node.setDependentsDirty(plugFor(AxisAngleToQuatNode::inputAxis_attr), affected);
+        node.setDependentsDirty(plugFor(AxisAngleToQuatNode::inputAngle_attr), affected);
+
+        return node.compute(outputPlug, data);
+    };
+
+    for (size_t i = 0; i < std::min(count, kVerifyCount); i++)
+    {
+        if (compute(i) != MS::kSuccess)
+        {
+            state.SkipWithError("axisAngleToQuat compute failed");
+            return;
+        }
+
+        double expected[4], actual[4];
+        axisAngleToQuat(&axis[i * 3], angle[i], expected);
+        getCompound(data, AxisAngleToQuatNode::outputQuat_attr, actual);
+
+        if (maxDifference(expected, actual, 4) > kTolerance)
+        {
+            state.SkipWithError("axisAngleToQuat output differs from quatMath axisAngleToQuat");
+            return;
+        }
+    }
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+            compute(i);
+
+        benchmark::DoNotOptimize(data.outputValue(AxisAngleToQuatNode::outputQuat_attr).child(AxisAngleToQuatNode::outputQuat_attr.child(3)).asDouble());
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_AxisAngleToQuatNode)->Apply(nodeArgs);
+
+static void BM_QuatToAxisAngleNode(benchmark::State &state)
+{
+    if (!initializeNode<QuatToAxisAngleNode>())
+    {
+        state.SkipWithError("quatToAxisAngle initialize failed");
+        return;
+    }
+
+    size_t count = (size_t) state.range(0);
+
+    QuatArray quats;
+    bench::randomQuats(quats, count);
+
+    ConstQuatArrayView qv = quats.view();
+
+    QuatToAxisAngleNode node;
+    MDataBlock data;
+    MPlugArray affected;
+
+    MPlug axisPlug = plugFor(QuatToAxisAngleNode::outputAxis_attr);
+    MPlug anglePlug = plugFor(QuatToAxisAngleNode::outputAngle_attr);
+
+    // Maya computes each connected output plug on its own.
+    auto compute = [&](size_t i) {
+        double q[4] = { qv.x[i], qv.y[i], qv.z[i], qv.w[i] };
+
+        setCompound(data, QuatToAxisAngleNode::inputQuat_attr, q);
+        node.setDependentsDirty(plugFor(QuatToAxisAngleNode::inputQuat_attr), affected);
+
+        MStatus status = node.compute(axisPlug, data);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        return node.compute(anglePlug, data);
+    };
+
+    for (size_t i = 0; i < std::min(count, kVerifyCount); i++)
+    {
+        if (compute(i) != MS::kSuccess)
+        {
+            state.SkipWithError("quatToAxisAngle compute failed");
+            return;
+        }
+
+        double q[4] = { qv.x[i], qv.y[i], qv.z[i], qv.w[i] };
+        double expected[4], actual[4];
+
+        quatToAxisAngle(q, expected, expected[3]);
+        getCompound(data, QuatToAxisAngleNode::outputAxis_attr, actual);
+        actual[3] = data.outputValue(QuatToAxisAngleNode::outputAngle_attr).asAngle().asRadians();
+
+        if (maxDifference(expected, actual, 4) > kTolerance)
+        {
+            state.SkipWithError("quatToAxisAngle output differs from quatMath quatToAxisAngle");
+            return;
+        }
+    }
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+            compute(i);
+
+        benchmark::DoNotOptimize(data.outputValue(QuatToAxisAngleNode::outputAngle_attr).asDouble());
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_QuatToAxisAngleNode)->Apply(nodeArgs);
@@ -0,0 +1,270 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatArrayDataBench
+    Two quatSlerpArray nodes in a chain, the first's output feeding the
+    second's input1, passing the quaternions as compound arrays (data:0)
+    or as quatArrayData (data:1). Each iteration computes the first node,
+    carries its output over the way a connection would, and computes the
+    second, so the difference between the two is what the transfer and
+    the per-element handle access cost.
+
+    A compound connection is carried over by reading the output array and
+    building the input array from it, one element at a time; a data
+    connection copies the quatArrayData, which shares its buffer.
+
+    Before timing, the data chain's output is checked against the compound
+    chain's and the benchmark fails if they differ by more than kTolerance.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "nodeUtils.h"
+#include "quatArrayData.h"
+#include "quatSlerpArray.h"
+
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MDataHandle.h>
+#include <maya/MFnPluginData.h>
+#include <maya/MObject.h>
+#include <maya/MPlug.h>
+#include <maya/MPlugArray.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace quatExtras;
+
+// Registered by pluginMain.cpp in the plugin.
+MTypeId QuatSlerpArrayNode::NODE_ID(0x00126b40);
+MString QuatSlerpArrayNode::NODE_NAME("quatSlerpArray");
+
+MTypeId QuatArrayData::TYPE_ID(0x00126b51);
+MString QuatArrayData::TYPE_NAME("quatArrayData");
+
+namespace
+{
+    const double kTolerance = 1e-12;
+
+    bool initialize()
+    {
+        static MStatus status = mayaStandIn::registerData(QuatArrayData::TYPE_ID, QuatArrayData::creator) ? QuatSlerpArrayNode::initialize() : MStatus(MS::kFailure);
+        return status == MS::kSuccess;
+    }
+
+    MPlug plugFor(const MObject &attribute)
+    {
+        return MPlug(MObject::kNullObj, attribute);
+    }
+
+    // What a connection from source to destination leaves in destination.
+    MStatus transferData(MDataBlock &source, const MObject &sourceAttr, MDataBlock &destination, const MObject &destinationAttr)
+    {
+        MStatus status;
+
+        MPxData *value = source.outputValue(sourceAttr).asPluginData();
+
+        if (value == nullptr)
+            return MS::kFailure;
+
+        MFnPluginData fnData;
+        MObject dataObject = fnData.create(QuatArrayData::TYPE_ID, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        fnData.data()->copy(*value);
+
+        return destination.inputValue(destinationAttr).set(dataObject);
+    }
+
+    MStatus transferCompound(MDataBlock &source, const QuatAttribute &sourceAttr, MDataBlock &destination, const QuatAttribute &destinationAttr, QuatArray &scratch)
+    {
+        MArrayDataHandle handle = source.outputArrayValue(sourceAttr);
+
+        unsigned length = logicalLength(handle);
+
+        scratch.resize(length);
+        sourceAttr.inputArrayValue(handle, scratch.view(), length);
+
+        return destinationAttr.outputArrayValue(destination, scratch.view(), length);
+    }
+
+    struct SlerpChain
+    {
+        QuatSlerpArrayNode first;
+        QuatSlerpArrayNode second;
+
+        MDataBlock firstData;
+        MDataBlock secondData;
+
+        bool useData;
+        QuatArray scratch;
+        MPlugArray affected;
+
+        SlerpChain(const QuatArray &p, const QuatArray &q, const QuatArray &r, std::vector<double> &tween, bool data) :
+            useData(data)
+        {
+            unsigned count = (unsigned) tween.size();
+
+            setQuats(firstData, QuatSlerpArrayNode::input1Quat_attr, QuatSlerpArrayNode::input1QuatData_attr, p);
+            setQuats(firstData, QuatSlerpArrayNode::input2Quat_attr, QuatSlerpArrayNode::input2QuatData_attr, q);
+            setQuats(secondData, QuatSlerpArrayNode::input2Quat_attr, QuatSlerpArrayNode::input2QuatData_attr, r);
+
+            outputDoubleArrayValue(firstData, tween.data(), count, QuatSlerpArrayNode::interpolationValue_attr);
+            outputDoubleArrayValue(secondData, tween.data(), count, QuatSlerpArrayNode::interpolationValue_attr);
+        }
+
+        void setQuats(MDataBlock &data, const QuatAttribute &compound, const MObject &dataAttr, const QuatArray &values)
+        {
+            if (!useData)
+            {
+                compound.outputArrayValue(data, values.view(), (unsigned) values.size());
+                return;
+            }
+
+            std::shared_ptr<QuatBuffer> buffer = std::make_shared<QuatBuffer>(values.size());
+            ConstQuatArrayView from = values.view();
+            QuatArrayView to = buffer->view();
+
+            std::copy(from.x, from.x + values.size(), to.x);
+            std::copy(from.y, from.y + values.size(), to.y);
+            std::copy(from.z, from.z + values.size(), to.z);
+            std::copy(from.w, from.w + values.size(), to.w);
+
+            outputQuatArrayData(data, dataAttr, buffer);
+        }
+
+        // One evaluation of the chain after the tweens change.
+        MStatus compute()
+        {
+            MStatus status;
+
+            first.setDependentsDirty(plugFor(QuatSlerpArrayNode::interpolationValue_attr), affected);
+            second.setDependentsDirty(plugFor(QuatSlerpArrayNode::interpolationValue_attr), affected);
+
+            if (useData)
+            {
+                status = first.compute(plugFor(QuatSlerpArrayNode::outputQuatData_attr), firstData);
+                CHECK_MSTATUS_AND_RETURN_IT(status);
+
+                status = transferData(firstData, QuatSlerpArrayNode::outputQuatData_attr, secondData, QuatSlerpArrayNode::input1QuatData_attr);
+                CHECK_MSTATUS_AND_RETURN_IT(status);
+
+                second.setDependentsDirty(plugFor(QuatSlerpArrayNode::input1QuatData_attr), affected);
+                return second.compute(plugFor(QuatSlerpArrayNode::outputQuatData_attr), secondData);
+            }
+
+            status = first.compute(plugFor(QuatSlerpArrayNode::outputQuat_attr), firstData);
+            CHECK_MSTATUS_AND_RETURN_IT(status);
+
+            status = transferCompound(firstData, QuatSlerpArrayNode::outputQuat_attr, secondData, QuatSlerpArrayNode::input1Quat_attr, scratch);
+            CHECK_MSTATUS_AND_RETURN_IT(status);
+
+            second.setDependentsDirty(plugFor(QuatSlerpArrayNode::input1Quat_attr), affected);
+            return second.compute(plugFor(QuatSlerpArrayNode::outputQuat_attr), secondData);
+        }
+
+        // The second node's output, as computed by the last compute.
+        void result(QuatArray &values)
+        {
+            if (useData)
+            {
+                QuatArrayData *value = static_cast<QuatArrayData*>(secondData.outputValue(QuatSlerpArrayNode::outputQuatData_attr).asPluginData());
+                ConstQuatArrayView from = value->buffer()->view();
+
+                values.resize(value->buffer()->size());
+                QuatArrayView to = values.view();
+
+                std::copy(from.x, from.x + values.size(), to.x);
+                std::copy(from.y, from.y + values.size(), to.y);
+                std::copy(from.z, from.z + values.size(), to.z);
+                std::copy(from.w, from.w + values.size(), to.w);
+                return;
+            }
+
+            MArrayDataHandle handle = secondData.outputArrayValue(QuatSlerpArrayNode::outputQuat_attr);
+            unsigned length = logicalLength(handle);
+
+            values.resize(length);
+            QuatSlerpArrayNode::outputQuat_attr.inputArrayValue(handle, values.view(), length);
+        }
+    };
+
+    double maxDifference(const QuatArray &a, const QuatArray &b)
+    {
+        if (a.size() != b.size())
+            return INFINITY;
+
+        ConstQuatArrayView av = a.view();
+        ConstQuatArrayView bv = b.view();
+
+        double result = 0.0;
+
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            result = std::fmax(result, std::fabs(av.x[i] - bv.x[i]));
+            result = std::fmax(result, std::fabs(av.y[i] - bv.y[i]));
+            result = std::fmax(result, std::fabs(av.z[i] - bv.z[i]));
+            result = std::fmax(result, std::fabs(av.w[i] - bv.w[i]));
+        }
+
+        return result;
+    }
+}
+
+static void BM_QuatSlerpArrayChain(benchmark::State &state)
+{
+    if (!initialize())
+    {
+        state.SkipWithError("quatSlerpArray initialize failed");
+        return;
+    }
+
+    size_t count = (size_t) state.range(0);
+    bool useData = state.range(1) != 0;
+
+    QuatArray p, q, r;
+    bench::randomQuats(p, count);
+    bench::randomQuats(q, count);
+    bench::randomQuats(r, count);
+
+    std::vector<double> tween;
+    bench::randomDoubles(tween, count, 0.0, 1.0);
+
+    SlerpChain chain(p, q, r, tween, useData);
+    SlerpChain reference(p, q, r, tween, false);
+
+    if (chain.compute() != MS::kSuccess || reference.compute() != MS::kSuccess)
+    {
+        state.SkipWithError("quatSlerpArray compute failed");
+        return;
+    }
+
+    QuatArray actual, expected;
+    chain.result(actual);
+    reference.result(expected);
+
+    if (maxDifference(actual, expected) > kTolerance)
+    {
+        state.SkipWithError("quatArrayData chain differs from the compound chain");
+        return;
+    }
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(chain.compute());
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_QuatSlerpArrayChain)->Apply([](benchmark::internal::Benchmark *b) {
+    b->ArgNames({ "n", "data" });
+    b->ArgsProduct({ benchmark::CreateRange(10, 100000, 10), { 0, 1 } });
+});
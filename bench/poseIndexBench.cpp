@@ -0,0 +1,126 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    poseIndexBench
+    Building the pose tree (once per pose change on quatPoseReader) and
+    querying the k nearest poses, against a scan of every pose like the
+    per-pose quatToAxisAngle setups it replaces. Queries are random
+    rotations; "visited" is the mean number of poses measured per query.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/poseIndex.h"
+#include "core/quatBatch.h"
+#include "core/quatMath.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+using namespace quatExtras;
+
+namespace
+{
+    const size_t kQueryCount = 256;
+
+    void poseArgs(benchmark::internal::Benchmark *b)
+    {
+        b->ArgNames({ "n", "k" });
+        b->ArgsProduct({ { 100, 1000, 10000, 100000 }, { 1, 4, 16 } });
+    }
+}
+
+static void BM_PoseIndexBuild(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+
+    QuatArray poses;
+    bench::randomQuats(poses, count);
+
+    PoseIndex index;
+
+    for (auto _ : state)
+    {
+        index.build(poses.view(), nullptr, count);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_PoseIndexBuild)->ArgName("n")->RangeMultiplier(10)->Range(100, 100000);
+
+static void BM_PoseIndexNearest(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    size_t k = (size_t) state.range(1);
+
+    QuatArray poses, queries;
+    bench::randomQuats(poses, count);
+    bench::randomQuats(queries, kQueryCount);
+
+    PoseIndex index;
+    index.build(poses.view(), nullptr, count);
+
+    std::vector<unsigned> id(k);
+    std::vector<double> angle(k);
+
+    ConstQuatArrayView view = queries.view();
+    size_t query = 0;
+    size_t visited = 0;
+
+    for (auto _ : state)
+    {
+        double q[4] = { view.x[query], view.y[query], view.z[query], view.w[query] };
+
+        index.nearest(q, k, id.data(), angle.data());
+        visited += index.lastDistanceCount();
+
+        benchmark::DoNotOptimize(angle.data());
+        query = (query + 1) % kQueryCount;
+    }
+
+    state.counters["visited"] = benchmark::Counter((double) visited, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_PoseIndexNearest)->Apply(poseArgs);
+
+static void BM_PoseScan(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    size_t k = (size_t) state.range(1);
+
+    QuatArray poses, queries;
+    bench::randomQuats(poses, count);
+    bench::randomQuats(queries, kQueryCount);
+
+    ConstQuatArrayView p = poses.view();
+    ConstQuatArrayView view = queries.view();
+
+    std::vector<std::pair<double, unsigned> > angle(count);
+    size_t query = 0;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            double d = std::fabs(
+                p.x[i] * view.x[query] + p.y[i] * view.y[query] +
+                p.z[i] * view.z[query] + p.w[i] * view.w[query]
+            );
+
+            angle[i] = std::make_pair(2.0 * std::acos(std::min(d, 1.0)), (unsigned) i);
+        }
+
+        std::partial_sort(angle.begin(), angle.begin() + k, angle.end());
+
+        benchmark::DoNotOptimize(angle.data());
+        query = (query + 1) % kQueryCount;
+    }
+}
+BENCHMARK(BM_PoseScan)->Apply(poseArgs);
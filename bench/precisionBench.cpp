@@ -0,0 +1,127 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    precisionBench
+    The kernels with a float version (quatBatch.h), run in double and in
+    float on the same inputs at each instruction set. The double runs match
+    BM_SlerpBatch, BM_AxisAngleToQuatBatch and BM_QuatToAxisAngleBatch;
+    compare each <float> line with the <double> line of the same n and simd
+    for the throughput gain. Conversion at the attribute boundary is not
+    included: the nodes convert while reading the data block, which they
+    do element by element in either precision.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/quatBatch.h"
+#include "core/quatMath.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+namespace
+{
+    template <class T>
+    struct PrecisionInputs
+    {
+        QuatArrayT<T> p;
+        QuatArrayT<T> q;
+        QuatArrayT<T> out;
+        std::vector<T> tween;
+        std::vector<short> spin;
+        std::vector<T> x, y, z, angle;
+        std::vector<unsigned char> nonZero;
+
+        explicit PrecisionInputs(size_t count)
+        {
+            bench::randomQuats(p, count);
+            bench::randomQuats(q, count);
+            bench::randomDoubles(tween, count, 0.0, 1.0);
+            bench::randomShorts(spin, count, -1, 1);
+            bench::randomDoubles(x, count, -1.0, 1.0);
+            bench::randomDoubles(y, count, -1.0, 1.0);
+            bench::randomDoubles(z, count, -1.0, 1.0);
+            bench::randomDoubles(angle, count, -kPi, kPi);
+            out.resize(count);
+            nonZero.resize(count);
+        }
+
+        VectorArrayViewT<T> axis()
+        {
+            VectorArrayViewT<T> result = { x.data(), y.data(), z.data() };
+            return result;
+        }
+    };
+}
+
+template <class T>
+static void BM_SlerpPrecision(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    PrecisionInputs<T> in(count);
+
+    for (auto _ : state)
+    {
+        slerpBatch(in.p.view(), in.q.view(), in.tween.data(), in.spin.data(), in.out.view(), count);
+
+        benchmark::DoNotOptimize(in.out.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK_TEMPLATE(BM_SlerpPrecision, double)->Apply(bench::batchArgs);
+BENCHMARK_TEMPLATE(BM_SlerpPrecision, float)->Apply(bench::batchArgs);
+
+template <class T>
+static void BM_AxisAngleToQuatPrecision(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    PrecisionInputs<T> in(count);
+
+    for (auto _ : state)
+    {
+        axisAngleToQuatBatch(in.axis(), in.angle.data(), in.out.view(), count);
+
+        benchmark::DoNotOptimize(in.out.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK_TEMPLATE(BM_AxisAngleToQuatPrecision, double)->Apply(bench::batchArgs);
+BENCHMARK_TEMPLATE(BM_AxisAngleToQuatPrecision, float)->Apply(bench::batchArgs);
+
+template <class T>
+static void BM_QuatToAxisAnglePrecision(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    PrecisionInputs<T> in(count);
+
+    for (auto _ : state)
+    {
+        quatToAxisAngleBatch(in.p.view(), in.axis(), in.angle.data(), in.nonZero.data(), count);
+
+        benchmark::DoNotOptimize(in.angle.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK_TEMPLATE(BM_QuatToAxisAnglePrecision, double)->Apply(bench::batchArgs);
+BENCHMARK_TEMPLATE(BM_QuatToAxisAnglePrecision, float)->Apply(bench::batchArgs);
@@ -0,0 +1,104 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatAverageBench
+    Outer product accumulation per instruction set, and a full quatAverage
+    update and solve against one where a single weight changed.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/quatAverage.h"
+#include "core/quatBatch.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+static void BM_OuterProductBatch(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+
+    QuatArray q;
+    bench::randomQuats(q, count);
+
+    std::vector<double> weight;
+    bench::randomDoubles(weight, count, 0.0, 1.0);
+
+    for (auto _ : state)
+    {
+        double m[10] = { 0.0 };
+        outerProductBatch(q.view(), weight.data(), count, m);
+
+        benchmark::DoNotOptimize(m);
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_OuterProductBatch)->Apply(bench::batchArgs);
+
+static void BM_AverageFull(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+
+    QuatArray q;
+    bench::randomQuats(q, count);
+
+    std::vector<double> weight;
+    bench::randomDoubles(weight, count, 0.0, 1.0);
+
+    for (auto _ : state)
+    {
+        QuatAverage average;
+        double out[4];
+
+        average.update(q.view(), weight.data(), count);
+        average.solve(out);
+
+        benchmark::DoNotOptimize(out);
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_AverageFull)->Apply(bench::scalarArgs);
+
+static void BM_AverageOneWeightChanged(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+
+    QuatArray q;
+    bench::randomQuats(q, count);
+
+    std::vector<double> weight;
+    bench::randomDoubles(weight, count, 0.0, 1.0);
+
+    QuatAverage average;
+    double out[4];
+
+    average.update(q.view(), weight.data(), count);
+    average.solve(out);
+
+    size_t i = 0;
+
+    for (auto _ : state)
+    {
+        weight[i] = 1.0 - weight[i];
+        i = (i + 1) % count;
+
+        average.update(q.view(), weight.data(), count);
+        average.solve(out);
+
+        benchmark::DoNotOptimize(out);
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_AverageOneWeightChanged)->Apply(bench::scalarArgs);
@@ -0,0 +1,625 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatBatchBench
+    Scalar (quatMath.h, one element per call) against batched (quatBatch.h,
+    per instruction set) slerp, axis-angle conversions, swing-twist
+    decomposition, rotation extraction from scaled matrices and quaternion
+    powers and hemisphere unflipping. BM_QuatPowerAxisAngle is the
+    quatToAxisAngle, multiply, axisAngleToQuat chain quatPower replaces.
+    BM_UnflipHistory is one quatUnflip compute during playback: the
+    reference lookup in a full history plus the batched unflip. The
+    history is kept to a few frames so the largest counts fit in memory. The batched slerp
+    is also run in each interpolation mode, with no spin so the approximate
+    modes never fall back to exact. BM_SlerpCachedSetup measures the
+    tween-only path of quatSlerp, where the endpoint setup is reused.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/quatBatch.h"
+#include "core/quatMath.h"
+#include "core/unflipHistory.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+namespace
+{
+    struct SlerpInputs
+    {
+        QuatArray p;
+        QuatArray q;
+        QuatArray out;
+        std::vector<double> tween;
+        std::vector<short> spin;
+
+        SlerpInputs(size_t count, bool withSpin)
+        {
+            bench::randomQuats(p, count);
+            bench::randomQuats(q, count);
+            bench::randomDoubles(tween, count, 0.0, 1.0);
+            bench::randomShorts(spin, count, withSpin ? -1 : 0, withSpin ? 1 : 0);
+            out.resize(count);
+        }
+    };
+
+    struct AxisAngleInputs
+    {
+        std::vector<double> x, y, z, angle;
+        std::vector<unsigned char> nonZero;
+        QuatArray quat;
+
+        explicit AxisAngleInputs(size_t count)
+        {
+            bench::randomDoubles(x, count, -1.0, 1.0);
+            bench::randomDoubles(y, count, -1.0, 1.0);
+            bench::randomDoubles(z, count, -1.0, 1.0);
+            bench::randomDoubles(angle, count, -kPi, kPi);
+            bench::randomQuats(quat, count);
+            nonZero.resize(count);
+        }
+
+        VectorArrayView axis()
+        {
+            VectorArrayView result = { x.data(), y.data(), z.data() };
+            return result;
+        }
+    };
+}
+
+static void BM_SlerpScalar(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    SlerpInputs in(count, true);
+
+    ConstQuatArrayView p = in.p.view();
+    ConstQuatArrayView q = in.q.view();
+    QuatArrayView out = in.out.view();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            double a[4] = { p.x[i], p.y[i], p.z[i], p.w[i] };
+            double b[4] = { q.x[i], q.y[i], q.z[i], q.w[i] };
+            double r[4];
+
+            slerp(a, b, in.tween[i], in.spin[i], r);
+
+            out.x[i] = r[0];
+            out.y[i] = r[1];
+            out.z[i] = r[2];
+            out.w[i] = r[3];
+        }
+
+        benchmark::DoNotOptimize(out.w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_SlerpScalar)->Apply(bench::scalarArgs);
+
+static void BM_SlerpCachedSetup(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    SlerpInputs in(count, true);
+
+    ConstQuatArrayView p = in.p.view();
+    ConstQuatArrayView q = in.q.view();
+    QuatArrayView out = in.out.view();
+
+    std::vector<SlerpSetup> setups(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        double a[4] = { p.x[i], p.y[i], p.z[i], p.w[i] };
+        double b[4] = { q.x[i], q.y[i], q.z[i], q.w[i] };
+
+        setups[i] = slerpSetup(a, b, in.spin[i]);
+    }
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            double a, b;
+            slerpWeights(setups[i], in.tween[i], kSlerpExact, a, b);
+
+            out.x[i] = a * p.x[i] + b * q.x[i];
+            out.y[i] = a * p.y[i] + b * q.y[i];
+            out.z[i] = a * p.z[i] + b * q.z[i];
+            out.w[i] = a * p.w[i] + b * q.w[i];
+        }
+
+        benchmark::DoNotOptimize(out.w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_SlerpCachedSetup)->Apply(bench::scalarArgs);
+
+static void BM_SlerpBatch(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    SlerpInputs in(count, true);
+
+    for (auto _ : state)
+    {
+        slerpBatch(in.p.view(), in.q.view(), in.tween.data(), in.spin.data(), in.out.view(), count);
+
+        benchmark::DoNotOptimize(in.out.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_SlerpBatch)->Apply(bench::batchArgs);
+
+static void BM_SlerpModeBatch(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    SlerpMode mode = (SlerpMode) state.range(2);
+    SlerpInputs in(count, false);
+
+    for (auto _ : state)
+    {
+        slerpBatch(in.p.view(), in.q.view(), in.tween.data(), in.spin.data(), in.out.view(), count, mode);
+
+        benchmark::DoNotOptimize(in.out.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_SlerpModeBatch)->Apply(bench::slerpModeArgs);
+
+static void BM_AxisAngleToQuatScalar(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    AxisAngleInputs in(count);
+
+    QuatArrayView out = in.quat.view();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            double axis[3] = { in.x[i], in.y[i], in.z[i] };
+            double r[4];
+
+            axisAngleToQuat(axis, in.angle[i], r);
+
+            out.x[i] = r[0];
+            out.y[i] = r[1];
+            out.z[i] = r[2];
+            out.w[i] = r[3];
+        }
+
+        benchmark::DoNotOptimize(out.w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_AxisAngleToQuatScalar)->Apply(bench::scalarArgs);
+
+static void BM_AxisAngleToQuatBatch(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    AxisAngleInputs in(count);
+
+    for (auto _ : state)
+    {
+        axisAngleToQuatBatch(in.axis(), in.angle.data(), in.quat.view(), count);
+
+        benchmark::DoNotOptimize(in.quat.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_AxisAngleToQuatBatch)->Apply(bench::batchArgs);
+
+static void BM_QuatToAxisAngleScalar(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    AxisAngleInputs in(count);
+
+    ConstQuatArrayView q = in.quat.view();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            double quat[4] = { q.x[i], q.y[i], q.z[i], q.w[i] };
+            double axis[3];
+
+            in.nonZero[i] = quatToAxisAngle(quat, axis, in.angle[i]) ? 1 : 0;
+
+            in.x[i] = axis[0];
+            in.y[i] = axis[1];
+            in.z[i] = axis[2];
+        }
+
+        benchmark::DoNotOptimize(in.angle.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_QuatToAxisAngleScalar)->Apply(bench::scalarArgs);
+
+static void BM_QuatToAxisAngleBatch(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    AxisAngleInputs in(count);
+
+    for (auto _ : state)
+    {
+        quatToAxisAngleBatch(in.quat.view(), in.axis(), in.angle.data(), in.nonZero.data(), count);
+
+        benchmark::DoNotOptimize(in.angle.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_QuatToAxisAngleBatch)->Apply(bench::batchArgs);
+
+static void BM_SwingTwistScalar(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    AxisAngleInputs in(count);
+
+    QuatArray swing, twist;
+    swing.resize(count);
+    twist.resize(count);
+
+    ConstQuatArrayView q = in.quat.view();
+    QuatArrayView swingView = swing.view();
+    QuatArrayView twistView = twist.view();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            double quat[4] = { q.x[i], q.y[i], q.z[i], q.w[i] };
+            double axis[3] = { in.x[i], in.y[i], in.z[i] };
+            double s[4], t[4];
+
+            in.angle[i] = swingTwist(quat, axis, s, t);
+
+            swingView.x[i] = s[0];
+            swingView.y[i] = s[1];
+            swingView.z[i] = s[2];
+            swingView.w[i] = s[3];
+            twistView.x[i] = t[0];
+            twistView.y[i] = t[1];
+            twistView.z[i] = t[2];
+            twistView.w[i] = t[3];
+        }
+
+        benchmark::DoNotOptimize(in.angle.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_SwingTwistScalar)->Apply(bench::scalarArgs);
+
+static void BM_SwingTwistBatch(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    AxisAngleInputs in(count);
+
+    QuatArray swing, twist;
+    swing.resize(count);
+    twist.resize(count);
+
+    for (auto _ : state)
+    {
+        swingTwistBatch(in.quat.view(), in.axis(), swing.view(), twist.view(), in.angle.data(), count);
+
+        benchmark::DoNotOptimize(in.angle.data());
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_SwingTwistBatch)->Apply(bench::batchArgs);
+
+namespace
+{
+    // Rotations with a random positive scale on each row.
+    struct MatrixInputs
+    {
+        std::vector<double> elements[9];
+        QuatArray quat;
+
+        explicit MatrixInputs(size_t count)
+        {
+            QuatArray rotation;
+            bench::randomQuats(rotation, count);
+
+            std::vector<double> scale;
+            bench::randomDoubles(scale, 3 * count, 0.5, 2.0);
+
+            for (int k = 0; k < 9; k++)
+                elements[k].resize(count);
+
+            ConstQuatArrayView r = rotation.view();
+
+            for (size_t i = 0; i < count; i++)
+            {
+                double q[4] = { r.x[i], r.y[i], r.z[i], r.w[i] };
+
+                for (int k = 0; k < 9; k++)
+                    elements[k][i] = rotationElement(q, k % 3, k / 3) * scale[3 * i + k / 3];
+            }
+
+            quat.resize(count);
+        }
+
+        ConstMatrixArrayView view() const
+        {
+            ConstMatrixArrayView result;
+
+            for (int k = 0; k < 9; k++)
+                result.m[k] = elements[k].data();
+
+            return result;
+        }
+    };
+}
+
+static void BM_MatrixToQuatScalar(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    MatrixInputs in(count);
+
+    QuatArrayView q = in.quat.view();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            double m[3][3];
+            double quat[4];
+
+            for (int k = 0; k < 9; k++)
+                m[k / 3][k % 3] = in.elements[k][i];
+
+            matrixToQuat(m, quat);
+
+            q.x[i] = quat[0];
+            q.y[i] = quat[1];
+            q.z[i] = quat[2];
+            q.w[i] = quat[3];
+        }
+
+        benchmark::DoNotOptimize(q.w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_MatrixToQuatScalar)->Apply(bench::scalarArgs);
+
+static void BM_MatrixToQuatBatch(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    MatrixInputs in(count);
+
+    for (auto _ : state)
+    {
+        matrixToQuatBatch(in.view(), in.quat.view(), count);
+
+        benchmark::DoNotOptimize(in.quat.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_MatrixToQuatBatch)->Apply(bench::batchArgs);
+
+static void BM_QuatPowerScalar(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    AxisAngleInputs in(count);
+
+    QuatArray out;
+    out.resize(count);
+
+    ConstQuatArrayView q = in.quat.view();
+    QuatArrayView outView = out.view();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            double quat[4] = { q.x[i], q.y[i], q.z[i], q.w[i] };
+            double result[4];
+
+            quatPower(quat, in.x[i], result);
+
+            outView.x[i] = result[0];
+            outView.y[i] = result[1];
+            outView.z[i] = result[2];
+            outView.w[i] = result[3];
+        }
+
+        benchmark::DoNotOptimize(outView.w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_QuatPowerScalar)->Apply(bench::scalarArgs);
+
+static void BM_QuatPowerAxisAngle(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    AxisAngleInputs in(count);
+
+    QuatArray out;
+    out.resize(count);
+
+    ConstQuatArrayView q = in.quat.view();
+    QuatArrayView outView = out.view();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            double quat[4] = { q.x[i], q.y[i], q.z[i], q.w[i] };
+            double axis[3];
+            double angle;
+            double result[4];
+
+            quatToAxisAngle(quat, axis, angle);
+            axisAngleToQuat(axis, angle * in.x[i], result);
+
+            outView.x[i] = result[0];
+            outView.y[i] = result[1];
+            outView.z[i] = result[2];
+            outView.w[i] = result[3];
+        }
+
+        benchmark::DoNotOptimize(outView.w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_QuatPowerAxisAngle)->Apply(bench::scalarArgs);
+
+static void BM_QuatPowerBatch(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    AxisAngleInputs in(count);
+
+    QuatArray out;
+    out.resize(count);
+
+    for (auto _ : state)
+    {
+        quatPowerBatch(in.quat.view(), in.x.data(), out.view(), count);
+
+        benchmark::DoNotOptimize(out.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_QuatPowerBatch)->Apply(bench::batchArgs);
+
+static void BM_UnflipScalar(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    SlerpInputs in(count, false);
+
+    ConstQuatArrayView q = in.q.view();
+    ConstQuatArrayView ref = in.p.view();
+    QuatArrayView outView = in.out.view();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            double quat[4] = { q.x[i], q.y[i], q.z[i], q.w[i] };
+            double reference[4] = { ref.x[i], ref.y[i], ref.z[i], ref.w[i] };
+            double result[4];
+
+            unflip(quat, reference, result);
+
+            outView.x[i] = result[0];
+            outView.y[i] = result[1];
+            outView.z[i] = result[2];
+            outView.w[i] = result[3];
+        }
+
+        benchmark::DoNotOptimize(outView.w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_UnflipScalar)->Apply(bench::scalarArgs);
+
+static void BM_UnflipBatch(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    SlerpInputs in(count, false);
+
+    for (auto _ : state)
+    {
+        unflipBatch(in.q.view(), in.p.view(), in.out.view(), count);
+
+        benchmark::DoNotOptimize(in.out.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_UnflipBatch)->Apply(bench::batchArgs);
+
+static void BM_UnflipHistory(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    SlerpInputs in(count, false);
+
+    UnflipHistory history;
+    history.setCapacity(4);
+
+    double frame = 0.0;
+
+    for (size_t i = 0; i < history.capacity(); i++)
+        history.unflip(frame++, in.q.view(), in.out.view(), count, 1.0);
+
+    for (auto _ : state)
+    {
+        history.unflip(frame++, in.q.view(), in.out.view(), count, 1.0);
+
+        benchmark::DoNotOptimize(in.out.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_UnflipHistory)->Apply(bench::batchArgs);
@@ -0,0 +1,256 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatDistributeBench
+    Sampling one pair of endpoints along a chain (quatDistribute), against
+    the same samples taken the way a quatSlerp node per joint takes them:
+    a slerpSetup and slerpWeights for every sample. Chains of ribbon and
+    twist joint lengths up to long curves, with every math backend.
+
+    Before timing, the uniform and falloff benchmarks check quatDistribute
+    against quatMath slerp with their math backend, for endpoints from
+    0.001 to 1.5 radians apart, spins from -2 to 2 and chains of 1, 2 and
+    n samples, to the bounds in quatDistribute.h.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/quatBatch.h"
+#include "core/quatDistribute.h"
+#include "core/quatMath.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace quatExtras;
+
+namespace
+{
+    struct ChainInputs
+    {
+        QuatArray endpoints;
+        double p[4];
+        double q[4];
+        std::vector<double> tween;
+        QuatArray out;
+
+        explicit ChainInputs(size_t count)
+        {
+            bench::randomQuats(endpoints, 2);
+
+            ConstQuatArrayView view = endpoints.view();
+
+            for (int i = 0; i < 2; i++)
+            {
+                double *target = i == 0 ? p : q;
+                target[0] = view.x[i];
+                target[1] = view.y[i];
+                target[2] = view.z[i];
+                target[3] = view.w[i];
+            }
+
+            bench::randomDoubles(tween, count, 0.0, 1.0);
+            out.resize(count);
+        }
+    };
+
+    // Angles between the endpoints of the accuracy check, in radians.
+    const double kCheckAngles[] = { 1.0e-3, 1.0e-2, 0.5, 1.5 };
+
+    // The bound quatDistribute.h gives for endpoints theta radians apart.
+    double allowedError(double theta, short spin)
+    {
+        if (spin == 0)
+            return 2.0e-14;
+
+        return 5.0e-14 * std::max(1.0, 1.0e-2 / theta);
+    }
+
+    /*
+        Largest difference per component between distributeSlerp and slerp
+        over count samples, evenly spaced when tween is null.
+    */
+    double distributeError(const double p[4], const double q[4], short spin, const double *tween, size_t count)
+    {
+        QuatArray out;
+        out.resize(count);
+
+        if (tween)
+        {
+            distributeSlerp(p, q, spin, tween, out.view(), count);
+        } else {
+            distributeSlerp(p, q, spin, out.view(), count);
+        }
+
+        ConstQuatArrayView view = out.view();
+        double result = 0.0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            double t = tween ? tween[i] : (count == 1 ? 0.5 : (double) i / (double) (count - 1));
+
+            double expected[4];
+            slerp(p, q, t, spin, expected);
+
+            result = std::max(result, std::fabs(view.x[i] - expected[0]));
+            result = std::max(result, std::fabs(view.y[i] - expected[1]));
+            result = std::max(result, std::fabs(view.z[i] - expected[2]));
+            result = std::max(result, std::fabs(view.w[i] - expected[3]));
+        }
+
+        return result;
+    }
+
+    /*
+        Checks distributeSlerp against slerp with the current math backend,
+        on chains of 1, 2 and count samples. Returns false, and skips the
+        benchmark, beyond the bound.
+    */
+    bool checkAccuracy(benchmark::State &state, size_t count, bool falloff)
+    {
+        QuatArray random;
+        bench::randomQuats(random, 2);
+
+        ConstQuatArrayView view = random.view();
+
+        double p[4] = { view.x[0], view.y[0], view.z[0], view.w[0] };
+        double axisLength = std::sqrt(view.x[1] * view.x[1] + view.y[1] * view.y[1] + view.z[1] * view.z[1]);
+
+        std::vector<double> tween;
+        bench::randomDoubles(tween, count, 0.0, 1.0);
+
+        const size_t lengths[] = { 1, 2, count };
+
+        for (double theta : kCheckAngles)
+        {
+            // p turned by theta, so that the endpoints are theta apart.
+            double s = std::sin(theta) / axisLength;
+            double turn[4] = { view.x[1] * s, view.y[1] * s, view.z[1] * s, std::cos(theta) };
+
+            double q[4];
+            quatMultiply(p, turn, q);
+
+            for (short spin = -2; spin <= 2; spin++)
+            {
+                for (size_t length : lengths)
+                {
+                    if (distributeError(p, q, spin, falloff ? tween.data() : NULL, length) > allowedError(theta, spin))
+                    {
+                        state.SkipWithError("quatDistribute differs from quatMath slerp");
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    /*
+        Chain lengths crossed with every SIMD level and math backend. Only
+        the falloff samples use the SIMD kernels.
+    */
+    void chainArgs(benchmark::internal::Benchmark *b)
+    {
+        b->ArgNames({ "n", "simd", "math" });
+        b->ArgsProduct({
+            { 8, 32, 128, 1024 },
+            { kSimdScalar, kSimdSSE2, kSimdAVX2, kSimdAVX512 },
+            { kMathLibm, kMathPolynomial, kMathTable }
+        });
+    }
+}
+
+static void BM_DistributePerSample(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    bench::ScopedMathBackend backend(state);
+
+    size_t count = (size_t) state.range(0);
+    ChainInputs in(count);
+
+    MathBackend math = defaultMathBackend();
+    QuatArrayView out = in.out.view();
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            double t = (double) i / (double) (count - 1);
+
+            SlerpSetup setup = slerpSetup(in.p, in.q, 0, math);
+
+            double a, b;
+            slerpWeights(setup, t, kSlerpExact, math, a, b);
+
+            out.x[i] = a * in.p[0] + b * in.q[0];
+            out.y[i] = a * in.p[1] + b * in.q[1];
+            out.z[i] = a * in.p[2] + b * in.q[2];
+            out.w[i] = a * in.p[3] + b * in.q[3];
+        }
+
+        benchmark::DoNotOptimize(out.w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_DistributePerSample)->Apply(chainArgs);
+
+static void BM_DistributeUniform(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    bench::ScopedMathBackend backend(state);
+
+    size_t count = (size_t) state.range(0);
+    ChainInputs in(count);
+
+    if (!checkAccuracy(state, count, false))
+        return;
+
+    for (auto _ : state)
+    {
+        distributeSlerp(in.p, in.q, 0, in.out.view(), count);
+
+        benchmark::DoNotOptimize(in.out.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_DistributeUniform)->Apply(chainArgs);
+
+static void BM_DistributeFalloff(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    bench::ScopedMathBackend backend(state);
+
+    size_t count = (size_t) state.range(0);
+    ChainInputs in(count);
+
+    if (!checkAccuracy(state, count, true))
+        return;
+
+    for (auto _ : state)
+    {
+        distributeSlerp(in.p, in.q, 0, in.tween.data(), in.out.view(), count);
+
+        benchmark::DoNotOptimize(in.out.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_DistributeFalloff)->Apply(chainArgs);
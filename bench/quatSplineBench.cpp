@@ -0,0 +1,84 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatSplineBench
+    Building the SQUAD control points (once per key change on quatSpline)
+    and evaluating sample parameters against a cached spline.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/quatBatch.h"
+#include "core/quatSpline.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+namespace
+{
+    const int kKeyCount = 16;
+
+    void randomSpline(QuatSpline &spline, size_t keyCount)
+    {
+        QuatArray keys;
+        bench::randomQuats(keys, keyCount);
+
+        std::vector<double> parameters;
+        bench::randomDoubles(parameters, keyCount, 0.0, (double) keyCount);
+
+        spline.setKeys(keys.view(), parameters.data(), keyCount);
+    }
+}
+
+static void BM_SplineSetKeys(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+
+    QuatArray keys;
+    bench::randomQuats(keys, count);
+
+    std::vector<double> parameters;
+    bench::randomDoubles(parameters, count, 0.0, (double) count);
+
+    QuatSpline spline;
+
+    for (auto _ : state)
+    {
+        spline.setKeys(keys.view(), parameters.data(), count);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_SplineSetKeys)->ArgName("keys")->RangeMultiplier(10)->Range(2, 100000);
+
+static void BM_SplineEvaluate(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+
+    QuatSpline spline;
+    randomSpline(spline, kKeyCount);
+
+    std::vector<double> parameters;
+    bench::randomDoubles(parameters, count, 0.0, (double) kKeyCount);
+
+    QuatArray out;
+    out.resize(count);
+
+    for (auto _ : state)
+    {
+        spline.evaluate(parameters.data(), out.view(), count);
+
+        benchmark::DoNotOptimize(out.view().w);
+        benchmark::ClobberMemory();
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_SplineEvaluate)->Apply(bench::scalarArgs);
@@ -0,0 +1,71 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatSpringBench
+    One frame of quatSpring: every spring advanced through its substeps
+    towards a target that moves from frame to frame, as in playback. Joint
+    counts from a single chain to a crowd, at 1 and 4 substeps per frame,
+    on every SIMD level.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/quatBatch.h"
+#include "core/quatSpring.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+namespace
+{
+    // Distinct frames of targets cycled through.
+    const size_t kFrameCount = 16;
+
+    void springArgs(benchmark::internal::Benchmark *b)
+    {
+        b->ArgNames({ "n", "simd", "substeps" });
+        b->ArgsProduct({
+            { 1, 10, 100, 500, 1000, 10000, 100000 },
+            { kSimdScalar, kSimdSSE2, kSimdAVX2, kSimdAVX512 },
+            { 1, 4 }
+        });
+    }
+}
+
+static void BM_QuatSpring(benchmark::State &state)
+{
+    if (!bench::useSimdLevel(state))
+        return;
+
+    size_t count = (size_t) state.range(0);
+    size_t substeps = (size_t) state.range(2);
+
+    std::vector<QuatArray> targets(kFrameCount);
+
+    for (size_t f = 0; f < kFrameCount; f++)
+        bench::randomQuats(targets[f], count);
+
+    QuatSpring spring;
+    spring.reset(targets[0].view(), count);
+
+    size_t frame = 0;
+
+    for (auto _ : state)
+    {
+        spring.step(targets[frame % kFrameCount].view(), 100.0, 20.0, 1.0 / (24.0 * (double) substeps), substeps);
+
+        benchmark::DoNotOptimize(spring.rotation().w);
+        benchmark::ClobberMemory();
+
+        frame++;
+    }
+
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_QuatSpring)->Apply(springArgs);
@@ -0,0 +1,75 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    taskSchedulerBench
+    slerpBatch over many frames run on the calling thread, and split by
+    parallelFor the way quatExtrasBake evaluates a bake. The parallel runs
+    scale with the cores available; set QUATEXTRAS_THREADS to compare
+    thread counts.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/quatBatch.h"
+#include "core/taskScheduler.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace quatExtras;
+
+namespace
+{
+    // Same chunk size quatExtrasBake hands to the scheduler.
+    const size_t kFramesPerTask = 256;
+}
+
+static void BM_BakeSlerp(benchmark::State &state)
+{
+    size_t count = (size_t) state.range(0);
+    bool parallel = state.range(1) != 0;
+
+    QuatArray p, q, out;
+    std::vector<double> tween;
+
+    bench::randomQuats(p, count);
+    bench::randomQuats(q, count);
+    bench::randomDoubles(tween, count, 0.0, 1.0);
+    out.resize(count);
+
+    ConstQuatArrayView pView = p.view();
+    ConstQuatArrayView qView = q.view();
+    QuatArrayView outView = out.view();
+
+    RangeTask task = [&](size_t begin, size_t end) {
+        ConstQuatArrayView pChunk = { pView.x + begin, pView.y + begin, pView.z + begin, pView.w + begin };
+        ConstQuatArrayView qChunk = { qView.x + begin, qView.y + begin, qView.z + begin, qView.w + begin };
+        QuatArrayView outChunk = { outView.x + begin, outView.y + begin, outView.z + begin, outView.w + begin };
+
+        slerpBatch(pChunk, qChunk, tween.data() + begin, NULL, outChunk, end - begin);
+    };
+
+    for (auto _ : state)
+    {
+        if (parallel)
+        {
+            parallelFor(count, kFramesPerTask, task);
+        } else {
+            task(0, count);
+        }
+
+        benchmark::DoNotOptimize(outView.w[count - 1]);
+    }
+
+    state.counters["threads"] = parallel ? schedulerThreadCount() : 1;
+    bench::setThroughput(state, count);
+}
+BENCHMARK(BM_BakeSlerp)
+    ->ArgNames({"count", "parallel"})
+    ->ArgsProduct({{1000, 10000, 100000, 1000000, 10000000}, {0, 1}})
+    ->UseRealTime();
@@ -0,0 +1,100 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    trackCacheBench
+    Per-frame playback cost of a track cache, as quatCache pays it: every
+    track decoded at two frames and slerped in between, for each encoding.
+    BM_TrackCacheOpen checks that opening does not grow with the file.
+-----------------------------------------------------------------------------*/
+
+#include "benchUtils.h"
+
+#include "core/trackCache.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace quatExtras;
+
+namespace
+{
+    const size_t kFrames = 240;
+
+    std::string cachePath(size_t tracks, int encoding)
+    {
+        return "quatExtras_bench_" + std::to_string(tracks) + "_" + std::to_string(encoding) + ".qxtc";
+    }
+
+    // Writes a cache of random tracks, once per tracks/encoding pair.
+    std::string benchCache(size_t tracks, TrackEncoding encoding)
+    {
+        std::string path = cachePath(tracks, encoding);
+
+        TrackCache existing;
+
+        if (existing.open(path) && existing.trackCount() == tracks)
+            return path;
+
+        QuatArray samples;
+        bench::randomQuats(samples, tracks * kFrames);
+
+        std::vector<std::string> names(tracks, "track");
+        writeTrackCache(path, names, samples.view(), kFrames, 0.0, 1.0, 24.0, encoding);
+
+        return path;
+    }
+}
+
+static void BM_TrackCacheEvaluate(benchmark::State &state)
+{
+    size_t tracks = (size_t) state.range(0);
+    TrackEncoding encoding = (TrackEncoding) state.range(1);
+
+    TrackCache cache;
+
+    if (!cache.open(benchCache(tracks, encoding)))
+    {
+        state.SkipWithError("cannot write the cache");
+        return;
+    }
+
+    QuatArray out;
+    double frame = 0.0;
+
+    for (auto _ : state)
+    {
+        cache.evaluate(frame, out);
+        benchmark::DoNotOptimize(out.view().w[0]);
+
+        frame += 1.5;
+
+        if (frame >= (double) kFrames)
+            frame -= (double) kFrames;
+    }
+
+    bench::setThroughput(state, tracks);
+}
+BENCHMARK(BM_TrackCacheEvaluate)
+    ->ArgNames({"tracks", "encoding"})
+    ->ArgsProduct({{100, 1000, 10000}, {kTrackFloat64, kTrackFloat16, kTrackSmallestThree}});
+
+static void BM_TrackCacheOpen(benchmark::State &state)
+{
+    size_t tracks = (size_t) state.range(0);
+    std::string path = benchCache(tracks, kTrackFloat64);
+
+    for (auto _ : state)
+    {
+        TrackCache cache;
+        benchmark::DoNotOptimize(cache.open(path));
+    }
+
+    bench::setThroughput(state, 1);
+}
+BENCHMARK(BM_TrackCacheOpen)->ArgName("tracks")->Arg(100)->Arg(1000)->Arg(10000);
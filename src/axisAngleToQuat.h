@@ -1,15 +1,20 @@
 #ifndef AXIS_ANGLE_TO_QUAT_H
 #define AXIS_ANGLE_TO_QUAT_H
 
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
 #include <maya/MDataBlock.h>
 #include <maya/MPlug.h>
 #include <maya/MPxNode.h>
 #include <maya/MString.h>
 #include <maya/MTypeId.h>
 
-class AxisAngleToQuatNode : public MPxNode
+class AxisAngleToQuatNode : public MPxNode, public ProfiledNode
 {
 public:
+                            AxisAngleToQuatNode();
+
     virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
     static  void*           creator();
     static  MStatus         initialize();
@@ -19,16 +24,9 @@ public:
     static MString          NODE_NAME;
 
     static MObject          inputAngle_attr;
-    static MObject          inputAxis_attr;
-        static MObject          inputAxisX_attr;
-        static MObject          inputAxisY_attr;
-        static MObject          inputAxisZ_attr;
-
-    static MObject          outputQuat_attr;
-        static MObject          outputQuatX_attr;
-        static MObject          outputQuatY_attr;
-        static MObject          outputQuatZ_attr;
-        static MObject          outputQuatW_attr;
+    static VectorAttribute  inputAxis_attr;
+
+    static QuatAttribute    outputQuat_attr;
 };
 
 #endif
\ No newline at end of file
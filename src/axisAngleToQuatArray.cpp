@@ -0,0 +1,155 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    axisAngleToQuatArray node
+    Constructs many quaternions from rotations about axes in a single
+    evaluation. Element i of each input array drives element i of the
+    output; missing elements use the attribute defaults.
+
+    axis  (axis)
+        The axes about which the rotations occur.
+
+    angle (an)
+        The angles of rotation about the axes.
+
+    precision  (pr)
+        Component type the rotations are computed in.
+            default Follows the plugin-wide setting, double unless the
+                    QUATEXTRAS_PRECISION environment variable is "float".
+            double  Full precision.
+            float   Twice as many elements per instruction, within 1.5e-7
+                    of double per component.
+
+    outputQuat  (oq)
+        Quaternion rotations around the axes. Has one element per logical
+        index of axis/angle, whichever is longer.
+
+    outputQuatData (oqd)
+        The same as quatArrayData, computed only when it is requested.
+
+-----------------------------------------------------------------------------*/
+
+#include "axisAngleToQuatArray.h"
+#include "quatArrayData.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnUnitAttribute.h>
+#include <maya/MPlug.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace quatExtras;
+
+MObject AxisAngleToQuatArrayNode::inputAngle_attr;
+VectorAttribute AxisAngleToQuatArrayNode::inputAxis_attr;
+MObject AxisAngleToQuatArrayNode::precision_attr;
+
+QuatAttribute AxisAngleToQuatArrayNode::outputQuat_attr;
+MObject AxisAngleToQuatArrayNode::outputQuatData_attr;
+
+AxisAngleToQuatArrayNode::AxisAngleToQuatArrayNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* AxisAngleToQuatArrayNode::creator()
+{
+    return new AxisAngleToQuatArrayNode();
+}
+
+MStatus AxisAngleToQuatArrayNode::initialize()
+{
+    MStatus status;
+
+    MFnUnitAttribute u;
+
+    const char *const axisNames[] = { "asx", "asy", "asz" };
+    status = inputAxis_attr.create("axis", "as", axisNames, kUnitAxisDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    inputAngle_attr = u.create("angle", "an", MFnUnitAttribute::kAngle, 0.0);
+    MAKE_INPUT(u);
+    u.setArray(true);
+
+    precision_attr = createPrecisionAttribute(&status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    outputQuatData_attr = createQuatArrayDataAttribute("outputQuatData", "oqd", true, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(inputAxis_attr);
+    addAttribute(inputAngle_attr);
+    addAttribute(precision_attr);
+    addAttribute(outputQuat_attr);
+    addAttribute(outputQuatData_attr);
+
+    attributeAffects(inputAxis_attr, outputQuat_attr);
+    attributeAffects(inputAngle_attr, outputQuat_attr);
+    attributeAffects(precision_attr, outputQuat_attr);
+
+    attributeAffects(inputAxis_attr, outputQuatData_attr);
+    attributeAffects(inputAngle_attr, outputQuatData_attr);
+    attributeAffects(precision_attr, outputQuatData_attr);
+
+    return MStatus::kSuccess;
+}
+
+namespace
+{
+    /*
+        Reads the inputs into T buffers, runs the T kernel and writes the
+        result; T is double or float.
+    */
+    template <class T>
+    MStatus computeOutputQuat(MDataBlock &data, MArrayDataHandle &axisHandle, MArrayDataHandle &angleHandle, QuatArrayOutput &output, unsigned count)
+    {
+        std::vector<T> axisX(count, T(1));
+        std::vector<T> axisY(count, T(1));
+        std::vector<T> axisZ(count, T(1));
+        std::vector<T> angle(count, T(0));
+
+        VectorArrayViewT<T> axisView = { axisX.data(), axisY.data(), axisZ.data() };
+
+        AxisAngleToQuatArrayNode::inputAxis_attr.inputArrayValue(axisHandle, axisView, count);
+        inputAngleArrayValue(angleHandle, angle.data(), count);
+
+        axisAngleToQuatBatch(axisView, angle.data(), output.allocateAs<T>(count), count);
+
+        return output.write(data);
+    }
+}
+
+MStatus AxisAngleToQuatArrayNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputQuat_attr) && !isPlugFor(plug, outputQuatData_attr))
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    MArrayDataHandle axisHandle = data.inputArrayValue(inputAxis_attr);
+    MArrayDataHandle angleHandle = data.inputArrayValue(inputAngle_attr);
+
+    QuatArrayOutput output(plug, outputQuat_attr, outputQuatData_attr);
+
+    unsigned count = std::max(logicalLength(axisHandle), logicalLength(angleHandle));
+    timer.setElements(count);
+
+    if (precisionValue(data, precision_attr) == kPrecisionFloat)
+        return computeOutputQuat<float>(data, axisHandle, angleHandle, output, count);
+
+    return computeOutputQuat<double>(data, axisHandle, angleHandle, output, count);
+}
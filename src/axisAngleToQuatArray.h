@@ -0,0 +1,34 @@
+#ifndef AXIS_ANGLE_TO_QUAT_ARRAY_H
+#define AXIS_ANGLE_TO_QUAT_ARRAY_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+class AxisAngleToQuatArrayNode : public MPxNode, public ProfiledNode
+{
+public:
+                            AxisAngleToQuatArrayNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static MObject          inputAngle_attr;
+    static VectorAttribute  inputAxis_attr;
+    static MObject          precision_attr;
+
+    static QuatAttribute    outputQuat_attr;
+    static MObject          outputQuatData_attr;
+};
+
+#endif
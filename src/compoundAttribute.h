@@ -0,0 +1,392 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    compoundAttribute
+    Descriptor for an attribute made of N double children, created together
+    and read or written as one value:
+
+        VectorAttribute     3 children, a numeric compound (double3).
+        QuatAttribute       4 children, a numeric compound (double4).
+
+    With kCompoundAngle the children are doubleAngles, like a transform's
+    rotate, and values are read and written in radians.
+
+    Child long names are the parent's long name followed by X, Y, Z and W.
+    Short names are given per child since the nodes do not share a pattern.
+
+    A numeric compound keeps its children in one value, so a vector is
+    read with a single asDouble3() and written with a single set3Double(),
+    and a quaternion with asDouble4() and set4Double(), with no child()
+    lookup per component.
+
+    The descriptor converts to its parent MObject, so it can be passed
+    straight to addAttribute, attributeAffects and plug comparisons.
+-----------------------------------------------------------------------------*/
+
+#ifndef COMPOUND_ATTRIBUTE_H
+#define COMPOUND_ATTRIBUTE_H
+
+#include "nodeUtils.h"
+
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataBuilder.h>
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MDataHandle.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnNumericData.h>
+#include <maya/MFnUnitAttribute.h>
+#include <maya/MObject.h>
+#include <maya/MPlug.h>
+#include <maya/MString.h>
+#include <maya/MTypes.h>
+
+#if MAYA_API_VERSION >= 201600
+#include <maya/MEvaluationNode.h>
+#endif
+
+enum CompoundAttributeFlags
+{
+    kCompoundInput  = 0,
+    kCompoundOutput = 1 << 0,
+    kCompoundArray  = 1 << 1,
+    kCompoundAngle  = 1 << 2
+};
+
+const double kIdentityQuatDefaults[4] = { 0.0, 0.0, 0.0, 1.0 };
+const double kUnitAxisDefaults[3] = { 1.0, 1.0, 1.0 };
+const double kXAxisDefaults[3] = { 1.0, 0.0, 0.0 };
+
+/*
+    Buffers for a whole array of values: VectorArrayView for three children,
+    QuatArrayView for four, and their float versions.
+*/
+template <unsigned N> struct CompoundArrayViews;
+
+template <> struct CompoundArrayViews<3>
+{
+    typedef quatExtras::VectorArrayView         View;
+    typedef quatExtras::ConstVectorArrayView    ConstView;
+    typedef quatExtras::VectorArrayViewF        ViewF;
+    typedef quatExtras::ConstVectorArrayViewF   ConstViewF;
+
+    template <class T> static void components(const quatExtras::VectorArrayViewT<T> &v, T *c[3])               { c[0] = v.x; c[1] = v.y; c[2] = v.z; }
+    template <class T> static void components(const quatExtras::ConstVectorArrayViewT<T> &v, const T *c[3])   { c[0] = v.x; c[1] = v.y; c[2] = v.z; }
+};
+
+template <> struct CompoundArrayViews<4>
+{
+    typedef quatExtras::QuatArrayView           View;
+    typedef quatExtras::ConstQuatArrayView      ConstView;
+    typedef quatExtras::QuatArrayViewF          ViewF;
+    typedef quatExtras::ConstQuatArrayViewF     ConstViewF;
+
+    template <class T> static void components(const quatExtras::QuatArrayViewT<T> &v, T *c[4])                 { c[0] = v.x; c[1] = v.y; c[2] = v.z; c[3] = v.w; }
+    template <class T> static void components(const quatExtras::ConstQuatArrayViewT<T> &v, const T *c[4])     { c[0] = v.x; c[1] = v.y; c[2] = v.z; c[3] = v.w; }
+};
+
+template <unsigned N>
+class CompoundAttribute
+{
+public:
+    typedef typename CompoundArrayViews<N>::View        ArrayView;
+    typedef typename CompoundArrayViews<N>::ConstView   ConstArrayView;
+    typedef typename CompoundArrayViews<N>::ViewF       ArrayViewF;
+    typedef typename CompoundArrayViews<N>::ConstViewF  ConstArrayViewF;
+
+    /*
+        Creates the parent and its children. flags combines
+        kCompoundOutput, kCompoundArray and kCompoundAngle (N == 3 only);
+        output arrays use an array data builder.
+    */
+    MStatus                 create(const MString &longName, const MString &shortName, const char *const (&childShortNames)[N], const double (&defaults)[N], int flags);
+
+                            operator const MObject&() const     { return attr; }
+    const MObject&          child(unsigned i) const             { return children[i]; }
+
+    // True for the parent and for any of its children.
+    bool                    owns(const MObject &attribute) const;
+
+#if MAYA_API_VERSION >= 201600
+    bool                    dirtyPlugExists(const MEvaluationNode &evaluationNode) const;
+#endif
+
+    // Values through a handle to the parent or to one of its elements.
+    void                    get(MDataHandle &handle, double value[N]) const;
+    void                    set(MDataHandle &handle, const double value[N]) const;
+
+    void                    inputValue(MDataBlock &data, double value[N]) const;
+    MStatus                 outputValue(MDataBlock &data, const double value[N]) const;
+
+    /*
+        Scatters the array's elements into the buffers by logical index.
+        Buffers must already hold length defaults; indices past length are
+        ignored. Float buffers are rounded on the way in.
+    */
+    void                    inputArrayValue(MArrayDataHandle &arrayHandle, const ArrayView &values, unsigned length) const;
+    void                    inputArrayValue(MArrayDataHandle &arrayHandle, const ArrayViewF &values, unsigned length) const;
+
+    // Replaces the output array with length elements built from values.
+    MStatus                 outputArrayValue(MDataBlock &data, const ConstArrayView &values, unsigned length) const;
+    MStatus                 outputArrayValue(MDataBlock &data, const ConstArrayViewF &values, unsigned length) const;
+
+private:
+    template <class T>
+    void                    scatter(MArrayDataHandle &arrayHandle, T *const components[N], unsigned length) const;
+
+    template <class T>
+    MStatus                 gather(MDataBlock &data, const T *const components[N], unsigned length) const;
+
+    MObject                 attr;
+    MObject                 children[N];
+};
+
+typedef CompoundAttribute<3> VectorAttribute;
+typedef CompoundAttribute<4> QuatAttribute;
+
+
+template <unsigned N>
+MStatus CompoundAttribute<N>::create(const MString &longName, const MString &shortName, const char *const (&childShortNames)[N], const double (&defaults)[N], int flags)
+{
+    static const char *const suffixes[] = { "X", "Y", "Z", "W" };
+
+    MStatus status;
+    MFnNumericAttribute n;
+    MFnUnitAttribute u;
+
+    for (unsigned i = 0; i < N; i++)
+    {
+        MFnAttribute *child;
+
+        if (flags & kCompoundAngle)
+        {
+            children[i] = u.create(longName + suffixes[i], childShortNames[i], MFnUnitAttribute::kAngle, defaults[i], &status);
+            child = &u;
+        } else {
+            children[i] = n.create(longName + suffixes[i], childShortNames[i], MFnNumericData::kDouble, defaults[i], &status);
+            child = &n;
+        }
+
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        if (flags & kCompoundOutput)
+        {
+            MAKE_OUTPUT((*child));
+        } else {
+            MAKE_INPUT((*child));
+        }
+    }
+
+    // children[N - 1], as children[3] is out of range when N is 3.
+    if (N == 3)
+        attr = n.create(longName, shortName, children[0], children[1], children[2], &status);
+    else
+        attr = n.create(longName, shortName, children[0], children[1], children[2], children[N - 1], &status);
+
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    if (flags & kCompoundArray)
+    {
+        n.setArray(true);
+        n.setUsesArrayDataBuilder((flags & kCompoundOutput) != 0);
+    }
+
+    return MStatus::kSuccess;
+}
+
+
+template <unsigned N>
+bool CompoundAttribute<N>::owns(const MObject &attribute) const
+{
+    if (attribute == attr)
+        return true;
+
+    for (unsigned i = 0; i < N; i++)
+    {
+        if (attribute == children[i])
+            return true;
+    }
+
+    return false;
+}
+
+
+#if MAYA_API_VERSION >= 201600
+template <unsigned N>
+bool CompoundAttribute<N>::dirtyPlugExists(const MEvaluationNode &evaluationNode) const
+{
+    if (evaluationNode.dirtyPlugExists(attr))
+        return true;
+
+    for (unsigned i = 0; i < N; i++)
+    {
+        if (evaluationNode.dirtyPlugExists(children[i]))
+            return true;
+    }
+
+    return false;
+}
+#endif
+
+
+template <>
+inline void CompoundAttribute<3>::get(MDataHandle &handle, double value[3]) const
+{
+    const double3 &v = handle.asDouble3();
+
+    value[0] = v[0];
+    value[1] = v[1];
+    value[2] = v[2];
+}
+
+
+template <>
+inline void CompoundAttribute<4>::get(MDataHandle &handle, double value[4]) const
+{
+    const double4 &v = handle.asDouble4();
+
+    value[0] = v[0];
+    value[1] = v[1];
+    value[2] = v[2];
+    value[3] = v[3];
+}
+
+
+template <>
+inline void CompoundAttribute<3>::set(MDataHandle &handle, const double value[3]) const
+{
+    handle.set3Double(value[0], value[1], value[2]);
+}
+
+
+template <>
+inline void CompoundAttribute<4>::set(MDataHandle &handle, const double value[4]) const
+{
+    handle.set4Double(value[0], value[1], value[2], value[3]);
+}
+
+
+template <unsigned N>
+void CompoundAttribute<N>::inputValue(MDataBlock &data, double value[N]) const
+{
+    MDataHandle handle = data.inputValue(attr);
+    get(handle, value);
+}
+
+
+template <unsigned N>
+MStatus CompoundAttribute<N>::outputValue(MDataBlock &data, const double value[N]) const
+{
+    MStatus status;
+
+    MDataHandle handle = data.outputValue(attr, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    set(handle, value);
+    handle.setClean();
+
+    return MStatus::kSuccess;
+}
+
+
+template <unsigned N>
+void CompoundAttribute<N>::inputArrayValue(MArrayDataHandle &arrayHandle, const ArrayView &values, unsigned length) const
+{
+    double *components[N];
+    CompoundArrayViews<N>::components(values, components);
+
+    scatter(arrayHandle, components, length);
+}
+
+
+template <unsigned N>
+void CompoundAttribute<N>::inputArrayValue(MArrayDataHandle &arrayHandle, const ArrayViewF &values, unsigned length) const
+{
+    float *components[N];
+    CompoundArrayViews<N>::components(values, components);
+
+    scatter(arrayHandle, components, length);
+}
+
+
+template <unsigned N>
+MStatus CompoundAttribute<N>::outputArrayValue(MDataBlock &data, const ConstArrayView &values, unsigned length) const
+{
+    const double *components[N];
+    CompoundArrayViews<N>::components(values, components);
+
+    return gather(data, components, length);
+}
+
+
+template <unsigned N>
+MStatus CompoundAttribute<N>::outputArrayValue(MDataBlock &data, const ConstArrayViewF &values, unsigned length) const
+{
+    const float *components[N];
+    CompoundArrayViews<N>::components(values, components);
+
+    return gather(data, components, length);
+}
+
+
+template <unsigned N>
+template <class T>
+void CompoundAttribute<N>::scatter(MArrayDataHandle &arrayHandle, T *const components[N], unsigned length) const
+{
+    unsigned numElements = arrayHandle.elementCount();
+
+    for (unsigned i = 0; i < numElements; i++)
+    {
+        arrayHandle.jumpToArrayElement(i);
+
+        unsigned index = arrayHandle.elementIndex();
+
+        if (index >= length)
+            continue;
+
+        MDataHandle elementHandle = arrayHandle.inputValue();
+
+        double value[N];
+        get(elementHandle, value);
+
+        for (unsigned k = 0; k < N; k++)
+            components[k][index] = T(value[k]);
+    }
+}
+
+
+template <unsigned N>
+template <class T>
+MStatus CompoundAttribute<N>::gather(MDataBlock &data, const T *const components[N], unsigned length) const
+{
+    MStatus status;
+
+    MArrayDataHandle arrayHandle = data.outputArrayValue(attr, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    MArrayDataBuilder builder(&data, attr, length, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    for (unsigned i = 0; i < length; i++)
+    {
+        MDataHandle elementHandle = builder.addElement(i);
+
+        double value[N];
+
+        for (unsigned k = 0; k < N; k++)
+            value[k] = components[k][i];
+
+        set(elementHandle, value);
+    }
+
+    arrayHandle.set(builder);
+    arrayHandle.setAllClean();
+
+    return MStatus::kSuccess;
+}
+
+#endif
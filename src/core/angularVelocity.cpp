@@ -0,0 +1,221 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "angularVelocity.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace quatExtras
+{
+    namespace
+    {
+        // Tracks differenced per call to quatToRotationVectorBatch.
+        const size_t kChunkSize = 256;
+
+        /*
+            The rotation from q to n, in parent or local space, as a
+            quaternion; out holds n elements.
+        */
+        void relativeRotation(ConstQuatArrayView q, ConstQuatArrayView n, size_t start, size_t length, VelocitySpace space, QuatArrayView out)
+        {
+            // Parent space is n * conjugate(q), local conjugate(q) * n; they
+            // differ only in the sign of the cross product.
+            double sign = space == kVelocityLocal ? -1.0 : 1.0;
+
+            for (size_t k = 0; k < length; k++)
+            {
+                size_t i = start + k;
+
+                double ax = n.x[i], ay = n.y[i], az = n.z[i], aw = n.w[i];
+                double bx = -q.x[i], by = -q.y[i], bz = -q.z[i], bw = q.w[i];
+
+                out.x[k] = aw * bx + ax * bw + sign * (ay * bz - az * by);
+                out.y[k] = aw * by + ay * bw + sign * (az * bx - ax * bz);
+                out.z[k] = aw * bz + az * bw + sign * (ax * by - ay * bx);
+                out.w[k] = aw * bw - ax * bx - ay * by - az * bz;
+            }
+        }
+    }
+
+    void angularVelocityBatch(
+        ConstQuatArrayView q,
+        ConstQuatArrayView n1,
+        double s1,
+        ConstQuatArrayView n2,
+        double s2,
+        VelocitySpace space,
+        VectorArrayView velocity,
+        VectorArrayView acceleration,
+        size_t count
+    ) {
+        double relative[4][kChunkSize];
+        double v1[3][kChunkSize];
+        double v2[3][kChunkSize];
+
+        QuatArrayView relativeView = { relative[0], relative[1], relative[2], relative[3] };
+        VectorArrayView v1View = { v1[0], v1[1], v1[2] };
+        VectorArrayView v2View = { v2[0], v2[1], v2[2] };
+
+        double denominator = s1 * s2 * (s2 - s1);
+
+        // velocity = a1 v1 + a2 v2, acceleration = b1 v1 + b2 v2.
+        double a1 = s2 * s2 / denominator;
+        double a2 = -s1 * s1 / denominator;
+        double b1 = -2.0 * s2 / denominator;
+        double b2 = 2.0 * s1 / denominator;
+
+        double *velocityOut[3] = { velocity.x, velocity.y, velocity.z };
+        double *accelerationOut[3] = { acceleration.x, acceleration.y, acceleration.z };
+
+        bool withAcceleration = acceleration.x != nullptr && acceleration.y != nullptr && acceleration.z != nullptr;
+
+        for (size_t start = 0; start < count; start += kChunkSize)
+        {
+            size_t n = std::min(kChunkSize, count - start);
+
+            relativeRotation(q, n1, start, n, space, relativeView);
+            quatToRotationVectorBatch(relativeView, v1View, n);
+
+            relativeRotation(q, n2, start, n, space, relativeView);
+            quatToRotationVectorBatch(relativeView, v2View, n);
+
+            for (int c = 0; c < 3; c++)
+            {
+                double *out = velocityOut[c] + start;
+
+                for (size_t k = 0; k < n; k++)
+                    out[k] = a1 * v1[c][k] + a2 * v2[c][k];
+            }
+
+            if (!withAcceleration)
+                continue;
+
+            for (int c = 0; c < 3; c++)
+            {
+                double *out = accelerationOut[c] + start;
+
+                for (size_t k = 0; k < n; k++)
+                    out[k] = b1 * v1[c][k] + b2 * v2[c][k];
+            }
+        }
+    }
+
+    const double VelocityHistory::kTimeTolerance = 1.0e-6;
+
+    VelocityHistory::VelocityHistory() :
+        trackCount_(0),
+        next_(0),
+        times_(kDefaultCapacity, std::numeric_limits<double>::quiet_NaN()),
+        samples_(kDefaultCapacity)
+    {
+    }
+
+    void VelocityHistory::clear()
+    {
+        std::fill(times_.begin(), times_.end(), std::numeric_limits<double>::quiet_NaN());
+        next_ = 0;
+    }
+
+    void VelocityHistory::setCapacity(size_t samples)
+    {
+        samples = std::max<size_t>(samples, 3);
+
+        if (samples == times_.size())
+            return;
+
+        times_.assign(samples, std::numeric_limits<double>::quiet_NaN());
+        samples_.resize(samples);
+        next_ = 0;
+    }
+
+    size_t VelocityHistory::sampleCount() const
+    {
+        size_t result = 0;
+
+        for (size_t s = 0; s < times_.size(); s++)
+        {
+            if (!std::isnan(times_[s]))
+                result++;
+        }
+
+        return result;
+    }
+
+    int VelocityHistory::slot(double time) const
+    {
+        for (size_t s = 0; s < times_.size(); s++)
+        {
+            if (std::fabs(times_[s] - time) <= kTimeTolerance)
+                return (int) s;
+        }
+
+        return -1;
+    }
+
+    bool VelocityHistory::find(double time, ConstQuatArrayView &q) const
+    {
+        int s = slot(time);
+
+        if (s < 0)
+            return false;
+
+        q = samples_[(size_t) s].view();
+        return true;
+    }
+
+    bool VelocityHistory::store(double time, ConstQuatArrayView q, size_t count)
+    {
+        bool kept = true;
+
+        if (count != trackCount_)
+        {
+            clear();
+            trackCount_ = count;
+            kept = false;
+        }
+
+        int s = slot(time);
+
+        if (s >= 0)
+        {
+            ConstQuatArrayView stored = samples_[(size_t) s].view();
+
+            bool same =
+                std::equal(q.x, q.x + count, stored.x) &&
+                std::equal(q.y, q.y + count, stored.y) &&
+                std::equal(q.z, q.z + count, stored.z) &&
+                std::equal(q.w, q.w + count, stored.w);
+
+            if (same)
+                return kept;
+
+            clear();
+            kept = false;
+            s = -1;
+        }
+
+        if (s < 0)
+        {
+            s = (int) next_;
+            next_ = (next_ + 1) % times_.size();
+        }
+
+        QuatArray &sample = samples_[(size_t) s];
+        sample.resize(count);
+
+        QuatArrayView sampleView = sample.view();
+
+        std::copy(q.x, q.x + count, sampleView.x);
+        std::copy(q.y, q.y + count, sampleView.y);
+        std::copy(q.z, q.z + count, sampleView.z);
+        std::copy(q.w, q.w + count, sampleView.w);
+
+        times_[(size_t) s] = time;
+
+        return kept;
+    }
+}
@@ -0,0 +1,112 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    angularVelocity
+    Maya-free angular velocity and acceleration of quaternion tracks by
+    finite differences through the log map.
+
+    Samples of a track at times s1 and s2 away from the sample q are each
+    turned into a rotation vector relative to q,
+
+        r(s) = quatToRotationVector(q(s) * conjugate(q))    parent space
+        r(s) = quatToRotationVector(conjugate(q) * q(s))    local space
+
+    and r(s) = velocity * s + acceleration * s^2 / 2 is fitted through
+    r(0) = 0, r(s1) and r(s2). In the tangent space at q that is exact for
+    a rotation at constant angular acceleration up to terms in s^3, so the
+    velocity is second order in the step whether the samples are on both
+    sides of q (central) or on one side (backward or forward); the
+    acceleration is second order central and first order one-sided. The
+    rotation vectors take the shorter way round, so a track that changes
+    sign between samples is differenced correctly, but a track that turns
+    more than 180 degrees between samples is not.
+
+    VelocityHistory is a ring buffer of recent samples of all the tracks,
+    keyed by time, so a node sampled along a timeline can difference each
+    frame against frames it has already seen instead of evaluating its
+    inputs at other times again. When more than capacity samples are
+    stored the oldest is overwritten. Storing a sample at a time already
+    stored, with different quaternions, means the inputs have changed, so
+    every other sample is dropped; so does a change in the number of
+    tracks.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_ANGULAR_VELOCITY_H
+#define QUAT_EXTRAS_ANGULAR_VELOCITY_H
+
+#include "quatBatch.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace quatExtras
+{
+    enum VelocitySpace
+    {
+        kVelocityParent = 0,
+        kVelocityLocal = 1
+    };
+
+    /*
+        velocity[i] and acceleration[i] of track i at q[i], from its
+        samples n1[i] and n2[i] at time offsets s1 and s2 from it. s1 and
+        s2 are non-zero and different, and may have either sign. Units are
+        radians per unit of s and per unit of s squared. acceleration may
+        have null components when it is not wanted.
+    */
+    void angularVelocityBatch(
+        ConstQuatArrayView q,
+        ConstQuatArrayView n1,
+        double s1,
+        ConstQuatArrayView n2,
+        double s2,
+        VelocitySpace space,
+        VectorArrayView velocity,
+        VectorArrayView acceleration,
+        size_t count
+    );
+
+    class VelocityHistory
+    {
+    public:
+        static const size_t     kDefaultCapacity = 8;
+
+        // Times closer than this are the same sample.
+        static const double     kTimeTolerance;
+
+                                VelocityHistory();
+
+        void                    clear();
+
+        // Samples kept; at least three, for a sample and two neighbours.
+        size_t                  capacity() const { return times_.size(); }
+        void                    setCapacity(size_t samples);
+
+        size_t                  sampleCount() const;
+
+        /*
+            Stores the count tracks of q as the sample at time. Returns
+            false if this dropped the other samples, because the number of
+            tracks changed or q differs from the sample already at time.
+        */
+        bool                    store(double time, ConstQuatArrayView q, size_t count);
+
+        // The sample at time; false when there is none.
+        bool                    find(double time, ConstQuatArrayView &q) const;
+
+    private:
+        int                     slot(double time) const;
+
+        size_t                  trackCount_;
+        size_t                  next_;
+
+        // NaN for an empty slot.
+        std::vector<double>     times_;
+        std::vector<QuatArray>  samples_;
+    };
+}
+
+#endif
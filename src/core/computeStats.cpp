@@ -0,0 +1,322 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "computeStats.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace quatExtras
+{
+    namespace
+    {
+        enum Field
+        {
+            kCalls,
+            kNanoseconds,
+            kElements,
+            kCacheHits,
+            kCacheMisses,
+            kFieldCount
+        };
+
+        /*
+            Counters written by one thread only. Blocks are linked into a
+            list that is only ever pushed to, and are never freed so the
+            counts of threads that have exited still add to the totals.
+        */
+        struct ThreadCounters
+        {
+            // Keeps the counters off the cache lines of whatever was
+            // allocated next to the block.
+            char                    before[64];
+
+            std::atomic<uint64_t>   values[kMaxStatsTypes][kFieldCount];
+            ThreadCounters         *next;
+
+            char                    after[64];
+
+            ThreadCounters() : next(NULL)
+            {
+                for (int t = 0; t < kMaxStatsTypes; t++)
+                {
+                    for (int f = 0; f < kFieldCount; f++)
+                        values[t][f].store(0, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        std::atomic<ThreadCounters*> threadList(NULL);
+
+        thread_local ThreadCounters *localCounters = NULL;
+
+        ThreadCounters& threadCounters()
+        {
+            if (!localCounters)
+            {
+                ThreadCounters *block = new ThreadCounters();
+                block->next = threadList.load(std::memory_order_relaxed);
+
+                while (!threadList.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+                {
+                }
+
+                localCounters = block;
+            }
+
+            return *localCounters;
+        }
+
+        // Names and reset baselines, only touched when registering a type
+        // or reporting.
+        std::mutex typeMutex;
+        std::vector<std::string> typeNames;
+        uint64_t baseline[kMaxStatsTypes][kFieldCount] = {};
+
+        void sumThreads(int type, uint64_t out[kFieldCount])
+        {
+            for (int f = 0; f < kFieldCount; f++)
+                out[f] = 0;
+
+            for (ThreadCounters *block = threadList.load(std::memory_order_acquire); block; block = block->next)
+            {
+                for (int f = 0; f < kFieldCount; f++)
+                    out[f] += block->values[type][f].load(std::memory_order_relaxed);
+            }
+        }
+
+        bool initialStatsEnabled()
+        {
+            const char* env = std::getenv("QUATEXTRAS_STATS");
+            return env && std::atoi(env) != 0;
+        }
+
+        void add(std::atomic<uint64_t> &counter, uint64_t value)
+        {
+            // Only the owning thread writes, so a plain load and store is
+            // enough and avoids a locked add.
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        std::string csvField(const std::string &value)
+        {
+            if (value.find_first_of(",\"\n") == std::string::npos)
+                return value;
+
+            std::string result = "\"";
+
+            for (size_t i = 0; i < value.size(); i++)
+            {
+                if (value[i] == '"')
+                    result += '"';
+
+                result += value[i];
+            }
+
+            return result + "\"";
+        }
+
+        std::string jsonString(const std::string &value)
+        {
+            std::string result = "\"";
+
+            for (size_t i = 0; i < value.size(); i++)
+            {
+                char c = value[i];
+
+                if (c == '"' || c == '\\')
+                {
+                    result += '\\';
+                    result += c;
+                } else if ((unsigned char) c < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned) c);
+                    result += escaped;
+                } else {
+                    result += c;
+                }
+            }
+
+            return result + "\"";
+        }
+
+        /*
+            The counter columns of a row, comma separated for CSV or as
+            key/value pairs for JSON.
+        */
+        std::string counterFields(const ComputeCounters &c, bool json)
+        {
+            double totalMs = c.nanoseconds * 1.0e-6;
+            double averageUs = c.calls ? c.nanoseconds * 1.0e-3 / c.calls : 0.0;
+
+            const char *format = json
+                ? "\"calls\": %llu, \"totalMs\": %.3f, \"averageUs\": %.3f, \"elements\": %llu, \"cacheHits\": %llu, \"cacheMisses\": %llu"
+                : "%llu,%.3f,%.3f,%llu,%llu,%llu";
+
+            char buffer[256];
+            std::snprintf(
+                buffer, sizeof(buffer), format,
+                (unsigned long long) c.calls, totalMs, averageUs,
+                (unsigned long long) c.elements,
+                (unsigned long long) c.cacheHits,
+                (unsigned long long) c.cacheMisses
+            );
+
+            return buffer;
+        }
+    }
+
+    namespace detail
+    {
+        std::atomic<bool> statsEnabled(initialStatsEnabled());
+    }
+
+    void setStatsEnabled(bool enabled)
+    {
+        detail::statsEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    int registerStatsType(const char *name)
+    {
+        std::lock_guard<std::mutex> lock(typeMutex);
+
+        for (size_t i = 0; i < typeNames.size(); i++)
+        {
+            if (typeNames[i] == name)
+                return (int) i;
+        }
+
+        if (typeNames.size() >= (size_t) kMaxStatsTypes)
+            return -1;
+
+        typeNames.push_back(name);
+        return (int) typeNames.size() - 1;
+    }
+
+    void recordCompute(int type, const ComputeCounters &delta)
+    {
+        if (type < 0 || type >= kMaxStatsTypes)
+            return;
+
+        std::atomic<uint64_t> *values = threadCounters().values[type];
+
+        add(values[kCalls], delta.calls);
+        add(values[kNanoseconds], delta.nanoseconds);
+        add(values[kElements], delta.elements);
+        add(values[kCacheHits], delta.cacheHits);
+        add(values[kCacheMisses], delta.cacheMisses);
+    }
+
+    void statsTypeTotals(std::vector<std::string> &names, std::vector<ComputeCounters> &totals)
+    {
+        std::lock_guard<std::mutex> lock(typeMutex);
+
+        names = typeNames;
+        totals.assign(typeNames.size(), ComputeCounters());
+
+        for (size_t t = 0; t < typeNames.size(); t++)
+        {
+            uint64_t sum[kFieldCount];
+            sumThreads((int) t, sum);
+
+            totals[t].calls = sum[kCalls] - baseline[t][kCalls];
+            totals[t].nanoseconds = sum[kNanoseconds] - baseline[t][kNanoseconds];
+            totals[t].elements = sum[kElements] - baseline[t][kElements];
+            totals[t].cacheHits = sum[kCacheHits] - baseline[t][kCacheHits];
+            totals[t].cacheMisses = sum[kCacheMisses] - baseline[t][kCacheMisses];
+        }
+    }
+
+    void resetStats()
+    {
+        std::lock_guard<std::mutex> lock(typeMutex);
+
+        for (int t = 0; t < kMaxStatsTypes; t++)
+            sumThreads(t, baseline[t]);
+    }
+
+    InstanceStats::InstanceStats() :
+        calls_(0),
+        nanoseconds_(0),
+        elements_(0),
+        cacheHits_(0),
+        cacheMisses_(0)
+    {
+    }
+
+    void InstanceStats::add(const ComputeCounters &delta)
+    {
+        calls_.fetch_add(delta.calls, std::memory_order_relaxed);
+        nanoseconds_.fetch_add(delta.nanoseconds, std::memory_order_relaxed);
+        elements_.fetch_add(delta.elements, std::memory_order_relaxed);
+        cacheHits_.fetch_add(delta.cacheHits, std::memory_order_relaxed);
+        cacheMisses_.fetch_add(delta.cacheMisses, std::memory_order_relaxed);
+    }
+
+    ComputeCounters InstanceStats::read() const
+    {
+        ComputeCounters result;
+
+        result.calls = calls_.load(std::memory_order_relaxed);
+        result.nanoseconds = nanoseconds_.load(std::memory_order_relaxed);
+        result.elements = elements_.load(std::memory_order_relaxed);
+        result.cacheHits = cacheHits_.load(std::memory_order_relaxed);
+        result.cacheMisses = cacheMisses_.load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+    void InstanceStats::reset()
+    {
+        calls_.store(0, std::memory_order_relaxed);
+        nanoseconds_.store(0, std::memory_order_relaxed);
+        elements_.store(0, std::memory_order_relaxed);
+        cacheHits_.store(0, std::memory_order_relaxed);
+        cacheMisses_.store(0, std::memory_order_relaxed);
+    }
+
+    void ComputeTimer::finish()
+    {
+        delta_.calls = 1;
+        delta_.nanoseconds = (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_).count();
+
+        recordCompute(type_, delta_);
+
+        if (instance_)
+            instance_->add(delta_);
+    }
+
+    std::string statsToCsv(const std::vector<StatsRow> &rows)
+    {
+        std::string result = "type,node,calls,totalMs,averageUs,elements,cacheHits,cacheMisses\n";
+
+        for (size_t i = 0; i < rows.size(); i++)
+        {
+            result += csvField(rows[i].type) + "," + csvField(rows[i].node) + ",";
+            result += counterFields(rows[i].counters, false) + "\n";
+        }
+
+        return result;
+    }
+
+    std::string statsToJson(const std::vector<StatsRow> &rows)
+    {
+        std::string result = "[";
+
+        for (size_t i = 0; i < rows.size(); i++)
+        {
+            result += i ? ",\n  {" : "\n  {";
+            result += "\"type\": " + jsonString(rows[i].type) + ", ";
+            result += "\"node\": " + (rows[i].node.empty() ? std::string("null") : jsonString(rows[i].node)) + ", ";
+            result += counterFields(rows[i].counters, true) + "}";
+        }
+
+        return result + (rows.empty() ? "]\n" : "\n]\n");
+    }
+}
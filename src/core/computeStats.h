@@ -0,0 +1,159 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    computeStats
+    Maya-free compute counters behind the quatExtrasStats command.
+
+    Each node type registers a name once and gets a slot. A ComputeTimer
+    wrapped around a compute adds the call, its wall time, the elements it
+    processed and its cache hits or misses to that slot and, optionally, to
+    an InstanceStats owned by the node.
+
+    Type counters live in a block per thread, written only by the thread
+    that owns it, so evaluation threads never share a cache line or take a
+    lock. Reading the totals sums every block. A reset stores the current
+    totals as a baseline instead of clearing the blocks, which their owners
+    may be writing to at the same time.
+
+    Collection starts disabled, or enabled when the QUATEXTRAS_STATS
+    environment variable is set to a non-zero value. While disabled a
+    ComputeTimer costs one relaxed load and a branch.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_COMPUTE_STATS_H
+#define QUAT_EXTRAS_COMPUTE_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace quatExtras
+{
+    struct ComputeCounters
+    {
+        uint64_t            calls;
+        uint64_t            nanoseconds;
+        uint64_t            elements;
+        uint64_t            cacheHits;
+        uint64_t            cacheMisses;
+
+                            ComputeCounters() : calls(0), nanoseconds(0), elements(0), cacheHits(0), cacheMisses(0) {}
+    };
+
+    // Node types beyond this many are not counted.
+    const int kMaxStatsTypes = 64;
+
+    namespace detail
+    {
+        extern std::atomic<bool> statsEnabled;
+    }
+
+    inline bool statsEnabled() { return detail::statsEnabled.load(std::memory_order_relaxed); }
+    void setStatsEnabled(bool enabled);
+
+    /*
+        Slot for the node type called name, added on first use. Returns -1
+        once kMaxStatsTypes types are registered.
+    */
+    int registerStatsType(const char *name);
+
+    // Adds delta to the calling thread's counters for type.
+    void recordCompute(int type, const ComputeCounters &delta);
+
+    // Every registered type and its counters since the last reset.
+    void statsTypeTotals(std::vector<std::string> &names, std::vector<ComputeCounters> &totals);
+
+    // Zeroes the type counters. Instance counters are reset by their owners.
+    void resetStats();
+
+    /*
+        Counters for one node. Only the thread computing the node writes to
+        them, so the atomic adds are never contended.
+    */
+    class InstanceStats
+    {
+    public:
+                            InstanceStats();
+
+        void                add(const ComputeCounters &delta);
+        ComputeCounters     read() const;
+        void                reset();
+
+    private:
+                            InstanceStats(const InstanceStats&);
+        InstanceStats&      operator=(const InstanceStats&);
+
+        std::atomic<uint64_t> calls_;
+        std::atomic<uint64_t> nanoseconds_;
+        std::atomic<uint64_t> elements_;
+        std::atomic<uint64_t> cacheHits_;
+        std::atomic<uint64_t> cacheMisses_;
+    };
+
+    /*
+        Times its own lifetime and records it, with whatever was reported
+        through the setters, when it goes out of scope. Does nothing if
+        collection was disabled when it was created.
+    */
+    class ComputeTimer
+    {
+        typedef std::chrono::steady_clock Clock;
+
+    public:
+                            ComputeTimer(int type, InstanceStats *instance = NULL) :
+                                active_(statsEnabled()),
+                                type_(type),
+                                instance_(instance)
+                            {
+                                if (active_)
+                                    start_ = Clock::now();
+                            }
+
+                            ~ComputeTimer()
+                            {
+                                if (active_)
+                                    finish();
+                            }
+
+        void                setElements(uint64_t count)     { delta_.elements = count; }
+        void                cacheHit()                      { delta_.cacheHits++; }
+        void                cacheMiss()                     { delta_.cacheMisses++; }
+
+    private:
+                            ComputeTimer(const ComputeTimer&);
+        ComputeTimer&       operator=(const ComputeTimer&);
+
+        void                finish();
+
+        bool                active_;
+        int                 type_;
+        InstanceStats      *instance_;
+        Clock::time_point   start_;
+        ComputeCounters     delta_;
+    };
+
+    /*
+        One line of a stats report. node is empty for a node type total.
+    */
+    struct StatsRow
+    {
+        std::string         type;
+        std::string         node;
+        ComputeCounters     counters;
+    };
+
+    /*
+        The rows as CSV with a header line, or as a JSON array of objects.
+        Both add the average time per call in microseconds.
+    */
+    std::string statsToCsv(const std::vector<StatsRow> &rows);
+    std::string statsToJson(const std::vector<StatsRow> &rows);
+}
+
+#endif
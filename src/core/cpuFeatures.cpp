@@ -0,0 +1,120 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "cpuFeatures.h"
+
+#include <cstring>
+
+#if defined(QUAT_EXTRAS_X86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+namespace quatExtras
+{
+#if defined(QUAT_EXTRAS_X86)
+    namespace
+    {
+        void cpuid(unsigned leaf, unsigned subleaf, unsigned regs[4])
+        {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuidex(info, (int) leaf, (int) subleaf);
+
+            for (int i = 0; i < 4; i++)
+                regs[i] = (unsigned) info[i];
+#else
+            __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+        }
+
+        unsigned long long xgetbv0()
+        {
+#if defined(_MSC_VER)
+            return _xgetbv(0);
+#else
+            unsigned eax, edx;
+            __asm__ __volatile__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return ((unsigned long long) edx << 32) | eax;
+#endif
+        }
+    }
+
+    SimdLevel detectSimdLevel()
+    {
+        unsigned regs[4];
+
+        cpuid(0, 0, regs);
+        unsigned maxLeaf = regs[0];
+
+        cpuid(1, 0, regs);
+
+        bool sse2 = (regs[3] & (1u << 26)) != 0;
+        bool fma = (regs[2] & (1u << 12)) != 0;
+        bool osxsave = (regs[2] & (1u << 27)) != 0;
+        bool avx = (regs[2] & (1u << 28)) != 0;
+
+        if (!sse2)
+            return kSimdScalar;
+
+        if (!osxsave || !avx || maxLeaf < 7)
+            return kSimdSSE2;
+
+        // XMM and YMM state must be enabled by the OS for AVX, plus the
+        // opmask and ZMM state for AVX-512.
+        unsigned long long xcr0 = xgetbv0();
+        bool osAvx = (xcr0 & 0x6) == 0x6;
+        bool osAvx512 = (xcr0 & 0xe6) == 0xe6;
+
+        cpuid(7, 0, regs);
+
+        bool avx2 = (regs[1] & (1u << 5)) != 0;
+        bool avx512f = (regs[1] & (1u << 16)) != 0;
+
+        if (osAvx512 && avx512f && avx2 && fma)
+            return kSimdAVX512;
+
+        if (osAvx && avx2 && fma)
+            return kSimdAVX2;
+
+        return kSimdSSE2;
+    }
+#else
+    SimdLevel detectSimdLevel()
+    {
+        return kSimdScalar;
+    }
+#endif
+
+    const char* simdLevelName(SimdLevel level)
+    {
+        switch (level)
+        {
+            case kSimdSSE2:     return "sse2";
+            case kSimdAVX2:     return "avx2";
+            case kSimdAVX512:   return "avx512";
+            default:            return "scalar";
+        }
+    }
+
+    bool parseSimdLevel(const char* name, SimdLevel &level)
+    {
+        const SimdLevel levels[] = { kSimdScalar, kSimdSSE2, kSimdAVX2, kSimdAVX512 };
+
+        for (int i = 0; i < 4; i++)
+        {
+            if (std::strcmp(name, simdLevelName(levels[i])) == 0)
+            {
+                level = levels[i];
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
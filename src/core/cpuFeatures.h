@@ -0,0 +1,38 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    cpuFeatures
+    Runtime detection of the vector instruction sets the batch kernels can
+    use. The result accounts for operating system support of the wider
+    register files, not just the CPUID feature bits.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_CPU_FEATURES_H
+#define QUAT_EXTRAS_CPU_FEATURES_H
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define QUAT_EXTRAS_X86 1
+#endif
+
+namespace quatExtras
+{
+    // Ordered from narrowest to widest; a level implies the ones below it.
+    enum SimdLevel
+    {
+        kSimdScalar = 0,
+        kSimdSSE2,
+        kSimdAVX2,
+        kSimdAVX512
+    };
+
+    SimdLevel   detectSimdLevel();
+    const char* simdLevelName(SimdLevel level);
+
+    // Parses "scalar", "sse2", "avx2" or "avx512". Returns false otherwise.
+    bool        parseSimdLevel(const char* name, SimdLevel &level);
+}
+
+#endif
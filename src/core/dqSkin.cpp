@@ -0,0 +1,179 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "dqSkin.h"
+#include "quatMath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace quatExtras
+{
+    void matrixToDualQuat(const double m[4][4], double real[4], double dual[4])
+    {
+        const double rotation[3][3] = {
+            { m[0][0], m[0][1], m[0][2] },
+            { m[1][0], m[1][1], m[1][2] },
+            { m[2][0], m[2][1], m[2][2] }
+        };
+
+        matrixToQuat(rotation, real);
+
+        // dual = 0.5 * (t, 0) * real
+        const double *t = m[3];
+
+        dual[0] = 0.5 * (real[3] * t[0] + t[1] * real[2] - t[2] * real[1]);
+        dual[1] = 0.5 * (real[3] * t[1] + t[2] * real[0] - t[0] * real[2]);
+        dual[2] = 0.5 * (real[3] * t[2] + t[0] * real[1] - t[1] * real[0]);
+        dual[3] = -0.5 * (t[0] * real[0] + t[1] * real[1] + t[2] * real[2]);
+    }
+
+    void dqSkinPoint(
+        ConstDualQuatArrayView joints,
+        const int *influence,
+        const double *weight,
+        unsigned count,
+        const double point[3],
+        double out[3]
+    ) {
+        double b[8] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+        for (unsigned k = 0; k < count; k++)
+        {
+            int j = influence[k];
+
+            double dq[8] = {
+                joints.real.x[j], joints.real.y[j], joints.real.z[j], joints.real.w[j],
+                joints.dual.x[j], joints.dual.y[j], joints.dual.z[j], joints.dual.w[j]
+            };
+
+            // Flip onto the hemisphere of the first influence.
+            int pivot = influence[0];
+            double d = dq[0] * joints.real.x[pivot] + dq[1] * joints.real.y[pivot] +
+                       dq[2] * joints.real.z[pivot] + dq[3] * joints.real.w[pivot];
+
+            double w = d < 0.0 ? -weight[k] : weight[k];
+
+            for (int c = 0; c < 8; c++)
+                b[c] += w * dq[c];
+        }
+
+        double length = std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2] + b[3] * b[3]);
+
+        if (length == 0.0)
+        {
+            out[0] = point[0];
+            out[1] = point[1];
+            out[2] = point[2];
+            return;
+        }
+
+        for (int c = 0; c < 8; c++)
+            b[c] /= length;
+
+        const double *r = b;
+        const double *e = b + 4;
+
+        double t[3] = {
+            r[1] * point[2] - r[2] * point[1] + r[3] * point[0],
+            r[2] * point[0] - r[0] * point[2] + r[3] * point[1],
+            r[0] * point[1] - r[1] * point[0] + r[3] * point[2]
+        };
+
+        out[0] = point[0] + 2.0 * (r[1] * t[2] - r[2] * t[1]) + 2.0 * (r[3] * e[0] - e[3] * r[0] + r[1] * e[2] - r[2] * e[1]);
+        out[1] = point[1] + 2.0 * (r[2] * t[0] - r[0] * t[2]) + 2.0 * (r[3] * e[1] - e[3] * r[1] + r[2] * e[0] - r[0] * e[2]);
+        out[2] = point[2] + 2.0 * (r[0] * t[1] - r[1] * t[0]) + 2.0 * (r[3] * e[2] - e[3] * r[2] + r[0] * e[1] - r[1] * e[0]);
+    }
+
+    SkinWeights::SkinWeights() :
+        maxInfluences_(kDefaultMaxInfluences),
+        influenceCount_(0),
+        offset_(1, 0)
+    {
+    }
+
+    void SkinWeights::clear(unsigned maxInfluences)
+    {
+        maxInfluences_ = std::max(maxInfluences, 1u);
+        influenceCount_ = 0;
+
+        offset_.assign(1, 0);
+        influence_.clear();
+        weight_.clear();
+    }
+
+    void SkinWeights::addVertex(size_t vertex, const int *influence, const double *weight, unsigned count)
+    {
+        while (vertexCount() < vertex)
+            offset_.push_back(offset_.back());
+
+        row_.clear();
+
+        for (unsigned k = 0; k < count; k++)
+        {
+            if (weight[k] > 0.0 && influence[k] >= 0)
+                row_.push_back(std::make_pair(weight[k], influence[k]));
+        }
+
+        // Largest weights first; equal weights by influence, so rows do not
+        // depend on the order the weights were read in.
+        size_t kept = std::min<size_t>(row_.size(), maxInfluences_);
+
+        std::partial_sort(row_.begin(), row_.begin() + kept, row_.end(),
+            [](const std::pair<double, int> &a, const std::pair<double, int> &b) {
+                return a.first != b.first ? a.first > b.first : a.second < b.second;
+            }
+        );
+
+        double sum = 0.0;
+
+        for (size_t k = 0; k < kept; k++)
+            sum += row_[k].first;
+
+        for (size_t k = 0; k < kept; k++)
+        {
+            influence_.push_back(row_[k].second);
+            weight_.push_back(row_[k].first / sum);
+
+            influenceCount_ = std::max(influenceCount_, row_[k].second + 1);
+        }
+
+        offset_.push_back((unsigned) influence_.size());
+    }
+
+    ConstSkinWeightsView SkinWeights::view(size_t first) const
+    {
+        ConstSkinWeightsView result = { offset_.data() + first, influence_.data(), weight_.data() };
+        return result;
+    }
+
+    void DualQuatArray::resize(size_t count)
+    {
+        size_t previous = dual_.size();
+
+        real_.resize(count);
+        dual_.resize(count);
+
+        for (size_t i = previous; i < count; i++)
+            dual_.set(i, 0.0, 0.0, 0.0, 0.0);
+    }
+
+    void DualQuatArray::set(size_t i, const double m[4][4])
+    {
+        double real[4];
+        double dual[4];
+
+        matrixToDualQuat(m, real, dual);
+
+        real_.set(i, real[0], real[1], real[2], real[3]);
+        dual_.set(i, dual[0], dual[1], dual[2], dual[3]);
+    }
+
+    ConstDualQuatArrayView DualQuatArray::view() const
+    {
+        ConstDualQuatArrayView result = { real_.view(), dual_.view() };
+        return result;
+    }
+}
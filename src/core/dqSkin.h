@@ -0,0 +1,117 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    dqSkin
+    Maya-free data for dual quaternion skinning (L. Kavan et al.,
+    "Geometric Skinning with Approximate Dual Quaternion Blending", 2008).
+    The blend itself is dqSkinBatch in quatBatch.h.
+
+    SkinWeights keeps each vertex's largest influences in compressed sparse
+    row layout: one offset per vertex into flat influence and weight
+    arrays. Only the kept weights are stored, so a dense mesh costs
+    maxInfluences entries per vertex however many joints the rig has.
+
+    DualQuatArray holds one unit dual quaternion per joint, built from the
+    joint's skinning matrix (bindPreMatrix * matrix in Maya's row-vector
+    layout). Dual quaternions carry rotation and translation only; scale
+    and shear in the matrix are dropped, as with skinCluster's dual
+    quaternion method without scale.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_DQ_SKIN_H
+#define QUAT_EXTRAS_DQ_SKIN_H
+
+#include "quatBatch.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace quatExtras
+{
+    /*
+        Rotation and translation of the 4x4 row-vector matrix m (translation
+        in the last row) as a unit dual quaternion, real in the w >= 0
+        hemisphere.
+    */
+    void matrixToDualQuat(const double m[4][4], double real[4], double dual[4]);
+
+    /*
+        One vertex, the reference for dqSkinBatch: point moved by the
+        influences' blended dual quaternion. Copies point when count is zero
+        or every weight is.
+    */
+    void dqSkinPoint(
+        ConstDualQuatArrayView joints,
+        const int *influence,
+        const double *weight,
+        unsigned count,
+        const double point[3],
+        double out[3]
+    );
+
+    class SkinWeights
+    {
+    public:
+        static const unsigned   kDefaultMaxInfluences = 4;
+
+                                SkinWeights();
+
+        // Removes every vertex and sets the influences kept per vertex.
+        void                    clear(unsigned maxInfluences);
+
+        /*
+            Adds the row of vertex, which must be past every vertex added
+            since clear; vertices skipped in between get no influences.
+            Keeps the maxInfluences largest positive weights, normalized to
+            sum to one.
+        */
+        void                    addVertex(size_t vertex, const int *influence, const double *weight, unsigned count);
+
+        // Vertices with a row, including skipped ones.
+        size_t                  vertexCount() const { return offset_.size() - 1; }
+        unsigned                maxInfluences() const { return maxInfluences_; }
+
+        // One past the highest influence index used.
+        int                     influenceCount() const { return influenceCount_; }
+
+        // Rows from vertex first on.
+        ConstSkinWeightsView    view(size_t first = 0) const;
+
+    private:
+        unsigned                maxInfluences_;
+        int                     influenceCount_;
+
+        std::vector<unsigned>   offset_;
+        std::vector<int>        influence_;
+        std::vector<double>     weight_;
+
+        // Scratch for addVertex.
+        std::vector<std::pair<double, int> > row_;
+    };
+
+    /*
+        Owning array of joint dual quaternions. Elements added by resize
+        are the identity.
+    */
+    class DualQuatArray
+    {
+    public:
+        size_t                  size() const { return real_.size(); }
+        void                    resize(size_t count);
+
+        // Element i from a skinning matrix; see matrixToDualQuat.
+        void                    set(size_t i, const double m[4][4]);
+
+        ConstDualQuatArrayView  view() const;
+
+    private:
+        QuatArray               real_;
+        QuatArray               dual_;
+    };
+}
+
+#endif
@@ -0,0 +1,147 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "mappedFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace quatExtras
+{
+#ifdef _WIN32
+    MappedFile::MappedFile() : data_(NULL), size_(0), file_(INVALID_HANDLE_VALUE), mapping_(NULL)
+    {
+    }
+#else
+    MappedFile::MappedFile() : data_(NULL), size_(0)
+    {
+    }
+#endif
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+#ifdef _WIN32
+    bool MappedFile::open(const std::string &path, std::string *error)
+    {
+        close();
+
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+
+        if (file_ == INVALID_HANDLE_VALUE)
+        {
+            if (error)
+                *error = "cannot open " + path;
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+
+        if (!GetFileSizeEx(file_, &fileSize) || fileSize.QuadPart == 0)
+        {
+            if (error)
+                *error = path + " is empty";
+            close();
+            return false;
+        }
+
+        mapping_ = CreateFileMappingA(file_, NULL, PAGE_READONLY, 0, 0, NULL);
+        data_ = mapping_ ? (const unsigned char*) MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : NULL;
+
+        if (!data_)
+        {
+            if (error)
+                *error = "cannot map " + path;
+            close();
+            return false;
+        }
+
+        size_ = (size_t) fileSize.QuadPart;
+
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (data_)
+            UnmapViewOfFile(data_);
+
+        if (mapping_)
+            CloseHandle(mapping_);
+
+        if (file_ != INVALID_HANDLE_VALUE)
+            CloseHandle(file_);
+
+        data_ = NULL;
+        size_ = 0;
+        mapping_ = NULL;
+        file_ = INVALID_HANDLE_VALUE;
+    }
+#else
+    bool MappedFile::open(const std::string &path, std::string *error)
+    {
+        close();
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+
+        if (fd < 0)
+        {
+            if (error)
+                *error = "cannot open " + path + ": " + std::strerror(errno);
+            return false;
+        }
+
+        struct stat info;
+
+        if (fstat(fd, &info) != 0 || info.st_size == 0)
+        {
+            if (error)
+                *error = path + " is empty";
+            ::close(fd);
+            return false;
+        }
+
+        void *mapped = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+        // The mapping keeps the file alive.
+        ::close(fd);
+
+        if (mapped == MAP_FAILED)
+        {
+            if (error)
+                *error = "cannot map " + path + ": " + std::strerror(errno);
+            return false;
+        }
+
+        data_ = (const unsigned char*) mapped;
+        size_ = (size_t) info.st_size;
+
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (data_)
+            munmap((void*) data_, size_);
+
+        data_ = NULL;
+        size_ = 0;
+    }
+#endif
+}
@@ -0,0 +1,50 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    mappedFile
+    Read-only memory map of a whole file. Opening only reserves address
+    space; pages are read from disk the first time they are touched, so
+    opening a file of any size costs the same.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_MAPPED_FILE_H
+#define QUAT_EXTRAS_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace quatExtras
+{
+    class MappedFile
+    {
+    public:
+                                MappedFile();
+                                ~MappedFile();
+
+        // Maps path, closing any file mapped before. On failure the
+        // reason is put in error.
+        bool                    open(const std::string &path, std::string *error = NULL);
+        void                    close();
+
+        bool                    isOpen() const  { return data_ != NULL; }
+        const unsigned char*    data() const    { return data_; }
+        size_t                  size() const    { return size_; }
+
+    private:
+                                MappedFile(const MappedFile&);
+        MappedFile&             operator=(const MappedFile&);
+
+        const unsigned char     *data_;
+        size_t                  size_;
+
+#ifdef _WIN32
+        void                    *file_;
+        void                    *mapping_;
+#endif
+    };
+}
+
+#endif
@@ -0,0 +1,260 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "poseIndex.h"
+#include "quatBatch.h"
+#include "quatMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace quatExtras
+{
+    namespace
+    {
+        // min(|p - q|, |p + q|), the distance between the rotations p and q.
+        inline double chordalDistance(const double p[4], const double q[4])
+        {
+            double minus = 0.0;
+            double plus = 0.0;
+
+            for (int i = 0; i < 4; i++)
+            {
+                minus += (p[i] - q[i]) * (p[i] - q[i]);
+                plus += (p[i] + q[i]) * (p[i] + q[i]);
+            }
+
+            return std::sqrt(std::min(minus, plus));
+        }
+
+        // Angle of the rotation between two unit quaternions a chordal
+        // distance d apart.
+        inline double chordalAngle(double d)
+        {
+            return 4.0 * std::asin(std::min(0.5 * d, 1.0));
+        }
+
+        // q scaled to unit length; zero is the identity.
+        inline void normalized(double x, double y, double z, double w, double out[4])
+        {
+            double length = std::sqrt(x * x + y * y + z * z + w * w);
+
+            if (length == 0.0)
+            {
+                out[0] = 0.0;
+                out[1] = 0.0;
+                out[2] = 0.0;
+                out[3] = 1.0;
+                return;
+            }
+
+            double k = 1.0 / length;
+
+            out[0] = x * k;
+            out[1] = y * k;
+            out[2] = z * k;
+            out[3] = w * k;
+        }
+
+        // First pose of the outside half of a range with its vantage pose
+        // at begin.
+        inline size_t splitPoint(size_t begin, size_t end)
+        {
+            return begin + 1 + (end - begin - 1) / 2;
+        }
+    }
+
+    /*
+        The k best poses found so far, nearest first, kept in the caller's
+        buffers by insertion; k is small, so this beats a heap.
+    */
+    struct PoseIndex::Search
+    {
+        double              q[4];
+        size_t              k;
+        size_t              found;
+        unsigned           *id;
+        double             *distance;
+        size_t              distanceCount;
+
+        // Distance a pose must beat to be kept.
+        double tau() const
+        {
+            return found < k ? std::numeric_limits<double>::infinity() : distance[found - 1];
+        }
+
+        double offer(const Pose &pose)
+        {
+            double d = chordalDistance(q, pose.q);
+            distanceCount++;
+
+            if (d >= tau())
+                return d;
+
+            size_t i = found < k ? found++ : k - 1;
+
+            for (; i > 0 && distance[i - 1] > d; i--)
+            {
+                distance[i] = distance[i - 1];
+                id[i] = id[i - 1];
+            }
+
+            distance[i] = d;
+            id[i] = pose.id;
+
+            return d;
+        }
+    };
+
+    PoseIndex::PoseIndex() :
+        lastDistanceCount_(0)
+    {
+    }
+
+    void PoseIndex::build(ConstQuatArrayView poses, const unsigned *id, size_t count)
+    {
+        poses_.resize(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            Pose &pose = poses_[i];
+
+            normalized(poses.x[i], poses.y[i], poses.z[i], poses.w[i], pose.q);
+            canonicalHemisphere(pose.q, pose.q);
+
+            pose.radius = 0.0;
+            pose.id = id != nullptr ? id[i] : (unsigned) i;
+        }
+
+        buildRange(0, count);
+    }
+
+    void PoseIndex::buildRange(size_t begin, size_t end)
+    {
+        if (end - begin <= kLeafSize)
+            return;
+
+        // The pose furthest from the first makes a vantage pose near the
+        // edge of the range, which splits it more evenly than one from
+        // the middle.
+        size_t vantage = begin;
+        double furthest = -1.0;
+
+        for (size_t i = begin; i < end; i++)
+        {
+            double d = chordalDistance(poses_[begin].q, poses_[i].q);
+
+            if (d > furthest)
+            {
+                furthest = d;
+                vantage = i;
+            }
+        }
+
+        std::swap(poses_[begin], poses_[vantage]);
+
+        // Radius holds each pose's distance from the vantage pose until
+        // the pose is itself a vantage pose below.
+        for (size_t i = begin + 1; i < end; i++)
+            poses_[i].radius = chordalDistance(poses_[begin].q, poses_[i].q);
+
+        size_t split = splitPoint(begin, end);
+
+        std::nth_element(
+            poses_.begin() + (begin + 1),
+            poses_.begin() + split,
+            poses_.begin() + end,
+            [](const Pose &a, const Pose &b) { return a.radius < b.radius; }
+        );
+
+        poses_[begin].radius = poses_[split].radius;
+
+        buildRange(begin + 1, split);
+        buildRange(split, end);
+    }
+
+    size_t PoseIndex::nearest(const double q[4], size_t k, unsigned *id, double *angle) const
+    {
+        Search search;
+
+        normalized(q[0], q[1], q[2], q[3], search.q);
+        search.k = std::min(k, poses_.size());
+        search.found = 0;
+        search.id = id;
+        search.distance = angle;
+        search.distanceCount = 0;
+
+        if (search.k != 0)
+            searchRange(search, 0, poses_.size());
+
+        for (size_t i = 0; i < search.found; i++)
+            angle[i] = chordalAngle(angle[i]);
+
+        lastDistanceCount_ = search.distanceCount;
+
+        return search.found;
+    }
+
+    /*
+        Poses inside the vantage pose's radius are at least d - radius from
+        q, and those outside at least radius - d, so either half is skipped
+        once that exceeds the k-th best distance. The half q falls in is
+        searched first, as it is the likelier to tighten that bound.
+    */
+    void PoseIndex::searchRange(Search &search, size_t begin, size_t end) const
+    {
+        if (end - begin <= kLeafSize)
+        {
+            for (size_t i = begin; i < end; i++)
+                search.offer(poses_[i]);
+
+            return;
+        }
+
+        const Pose &vantage = poses_[begin];
+
+        double d = search.offer(vantage);
+        double radius = vantage.radius;
+        size_t split = splitPoint(begin, end);
+
+        if (d < radius)
+        {
+            searchRange(search, begin + 1, split);
+
+            if (d + search.tau() >= radius)
+                searchRange(search, split, end);
+        } else {
+            searchRange(search, split, end);
+
+            if (d - search.tau() <= radius)
+                searchRange(search, begin + 1, split);
+        }
+    }
+
+    void poseWeights(const double *angle, size_t count, double radius, PoseKernel kernel, bool normalize, double *weight)
+    {
+        double invRadius = 1.0 / std::max(radius, 1.0e-12);
+        double sum = 0.0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            double x = angle[i] * invRadius;
+
+            weight[i] = kernel == kPoseCone ? std::max(1.0 - x, 0.0) : std::exp(-x * x);
+            sum += weight[i];
+        }
+
+        if (normalize && sum > 0.0)
+        {
+            double k = 1.0 / sum;
+
+            for (size_t i = 0; i < count; i++)
+                weight[i] *= k;
+        }
+    }
+}
@@ -0,0 +1,107 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    poseIndex
+    Maya-free nearest neighbour search over a library of rotations, for
+    pose-space readers that compare one rotation against thousands of
+    sculpted poses.
+
+    Poses are normalized and stored on one hemisphere (canonicalHemisphere)
+    in a vantage-point tree. The metric is the chordal distance between
+    rotations,
+
+        d(p, q) = min(|p - q|, |p + q|) = 2 sin(angle / 4)
+
+    where angle is the rotation between them. It is a true metric, so the
+    tree can discard a whole subtree by the triangle inequality, and it is
+    monotonic in the angle, so it ranks poses the same way while needing no
+    acos. Each tree node splits its poses at the median distance from a
+    vantage pose; ranges of kLeafSize poses or fewer are scanned.
+
+    Building is O(n log n). Queries grow with log n and with k: over
+    uniformly random poses and queries, k = 4 evaluates the distance to
+    about 80 poses of 100, 140 of 1000, 120 of 10,000 and 110 of 100,000.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_POSE_INDEX_H
+#define QUAT_EXTRAS_POSE_INDEX_H
+
+#include "quatBatch.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace quatExtras
+{
+    /*
+        How poseWeights maps the angle to a pose onto its weight, with r
+        the radius:
+
+            kPoseGaussian   exp(-(angle / r)^2)
+            kPoseCone       max(1 - angle / r, 0)
+    */
+    enum PoseKernel
+    {
+        kPoseGaussian = 0,
+        kPoseCone     = 1
+    };
+
+    class PoseIndex
+    {
+    public:
+        // Ranges of at most this many poses are leaves, scanned in full.
+        static const size_t kLeafSize = 8;
+
+                            PoseIndex();
+
+        /*
+            Replaces the poses. id[i] is returned for pose i by nearest;
+            a null id uses i. Zero length poses are the identity.
+        */
+        void                build(ConstQuatArrayView poses, const unsigned *id, size_t count);
+
+        size_t              size() const { return poses_.size(); }
+
+        /*
+            The min(k, size()) poses closest to q, nearest first: their ids
+            and the angles, in radians in [0, pi], of the rotations from q
+            to them. Returns the number found. id and angle hold at least
+            k elements. q need not be normalized.
+        */
+        size_t              nearest(const double q[4], size_t k, unsigned *id, double *angle) const;
+
+        // Distances evaluated by the last call to nearest.
+        size_t              lastDistanceCount() const { return lastDistanceCount_; }
+
+    private:
+        struct Pose
+        {
+            double          q[4];
+            double          radius;
+            unsigned        id;
+        };
+
+        struct Search;
+
+        void                buildRange(size_t begin, size_t end);
+        void                searchRange(Search &search, size_t begin, size_t end) const;
+
+        // In tree order: each range starts with its vantage pose, whose
+        // radius is the median distance splitting the rest of the range
+        // into the poses inside it and those outside.
+        std::vector<Pose>   poses_;
+
+        mutable size_t      lastDistanceCount_;
+    };
+
+    /*
+        Weights of poses at the given angles (see PoseKernel). With
+        normalize, they are scaled to sum to one unless they are all zero.
+    */
+    void poseWeights(const double *angle, size_t count, double radius, PoseKernel kernel, bool normalize, double *weight);
+}
+
+#endif
@@ -0,0 +1,298 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "quatAverage.h"
+#include "quatBatch.h"
+#include "quatMath.h"
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace quatExtras
+{
+    namespace
+    {
+        // Index into the packed upper triangle for row r, column c.
+        const int kPacked[4][4] = {
+            { 0, 1, 2, 3 },
+            { 1, 4, 5, 6 },
+            { 2, 5, 7, 8 },
+            { 3, 6, 8, 9 }
+        };
+
+        const double kTolerance = 1.0e-13;
+
+        // The power iteration runs on M^(2^kSquarings), which has the same
+        // eigenvectors and raises the eigenvalue ratio that sets its
+        // convergence rate to the same power.
+        const int kSquarings = 4;
+
+        void unpack(const double m[10], double out[4][4])
+        {
+            for (int r = 0; r < 4; r++)
+            {
+                for (int c = 0; c < 4; c++)
+                    out[r][c] = m[kPacked[r][c]];
+            }
+        }
+
+        /*
+            a = a * a / trace(a * a), keeping the entries near one.
+        */
+        void squareNormalized(double a[4][4])
+        {
+            double result[4][4];
+            double trace = 0.0;
+
+            for (int r = 0; r < 4; r++)
+            {
+                for (int c = 0; c < 4; c++)
+                {
+                    result[r][c] = a[r][0] * a[0][c] + a[r][1] * a[1][c] + a[r][2] * a[2][c] + a[r][3] * a[3][c];
+                }
+
+                trace += result[r][r];
+            }
+
+            double k = trace > 0.0 ? 1.0 / trace : 1.0;
+
+            for (int r = 0; r < 4; r++)
+            {
+                for (int c = 0; c < 4; c++)
+                    a[r][c] = result[r][c] * k;
+            }
+        }
+
+        void multiply(const double a[4][4], const double v[4], double out[4])
+        {
+            for (int r = 0; r < 4; r++)
+                out[r] = a[r][0] * v[0] + a[r][1] * v[1] + a[r][2] * v[2] + a[r][3] * v[3];
+        }
+
+        void addOuterProduct(const double q[4], double weight, double m[10])
+        {
+            for (int r = 0; r < 4; r++)
+            {
+                for (int c = r; c < 4; c++)
+                    m[kPacked[r][c]] += weight * q[r] * q[c];
+            }
+        }
+
+        /*
+            Column of m with the largest diagonal entry. Never orthogonal to
+            the dominant eigenvector of a non-zero positive semi-definite m.
+        */
+        void largestColumn(const double m[10], double v[4])
+        {
+            int best = 0;
+
+            for (int c = 1; c < 4; c++)
+            {
+                if (m[kPacked[c][c]] > m[kPacked[best][best]])
+                    best = c;
+            }
+
+            for (int r = 0; r < 4; r++)
+                v[r] = m[kPacked[r][best]];
+        }
+    }
+
+    int dominantEigenvector(const double m[10], double v[4], int maxIterations, double tolerance)
+    {
+        double length = std::sqrt(dot(v, v));
+
+        if (length == 0.0)
+        {
+            largestColumn(m, v);
+            length = std::sqrt(dot(v, v));
+
+            if (length == 0.0)
+            {
+                v[0] = v[1] = v[2] = 0.0;
+                v[3] = 1.0;
+                return 0;
+            }
+        }
+
+        double start[4];
+
+        for (int k = 0; k < 4; k++)
+        {
+            v[k] /= length;
+            start[k] = v[k];
+        }
+
+        double power[4][4];
+        unpack(m, power);
+
+        for (int k = 0; k < kSquarings; k++)
+            squareNormalized(power);
+
+        int iteration = 0;
+
+        while (iteration < maxIterations)
+        {
+            double next[4];
+            multiply(power, v, next);
+            iteration++;
+
+            double nextLength = std::sqrt(dot(next, next));
+
+            // v is orthogonal to every non-zero eigenvector; restart from a
+            // column of m, which is not.
+            if (nextLength == 0.0)
+            {
+                largestColumn(m, next);
+                nextLength = std::sqrt(dot(next, next));
+
+                if (nextLength == 0.0)
+                    break;
+            }
+
+            double step = 0.0;
+
+            for (int k = 0; k < 4; k++)
+            {
+                next[k] /= nextLength;
+                step += (next[k] - v[k]) * (next[k] - v[k]);
+                v[k] = next[k];
+            }
+
+            if (step < tolerance * tolerance)
+                break;
+        }
+
+        if (dot(v, start) < 0.0)
+        {
+            for (int k = 0; k < 4; k++)
+                v[k] = -v[k];
+        }
+
+        return iteration;
+    }
+
+    QuatAverage::QuatAverage() :
+        hasPrevious_(false),
+        incrementalUpdates_(0),
+        lastUpdateIncremental_(false),
+        lastChangedCount_(0),
+        lastIterations_(0)
+    {
+        for (int k = 0; k < 10; k++)
+            m_[k] = 0.0;
+
+        previous_[0] = previous_[1] = previous_[2] = 0.0;
+        previous_[3] = 1.0;
+    }
+
+    void QuatAverage::rebuild(ConstQuatArrayView q, const double *weight, size_t count)
+    {
+        quats_.resize(count);
+        weights_.resize(count);
+
+        QuatArrayView quats = quats_.view();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            quats.x[i] = q.x[i];
+            quats.y[i] = q.y[i];
+            quats.z[i] = q.z[i];
+            quats.w[i] = q.w[i];
+            weights_[i] = weight[i];
+        }
+
+        for (int k = 0; k < 10; k++)
+            m_[k] = 0.0;
+
+        outerProductBatch(q, weight, count, m_);
+
+        incrementalUpdates_ = 0;
+        lastUpdateIncremental_ = false;
+        lastChangedCount_ = count;
+    }
+
+    void QuatAverage::update(ConstQuatArrayView q, const double *weight, size_t count)
+    {
+        if (count != weights_.size() || incrementalUpdates_ >= kMaxIncrementalUpdates)
+        {
+            rebuild(q, weight, count);
+            return;
+        }
+
+        QuatArrayView quats = quats_.view();
+
+        std::vector<size_t> changed;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (q.x[i] != quats.x[i] || q.y[i] != quats.y[i] || q.z[i] != quats.z[i] ||
+                q.w[i] != quats.w[i] || weight[i] != weights_[i])
+            {
+                changed.push_back(i);
+
+                if (changed.size() * kIncrementalFraction > count)
+                {
+                    rebuild(q, weight, count);
+                    return;
+                }
+            }
+        }
+
+        for (size_t j = 0; j < changed.size(); j++)
+        {
+            size_t i = changed[j];
+
+            double before[4] = { quats.x[i], quats.y[i], quats.z[i], quats.w[i] };
+            double after[4] = { q.x[i], q.y[i], q.z[i], q.w[i] };
+
+            addOuterProduct(before, -weights_[i], m_);
+            addOuterProduct(after, weight[i], m_);
+
+            quats.x[i] = after[0];
+            quats.y[i] = after[1];
+            quats.z[i] = after[2];
+            quats.w[i] = after[3];
+            weights_[i] = weight[i];
+        }
+
+        if (!changed.empty())
+            incrementalUpdates_++;
+
+        lastUpdateIncremental_ = true;
+        lastChangedCount_ = changed.size();
+    }
+
+    void QuatAverage::solve(double out[4])
+    {
+        if (m_[0] + m_[4] + m_[7] + m_[9] <= 0.0)
+        {
+            out[0] = out[1] = out[2] = 0.0;
+            out[3] = 1.0;
+
+            hasPrevious_ = false;
+            lastIterations_ = 0;
+            return;
+        }
+
+        double v[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+        if (hasPrevious_)
+        {
+            for (int k = 0; k < 4; k++)
+                v[k] = previous_[k];
+        }
+
+        lastIterations_ = dominantEigenvector(m_, v, kMaxIterations, kTolerance);
+
+        for (int k = 0; k < 4; k++)
+        {
+            previous_[k] = v[k];
+            out[k] = v[k];
+        }
+
+        hasPrevious_ = true;
+    }
+}
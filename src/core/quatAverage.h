@@ -0,0 +1,93 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatAverage
+    Maya-free weighted average of many quaternions (F. L. Markley et al.,
+    "Averaging Quaternions", 2007). The average is the dominant eigenvector
+    of
+
+        M = sum of weight[i] * q[i] q[i]^T
+
+    which, unlike chained slerps, does not depend on the order of the
+    inputs or on their signs. Weights should not be negative.
+
+    QuatAverage keeps M and the previous result between updates. When only
+    a few inputs changed, M is corrected by their old and new outer
+    products instead of being accumulated again, and the power iteration
+    starts from the previous average, which usually converges in a handful
+    of steps. Every kMaxIncrementalUpdates corrections M is rebuilt from
+    scratch so rounding errors cannot build up.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_QUAT_AVERAGE_H
+#define QUAT_EXTRAS_QUAT_AVERAGE_H
+
+#include "quatBatch.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace quatExtras
+{
+    /*
+        Dominant eigenvector of the symmetric positive semi-definite 4x4
+        matrix m (stored as in outerProductBatch) by power iteration on
+        m^16, starting from v and stopping once a step moves v by less than
+        tolerance. A zero v starts from the largest column of m. Returns the
+        number of iterations used. v is returned unit length, on the same
+        hemisphere as the starting vector.
+    */
+    int dominantEigenvector(const double m[10], double v[4], int maxIterations, double tolerance);
+
+    class QuatAverage
+    {
+    public:
+        // Rebuild M from scratch after this many incremental corrections.
+        static const int    kMaxIncrementalUpdates = 64;
+
+        // Apply corrections only when at most 1 / kIncrementalFraction of
+        // the inputs changed; otherwise accumulate again.
+        static const size_t kIncrementalFraction = 4;
+
+        static const int    kMaxIterations = 100;
+
+                            QuatAverage();
+
+        /*
+            Replaces the inputs. Quaternions need not be normalized; they
+            are weighted by their squared length.
+        */
+        void                update(ConstQuatArrayView q, const double *weight, size_t count);
+
+        /*
+            Average of the current inputs, continuing from the previous
+            result. The identity if every weight is zero.
+        */
+        void                solve(double out[4]);
+
+        // Diagnostics for the last update and solve.
+        bool                lastUpdateIncremental() const { return lastUpdateIncremental_; }
+        size_t              lastChangedCount() const { return lastChangedCount_; }
+        int                 lastIterations() const { return lastIterations_; }
+
+    private:
+        void                rebuild(ConstQuatArrayView q, const double *weight, size_t count);
+
+        QuatArray           quats_;
+        std::vector<double> weights_;
+        double              m_[10];
+
+        double              previous_[4];
+        bool                hasPrevious_;
+
+        int                 incrementalUpdates_;
+        bool                lastUpdateIncremental_;
+        size_t              lastChangedCount_;
+        int                 lastIterations_;
+    };
+}
+
+#endif
@@ -0,0 +1,453 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "quatBatch.h"
+#include "quatBatchKernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace quatExtras
+{
+    namespace
+    {
+        /*
+            Widest kernel set at or below level that was compiled in.
+        */
+        const BatchKernels* kernelsFor(SimdLevel level)
+        {
+            const BatchKernels* kernels = 0;
+
+            if (!kernels && level >= kSimdAVX512)
+                kernels = avx512BatchKernels();
+
+            if (!kernels && level >= kSimdAVX2)
+                kernels = avx2BatchKernels();
+
+            if (!kernels && level >= kSimdSSE2)
+                kernels = sse2BatchKernels();
+
+            if (!kernels)
+                kernels = scalarBatchKernels();
+
+            return kernels;
+        }
+
+        SimdLevel defaultSimdLevel()
+        {
+            SimdLevel level = detectSimdLevel();
+            SimdLevel requested;
+
+            const char* env = std::getenv("QUATEXTRAS_SIMD");
+
+            if (env && parseSimdLevel(env, requested) && requested < level)
+                level = requested;
+
+            return level;
+        }
+
+        std::atomic<const BatchKernels*> activeKernels(0);
+
+        // Below this many elements the wide kernels spend longer staging the
+        // partial register than computing, so the scalar set is used.
+        const size_t kMinVectorCount = 4;
+
+        const BatchKernels& kernels()
+        {
+            const BatchKernels* result = activeKernels.load(std::memory_order_acquire);
+
+            if (!result)
+            {
+                result = kernelsFor(defaultSimdLevel());
+                activeKernels.store(result, std::memory_order_release);
+            }
+
+            return *result;
+        }
+
+        const BatchKernels& kernels(size_t count)
+        {
+            return count < kMinVectorCount ? *scalarBatchKernels() : kernels();
+        }
+
+        Precision precisionFromEnvironment()
+        {
+            const char* env = std::getenv("QUATEXTRAS_PRECISION");
+
+            return env && std::strcmp(env, "float") == 0 ? kPrecisionFloat : kPrecisionDouble;
+        }
+
+        std::atomic<int> activePrecision(-1);
+
+        MathBackend mathBackendFromEnvironment()
+        {
+            MathBackend backend = kMathPolynomial;
+
+            const char* env = std::getenv("QUATEXTRAS_MATH");
+
+            if (env)
+                parseMathBackend(env, backend);
+
+            return backend;
+        }
+
+        std::atomic<int> activeMathBackend(-1);
+
+        /*
+            std::sin and friends are evaluated in double for both
+            precisions, then rounded once.
+        */
+        MathTables buildMathTables()
+        {
+            MathTables tables;
+
+            for (int k = 0; k <= MathTables::kSinCosSteps; k++)
+            {
+                double x = k * (kPi / 4.0) / MathTables::kSinCosSteps;
+
+                tables.sin[k] = std::sin(x);
+                tables.cos[k] = std::cos(x);
+                tables.sinF[k] = (float) tables.sin[k];
+                tables.cosF[k] = (float) tables.cos[k];
+            }
+
+            for (int k = 0; k <= MathTables::kAtanSteps; k++)
+            {
+                tables.atan[k] = std::atan((double) k / MathTables::kAtanSteps);
+                tables.atanF[k] = (float) tables.atan[k];
+            }
+
+            return tables;
+        }
+    }
+
+    const MathTables& mathTables()
+    {
+        static const MathTables tables = buildMathTables();
+        return tables;
+    }
+
+    SimdLevel batchSimdLevel()
+    {
+        return kernels().level;
+    }
+
+    SimdLevel setBatchSimdLevel(SimdLevel level)
+    {
+        SimdLevel supported = detectSimdLevel();
+
+        const BatchKernels* result = kernelsFor(level < supported ? level : supported);
+        activeKernels.store(result, std::memory_order_release);
+
+        return result->level;
+    }
+
+    Precision defaultPrecision()
+    {
+        int result = activePrecision.load(std::memory_order_relaxed);
+
+        if (result < 0)
+        {
+            result = precisionFromEnvironment();
+            activePrecision.store(result, std::memory_order_relaxed);
+        }
+
+        return Precision(result);
+    }
+
+    void setDefaultPrecision(Precision precision)
+    {
+        activePrecision.store(precision, std::memory_order_relaxed);
+    }
+
+    MathBackend defaultMathBackend()
+    {
+        int result = activeMathBackend.load(std::memory_order_relaxed);
+
+        if (result < 0)
+        {
+            result = mathBackendFromEnvironment();
+            activeMathBackend.store(result, std::memory_order_relaxed);
+        }
+
+        return MathBackend(result);
+    }
+
+    void setDefaultMathBackend(MathBackend backend)
+    {
+        activeMathBackend.store(backend, std::memory_order_relaxed);
+    }
+
+    const char* mathBackendName(MathBackend backend)
+    {
+        switch (backend)
+        {
+            case kMathLibm:         return "libm";
+            case kMathPolynomial:   return "polynomial";
+            case kMathTable:        return "table";
+        }
+
+        return "unknown";
+    }
+
+    bool parseMathBackend(const char* name, MathBackend &backend)
+    {
+        const MathBackend backends[] = { kMathLibm, kMathPolynomial, kMathTable };
+
+        for (size_t i = 0; i < sizeof(backends) / sizeof(backends[0]); i++)
+        {
+            if (std::strcmp(name, mathBackendName(backends[i])) == 0)
+            {
+                backend = backends[i];
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void sinCosBatch(const double *x, double *s, double *c, size_t count)
+    {
+        kernels(count).sinCos(x, s, c, count, defaultMathBackend());
+    }
+
+    void atan2Batch(const double *y, const double *x, double *out, size_t count)
+    {
+        kernels(count).atan2(y, x, out, count, defaultMathBackend());
+    }
+
+    /*
+        theta comes from atan2 of sin and cos theta, as in the slerp kernel,
+        rather than the acos of slerpSetup in quatMath.h.
+    */
+    SlerpSetup slerpSetup(const double p[4], const double q[4], short spin, MathBackend backend)
+    {
+        SlerpSetup setup;
+
+        double cosTheta = dot(p, q);
+
+        setup.sign = cosTheta < 0.0 ? -1.0 : 1.0;
+        cosTheta = std::fabs(cosTheta);
+
+        setup.cosTheta = cosTheta;
+        setup.spin = spin;
+        setup.linear = (1.0 - cosTheta) <= kSlerpEpsilon;
+
+        if (setup.linear)
+        {
+            setup.theta = 0.0;
+            setup.sinTheta = 0.0;
+            setup.invSinTheta = 0.0;
+            setup.phi = 0.0;
+        } else {
+            setup.sinTheta = std::sqrt(std::max((1.0 - cosTheta) * (1.0 + cosTheta), 0.0));
+            scalarBatchKernels()->atan2(&setup.sinTheta, &cosTheta, &setup.theta, 1, backend);
+            setup.invSinTheta = 1.0 / setup.sinTheta;
+            setup.phi = setup.theta + spin * kPi;
+        }
+
+        return setup;
+    }
+
+    void slerpWeights(const SlerpSetup &setup, double t, SlerpMode mode, MathBackend backend, double &a, double &b)
+    {
+        if (setup.linear || (mode != kSlerpExact && setup.spin == 0))
+        {
+            slerpWeights(setup, t, mode, a, b);
+            return;
+        }
+
+        double tPhi = t * setup.phi;
+        double sinTPhi, cosTPhi;
+
+        scalarBatchKernels()->sinCos(&tPhi, &sinTPhi, &cosTPhi, 1, backend);
+
+        b = sinTPhi * setup.invSinTheta;
+        a = cosTPhi - setup.cosTheta * b;
+        b *= setup.sign;
+    }
+
+    void slerpBatch(
+        ConstQuatArrayView p,
+        ConstQuatArrayView q,
+        const double *tween,
+        const short *spin,
+        QuatArrayView out,
+        size_t count,
+        SlerpMode mode
+    ) {
+        kernels(count).slerp(p, q, tween, spin, out, count, mode, defaultMathBackend());
+    }
+
+    void axisAngleToQuatBatch(
+        ConstVectorArrayView axis,
+        const double *angle,
+        QuatArrayView out,
+        size_t count
+    ) {
+        kernels(count).axisAngleToQuat(axis, angle, out, count, defaultMathBackend());
+    }
+
+    void quatToAxisAngleBatch(
+        ConstQuatArrayView q,
+        VectorArrayView axis,
+        double *angle,
+        unsigned char *nonZero,
+        size_t count
+    ) {
+        kernels(count).quatToAxisAngle(q, axis, angle, nonZero, count, defaultMathBackend());
+    }
+
+    void slerpBatch(
+        ConstQuatArrayViewF p,
+        ConstQuatArrayViewF q,
+        const float *tween,
+        const short *spin,
+        QuatArrayViewF out,
+        size_t count,
+        SlerpMode mode
+    ) {
+        kernels(count).slerpF(p, q, tween, spin, out, count, mode, defaultMathBackend());
+    }
+
+    void axisAngleToQuatBatch(
+        ConstVectorArrayViewF axis,
+        const float *angle,
+        QuatArrayViewF out,
+        size_t count
+    ) {
+        kernels(count).axisAngleToQuatF(axis, angle, out, count, defaultMathBackend());
+    }
+
+    void quatToAxisAngleBatch(
+        ConstQuatArrayViewF q,
+        VectorArrayViewF axis,
+        float *angle,
+        unsigned char *nonZero,
+        size_t count
+    ) {
+        kernels(count).quatToAxisAngleF(q, axis, angle, nonZero, count, defaultMathBackend());
+    }
+
+    void quatToRotationVectorBatch(
+        ConstQuatArrayView q,
+        VectorArrayView out,
+        size_t count
+    ) {
+        kernels(count).quatToRotationVector(q, out, count);
+    }
+
+    void rotationVectorToQuatBatch(
+        ConstVectorArrayView v,
+        QuatArrayView out,
+        size_t count
+    ) {
+        kernels(count).rotationVectorToQuat(v, out, count);
+    }
+
+    void quatPowerBatch(
+        ConstQuatArrayView q,
+        const double *power,
+        QuatArrayView out,
+        size_t count
+    ) {
+        kernels(count).quatPower(q, power, out, count);
+    }
+
+    void matrixToQuatBatch(
+        ConstMatrixArrayView matrix,
+        QuatArrayView out,
+        size_t count
+    ) {
+        kernels(count).matrixToQuat(matrix, 0, out, count);
+    }
+
+    void matrixToQuatBatch(
+        ConstMatrixArrayView matrix,
+        ConstMatrixArrayView parentInverse,
+        QuatArrayView out,
+        size_t count
+    ) {
+        kernels(count).matrixToQuat(matrix, &parentInverse, out, count);
+    }
+
+    void eulerToQuatBatch(
+        ConstVectorArrayView euler,
+        RotateOrder order,
+        QuatArrayView out,
+        size_t count
+    ) {
+        kernels(count).eulerToQuat(euler, order, out, count);
+    }
+
+    void quatToEulerBatch(
+        ConstQuatArrayView q,
+        RotateOrder order,
+        VectorArrayView euler,
+        size_t count
+    ) {
+        kernels(count).quatToEuler(q, order, euler, count);
+    }
+
+    void eulerFilterBatch(
+        ConstVectorArrayView euler,
+        ConstVectorArrayView previous,
+        RotateOrder order,
+        VectorArrayView out,
+        size_t count
+    ) {
+        kernels(count).eulerFilter(euler, previous, order, out, count);
+    }
+
+    void unflipBatch(
+        ConstQuatArrayView q,
+        ConstQuatArrayView reference,
+        QuatArrayView out,
+        size_t count
+    ) {
+        kernels(count).unflip(q, reference, out, count);
+    }
+
+    void canonicalHemisphereBatch(
+        ConstQuatArrayView q,
+        QuatArrayView out,
+        size_t count
+    ) {
+        kernels(count).canonicalHemisphere(q, out, count);
+    }
+
+    void swingTwistBatch(
+        ConstQuatArrayView q,
+        ConstVectorArrayView axis,
+        QuatArrayView swing,
+        QuatArrayView twist,
+        double *twistAngle,
+        size_t count
+    ) {
+        kernels(count).swingTwist(q, axis, swing, twist, twistAngle, count);
+    }
+
+    void outerProductBatch(
+        ConstQuatArrayView q,
+        const double *weight,
+        size_t count,
+        double m[10]
+    ) {
+        kernels(count).outerProducts(q, weight, count, m);
+    }
+
+    void dqSkinBatch(
+        ConstDualQuatArrayView joints,
+        ConstSkinWeightsView weights,
+        ConstVectorArrayView points,
+        VectorArrayView out,
+        size_t count
+    ) {
+        kernels(count).dqSkin(joints, weights, points, out, count);
+    }
+}
\ No newline at end of file
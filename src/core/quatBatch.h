@@ -0,0 +1,495 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatBatch
+    Maya-free kernels that operate on whole arrays of quaternions at once.
+
+    Quaternion and vector arrays are stored as structure-of-arrays: one
+    contiguous buffer per component. The kernels never allocate; callers own
+    the buffers, usually through a QuatArray.
+
+    Each kernel has SSE2, AVX2 and AVX-512 versions plus a portable scalar
+    fallback, and dispatches to the widest one the CPU supports. Setting the
+    QUATEXTRAS_SIMD environment variable to scalar, sse2, avx2 or avx512
+    caps the level, which is useful for checking one path against another.
+    See quatBatchKernels.inl for the accuracy of the kernels relative to the
+    scalar functions in quatMath.h.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_QUAT_BATCH_H
+#define QUAT_EXTRAS_QUAT_BATCH_H
+
+#include "cpuFeatures.h"
+#include "quatMath.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace quatExtras
+{
+    /*
+        Views are templated on the component type so the float kernels (see
+        Precision below) can share them. The double views keep their
+        original names.
+    */
+    template <class T>
+    struct ConstQuatArrayViewT
+    {
+        const T *x;
+        const T *y;
+        const T *z;
+        const T *w;
+    };
+
+    template <class T>
+    struct QuatArrayViewT
+    {
+        T *x;
+        T *y;
+        T *z;
+        T *w;
+
+        operator ConstQuatArrayViewT<T>() const
+        {
+            ConstQuatArrayViewT<T> result = { x, y, z, w };
+            return result;
+        }
+    };
+
+    template <class T>
+    struct ConstVectorArrayViewT
+    {
+        const T *x;
+        const T *y;
+        const T *z;
+    };
+
+    template <class T>
+    struct VectorArrayViewT
+    {
+        T *x;
+        T *y;
+        T *z;
+
+        operator ConstVectorArrayViewT<T>() const
+        {
+            ConstVectorArrayViewT<T> result = { x, y, z };
+            return result;
+        }
+    };
+
+    typedef ConstQuatArrayViewT<double>     ConstQuatArrayView;
+    typedef QuatArrayViewT<double>          QuatArrayView;
+    typedef ConstVectorArrayViewT<double>   ConstVectorArrayView;
+    typedef VectorArrayViewT<double>        VectorArrayView;
+
+    typedef ConstQuatArrayViewT<float>      ConstQuatArrayViewF;
+    typedef QuatArrayViewT<float>           QuatArrayViewF;
+    typedef ConstVectorArrayViewT<float>    ConstVectorArrayViewF;
+    typedef VectorArrayViewT<float>         VectorArrayViewF;
+
+    /*
+        Upper 3x3 of an array of matrices, one buffer per element:
+        m[3 * row + column], in Maya's row-vector layout.
+    */
+    struct ConstMatrixArrayView
+    {
+        const double *m[9];
+    };
+
+    /*
+        Joint transforms as unit dual quaternions: real is the rotation and
+        dual is half the translation times it (see core/dqSkin.h).
+    */
+    struct ConstDualQuatArrayView
+    {
+        ConstQuatArrayView real;
+        ConstQuatArrayView dual;
+    };
+
+    /*
+        Sparse skin weights in compressed sparse row layout. The influences
+        of vertex i are influence[k], with weight weight[k], for k in
+        [offset[i], offset[i + 1]), largest weight first.
+    */
+    struct ConstSkinWeightsView
+    {
+        const unsigned *offset;
+        const int *influence;
+        const double *weight;
+    };
+
+    /*
+        Owning structure-of-arrays quaternion buffer. Elements added by
+        resize are identity quaternions.
+    */
+    template <class T>
+    class QuatArrayT
+    {
+    public:
+        size_t                  size() const { return w_.size(); }
+        void                    resize(size_t count);
+
+        void                    set(size_t i, T x, T y, T z, T w);
+
+        QuatArrayViewT<T>       view();
+        ConstQuatArrayViewT<T>  view() const;
+
+    private:
+        std::vector<T>          x_;
+        std::vector<T>          y_;
+        std::vector<T>          z_;
+        std::vector<T>          w_;
+    };
+
+    typedef QuatArrayT<double>  QuatArray;
+    typedef QuatArrayT<float>   QuatArrayF;
+
+    template <class T>
+    void QuatArrayT<T>::resize(size_t count)
+    {
+        x_.resize(count, T(0));
+        y_.resize(count, T(0));
+        z_.resize(count, T(0));
+        w_.resize(count, T(1));
+    }
+
+    template <class T>
+    void QuatArrayT<T>::set(size_t i, T x, T y, T z, T w)
+    {
+        x_[i] = x;
+        y_[i] = y;
+        z_[i] = z;
+        w_[i] = w;
+    }
+
+    template <class T>
+    QuatArrayViewT<T> QuatArrayT<T>::view()
+    {
+        QuatArrayViewT<T> result = { x_.data(), y_.data(), z_.data(), w_.data() };
+        return result;
+    }
+
+    template <class T>
+    ConstQuatArrayViewT<T> QuatArrayT<T>::view() const
+    {
+        ConstQuatArrayViewT<T> result = { x_.data(), y_.data(), z_.data(), w_.data() };
+        return result;
+    }
+
+    /*
+        Instruction set used by the kernels. setBatchSimdLevel clamps the
+        request to what the CPU supports and returns the level in effect.
+    */
+    SimdLevel batchSimdLevel();
+    SimdLevel setBatchSimdLevel(SimdLevel level);
+
+    /*
+        Component type a node evaluates its batch kernels in. Only slerp and
+        the axis-angle conversions have float kernels; see the float
+        overloads below. The plugin-wide default is double unless the
+        QUATEXTRAS_PRECISION environment variable is set to float; nodes
+        with a precision attribute can override it.
+    */
+    enum Precision
+    {
+        kPrecisionDouble = 0,
+        kPrecisionFloat  = 1
+    };
+
+    Precision defaultPrecision();
+    void setDefaultPrecision(Precision precision);
+
+    /*
+        Implementation of the sin, cos and atan2 calls in slerpBatch (exact
+        weights), axisAngleToQuatBatch and quatToAxisAngleBatch in both
+        precisions, in sinCosBatch and atan2Batch, and in the slerpSetup and
+        slerpWeights overloads below. The other kernels always use the
+        polynomials.
+
+            kMathLibm           The C library, one lane at a time; the rest
+                                of each kernel stays vectorized.
+            kMathPolynomial     The Cephes polynomials of the batch kernels,
+                                evaluated in every lane at once.
+            kMathTable          129 entry tables of sin and cos over
+                                [0, pi/4] and of atan over [0, 1], read
+                                with one gather per table, corrected by a
+                                short series. 4.6 KB in all, so they stay
+                                in L1.
+
+        Maximum error in ulps against double precision libm, over 10^7
+        random arguments: sin and cos of x in [-4pi, 4pi] ([-pi, pi] in
+        float), atan2 of y and x in [-1, 1]:
+
+                                double                  float
+            kMathLibm           0                       0.6
+            kMathPolynomial     2                       1.5
+            kMathTable          3 (sin, cos)            3.2 (sin, cos)
+                                5 (atan2)               2.4 (atan2)
+
+        In double the slerp and axis-angle kernels agree across backends to
+        within 1e-15 per component and radian over 10^6 random inputs, and
+        so do the one-at-a-time slerpSetup and slerpWeights. A spin raises
+        the slerp difference near coincident endpoints, to 1.2e-13 over the
+        same inputs. kMathTable has the fastest atan2 at every instruction
+        set, but its two gathers make sin and cos slower than the
+        polynomials beyond SSE2; kMathLibm is several times slower than
+        both once the kernels are vectorized. The
+        plugin-wide default is kMathPolynomial unless the QUATEXTRAS_MATH
+        environment variable names another; the plugin also reads the
+        quatExtrasMathBackend optionVar when it loads.
+    */
+    enum MathBackend
+    {
+        kMathLibm       = 0,
+        kMathPolynomial = 1,
+        kMathTable      = 2
+    };
+
+    MathBackend defaultMathBackend();
+    void setDefaultMathBackend(MathBackend backend);
+
+    const char* mathBackendName(MathBackend backend);
+
+    // Parses "libm", "polynomial" or "table". Returns false otherwise.
+    bool parseMathBackend(const char* name, MathBackend &backend);
+
+    /*
+        s[i] = sin(x[i]) and c[i] = cos(x[i]), and out[i] = atan2(y[i],
+        x[i]), with the default math backend. atan2 of two zeros is zero,
+        whatever their signs.
+    */
+    void sinCosBatch(const double *x, double *s, double *c, size_t count);
+    void atan2Batch(const double *y, const double *x, double *out, size_t count);
+
+    /*
+        slerpSetup and slerpWeights (quatMath.h) with their transcendentals
+        from backend. For nodes that evaluate one slerp at a time.
+    */
+    SlerpSetup slerpSetup(const double p[4], const double q[4], short spin, MathBackend backend);
+    void slerpWeights(const SlerpSetup &setup, double t, SlerpMode mode, MathBackend backend, double &a, double &b);
+
+    /*
+        out[i] = slerp(p[i], q[i], tween[i], spin[i], mode) for i in
+        [0, count). spin may be null for no extra spins. out may alias p or
+        q. See quatMath.h for the accuracy of each mode.
+    */
+    void slerpBatch(
+        ConstQuatArrayView p,
+        ConstQuatArrayView q,
+        const double *tween,
+        const short *spin,
+        QuatArrayView out,
+        size_t count,
+        SlerpMode mode = kSlerpExact
+    );
+
+    /*
+        out[i] = rotation of angle[i] radians about axis[i]. Axes need not be
+        normalized; a zero-length axis gives the identity.
+    */
+    void axisAngleToQuatBatch(
+        ConstVectorArrayView axis,
+        const double *angle,
+        QuatArrayView out,
+        size_t count
+    );
+
+    /*
+        Splits q[i] into a unit axis and an angle in [0, 2pi] radians.
+        nonZero[i] is 0, with a zero axis and angle, when q[i] has no
+        rotation axis (see quatToAxisAngle in quatMath.h). nonZero may be
+        null.
+    */
+    void quatToAxisAngleBatch(
+        ConstQuatArrayView q,
+        VectorArrayView axis,
+        double *angle,
+        unsigned char *nonZero,
+        size_t count
+    );
+
+    /*
+        Float versions of the three kernels above. They use the same
+        algorithms with twice as many lanes per register and do no
+        conversion; callers convert at the attribute boundary. Maximum error
+        against the double kernels given the same (float) inputs, over 10^6
+        random unit quaternions, normalized axes and angles in [-2pi, 2pi]:
+
+            slerpBatch, kSlerpExact         3.1e-7 per component
+            slerpBatch, kSlerpNlerp/Fast    1.9e-7 per component
+            axisAngleToQuatBatch            1.5e-7 per component
+            quatToAxisAngleBatch            1.6e-7 per axis component,
+                                            5.7e-7 radians, same nonZero
+
+        With a non-zero spin the slerp error is about 1.1e-6 / theta for
+        endpoints theta >= 0.1 radians apart. Closer than that a spin makes
+        both precisions amplify the rounding of their inputs, the double
+        kernel by about pi / theta^2 and the float one by pi / theta. The
+        quatToAxisAngle axis error grows as 1 / sin(angle / 2) near the
+        identity, as it does in double.
+    */
+    void slerpBatch(
+        ConstQuatArrayViewF p,
+        ConstQuatArrayViewF q,
+        const float *tween,
+        const short *spin,
+        QuatArrayViewF out,
+        size_t count,
+        SlerpMode mode = kSlerpExact
+    );
+
+    void axisAngleToQuatBatch(
+        ConstVectorArrayViewF axis,
+        const float *angle,
+        QuatArrayViewF out,
+        size_t count
+    );
+
+    void quatToAxisAngleBatch(
+        ConstQuatArrayViewF q,
+        VectorArrayViewF axis,
+        float *angle,
+        unsigned char *nonZero,
+        size_t count
+    );
+
+    /*
+        Rotation vectors (axis * angle, the log map doubled) of q[i] and
+        back, and out[i] = q[i]^power[i]. See quatToRotationVector,
+        rotationVectorToQuat and quatPower in quatMath.h; near the identity
+        the kernels use the same series. out may alias q for
+        quatPowerBatch.
+    */
+    void quatToRotationVectorBatch(
+        ConstQuatArrayView q,
+        VectorArrayView out,
+        size_t count
+    );
+
+    void rotationVectorToQuatBatch(
+        ConstVectorArrayView v,
+        QuatArrayView out,
+        size_t count
+    );
+
+    void quatPowerBatch(
+        ConstQuatArrayView q,
+        const double *power,
+        QuatArrayView out,
+        size_t count
+    );
+
+    /*
+        out[i] = rotation of matrix[i], or of matrix[i] * parentInverse[i],
+        with scale and shear removed; see matrixToQuat in quatMath.h.
+    */
+    void matrixToQuatBatch(
+        ConstMatrixArrayView matrix,
+        QuatArrayView out,
+        size_t count
+    );
+
+    void matrixToQuatBatch(
+        ConstMatrixArrayView matrix,
+        ConstMatrixArrayView parentInverse,
+        QuatArrayView out,
+        size_t count
+    );
+
+    /*
+        Euler angles in radians to quaternions and back, for one rotate
+        order (see eulerToQuat and quatToEuler in quatMath.h). Each rotate
+        order has its own kernel, picked once per call. out may alias the
+        input for eulerFilterBatch, which moves each euler[i] to the
+        equivalent angles closest to previous[i].
+    */
+    void eulerToQuatBatch(
+        ConstVectorArrayView euler,
+        RotateOrder order,
+        QuatArrayView out,
+        size_t count
+    );
+
+    void quatToEulerBatch(
+        ConstQuatArrayView q,
+        RotateOrder order,
+        VectorArrayView euler,
+        size_t count
+    );
+
+    void eulerFilterBatch(
+        ConstVectorArrayView euler,
+        ConstVectorArrayView previous,
+        RotateOrder order,
+        VectorArrayView out,
+        size_t count
+    );
+
+    /*
+        q[i] or -q[i], on the hemisphere of reference[i] (unflip in
+        quatMath.h), or by the fixed rule of canonicalHemisphere. out may
+        alias q.
+    */
+    void unflipBatch(
+        ConstQuatArrayView q,
+        ConstQuatArrayView reference,
+        QuatArrayView out,
+        size_t count
+    );
+
+    void canonicalHemisphereBatch(
+        ConstQuatArrayView q,
+        QuatArrayView out,
+        size_t count
+    );
+
+    /*
+        Splits q[i] into swing[i] * twist[i], twist[i] being the rotation
+        about axis[i] and twistAngle[i] its angle in [-pi, pi] radians (see
+        swingTwist in quatMath.h). Axes need not be normalized. swing and
+        twist may alias q.
+    */
+    void swingTwistBatch(
+        ConstQuatArrayView q,
+        ConstVectorArrayView axis,
+        QuatArrayView swing,
+        QuatArrayView twist,
+        double *twistAngle,
+        size_t count
+    );
+
+    /*
+        Dual quaternion skinning (Kavan et al. 2008): out[i] is points[i]
+        moved by the normalized sum of its influences' joint dual
+        quaternions, each weighted and flipped onto the hemisphere of the
+        vertex's first influence. Joints are gathered per lane, so
+        neighbouring vertices may use any joints in any order. Vertices with
+        no influences are copied. Every influence must index joints. out
+        may alias points.
+    */
+    void dqSkinBatch(
+        ConstDualQuatArrayView joints,
+        ConstSkinWeightsView weights,
+        ConstVectorArrayView points,
+        VectorArrayView out,
+        size_t count
+    );
+
+    /*
+        Adds the weighted outer products weight[i] * q[i] q[i]^T to m, the
+        upper triangle of a symmetric 4x4 matrix stored as
+        xx xy xz xw yy yz yw zz zw ww.
+    */
+    void outerProductBatch(
+        ConstQuatArrayView q,
+        const double *weight,
+        size_t count,
+        double m[10]
+    );
+}
+
+#endif
\ No newline at end of file
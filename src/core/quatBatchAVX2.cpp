@@ -0,0 +1,71 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*
+    AVX2 batch kernels. Four lanes with FMA, eight in single precision. Built with -mavx2 -mfma (/arch:AVX2).
+*/
+
+#include "quatBatchKernels.h"
+#include "quatMath.h"
+#include "simd.h"
+
+#include <cstddef>
+
+namespace quatExtras
+{
+#if defined(QUAT_EXTRAS_HAS_AVX2)
+    namespace avx2f
+    {
+        typedef AVX2F V;
+        typedef AVX2FMask M;
+
+        #define QUAT_EXTRAS_SINGLE_PRECISION
+        #include "quatBatchKernels.inl"
+        #undef QUAT_EXTRAS_SINGLE_PRECISION
+    }
+
+    namespace avx2
+    {
+        typedef AVX2D V;
+        typedef AVX2DMask M;
+
+        #include "quatBatchKernels.inl"
+
+        const BatchKernels kernels = {
+            kSimdAVX2,
+            slerp,
+            axisAngleToQuat,
+            quatToAxisAngle,
+            quatToRotationVector,
+            rotationVectorToQuat,
+            quatPower,
+            matrixToQuat,
+            eulerToQuat,
+            quatToEuler,
+            eulerFilter,
+            swingTwist,
+            outerProducts,
+            dqSkin,
+            unflip,
+            canonicalHemisphere,
+            sinCos,
+            atan2,
+            avx2f::slerp,
+            avx2f::axisAngleToQuat,
+            avx2f::quatToAxisAngle
+        };
+    }
+
+    const BatchKernels* avx2BatchKernels()
+    {
+        return &avx2::kernels;
+    }
+#else
+    const BatchKernels* avx2BatchKernels()
+    {
+        return 0;
+    }
+#endif
+}
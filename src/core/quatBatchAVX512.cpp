@@ -0,0 +1,71 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*
+    AVX512 batch kernels. Eight lanes, sixteen in single precision. Built with -mavx512f (/arch:AVX512).
+*/
+
+#include "quatBatchKernels.h"
+#include "quatMath.h"
+#include "simd.h"
+
+#include <cstddef>
+
+namespace quatExtras
+{
+#if defined(QUAT_EXTRAS_HAS_AVX512)
+    namespace avx512f
+    {
+        typedef AVX512F V;
+        typedef AVX512FMask M;
+
+        #define QUAT_EXTRAS_SINGLE_PRECISION
+        #include "quatBatchKernels.inl"
+        #undef QUAT_EXTRAS_SINGLE_PRECISION
+    }
+
+    namespace avx512
+    {
+        typedef AVX512D V;
+        typedef AVX512DMask M;
+
+        #include "quatBatchKernels.inl"
+
+        const BatchKernels kernels = {
+            kSimdAVX512,
+            slerp,
+            axisAngleToQuat,
+            quatToAxisAngle,
+            quatToRotationVector,
+            rotationVectorToQuat,
+            quatPower,
+            matrixToQuat,
+            eulerToQuat,
+            quatToEuler,
+            eulerFilter,
+            swingTwist,
+            outerProducts,
+            dqSkin,
+            unflip,
+            canonicalHemisphere,
+            sinCos,
+            atan2,
+            avx512f::slerp,
+            avx512f::axisAngleToQuat,
+            avx512f::quatToAxisAngle
+        };
+    }
+
+    const BatchKernels* avx512BatchKernels()
+    {
+        return &avx512::kernels;
+    }
+#else
+    const BatchKernels* avx512BatchKernels()
+    {
+        return 0;
+    }
+#endif
+}
@@ -0,0 +1,213 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatBatchKernels
+    Internal dispatch table for the batch kernels. Each quatBatch<ISA>.cpp
+    fills one in; quatBatch.cpp picks the widest the CPU supports.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_QUAT_BATCH_KERNELS_H
+#define QUAT_EXTRAS_QUAT_BATCH_KERNELS_H
+
+#include "cpuFeatures.h"
+#include "quatBatch.h"
+#include "quatMath.h"
+
+#include <cstddef>
+
+namespace quatExtras
+{
+    struct BatchKernels
+    {
+        SimdLevel level;
+
+        void (*slerp)(
+            ConstQuatArrayView p,
+            ConstQuatArrayView q,
+            const double *tween,
+            const short *spin,
+            QuatArrayView out,
+            size_t count,
+            SlerpMode mode,
+            MathBackend math
+        );
+
+        void (*axisAngleToQuat)(
+            ConstVectorArrayView axis,
+            const double *angle,
+            QuatArrayView out,
+            size_t count,
+            MathBackend math
+        );
+
+        void (*quatToAxisAngle)(
+            ConstQuatArrayView q,
+            VectorArrayView axis,
+            double *angle,
+            unsigned char *nonZero,
+            size_t count,
+            MathBackend math
+        );
+
+        void (*quatToRotationVector)(
+            ConstQuatArrayView q,
+            VectorArrayView out,
+            size_t count
+        );
+
+        void (*rotationVectorToQuat)(
+            ConstVectorArrayView v,
+            QuatArrayView out,
+            size_t count
+        );
+
+        void (*quatPower)(
+            ConstQuatArrayView q,
+            const double *power,
+            QuatArrayView out,
+            size_t count
+        );
+
+        void (*matrixToQuat)(
+            ConstMatrixArrayView matrix,
+            const ConstMatrixArrayView *parentInverse,
+            QuatArrayView out,
+            size_t count
+        );
+
+        void (*eulerToQuat)(
+            ConstVectorArrayView euler,
+            RotateOrder order,
+            QuatArrayView out,
+            size_t count
+        );
+
+        void (*quatToEuler)(
+            ConstQuatArrayView q,
+            RotateOrder order,
+            VectorArrayView euler,
+            size_t count
+        );
+
+        void (*eulerFilter)(
+            ConstVectorArrayView euler,
+            ConstVectorArrayView previous,
+            RotateOrder order,
+            VectorArrayView out,
+            size_t count
+        );
+
+        void (*swingTwist)(
+            ConstQuatArrayView q,
+            ConstVectorArrayView axis,
+            QuatArrayView swing,
+            QuatArrayView twist,
+            double *twistAngle,
+            size_t count
+        );
+
+        void (*outerProducts)(
+            ConstQuatArrayView q,
+            const double *weight,
+            size_t count,
+            double m[10]
+        );
+
+        void (*dqSkin)(
+            ConstDualQuatArrayView joints,
+            ConstSkinWeightsView weights,
+            ConstVectorArrayView points,
+            VectorArrayView out,
+            size_t count
+        );
+
+        void (*unflip)(
+            ConstQuatArrayView q,
+            ConstQuatArrayView reference,
+            QuatArrayView out,
+            size_t count
+        );
+
+        void (*canonicalHemisphere)(
+            ConstQuatArrayView q,
+            QuatArrayView out,
+            size_t count
+        );
+
+        void (*sinCos)(
+            const double *x,
+            double *s,
+            double *c,
+            size_t count,
+            MathBackend math
+        );
+
+        void (*atan2)(
+            const double *y,
+            const double *x,
+            double *out,
+            size_t count,
+            MathBackend math
+        );
+
+        // Single precision kernels; see the float overloads in quatBatch.h.
+        void (*slerpF)(
+            ConstQuatArrayViewF p,
+            ConstQuatArrayViewF q,
+            const float *tween,
+            const short *spin,
+            QuatArrayViewF out,
+            size_t count,
+            SlerpMode mode,
+            MathBackend math
+        );
+
+        void (*axisAngleToQuatF)(
+            ConstVectorArrayViewF axis,
+            const float *angle,
+            QuatArrayViewF out,
+            size_t count,
+            MathBackend math
+        );
+
+        void (*quatToAxisAngleF)(
+            ConstQuatArrayViewF q,
+            VectorArrayViewF axis,
+            float *angle,
+            unsigned char *nonZero,
+            size_t count,
+            MathBackend math
+        );
+    };
+
+    /*
+        Tables for kMathTable: sin and cos of k pi/4 / kSinCosSteps and atan
+        of k / kAtanSteps, for k in [0, steps], rounded to each precision.
+        Built on first use.
+    */
+    struct MathTables
+    {
+        enum { kSinCosSteps = 128, kAtanSteps = 128 };
+
+        double sin[kSinCosSteps + 1];
+        double cos[kSinCosSteps + 1];
+        double atan[kAtanSteps + 1];
+
+        float sinF[kSinCosSteps + 1];
+        float cosF[kSinCosSteps + 1];
+        float atanF[kAtanSteps + 1];
+    };
+
+    const MathTables& mathTables();
+
+    // Null when the instruction set was not compiled in.
+    const BatchKernels* scalarBatchKernels();
+    const BatchKernels* sse2BatchKernels();
+    const BatchKernels* avx2BatchKernels();
+    const BatchKernels* avx512BatchKernels();
+}
+
+#endif
@@ -0,0 +1,1560 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatBatchKernels.inl
+    Shared body of the batch kernels. Each quatBatch<ISA>.cpp includes this
+    inside its own namespace after defining
+
+        V   the simd.h vector type for that instruction set
+        M   its mask type
+
+    so the same source compiles to one kernel set per instruction set. The
+    files include it a second time with a float V (and
+    QUAT_EXTRAS_SINGLE_PRECISION defined) for the single precision slerp and
+    axis-angle kernels; streams are then float buffers of V::Real.
+    Only simd.h operations and the functions in this file may be called from
+    here; inline helpers from other headers would be compiled with this
+    file's instruction set and could be shared with code that cannot run it.
+
+    Transcendentals use the Cephes double precision polynomials (sin/cos on
+    [-pi/4, pi/4], atan with the tan(3pi/8) / 0.66 range split), which are
+    accurate to about 1 ulp. The kernels that take a MathBackend can use
+    libm or lookup tables instead; the figures here are for the
+    polynomials, and the other backends are described with MathBackend in
+    quatBatch.h. Compared with the libm-based scalar functions in
+    quatMath.h the kernels agree to within 1e-12 per component for unit
+    quaternions and normalized axes, 1e-12 radians for angles, and report
+    exactly the same nonZero result. The one exception is slerp with a
+    non-zero spin between nearly parallel endpoints (theta below ~1e-4),
+    where both versions divide their rounding error by sin(theta); there
+    they agree to within 1e-10.
+
+    The kSlerpNlerp and kSlerpFast kernels match their quatMath.h
+    counterparts to within 2e-14; their error relative to exact slerp is
+    documented there.
+
+    With a float V the same polynomials are evaluated in float, where they
+    are accurate to about 1 float ulp; the error against the double kernels
+    is documented with the float overloads in quatBatch.h.
+-----------------------------------------------------------------------------*/
+
+typedef V::Real Real;
+
+/*-----------------------------------------------------------------------------
+    Vector math
+-----------------------------------------------------------------------------*/
+
+// pi / 2 split into three parts so n * pi / 2 can be subtracted exactly.
+const double kPiOver2A = 1.57079625129699707031;
+const double kPiOver2B = 7.54978941586159635335e-8;
+const double kPiOver2C = 5.39030285815811905290e-15;
+
+const double kTwoOverPi = 0.63661977236758134308;
+const double kPiOver2 = 1.57079632679489661923;
+const double kPiOver4 = 0.78539816339744830962;
+const double kTan3PiOver8 = 2.41421356237309504880;
+const double kAtanMoreBits = 6.123233995736765886130e-17;
+
+inline V polySin(V z)
+{
+    V p = V(1.58962301576546568060e-10);
+    p = fmadd(p, z, V(-2.50507477628578072866e-8));
+    p = fmadd(p, z, V(2.75573136213857245213e-6));
+    p = fmadd(p, z, V(-1.98412698295895385996e-4));
+    p = fmadd(p, z, V(8.33333333332211858878e-3));
+    p = fmadd(p, z, V(-1.66666666666666307295e-1));
+    return p;
+}
+
+inline V polyCos(V z)
+{
+    V p = V(-1.13585365213876817300e-11);
+    p = fmadd(p, z, V(2.08757008419747316778e-9));
+    p = fmadd(p, z, V(-2.75573141792967388112e-7));
+    p = fmadd(p, z, V(2.48015872888517045348e-5));
+    p = fmadd(p, z, V(-1.38888888888730564116e-3));
+    p = fmadd(p, z, V(4.16666666666665929218e-2));
+    return p;
+}
+
+/*
+    Returns the nearest multiple n of pi/2 to x, and the remainder
+    r = x - n pi/2 in [-pi/4, pi/4].
+*/
+inline V reduceQuadrant(V x, V &r)
+{
+    V n = round(x * V(kTwoOverPi));
+
+    r = fmadd(n, V(-kPiOver2A), x);
+    r = fmadd(n, V(-kPiOver2B), r);
+    r = fmadd(n, V(-kPiOver2C), r);
+
+    return n;
+}
+
+/*
+    sin and cos of x = r + n pi/2 from those of the remainder r, routed by
+    the quadrant n mod 4.
+*/
+inline void routeQuadrant(V n, V sinR, V cosR, V &s, V &c)
+{
+    V quadrant = n - V(4.0) * round(n * V(0.25));
+    quadrant = select(quadrant < V(0.0), quadrant + V(4.0), quadrant);
+
+    M q1 = quadrant == V(1.0);
+    M q2 = quadrant == V(2.0);
+    M q3 = quadrant == V(3.0);
+
+    M swap = q1 | q3;
+
+    V sinX = select(swap, cosR, sinR);
+    V cosX = select(swap, sinR, cosR);
+
+    s = select(q2 | q3, -sinX, sinX);
+    c = select(q1 | q2, -cosX, cosX);
+}
+
+/*
+    Evaluates both polynomials on the remainder of x.
+*/
+inline void vSinCos(V x, V &s, V &c)
+{
+    V r;
+    V n = reduceQuadrant(x, r);
+
+    V z = r * r;
+    V sinR = fmadd(r * z, polySin(z), r);
+    V cosR = fmadd(z * z, polyCos(z), V(1.0) - V(0.5) * z);
+
+    routeQuadrant(n, sinR, cosR, s, c);
+}
+
+inline V vAtan(V x)
+{
+    V ax = abs(x);
+
+    M big = ax > V(kTan3PiOver8);
+    M mid = andNot(ax > V(0.66), big);
+
+    V y0 = select(big, V(kPiOver2), select(mid, V(kPiOver4), V(0.0)));
+    V r = select(big, V(-1.0) / ax, select(mid, (ax - V(1.0)) / (ax + V(1.0)), ax));
+
+    V z = r * r;
+
+    V p = V(-8.750608600031904122785e-1);
+    p = fmadd(p, z, V(-1.615753718733365076637e1));
+    p = fmadd(p, z, V(-7.500855792314704667340e1));
+    p = fmadd(p, z, V(-1.228866684490136173410e2));
+    p = fmadd(p, z, V(-6.485021904942025371773e1));
+
+    V q = z + V(2.485846490142306297962e1);
+    q = fmadd(q, z, V(1.650270098316988542046e2));
+    q = fmadd(q, z, V(4.328810604912902668951e2));
+    q = fmadd(q, z, V(4.853903996359136964868e2));
+    q = fmadd(q, z, V(1.945506571482613964425e2));
+
+    z = z * p / q;
+    z = fmadd(r, z, r);
+    z = z + select(big, V(kAtanMoreBits), select(mid, V(0.5 * kAtanMoreBits), V(0.0)));
+
+    return copysign(y0 + z, x);
+}
+
+/*
+    Quadrant-correct atan2. Both inputs zero gives zero.
+*/
+inline V vAtan2(V y, V x)
+{
+    V ax = abs(x);
+    V ay = abs(y);
+
+    M bothZero = (ax == V(0.0)) & (ay == V(0.0));
+
+    V a = vAtan(ay / select(bothZero, V(1.0), ax));
+    a = select(x < V(0.0), V(kPi) - a, a);
+    a = select(bothZero, V(0.0), a);
+
+    return copysign(a, y);
+}
+
+/*-----------------------------------------------------------------------------
+    Math backends
+
+    The kernels that take a MathBackend are templates over one of these,
+    each providing sinCos(x, s, c) and atan2(y, x) with the same special
+    cases as vSinCos and vAtan2. See MathBackend in quatBatch.h for their
+    accuracy.
+-----------------------------------------------------------------------------*/
+
+struct PolynomialMath
+{
+    void sinCos(V x, V &s, V &c) const { vSinCos(x, s, c); }
+    V atan2(V y, V x) const { return vAtan2(y, x); }
+};
+
+// The C functions rather than the std:: overloads, which for float are
+// inline and so must not be compiled here.
+inline double libmSin(double x) { return ::sin(x); }
+inline double libmCos(double x) { return ::cos(x); }
+inline double libmAtan2(double y, double x) { return ::atan2(y, x); }
+inline float libmSin(float x) { return ::sinf(x); }
+inline float libmCos(float x) { return ::cosf(x); }
+inline float libmAtan2(float y, float x) { return ::atan2f(y, x); }
+
+/*
+    One call per lane, through memory.
+*/
+struct LibmMath
+{
+    void sinCos(V x, V &s, V &c) const
+    {
+        Real lanes[V::width], sinLanes[V::width], cosLanes[V::width];
+        x.store(lanes);
+
+        for (int i = 0; i < V::width; i++)
+        {
+            sinLanes[i] = libmSin(lanes[i]);
+            cosLanes[i] = libmCos(lanes[i]);
+        }
+
+        s = V::load(sinLanes);
+        c = V::load(cosLanes);
+    }
+
+    V atan2(V y, V x) const
+    {
+        Real yLanes[V::width], xLanes[V::width];
+        y.store(yLanes);
+        x.store(xLanes);
+
+        for (int i = 0; i < V::width; i++)
+        {
+            bool bothZero = yLanes[i] == Real(0) && xLanes[i] == Real(0);
+            yLanes[i] = bothZero ? Real(0) : libmAtan2(yLanes[i], xLanes[i]);
+        }
+
+        return V::load(yLanes);
+    }
+};
+
+// pi/4 / kSinCosSteps split into two parts, the first short enough that
+// k times it is exact in Real for every step k.
+const double kSinCosStepA = sizeof(Real) < sizeof(double) ? 6.135821342468262e-3 : 6.135923151542544e-3;
+const double kSinCosStepB = sizeof(Real) < sizeof(double) ? 1.0180907430296093e-7 : 2.0816681711721685e-17;
+
+/*
+    Nearest table entry plus a short series for the rest. For sin and cos,
+    with d the distance to the nearest step (|d| <= 3.1e-3),
+
+        sin(k h + d) = sin(k h) cos(d) + cos(k h) sin(d)
+        cos(k h + d) = cos(k h) cos(d) - sin(k h) sin(d)
+
+    and for atan of a = min / max of |y| and |x|, with r = k / kAtanSteps
+    the nearest step,
+
+        atan(a) = atan(r) + atan(u),  u = (a - r) / (1 + a r)
+
+    where |u| <= 1 / (2 kAtanSteps). sin(d), cos(d) and atan(u) are taken
+    to their third terms, which leaves truncation errors below 1e-17 and
+    the result within a few ulps. Indices are clamped so a NaN argument
+    still reads inside the table.
+*/
+struct TableMath
+{
+    const Real *sinTable;
+    const Real *cosTable;
+    const Real *atanTable;
+
+    void sinCos(V x, V &s, V &c) const
+    {
+        V r;
+        V n = reduceQuadrant(x, r);
+
+        V a = abs(r);
+        V k = min(round(a * V(MathTables::kSinCosSteps / kPiOver4)), V(MathTables::kSinCosSteps));
+
+        V d = fmadd(k, V(-kSinCosStepA), a);
+        d = fmadd(k, V(-kSinCosStepB), d);
+
+        V sinK = V::lookup(sinTable, k);
+        V cosK = V::lookup(cosTable, k);
+
+        V d2 = d * d;
+        V sinD = fmadd(d * d2, fmadd(d2, V(1.0 / 120.0), V(-1.0 / 6.0)), d);
+        V cosD = fmadd(d2, fmadd(d2, V(1.0 / 24.0), V(-0.5)), V(1.0));
+
+        V sinA = fmadd(sinK, cosD, cosK * sinD);
+        V cosA = fmadd(cosK, cosD, -(sinK * sinD));
+
+        routeQuadrant(n, copysign(sinA, r), cosA, s, c);
+    }
+
+    V atan2(V y, V x) const
+    {
+        V ax = abs(x);
+        V ay = abs(y);
+
+        M steep = ay > ax;
+        V low = select(steep, ax, ay);
+        V high = select(steep, ay, ax);
+
+        M bothZero = high == V(0.0);
+
+        V a = low / select(bothZero, V(1.0), high);
+        V k = min(round(a * V(MathTables::kAtanSteps)), V(MathTables::kAtanSteps));
+        V r = k * V(1.0 / MathTables::kAtanSteps);
+        V u = (a - r) / fmadd(a, r, V(1.0));
+
+        V u2 = u * u;
+        V angle = V::lookup(atanTable, k) + fmadd(u * u2, fmadd(u2, V(0.2), V(-1.0 / 3.0)), u);
+        angle = select(steep, V(kPiOver2) - angle, angle);
+        angle = select(x < V(0.0), V(kPi) - angle, angle);
+        angle = select(bothZero, V(0.0), angle);
+
+        return copysign(angle, y);
+    }
+};
+
+// The table of each pair with Real elements, picked by the type of the
+// last argument.
+inline const double* realTable(const double *table, const float *, double) { return table; }
+inline const float* realTable(const double *, const float *table, float) { return table; }
+
+inline TableMath tableMath()
+{
+    const MathTables &tables = mathTables();
+
+    TableMath result = {
+        realTable(tables.sin, tables.sinF, Real()),
+        realTable(tables.cos, tables.cosF, Real()),
+        realTable(tables.atan, tables.atanF, Real())
+    };
+
+    return result;
+}
+
+/*-----------------------------------------------------------------------------
+    Stream runner
+
+    Applies op to NIn input streams, NOut lanes at a time, writing NOut
+    output streams. The last partial register is staged through zero-padded
+    buffers so the kernels never touch memory past count.
+-----------------------------------------------------------------------------*/
+
+template <int NIn, int NOut, class Op>
+void runStreams(const Real *const *in, Real *const *out, size_t count, const Op &op)
+{
+    const size_t width = V::width;
+
+    V a[NIn];
+    V r[NOut];
+
+    size_t i = 0;
+
+    for (; i + width <= count; i += width)
+    {
+        for (int k = 0; k < NIn; k++)
+            a[k] = V::load(in[k] + i);
+
+        op(a, r);
+
+        for (int k = 0; k < NOut; k++)
+            r[k].store(out[k] + i);
+    }
+
+    if (i < count)
+    {
+        size_t rest = count - i;
+        Real buffer[V::width];
+
+        for (int k = 0; k < NIn; k++)
+        {
+            for (size_t j = 0; j < width; j++)
+                buffer[j] = j < rest ? in[k][i + j] : Real(0);
+
+            a[k] = V::load(buffer);
+        }
+
+        op(a, r);
+
+        for (int k = 0; k < NOut; k++)
+        {
+            r[k].store(buffer);
+
+            for (size_t j = 0; j < rest; j++)
+                out[k][i + j] = buffer[j];
+        }
+    }
+}
+
+// Streams with integer or byte elements are converted in chunks of this size.
+const size_t kChunkSize = 256;
+
+/*-----------------------------------------------------------------------------
+    Kernels
+-----------------------------------------------------------------------------*/
+
+/*
+    in:  px py pz pw qx qy qz qw tween spin
+    out: x y z w
+*/
+template <class Math>
+struct SlerpOp
+{
+    Math math;
+
+    explicit SlerpOp(const Math &math) : math(math) {}
+
+    void operator()(const V *in, V *out) const
+    {
+        V px = in[0], py = in[1], pz = in[2], pw = in[3];
+        V qx = in[4], qy = in[5], qz = in[6], qw = in[7];
+        V t = in[8];
+        V spin = in[9];
+
+        V cosTheta = fmadd(px, qx, fmadd(py, qy, fmadd(pz, qz, pw * qw)));
+        V sign = select(cosTheta < V(0.0), V(-1.0), V(1.0));
+
+        cosTheta = abs(cosTheta);
+
+        M linear = (V(1.0) - cosTheta) <= V(kSlerpEpsilon);
+
+        // (1 - c)(1 + c) keeps full precision when the endpoints are close.
+        V sinTheta = sqrt(max((V(1.0) - cosTheta) * (V(1.0) + cosTheta), V(0.0)));
+        V theta = math.atan2(sinTheta, cosTheta);
+
+        // In float a rounded cosTheta leaves too few bits of a small theta,
+        // which a spin multiplies by pi / theta. theta / 2 is the angle
+        // between the chords |p + q| and |p - q|, which keep them all.
+        if (sizeof(Real) < sizeof(double))
+        {
+            V dx = px - sign * qx, dy = py - sign * qy, dz = pz - sign * qz, dw = pw - sign * qw;
+            V sx = px + sign * qx, sy = py + sign * qy, sz = pz + sign * qz, sw = pw + sign * qw;
+
+            V d2 = fmadd(dx, dx, fmadd(dy, dy, fmadd(dz, dz, dw * dw)));
+            V s2 = fmadd(sx, sx, fmadd(sy, sy, fmadd(sz, sz, sw * sw)));
+
+            theta = V(2.0) * math.atan2(sqrt(d2), sqrt(s2));
+            sinTheta = V(2.0) * sqrt(d2 * s2) / select(linear, V(1.0), d2 + s2);
+        }
+        V phi = fmadd(spin, V(kPi), theta);
+        V invSinTheta = V(1.0) / select(linear, V(1.0), sinTheta);
+
+        V tPhi = t * phi;
+        V sinA, cosA, sinB, cosB;
+
+        math.sinCos(theta - tPhi, sinA, cosA);
+        math.sinCos(tPhi, sinB, cosB);
+
+        V a = select(linear, V(1.0) - t, sinA * invSinTheta);
+        V b = select(linear, t, sinB * invSinTheta) * sign;
+
+        out[0] = fmadd(a, px, b * qx);
+        out[1] = fmadd(a, py, b * qy);
+        out[2] = fmadd(a, pz, b * qz);
+        out[3] = fmadd(a, pw, b * qw);
+    }
+};
+
+/*
+    Weights (1 - t) and t, with the result renormalized.
+*/
+struct NlerpOp
+{
+    void operator()(const V *in, V *out) const
+    {
+        V px = in[0], py = in[1], pz = in[2], pw = in[3];
+        V qx = in[4], qy = in[5], qz = in[6], qw = in[7];
+        V t = in[8];
+
+        V cosTheta = fmadd(px, qx, fmadd(py, qy, fmadd(pz, qz, pw * qw)));
+
+        V a = V(1.0) - t;
+        V b = select(cosTheta < V(0.0), -t, t);
+
+        V x = fmadd(a, px, b * qx);
+        V y = fmadd(a, py, b * qy);
+        V z = fmadd(a, pz, b * qz);
+        V w = fmadd(a, pw, b * qw);
+
+        V length = sqrt(fmadd(x, x, fmadd(y, y, fmadd(z, z, w * w))));
+        V k = select(length > V(0.0), V(1.0) / select(length > V(0.0), length, V(1.0)), V(0.0));
+
+        out[0] = x * k;
+        out[1] = y * k;
+        out[2] = z * k;
+        out[3] = w * k;
+    }
+};
+
+/*
+    Eberly's polynomial approximation of the slerp weights (see kSlerpFast
+    in quatMath.h). Both weights share the powers of cosTheta - 1.
+*/
+struct FastSlerpOp
+{
+    void operator()(const V *in, V *out) const
+    {
+        V px = in[0], py = in[1], pz = in[2], pw = in[3];
+        V qx = in[4], qy = in[5], qz = in[6], qw = in[7];
+        V t = in[8];
+        V d = V(1.0) - t;
+
+        V cosTheta = fmadd(px, qx, fmadd(py, qy, fmadd(pz, qz, pw * qw)));
+        V sign = select(cosTheta < V(0.0), V(-1.0), V(1.0));
+        V xm1 = abs(cosTheta) - V(1.0);
+
+        V t2 = t * t;
+        V d2 = d * d;
+
+        V a = V(1.0);
+        V b = V(1.0);
+
+        for (int i = kFastSlerpTerms - 1; i >= 0; i--)
+        {
+            V u = V(kFastSlerpU[i]);
+            V v = V(kFastSlerpV[i]);
+
+            a = fmadd(fmadd(u, d2, -v) * xm1, a, V(1.0));
+            b = fmadd(fmadd(u, t2, -v) * xm1, b, V(1.0));
+        }
+
+        a = a * d;
+        b = b * t * sign;
+
+        out[0] = fmadd(a, px, b * qx);
+        out[1] = fmadd(a, py, b * qy);
+        out[2] = fmadd(a, pz, b * qz);
+        out[3] = fmadd(a, pw, b * qw);
+    }
+};
+
+/*
+    Runs Op, then exact slerp for the lanes with a non-zero spin. Only used
+    on chunks that have some spin.
+*/
+template <class Op, class Math>
+struct SpinFallbackOp
+{
+    SlerpOp<Math> exact;
+
+    explicit SpinFallbackOp(const Math &math) : exact(math) {}
+
+    void operator()(const V *in, V *out) const
+    {
+        V approx[4];
+
+        Op()(in, approx);
+        exact(in, out);
+
+        M noSpin = abs(in[9]) == V(0.0);
+
+        for (int k = 0; k < 4; k++)
+            out[k] = select(noSpin, approx[k], out[k]);
+    }
+};
+
+/*
+    in:  axisX axisY axisZ angle
+    out: x y z w
+*/
+template <class Math>
+struct AxisAngleToQuatOp
+{
+    Math math;
+
+    explicit AxisAngleToQuatOp(const Math &math) : math(math) {}
+
+    void operator()(const V *in, V *out) const
+    {
+        V ax = in[0], ay = in[1], az = in[2];
+
+        V length2 = fmadd(ax, ax, fmadd(ay, ay, az * az));
+        M valid = length2 > V(0.0);
+
+        V sinHalf, cosHalf;
+        math.sinCos(in[3] * V(0.5), sinHalf, cosHalf);
+
+        V k = select(valid, sinHalf / sqrt(select(valid, length2, V(1.0))), V(0.0));
+
+        out[0] = ax * k;
+        out[1] = ay * k;
+        out[2] = az * k;
+        out[3] = select(valid, cosHalf, V(1.0));
+    }
+};
+
+/*
+    in:  x y z w
+    out: axisX axisY axisZ angle nonZero (1.0 or 0.0)
+*/
+template <class Math>
+struct QuatToAxisAngleOp
+{
+    Math math;
+
+    explicit QuatToAxisAngleOp(const Math &math) : math(math) {}
+
+    void operator()(const V *in, V *out) const
+    {
+        V x = in[0], y = in[1], z = in[2], w = in[3];
+
+        V sinHalf = sqrt(fmadd(x, x, fmadd(y, y, z * z)));
+        M nonZero = sinHalf > V(kAxisAngleEpsilon);
+
+        V k = V(1.0) / select(nonZero, sinHalf, V(1.0));
+
+        out[0] = select(nonZero, x * k, V(0.0));
+        out[1] = select(nonZero, y * k, V(0.0));
+        out[2] = select(nonZero, z * k, V(0.0));
+        out[3] = select(nonZero, V(2.0) * math.atan2(sinHalf, w), V(0.0));
+        out[4] = select(nonZero, V(1.0), V(0.0));
+    }
+};
+
+template <class Math>
+void slerpWith(
+    const Math &math,
+    ConstQuatArrayViewT<Real> p,
+    ConstQuatArrayViewT<Real> q,
+    const Real *tween,
+    const short *spin,
+    QuatArrayViewT<Real> out,
+    size_t count,
+    SlerpMode mode
+) {
+    Real spinChunk[kChunkSize];
+
+    for (size_t begin = 0; begin < count; begin += kChunkSize)
+    {
+        size_t n = count - begin < kChunkSize ? count - begin : kChunkSize;
+        bool anySpin = false;
+
+        for (size_t i = 0; i < n; i++)
+        {
+            spinChunk[i] = spin ? Real(spin[begin + i]) : Real(0);
+            anySpin = anySpin || spinChunk[i] != Real(0);
+        }
+
+        const Real *in[10] = {
+            p.x + begin, p.y + begin, p.z + begin, p.w + begin,
+            q.x + begin, q.y + begin, q.z + begin, q.w + begin,
+            tween + begin, spinChunk
+        };
+
+        Real *const outStreams[4] = { out.x + begin, out.y + begin, out.z + begin, out.w + begin };
+
+        if (mode == kSlerpNlerp && anySpin)
+            runStreams<10, 4>(in, outStreams, n, SpinFallbackOp<NlerpOp, Math>(math));
+        else if (mode == kSlerpNlerp)
+            runStreams<10, 4>(in, outStreams, n, NlerpOp());
+        else if (mode == kSlerpFast && anySpin)
+            runStreams<10, 4>(in, outStreams, n, SpinFallbackOp<FastSlerpOp, Math>(math));
+        else if (mode == kSlerpFast)
+            runStreams<10, 4>(in, outStreams, n, FastSlerpOp());
+        else
+            runStreams<10, 4>(in, outStreams, n, SlerpOp<Math>(math));
+    }
+}
+
+void slerp(
+    ConstQuatArrayViewT<Real> p,
+    ConstQuatArrayViewT<Real> q,
+    const Real *tween,
+    const short *spin,
+    QuatArrayViewT<Real> out,
+    size_t count,
+    SlerpMode mode,
+    MathBackend math
+) {
+    if (math == kMathLibm)
+        slerpWith(LibmMath(), p, q, tween, spin, out, count, mode);
+    else if (math == kMathTable)
+        slerpWith(tableMath(), p, q, tween, spin, out, count, mode);
+    else
+        slerpWith(PolynomialMath(), p, q, tween, spin, out, count, mode);
+}
+
+template <class Math>
+void axisAngleToQuatWith(const Math &math, ConstVectorArrayViewT<Real> axis, const Real *angle, QuatArrayViewT<Real> out, size_t count)
+{
+    const Real *in[4] = { axis.x, axis.y, axis.z, angle };
+    Real *const outStreams[4] = { out.x, out.y, out.z, out.w };
+
+    runStreams<4, 4>(in, outStreams, count, AxisAngleToQuatOp<Math>(math));
+}
+
+void axisAngleToQuat(ConstVectorArrayViewT<Real> axis, const Real *angle, QuatArrayViewT<Real> out, size_t count, MathBackend math)
+{
+    if (math == kMathLibm)
+        axisAngleToQuatWith(LibmMath(), axis, angle, out, count);
+    else if (math == kMathTable)
+        axisAngleToQuatWith(tableMath(), axis, angle, out, count);
+    else
+        axisAngleToQuatWith(PolynomialMath(), axis, angle, out, count);
+}
+
+template <class Math>
+void quatToAxisAngleWith(
+    const Math &math,
+    ConstQuatArrayViewT<Real> q,
+    VectorArrayViewT<Real> axis,
+    Real *angle,
+    unsigned char *nonZero,
+    size_t count
+) {
+    Real nonZeroChunk[kChunkSize];
+
+    for (size_t begin = 0; begin < count; begin += kChunkSize)
+    {
+        size_t n = count - begin < kChunkSize ? count - begin : kChunkSize;
+
+        const Real *in[4] = { q.x + begin, q.y + begin, q.z + begin, q.w + begin };
+        Real *const outStreams[5] = { axis.x + begin, axis.y + begin, axis.z + begin, angle + begin, nonZeroChunk };
+
+        runStreams<4, 5>(in, outStreams, n, QuatToAxisAngleOp<Math>(math));
+
+        if (nonZero)
+        {
+            for (size_t i = 0; i < n; i++)
+                nonZero[begin + i] = nonZeroChunk[i] != Real(0) ? 1 : 0;
+        }
+    }
+}
+
+void quatToAxisAngle(
+    ConstQuatArrayViewT<Real> q,
+    VectorArrayViewT<Real> axis,
+    Real *angle,
+    unsigned char *nonZero,
+    size_t count,
+    MathBackend math
+) {
+    if (math == kMathLibm)
+        quatToAxisAngleWith(LibmMath(), q, axis, angle, nonZero, count);
+    else if (math == kMathTable)
+        quatToAxisAngleWith(tableMath(), q, axis, angle, nonZero, count);
+    else
+        quatToAxisAngleWith(PolynomialMath(), q, axis, angle, nonZero, count);
+}
+
+/*-----------------------------------------------------------------------------
+    Everything below is double only. QUAT_EXTRAS_SINGLE_PRECISION is defined
+    when this file is included with a float V; the kernels above compile for
+    both.
+-----------------------------------------------------------------------------*/
+
+#if !defined(QUAT_EXTRAS_SINGLE_PRECISION)
+
+/*
+    in:  x y z w axisX axisY axisZ
+    out: swingX swingY swingZ swingW twistX twistY twistZ twistW twistAngle
+*/
+struct SwingTwistOp
+{
+    void operator()(const V *in, V *out) const
+    {
+        V x = in[0], y = in[1], z = in[2], w = in[3];
+        V ax = in[4], ay = in[5], az = in[6];
+
+        V length2 = fmadd(ax, ax, fmadd(ay, ay, az * az));
+        M validAxis = length2 > V(0.0);
+
+        V invLength = V(1.0) / sqrt(select(validAxis, length2, V(1.0)));
+        V ux = ax * invLength, uy = ay * invLength, uz = az * invLength;
+
+        // Projection of q onto the axis, in the w >= 0 hemisphere.
+        V sign = select(w < V(0.0), V(-1.0), V(1.0));
+        V s = fmadd(x, ux, fmadd(y, uy, z * uz)) * sign;
+        V c = w * sign;
+
+        V norm = sqrt(fmadd(s, s, c * c));
+        M valid = validAxis & (norm > V(kAxisAngleEpsilon));
+
+        V k = V(1.0) / select(valid, norm, V(1.0));
+        V sinHalf = select(valid, s * k, V(0.0));
+        V cosHalf = select(valid, c * k, V(1.0));
+
+        V tx = ux * sinHalf, ty = uy * sinHalf, tz = uz * sinHalf;
+
+        // swing = q * conjugate(twist)
+        out[0] = fmadd(x, cosHalf, fmadd(z, ty, -fmadd(w, tx, y * tz)));
+        out[1] = fmadd(y, cosHalf, fmadd(x, tz, -fmadd(w, ty, z * tx)));
+        out[2] = fmadd(z, cosHalf, fmadd(y, tx, -fmadd(w, tz, x * ty)));
+        out[3] = fmadd(w, cosHalf, fmadd(x, tx, fmadd(y, ty, z * tz)));
+
+        out[4] = tx;
+        out[5] = ty;
+        out[6] = tz;
+        out[7] = cosHalf;
+
+        out[8] = select(valid, V(2.0) * vAtan2(s, c), V(0.0));
+    }
+};
+
+/*
+    in:  eulerX eulerY eulerZ
+    out: x y z w
+
+    I, J and K are the axes in the order they are applied; Parity is +1
+    when they are a cyclic permutation of x y z. See eulerToQuat in
+    quatMath.h.
+*/
+template <int I, int J, int K, int Parity>
+struct EulerToQuatOp
+{
+    void operator()(const V *in, V *out) const
+    {
+        V si, ci, sj, cj, sk, ck;
+
+        vSinCos(in[I] * V(0.5), si, ci);
+        vSinCos(in[J] * V(0.5), sj, cj);
+        vSinCos(in[K] * V(0.5), sk, ck);
+
+        V p = V((double) Parity);
+
+        V cicj = ci * cj;
+        V sisj = si * sj;
+        V sicj = si * cj;
+        V cisj = ci * sj;
+
+        out[I] = fmadd(sicj, ck, -p * cisj * sk);
+        out[J] = fmadd(cisj, ck, p * sicj * sk);
+        out[K] = fmadd(cicj, sk, -p * sisj * ck);
+        out[3] = fmadd(cicj, ck, p * sisj * sk);
+    }
+};
+
+// Row A, column B of the rotation matrix of q; see rotationElement in
+// quatMath.h.
+template <int A, int B>
+inline V rotationElement(const V *q)
+{
+    if (A == B)
+    {
+        const int C1 = (A + 1) % 3;
+        const int C2 = (A + 2) % 3;
+
+        return V(1.0) - V(2.0) * fmadd(q[C1], q[C1], q[C2] * q[C2]);
+    }
+
+    V wc = q[3] * q[3 - A - B];
+
+    return V(2.0) * (B == (A + 1) % 3 ? fmadd(q[A], q[B], -wc) : fmadd(q[A], q[B], wc));
+}
+
+/*
+    in:  x y z w
+    out: eulerX eulerY eulerZ
+*/
+template <int I, int J, int K, int Parity>
+struct QuatToEulerOp
+{
+    void operator()(const V *in, V *out) const
+    {
+        V p = V((double) Parity);
+
+        V rii = rotationElement<I, I>(in);
+        V rji = rotationElement<J, I>(in);
+
+        V cosMiddle = sqrt(fmadd(rii, rii, rji * rji));
+        M gimbal = cosMiddle <= V(kEulerGimbalEpsilon);
+
+        V first = vAtan2(p * rotationElement<K, J>(in), rotationElement<K, K>(in));
+        V firstLocked = vAtan2(-p * rotationElement<J, K>(in), rotationElement<J, J>(in));
+
+        out[I] = select(gimbal, firstLocked, first);
+        out[J] = vAtan2(-p * rotationElement<K, I>(in), cosMiddle);
+        out[K] = select(gimbal, V(0.0), vAtan2(p * rji, rii));
+    }
+};
+
+inline V vClosestAngle(V angle, V target)
+{
+    return fmadd(round((target - angle) * V(0.5 / kPi)), V(2.0 * kPi), angle);
+}
+
+/*
+    in:  eulerX eulerY eulerZ previousX previousY previousZ
+    out: eulerX eulerY eulerZ
+
+    J is the middle axis of the rotate order; see eulerFilter in
+    quatMath.h.
+*/
+template <int J>
+struct EulerFilterOp
+{
+    void operator()(const V *in, V *out) const
+    {
+        V a[3];
+        V b[3];
+        V distanceA = V(0.0);
+        V distanceB = V(0.0);
+
+        for (int i = 0; i < 3; i++)
+        {
+            a[i] = vClosestAngle(in[i], in[3 + i]);
+            b[i] = vClosestAngle(i == J ? V(kPi) - in[i] : in[i] + V(kPi), in[3 + i]);
+
+            distanceA = distanceA + abs(a[i] - in[3 + i]);
+            distanceB = distanceB + abs(b[i] - in[3 + i]);
+        }
+
+        M useB = distanceB < distanceA;
+
+        for (int i = 0; i < 3; i++)
+            out[i] = select(useB, b[i], a[i]);
+    }
+};
+
+/*
+    Rotation vector of q, folded onto w >= 0; see quatToRotationVector in
+    quatMath.h. Zero quaternions give a zero vector.
+*/
+inline void vRotationVector(const V *q, V *out)
+{
+    V sign = copysign(V(2.0), q[3]);
+    V w = abs(q[3]);
+
+    V sinHalf = sqrt(fmadd(q[0], q[0], fmadd(q[1], q[1], q[2] * q[2])));
+
+    M series = sinHalf < V(kLogSeriesThreshold) * w;
+
+    V t = sinHalf / select(series, w, V(1.0));
+    V atanSeries = fmadd(t * t, fmadd(t * t, V(0.2), V(-1.0 / 3.0)), V(1.0));
+
+    M zero = sinHalf == V(0.0);
+    V k = select(series, atanSeries / w, vAtan2(sinHalf, w) / select(zero, V(1.0), sinHalf));
+    k = select(andNot(zero, series), V(0.0), k) * sign;
+
+    out[0] = q[0] * k;
+    out[1] = q[1] * k;
+    out[2] = q[2] * k;
+}
+
+/*
+    Quaternion of the rotation vector v; see rotationVectorToQuat in
+    quatMath.h.
+*/
+inline void vRotationVectorToQuat(const V *v, V *out)
+{
+    V halfAngle = V(0.5) * sqrt(fmadd(v[0], v[0], fmadd(v[1], v[1], v[2] * v[2])));
+
+    V s, c;
+    vSinCos(halfAngle, s, c);
+
+    M series = halfAngle < V(kLogSeriesThreshold);
+
+    V h2 = halfAngle * halfAngle;
+    V sinSeries = fmadd(h2, fmadd(h2, V(1.0 / 120.0), V(-1.0 / 6.0)), V(1.0));
+
+    V k = V(0.5) * select(series, sinSeries, s / select(series, V(1.0), halfAngle));
+
+    out[0] = v[0] * k;
+    out[1] = v[1] * k;
+    out[2] = v[2] * k;
+    out[3] = c;
+}
+
+/*
+    in:  x y z w
+    out: rotation vector x y z
+*/
+struct RotationVectorOp
+{
+    void operator()(const V *in, V *out) const
+    {
+        vRotationVector(in, out);
+    }
+};
+
+/*
+    in:  rotation vector x y z
+    out: x y z w
+*/
+struct RotationVectorToQuatOp
+{
+    void operator()(const V *in, V *out) const
+    {
+        vRotationVectorToQuat(in, out);
+    }
+};
+
+/*
+    in:  x y z w power
+    out: x y z w
+*/
+struct QuatPowerOp
+{
+    void operator()(const V *in, V *out) const
+    {
+        V v[3];
+        vRotationVector(in, v);
+
+        v[0] = v[0] * in[4];
+        v[1] = v[1] * in[4];
+        v[2] = v[2] * in[4];
+
+        vRotationVectorToQuat(v, out);
+    }
+};
+
+/*
+    Orthonormalizes the 3x3 matrix m (m[3 * row + column]) in place; see
+    orthonormalizeRows in quatMath.h.
+*/
+inline void vOrthonormalizeRows(V *m)
+{
+    const V tiny = V(1.0e-300);
+
+    V xLength = sqrt(fmadd(m[0], m[0], fmadd(m[1], m[1], m[2] * m[2])));
+    V xInv = V(1.0) / max(xLength, tiny);
+
+    m[0] = m[0] * xInv;
+    m[1] = m[1] * xInv;
+    m[2] = m[2] * xInv;
+
+    V d = fmadd(m[3], m[0], fmadd(m[4], m[1], m[5] * m[2]));
+
+    m[3] = fmadd(-d, m[0], m[3]);
+    m[4] = fmadd(-d, m[1], m[4]);
+    m[5] = fmadd(-d, m[2], m[5]);
+
+    V yLength = sqrt(fmadd(m[3], m[3], fmadd(m[4], m[4], m[5] * m[5])));
+    V yInv = V(1.0) / max(yLength, tiny);
+
+    m[3] = m[3] * yInv;
+    m[4] = m[4] * yInv;
+    m[5] = m[5] * yInv;
+
+    m[6] = fmadd(m[1], m[5], -m[2] * m[4]);
+    m[7] = fmadd(m[2], m[3], -m[0] * m[5]);
+    m[8] = fmadd(m[0], m[4], -m[1] * m[3]);
+}
+
+/*
+    Shepperd's method without branches: every lane computes all four
+    cases' inputs and selects by its largest component, with the same tie
+    order as matrixToQuat in quatMath.h.
+*/
+inline void vMatrixToQuat(const V *m, V *out)
+{
+    V tx = V(1.0) + m[0] - m[4] - m[8];
+    V ty = V(1.0) - m[0] + m[4] - m[8];
+    V tz = V(1.0) - m[0] - m[4] + m[8];
+    V tw = V(1.0) + m[0] + m[4] + m[8];
+
+    M isW = tw >= max(max(tx, ty), tz);
+    M isX = andNot((tx >= ty) & (tx >= tz), isW);
+    M isY = andNot(andNot(ty >= tz, isW), isX);
+
+    V wx = m[5] - m[7];
+    V wy = m[6] - m[2];
+    V wz = m[1] - m[3];
+    V xy = m[1] + m[3];
+    V xz = m[2] + m[6];
+    V yz = m[5] + m[7];
+
+    V t = select(isW, tw, select(isX, tx, select(isY, ty, tz)));
+    V s = sqrt(t);
+    V half = V(0.5) * s;
+    V inv = V(0.5) / s;
+
+    V x = select(isX, half, select(isW, wx, select(isY, xy, xz)) * inv);
+    V y = select(isY, half, select(isW, wy, select(isX, xy, yz)) * inv);
+    V z = select(isW | isX | isY, select(isW, wz, select(isX, xz, yz)) * inv, half);
+    V w = select(isW, half, select(isX, wx, select(isY, wy, wz)) * inv);
+
+    V sign = copysign(V(1.0), w);
+
+    out[0] = x * sign;
+    out[1] = y * sign;
+    out[2] = z * sign;
+    out[3] = w * sign;
+}
+
+/*
+    in:  m00 m01 m02 m10 m11 m12 m20 m21 m22
+    out: x y z w
+*/
+struct MatrixToQuatOp
+{
+    void operator()(const V *in, V *out) const
+    {
+        V m[9];
+
+        for (int k = 0; k < 9; k++)
+            m[k] = in[k];
+
+        vOrthonormalizeRows(m);
+        vMatrixToQuat(m, out);
+    }
+};
+
+/*
+    in:  the nine elements of a, then the nine of b
+    out: x y z w of a * b
+*/
+struct MatrixProductToQuatOp
+{
+    void operator()(const V *in, V *out) const
+    {
+        const V *a = in;
+        const V *b = in + 9;
+
+        V m[9];
+
+        for (int r = 0; r < 3; r++)
+        {
+            for (int c = 0; c < 3; c++)
+                m[3 * r + c] = fmadd(a[3 * r], b[c], fmadd(a[3 * r + 1], b[3 + c], a[3 * r + 2] * b[6 + c]));
+        }
+
+        vOrthonormalizeRows(m);
+        vMatrixToQuat(m, out);
+    }
+};
+
+void quatToRotationVector(ConstQuatArrayView q, VectorArrayView out, size_t count)
+{
+    const double *in[4] = { q.x, q.y, q.z, q.w };
+    double *const outStreams[3] = { out.x, out.y, out.z };
+
+    runStreams<4, 3>(in, outStreams, count, RotationVectorOp());
+}
+
+void rotationVectorToQuat(ConstVectorArrayView v, QuatArrayView out, size_t count)
+{
+    const double *in[3] = { v.x, v.y, v.z };
+    double *const outStreams[4] = { out.x, out.y, out.z, out.w };
+
+    runStreams<3, 4>(in, outStreams, count, RotationVectorToQuatOp());
+}
+
+void quatPower(ConstQuatArrayView q, const double *power, QuatArrayView out, size_t count)
+{
+    const double *in[5] = { q.x, q.y, q.z, q.w, power };
+    double *const outStreams[4] = { out.x, out.y, out.z, out.w };
+
+    runStreams<5, 4>(in, outStreams, count, QuatPowerOp());
+}
+
+void matrixToQuat(ConstMatrixArrayView matrix, const ConstMatrixArrayView *parentInverse, QuatArrayView out, size_t count)
+{
+    double *const outStreams[4] = { out.x, out.y, out.z, out.w };
+
+    if (parentInverse == 0)
+    {
+        runStreams<9, 4>(matrix.m, outStreams, count, MatrixToQuatOp());
+        return;
+    }
+
+    const double *in[18];
+
+    for (int k = 0; k < 9; k++)
+    {
+        in[k] = matrix.m[k];
+        in[9 + k] = parentInverse->m[k];
+    }
+
+    runStreams<18, 4>(in, outStreams, count, MatrixProductToQuatOp());
+}
+
+// The rotate order is resolved once per call, never per element.
+void eulerToQuat(ConstVectorArrayView euler, RotateOrder order, QuatArrayView out, size_t count)
+{
+    const double *in[3] = { euler.x, euler.y, euler.z };
+    double *const outStreams[4] = { out.x, out.y, out.z, out.w };
+
+    switch (order)
+    {
+        case kRotateXYZ: runStreams<3, 4>(in, outStreams, count, EulerToQuatOp<0, 1, 2, 1>()); break;
+        case kRotateYZX: runStreams<3, 4>(in, outStreams, count, EulerToQuatOp<1, 2, 0, 1>()); break;
+        case kRotateZXY: runStreams<3, 4>(in, outStreams, count, EulerToQuatOp<2, 0, 1, 1>()); break;
+        case kRotateXZY: runStreams<3, 4>(in, outStreams, count, EulerToQuatOp<0, 2, 1, -1>()); break;
+        case kRotateYXZ: runStreams<3, 4>(in, outStreams, count, EulerToQuatOp<1, 0, 2, -1>()); break;
+        case kRotateZYX: runStreams<3, 4>(in, outStreams, count, EulerToQuatOp<2, 1, 0, -1>()); break;
+    }
+}
+
+void quatToEuler(ConstQuatArrayView q, RotateOrder order, VectorArrayView euler, size_t count)
+{
+    const double *in[4] = { q.x, q.y, q.z, q.w };
+    double *const outStreams[3] = { euler.x, euler.y, euler.z };
+
+    switch (order)
+    {
+        case kRotateXYZ: runStreams<4, 3>(in, outStreams, count, QuatToEulerOp<0, 1, 2, 1>()); break;
+        case kRotateYZX: runStreams<4, 3>(in, outStreams, count, QuatToEulerOp<1, 2, 0, 1>()); break;
+        case kRotateZXY: runStreams<4, 3>(in, outStreams, count, QuatToEulerOp<2, 0, 1, 1>()); break;
+        case kRotateXZY: runStreams<4, 3>(in, outStreams, count, QuatToEulerOp<0, 2, 1, -1>()); break;
+        case kRotateYXZ: runStreams<4, 3>(in, outStreams, count, QuatToEulerOp<1, 0, 2, -1>()); break;
+        case kRotateZYX: runStreams<4, 3>(in, outStreams, count, QuatToEulerOp<2, 1, 0, -1>()); break;
+    }
+}
+
+void eulerFilter(ConstVectorArrayView euler, ConstVectorArrayView previous, RotateOrder order, VectorArrayView out, size_t count)
+{
+    const double *in[6] = { euler.x, euler.y, euler.z, previous.x, previous.y, previous.z };
+    double *const outStreams[3] = { out.x, out.y, out.z };
+
+    switch (kRotateOrderAxes[order][1])
+    {
+        case 0: runStreams<6, 3>(in, outStreams, count, EulerFilterOp<0>()); break;
+        case 1: runStreams<6, 3>(in, outStreams, count, EulerFilterOp<1>()); break;
+        case 2: runStreams<6, 3>(in, outStreams, count, EulerFilterOp<2>()); break;
+    }
+}
+
+void swingTwist(
+    ConstQuatArrayView q,
+    ConstVectorArrayView axis,
+    QuatArrayView swing,
+    QuatArrayView twist,
+    double *twistAngle,
+    size_t count
+) {
+    const double *in[7] = { q.x, q.y, q.z, q.w, axis.x, axis.y, axis.z };
+    double *const outStreams[9] = {
+        swing.x, swing.y, swing.z, swing.w,
+        twist.x, twist.y, twist.z, twist.w,
+        twistAngle
+    };
+
+    runStreams<7, 9>(in, outStreams, count, SwingTwistOp());
+}
+
+/*
+    m += sum of weight[i] * q[i] q[i]^T, as the upper triangle of the 4x4
+    matrix in the order xx xy xz xw yy yz yw zz zw ww. Each lane keeps its
+    own partial sums, which are added together at the end.
+*/
+inline void accumulateOuterProduct(V *sum, V x, V y, V z, V w, V weight)
+{
+    V wx = weight * x;
+    V wy = weight * y;
+    V wz = weight * z;
+    V ww = weight * w;
+
+    sum[0] = fmadd(wx, x, sum[0]);
+    sum[1] = fmadd(wx, y, sum[1]);
+    sum[2] = fmadd(wx, z, sum[2]);
+    sum[3] = fmadd(wx, w, sum[3]);
+    sum[4] = fmadd(wy, y, sum[4]);
+    sum[5] = fmadd(wy, z, sum[5]);
+    sum[6] = fmadd(wy, w, sum[6]);
+    sum[7] = fmadd(wz, z, sum[7]);
+    sum[8] = fmadd(wz, w, sum[8]);
+    sum[9] = fmadd(ww, w, sum[9]);
+}
+
+void outerProducts(ConstQuatArrayView q, const double *weight, size_t count, double m[10])
+{
+    const size_t width = V::width;
+
+    V sum[10];
+
+    for (int k = 0; k < 10; k++)
+        sum[k] = V(0.0);
+
+    size_t i = 0;
+
+    for (; i + width <= count; i += width)
+    {
+        accumulateOuterProduct(
+            sum,
+            V::load(q.x + i), V::load(q.y + i), V::load(q.z + i), V::load(q.w + i),
+            V::load(weight + i)
+        );
+    }
+
+    double buffer[5][V::width];
+
+    if (i < count)
+    {
+        // Padding lanes get zero weight, so they add nothing.
+        const double *in[5] = { q.x, q.y, q.z, q.w, weight };
+
+        for (int k = 0; k < 5; k++)
+        {
+            for (size_t j = 0; j < width; j++)
+                buffer[k][j] = i + j < count ? in[k][i + j] : 0.0;
+        }
+
+        accumulateOuterProduct(
+            sum,
+            V::load(buffer[0]), V::load(buffer[1]), V::load(buffer[2]), V::load(buffer[3]),
+            V::load(buffer[4])
+        );
+    }
+
+    for (int k = 0; k < 10; k++)
+    {
+        sum[k].store(buffer[0]);
+
+        for (size_t j = 0; j < width; j++)
+            m[k] += buffer[0][j];
+    }
+}
+
+/*
+    Loads and stores the first lanes of a register. A partial register goes
+    through a zero-padded buffer, as in runStreams.
+*/
+inline V loadLanes(const double *p, size_t lanes)
+{
+    if (lanes == V::width)
+        return V::load(p);
+
+    double buffer[V::width];
+
+    for (size_t j = 0; j < V::width; j++)
+        buffer[j] = j < lanes ? p[j] : 0.0;
+
+    return V::load(buffer);
+}
+
+inline void storeLanes(V v, double *p, size_t lanes)
+{
+    if (lanes == V::width)
+    {
+        v.store(p);
+        return;
+    }
+
+    double buffer[V::width];
+    v.store(buffer);
+
+    for (size_t j = 0; j < lanes; j++)
+        p[j] = buffer[j];
+}
+
+/*
+    One register of vertices at a time. Each lane walks its own CSR row;
+    rows shorter than the longest in the register add zero weights of
+    joint 0, so every step is one gather per dual quaternion component.
+*/
+void dqSkin(
+    ConstDualQuatArrayView joints,
+    ConstSkinWeightsView weights,
+    ConstVectorArrayView points,
+    VectorArrayView out,
+    size_t count
+) {
+    const size_t width = V::width;
+
+    const double *const jointStreams[8] = {
+        joints.real.x, joints.real.y, joints.real.z, joints.real.w,
+        joints.dual.x, joints.dual.y, joints.dual.z, joints.dual.w
+    };
+
+    for (size_t i = 0; i < count; i += width)
+    {
+        size_t lanes = count - i < width ? count - i : width;
+
+        unsigned rowBegin[V::width];
+        unsigned rowLength[V::width];
+        unsigned maxLength = 0;
+
+        for (size_t j = 0; j < width; j++)
+        {
+            rowBegin[j] = j < lanes ? weights.offset[i + j] : 0;
+            rowLength[j] = j < lanes ? weights.offset[i + j + 1] - rowBegin[j] : 0;
+
+            if (rowLength[j] > maxLength)
+                maxLength = rowLength[j];
+        }
+
+        V px = loadLanes(points.x + i, lanes);
+        V py = loadLanes(points.y + i, lanes);
+        V pz = loadLanes(points.z + i, lanes);
+
+        if (maxLength == 0)
+        {
+            storeLanes(px, out.x + i, lanes);
+            storeLanes(py, out.y + i, lanes);
+            storeLanes(pz, out.z + i, lanes);
+            continue;
+        }
+
+        int index[V::width];
+        double weight[V::width];
+
+        for (size_t j = 0; j < width; j++)
+            index[j] = rowLength[j] != 0 ? weights.influence[rowBegin[j]] : 0;
+
+        V pivot[4];
+
+        for (int c = 0; c < 4; c++)
+            pivot[c] = V::gather(jointStreams[c], index);
+
+        V blend[8];
+
+        for (int c = 0; c < 8; c++)
+            blend[c] = V(0.0);
+
+        for (unsigned k = 0; k < maxLength; k++)
+        {
+            for (size_t j = 0; j < width; j++)
+            {
+                bool used = k < rowLength[j];
+
+                index[j] = used ? weights.influence[rowBegin[j] + k] : 0;
+                weight[j] = used ? weights.weight[rowBegin[j] + k] : 0.0;
+            }
+
+            V dq[8];
+
+            for (int c = 0; c < 8; c++)
+                dq[c] = V::gather(jointStreams[c], index);
+
+            V w = V::load(weight);
+            V d = fmadd(dq[0], pivot[0], fmadd(dq[1], pivot[1], fmadd(dq[2], pivot[2], dq[3] * pivot[3])));
+
+            w = select(d < V(0.0), -w, w);
+
+            for (int c = 0; c < 8; c++)
+                blend[c] = fmadd(w, dq[c], blend[c]);
+        }
+
+        V length2 = fmadd(blend[0], blend[0], fmadd(blend[1], blend[1], fmadd(blend[2], blend[2], blend[3] * blend[3])));
+        M valid = length2 > V(0.0);
+
+        V inv = V(1.0) / sqrt(select(valid, length2, V(1.0)));
+
+        V rx = blend[0] * inv, ry = blend[1] * inv, rz = blend[2] * inv, rw = blend[3] * inv;
+        V dx = blend[4] * inv, dy = blend[5] * inv, dz = blend[6] * inv, dw = blend[7] * inv;
+
+        // p + 2 r x (r x p + w p), the rotation of p by the real part.
+        V tx = fmadd(ry, pz, fmadd(-rz, py, rw * px));
+        V ty = fmadd(rz, px, fmadd(-rx, pz, rw * py));
+        V tz = fmadd(rx, py, fmadd(-ry, px, rw * pz));
+
+        V qx = fmadd(V(2.0), fmadd(ry, tz, -rz * ty), px);
+        V qy = fmadd(V(2.0), fmadd(rz, tx, -rx * tz), py);
+        V qz = fmadd(V(2.0), fmadd(rx, ty, -ry * tx), pz);
+
+        // Plus the translation, the vector part of 2 d r*.
+        qx = fmadd(V(2.0), fmadd(rw, dx, fmadd(-dw, rx, fmadd(ry, dz, -rz * dy))), qx);
+        qy = fmadd(V(2.0), fmadd(rw, dy, fmadd(-dw, ry, fmadd(rz, dx, -rx * dz))), qy);
+        qz = fmadd(V(2.0), fmadd(rw, dz, fmadd(-dw, rz, fmadd(rx, dy, -ry * dx))), qz);
+
+        storeLanes(select(valid, qx, px), out.x + i, lanes);
+        storeLanes(select(valid, qy, py), out.y + i, lanes);
+        storeLanes(select(valid, qz, pz), out.z + i, lanes);
+    }
+}
+
+/*
+    in:  x y z w referenceX referenceY referenceZ referenceW
+    out: x y z w
+*/
+struct UnflipOp
+{
+    void operator()(const V *in, V *out) const
+    {
+        V d = fmadd(in[0], in[4], fmadd(in[1], in[5], fmadd(in[2], in[6], in[3] * in[7])));
+        M flip = d < V(0.0);
+
+        for (int c = 0; c < 4; c++)
+            out[c] = select(flip, -in[c], in[c]);
+    }
+};
+
+/*
+    in:  x y z w
+    out: x y z w
+*/
+struct CanonicalHemisphereOp
+{
+    void operator()(const V *in, V *out) const
+    {
+        V zero = V(0.0);
+        V key = select(in[3] == zero, select(in[0] == zero, select(in[1] == zero, in[2], in[1]), in[0]), in[3]);
+        M flip = key < zero;
+
+        for (int c = 0; c < 4; c++)
+            out[c] = select(flip, -in[c], in[c]);
+    }
+};
+
+void unflip(ConstQuatArrayView q, ConstQuatArrayView reference, QuatArrayView out, size_t count)
+{
+    const double *in[8] = { q.x, q.y, q.z, q.w, reference.x, reference.y, reference.z, reference.w };
+    double *const outStreams[4] = { out.x, out.y, out.z, out.w };
+
+    runStreams<8, 4>(in, outStreams, count, UnflipOp());
+}
+
+void canonicalHemisphere(ConstQuatArrayView q, QuatArrayView out, size_t count)
+{
+    const double *in[4] = { q.x, q.y, q.z, q.w };
+    double *const outStreams[4] = { out.x, out.y, out.z, out.w };
+
+    runStreams<4, 4>(in, outStreams, count, CanonicalHemisphereOp());
+}
+
+/*
+    in:  x
+    out: sin cos
+*/
+template <class Math>
+struct SinCosOp
+{
+    Math math;
+
+    explicit SinCosOp(const Math &math) : math(math) {}
+
+    void operator()(const V *in, V *out) const
+    {
+        math.sinCos(in[0], out[0], out[1]);
+    }
+};
+
+/*
+    in:  y x
+    out: angle
+*/
+template <class Math>
+struct Atan2Op
+{
+    Math math;
+
+    explicit Atan2Op(const Math &math) : math(math) {}
+
+    void operator()(const V *in, V *out) const
+    {
+        out[0] = math.atan2(in[0], in[1]);
+    }
+};
+
+void sinCos(const double *x, double *s, double *c, size_t count, MathBackend math)
+{
+    const double *in[1] = { x };
+    double *const outStreams[2] = { s, c };
+
+    if (math == kMathLibm)
+        runStreams<1, 2>(in, outStreams, count, SinCosOp<LibmMath>(LibmMath()));
+    else if (math == kMathTable)
+        runStreams<1, 2>(in, outStreams, count, SinCosOp<TableMath>(tableMath()));
+    else
+        runStreams<1, 2>(in, outStreams, count, SinCosOp<PolynomialMath>(PolynomialMath()));
+}
+
+void atan2(const double *y, const double *x, double *out, size_t count, MathBackend math)
+{
+    const double *in[2] = { y, x };
+    double *const outStreams[1] = { out };
+
+    if (math == kMathLibm)
+        runStreams<2, 1>(in, outStreams, count, Atan2Op<LibmMath>(LibmMath()));
+    else if (math == kMathTable)
+        runStreams<2, 1>(in, outStreams, count, Atan2Op<TableMath>(tableMath()));
+    else
+        runStreams<2, 1>(in, outStreams, count, Atan2Op<PolynomialMath>(PolynomialMath()));
+}
+
+#endif
@@ -0,0 +1,71 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*
+    SSE2 batch kernels. Two lanes, four in single precision. Baseline for every x86-64 CPU.
+*/
+
+#include "quatBatchKernels.h"
+#include "quatMath.h"
+#include "simd.h"
+
+#include <cstddef>
+
+namespace quatExtras
+{
+#if defined(QUAT_EXTRAS_HAS_SSE2)
+    namespace sse2f
+    {
+        typedef SSE2F V;
+        typedef SSE2FMask M;
+
+        #define QUAT_EXTRAS_SINGLE_PRECISION
+        #include "quatBatchKernels.inl"
+        #undef QUAT_EXTRAS_SINGLE_PRECISION
+    }
+
+    namespace sse2
+    {
+        typedef SSE2D V;
+        typedef SSE2DMask M;
+
+        #include "quatBatchKernels.inl"
+
+        const BatchKernels kernels = {
+            kSimdSSE2,
+            slerp,
+            axisAngleToQuat,
+            quatToAxisAngle,
+            quatToRotationVector,
+            rotationVectorToQuat,
+            quatPower,
+            matrixToQuat,
+            eulerToQuat,
+            quatToEuler,
+            eulerFilter,
+            swingTwist,
+            outerProducts,
+            dqSkin,
+            unflip,
+            canonicalHemisphere,
+            sinCos,
+            atan2,
+            sse2f::slerp,
+            sse2f::axisAngleToQuat,
+            sse2f::quatToAxisAngle
+        };
+    }
+
+    const BatchKernels* sse2BatchKernels()
+    {
+        return &sse2::kernels;
+    }
+#else
+    const BatchKernels* sse2BatchKernels()
+    {
+        return 0;
+    }
+#endif
+}
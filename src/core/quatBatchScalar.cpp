@@ -0,0 +1,64 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*
+    Scalar batch kernels. Portable fallback; always compiled.
+*/
+
+#include "quatBatchKernels.h"
+#include "quatMath.h"
+#include "simd.h"
+
+#include <cstddef>
+
+namespace quatExtras
+{
+    namespace scalarf
+    {
+        typedef ScalarF V;
+        typedef ScalarFMask M;
+
+        #define QUAT_EXTRAS_SINGLE_PRECISION
+        #include "quatBatchKernels.inl"
+        #undef QUAT_EXTRAS_SINGLE_PRECISION
+    }
+
+    namespace scalar
+    {
+        typedef ScalarD V;
+        typedef ScalarDMask M;
+
+        #include "quatBatchKernels.inl"
+
+        const BatchKernels kernels = {
+            kSimdScalar,
+            slerp,
+            axisAngleToQuat,
+            quatToAxisAngle,
+            quatToRotationVector,
+            rotationVectorToQuat,
+            quatPower,
+            matrixToQuat,
+            eulerToQuat,
+            quatToEuler,
+            eulerFilter,
+            swingTwist,
+            outerProducts,
+            dqSkin,
+            unflip,
+            canonicalHemisphere,
+            sinCos,
+            atan2,
+            scalarf::slerp,
+            scalarf::axisAngleToQuat,
+            scalarf::quatToAxisAngle
+        };
+    }
+
+    const BatchKernels* scalarBatchKernels()
+    {
+        return &scalar::kernels;
+    }
+}
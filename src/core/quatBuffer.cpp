@@ -0,0 +1,45 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "quatBuffer.h"
+#include "quatBatch.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace quatExtras
+{
+    namespace
+    {
+        const size_t kAlignmentDoubles = QuatBuffer::kAlignment / sizeof(double);
+    }
+
+    QuatBuffer::QuatBuffer(size_t count) :
+        count_(count),
+        stride_((count + kAlignmentDoubles - 1) / kAlignmentDoubles * kAlignmentDoubles),
+        storage_(4 * stride_ + kAlignmentDoubles, 0.0)
+    {
+        // The vector is never resized, so the aligned start stays put.
+        uintptr_t address = reinterpret_cast<uintptr_t>(storage_.data());
+        uintptr_t aligned = (address + kAlignment - 1) / kAlignment * kAlignment;
+
+        planes_ = storage_.data() + (aligned - address) / sizeof(double);
+
+        std::fill(planes_ + 3 * stride_, planes_ + 3 * stride_ + count_, 1.0);
+    }
+
+    QuatArrayView QuatBuffer::view()
+    {
+        QuatArrayView result = { planes_, planes_ + stride_, planes_ + 2 * stride_, planes_ + 3 * stride_ };
+        return result;
+    }
+
+    ConstQuatArrayView QuatBuffer::view() const
+    {
+        ConstQuatArrayView result = { planes_, planes_ + stride_, planes_ + 2 * stride_, planes_ + 3 * stride_ };
+        return result;
+    }
+}
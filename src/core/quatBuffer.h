@@ -0,0 +1,61 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatBuffer
+    Maya-free quaternion storage for handing whole arrays from one node to
+    the next. The x, y, z and w planes share a single allocation, each
+    starting on a kAlignment byte boundary, so they can be passed straight
+    to the batch kernels as a view.
+
+    Buffers are shared, not copied: a node builds one, then publishes it
+    as a SharedQuatBuffer, after which nobody writes to it. Every reader,
+    and every copy Maya makes of the data holding it, refers to the same
+    quaternions.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_QUAT_BUFFER_H
+#define QUAT_EXTRAS_QUAT_BUFFER_H
+
+#include "quatBatch.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace quatExtras
+{
+    class QuatBuffer
+    {
+    public:
+        // Alignment of each plane, in bytes: a cache line, and an AVX-512
+        // register.
+        static const size_t kAlignment = 64;
+
+        // count identity quaternions.
+        explicit                QuatBuffer(size_t count = 0);
+
+        size_t                  size() const { return count_; }
+
+        QuatArrayView           view();
+        ConstQuatArrayView      view() const;
+
+    private:
+                                QuatBuffer(const QuatBuffer&);
+        QuatBuffer&             operator=(const QuatBuffer&);
+
+        size_t                  count_;
+
+        // Doubles from the start of one plane to the next.
+        size_t                  stride_;
+
+        std::vector<double>     storage_;
+        double                 *planes_;
+    };
+
+    typedef std::shared_ptr<const QuatBuffer> SharedQuatBuffer;
+}
+
+#endif
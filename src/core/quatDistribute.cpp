@@ -0,0 +1,124 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "quatDistribute.h"
+#include "quatBatch.h"
+#include "quatBatchKernels.h"
+#include "quatMath.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace quatExtras
+{
+    namespace
+    {
+        // Tweens evaluated per sinCosBatch call by the tween overload.
+        const size_t kChunkSize = 256;
+
+        inline void blend(const double p[4], const double q[4], double a, double b, QuatArrayView out, size_t i)
+        {
+            out.x[i] = a * p[0] + b * q[0];
+            out.y[i] = a * p[1] + b * q[1];
+            out.z[i] = a * p[2] + b * q[2];
+            out.w[i] = a * p[3] + b * q[3];
+        }
+
+        // Exact slerp weights from sin and cos of t * phi (see slerpWeights).
+        inline void blendExact(const double p[4], const double q[4], const SlerpSetup &setup, double sinTPhi, double cosTPhi, QuatArrayView out, size_t i)
+        {
+            double b = sinTPhi * setup.invSinTheta;
+            double a = cosTPhi - setup.cosTheta * b;
+
+            blend(p, q, a, b * setup.sign, out, i);
+        }
+
+        inline void blendLinear(const double p[4], const double q[4], const SlerpSetup &setup, double t, QuatArrayView out, size_t i)
+        {
+            blend(p, q, 1.0 - t, t * setup.sign, out, i);
+        }
+    }
+
+    void distributeSlerp(const double p[4], const double q[4], short spin, QuatArrayView out, size_t count)
+    {
+        if (count == 0)
+            return;
+
+        MathBackend backend = defaultMathBackend();
+        SlerpSetup setup = slerpSetup(p, q, spin, backend);
+
+        if (count == 1)
+        {
+            double a, b;
+            slerpWeights(setup, 0.5, kSlerpExact, backend, a, b);
+            blend(p, q, a, b, out, 0);
+            return;
+        }
+
+        double step = 1.0 / (double) (count - 1);
+
+        if (setup.linear)
+        {
+            for (size_t i = 0; i < count; i++)
+                blendLinear(p, q, setup, (double) i * step, out, i);
+
+            return;
+        }
+
+        const BatchKernels *scalar = scalarBatchKernels();
+
+        double delta = setup.phi * step;
+        double sinDelta, cosDelta;
+        scalar->sinCos(&delta, &sinDelta, &cosDelta, 1, backend);
+
+        double s = 0.0;
+        double c = 1.0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (i % kRecurrenceRestart == 0 && i != 0)
+            {
+                double angle = (double) i * delta;
+                scalar->sinCos(&angle, &s, &c, 1, backend);
+            }
+
+            blendExact(p, q, setup, s, c, out, i);
+
+            double next = c * cosDelta - s * sinDelta;
+            s = s * cosDelta + c * sinDelta;
+            c = next;
+        }
+    }
+
+    void distributeSlerp(const double p[4], const double q[4], short spin, const double *tween, QuatArrayView out, size_t count)
+    {
+        SlerpSetup setup = slerpSetup(p, q, spin, defaultMathBackend());
+
+        if (setup.linear)
+        {
+            for (size_t i = 0; i < count; i++)
+                blendLinear(p, q, setup, tween[i], out, i);
+
+            return;
+        }
+
+        double tPhi[kChunkSize];
+        double sinTPhi[kChunkSize];
+        double cosTPhi[kChunkSize];
+
+        for (size_t start = 0; start < count; start += kChunkSize)
+        {
+            size_t n = std::min(kChunkSize, count - start);
+
+            for (size_t i = 0; i < n; i++)
+                tPhi[i] = tween[start + i] * setup.phi;
+
+            sinCosBatch(tPhi, sinTPhi, cosTPhi, n);
+
+            for (size_t i = 0; i < n; i++)
+                blendExact(p, q, setup, sinTPhi[i], cosTPhi[i], out, start + i);
+        }
+    }
+}
@@ -0,0 +1,652 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatMath
+    Maya-free scalar quaternion kernels shared by the quatExtras nodes.
+
+    Quaternions are passed as four doubles in (x, y, z, w) order, which is
+    the component order of the compound attributes on the nodes.
+
+    slerp follows the extra-spin formulation from Graphics Gems III
+    (J. Morrison, "Quaternion Interpolation with Extra Spins"), which is the
+    behaviour of MQuaternion's slerp(p, q, t, spin):
+
+        cosTheta = |p.q|          (q is flipped onto p's hemisphere)
+        phi      = theta + spin * pi
+        a        = sin(theta - t * phi) / sin(theta)
+        b        = sin(t * phi) / sin(theta)
+        result   = a * p + b * q
+
+    When the endpoints are (nearly) parallel the weights fall back to a
+    linear blend and spin is ignored.
+
+    Two cheaper interpolation modes trade accuracy for speed. Both honour
+    spin by falling back to the exact weights whenever spin is non-zero.
+
+    kSlerpNlerp     normalized (1 - t) * p + t * q. Exact at t = 0, 0.5 and
+                    1; in between it runs ahead of slerp near the ends and
+                    behind it near the middle. The error grows with the
+                    angle between the inputs: about 0.0006 radians of
+                    rotation for inputs 30 degrees apart, 0.016 radians at
+                    90 degrees, and 0.14 radians (8 degrees) at 180 degrees.
+
+    kSlerpFast      D. Eberly, "A Fast and Accurate Algorithm for Computing
+                    SLERP" (2011). sin(t * theta) / sin(theta) is expanded
+                    as a polynomial in cos(theta) - 1, truncated to eight
+                    terms with a corrected last coefficient, so the weights
+                    cost sixteen multiply-adds and no transcendentals. Over
+                    the whole input range the weights are within 2e-5 of
+                    the exact ones and the result is within 1.7e-5 radians
+                    (0.001 degrees) of rotation of exact slerp. The result
+                    is not renormalized; its length is within 3e-5 of 1.
+
+    axisAngleToQuat normalizes the axis; a zero-length axis gives the
+    identity. quatToAxisAngle reports the rotation angle in [0, 2pi] and
+    returns false (with a zero axis and angle) when the vector part is too
+    short to define an axis, matching the nonZero result of
+    MQuaternion::getAxisAngle.
+
+    Euler angles are in radians, indexed by axis (x, y, z) whatever the
+    rotate order. RotateOrder matches the values of a transform's
+    rotateOrder: kRotateXYZ turns about X first, then Y, then Z, the same
+    as MEulerRotation::asQuaternion. quatToEuler returns the middle angle in
+    [-pi/2, pi/2] and the others in [-pi, pi]; in gimbal lock the last angle
+    is 0. eulerFilter picks the equivalent Euler rotation closest to a
+    previous one, as Maya's Euler filter does.
+
+    q and -q are the same rotation. unflip picks the sign on the hemisphere
+    of a reference quaternion, so consecutive samples of a track stay
+    close; canonicalHemisphere picks one by a fixed rule when there is no
+    reference.
+
+    matrixToQuat takes the upper 3x3 of a matrix in Maya's layout: row
+    vectors, so row 0 is where the matrix sends the x axis. Scale and shear
+    are removed first (orthonormalizeRows), keeping the direction of the x
+    axis and then the xy plane; a mirrored matrix gives the rotation with
+    its z axis flipped back. The quaternion is extracted with Shepperd's
+    method, so no component comes from the square root of a small number,
+    and always has w >= 0.
+
+    quatLog and quatExp map unit quaternions to and from their vector part
+    in the tangent space at the identity: log(q) = axis * angle / 2, with a
+    zero vector for the identity. Near the identity both switch to Taylor
+    series, so small rotations keep full relative precision instead of
+    going through acos(w) as MQuaternion::getAxisAngle does.
+
+    quatToRotationVector is 2 log(q) on the hemisphere w >= 0: axis * angle
+    with the angle in [0, pi], the shorter way round. Weighted sums of
+    rotation vectors blend rotations, and quatPower(q, p) = exp(p log(q))
+    turns p times as far about the same axis.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_QUAT_MATH_H
+#define QUAT_EXTRAS_QUAT_MATH_H
+
+#include <algorithm>
+#include <cmath>
+
+namespace quatExtras
+{
+    const double kPi = 3.14159265358979323846;
+
+    // Endpoints with 1 - |p.q| at or below this are blended linearly.
+    const double kSlerpEpsilon = 1.0e-10;
+
+    enum SlerpMode
+    {
+        kSlerpExact = 0,
+        kSlerpNlerp = 1,
+        kSlerpFast  = 2
+    };
+
+    // Polynomial coefficients for kSlerpFast: u[i] = 1 / (i (2i + 1)) and
+    // v[i] = i / (2i + 1) for i = 1..8, with the last pair scaled by 1 + mu.
+    const int    kFastSlerpTerms = 8;
+    const double kFastSlerpOnePlusMu = 1.85298109240830;
+
+    const double kFastSlerpU[kFastSlerpTerms] = {
+        1.0 / (1.0 * 3.0), 1.0 / (2.0 * 5.0), 1.0 / (3.0 * 7.0), 1.0 / (4.0 * 9.0),
+        1.0 / (5.0 * 11.0), 1.0 / (6.0 * 13.0), 1.0 / (7.0 * 15.0),
+        kFastSlerpOnePlusMu / (8.0 * 17.0)
+    };
+
+    const double kFastSlerpV[kFastSlerpTerms] = {
+        1.0 / 3.0, 2.0 / 5.0, 3.0 / 7.0, 4.0 / 9.0,
+        5.0 / 11.0, 6.0 / 13.0, 7.0 / 15.0,
+        kFastSlerpOnePlusMu * 8.0 / 17.0
+    };
+
+    // Quaternions whose vector part is no longer than this have no axis.
+    const double kAxisAngleEpsilon = 1.0e-10;
+
+    /*
+        Everything slerp derives from the endpoints and spin. Only the
+        tween-dependent part of the interpolation is left to slerpWeights,
+        so a setup can be kept while only the tween changes.
+    */
+    struct SlerpSetup
+    {
+        double cosTheta;
+        double sinTheta;
+        double invSinTheta;
+        double theta;
+        double phi;
+        double sign;
+        short  spin;
+        bool   linear;
+    };
+
+    inline double dot(const double p[4], const double q[4])
+    {
+        return p[0] * q[0] + p[1] * q[1] + p[2] * q[2] + p[3] * q[3];
+    }
+
+    inline SlerpSetup slerpSetup(const double p[4], const double q[4], short spin)
+    {
+        SlerpSetup setup;
+
+        double cosTheta = dot(p, q);
+
+        setup.sign = 1.0;
+
+        if (cosTheta < 0.0)
+        {
+            cosTheta = -cosTheta;
+            setup.sign = -1.0;
+        }
+
+        setup.cosTheta = cosTheta;
+        setup.spin = spin;
+        setup.linear = (1.0 - cosTheta) <= kSlerpEpsilon;
+
+        if (setup.linear)
+        {
+            setup.theta = 0.0;
+            setup.sinTheta = 0.0;
+            setup.invSinTheta = 0.0;
+            setup.phi = 0.0;
+        } else {
+            setup.theta = std::acos(cosTheta);
+            setup.sinTheta = std::sin(setup.theta);
+            setup.invSinTheta = 1.0 / setup.sinTheta;
+            setup.phi = setup.theta + spin * kPi;
+        }
+
+        return setup;
+    }
+
+    /*
+        Approximates sin(t * theta) / sin(theta) from cosTheta - 1 (see
+        kSlerpFast). Valid for t in [0, 1] and cosTheta in [0, 1].
+    */
+    inline double fastSlerpWeight(double cosThetaMinusOne, double t)
+    {
+        double t2 = t * t;
+        double result = 1.0;
+
+        for (int i = kFastSlerpTerms - 1; i >= 0; i--)
+            result = 1.0 + (kFastSlerpU[i] * t2 - kFastSlerpV[i]) * cosThetaMinusOne * result;
+
+        return t * result;
+    }
+
+    /*
+        Weights applied to p (a) and q (b) for the given tween. The hemisphere
+        flip is folded into b, and for kSlerpNlerp so is the normalization.
+        Non-zero spin always uses the exact weights.
+
+        The exact weights need a single sin/cos pair of t * phi:
+
+            sin(theta - t * phi) / sin(theta)
+                = cos(t * phi) - cos(theta) * sin(t * phi) / sin(theta)
+    */
+    inline void slerpWeights(const SlerpSetup &setup, double t, SlerpMode mode, double &a, double &b)
+    {
+        if (setup.spin != 0)
+            mode = kSlerpExact;
+
+        if (mode == kSlerpNlerp)
+        {
+            // |(1 - t) p + t q|^2 for unit p and q.
+            double length2 = (1.0 - t) * (1.0 - t) + t * t + 2.0 * t * (1.0 - t) * setup.cosTheta;
+            double k = 1.0 / std::sqrt(length2);
+
+            a = (1.0 - t) * k;
+            b = t * k;
+        } else if (mode == kSlerpFast) {
+            double xm1 = setup.cosTheta - 1.0;
+
+            a = fastSlerpWeight(xm1, 1.0 - t);
+            b = fastSlerpWeight(xm1, t);
+        } else if (setup.linear) {
+            a = 1.0 - t;
+            b = t;
+        } else {
+            double tPhi = t * setup.phi;
+
+            b = std::sin(tPhi) * setup.invSinTheta;
+            a = std::cos(tPhi) - setup.cosTheta * b;
+        }
+
+        b *= setup.sign;
+    }
+
+    inline void slerp(const double p[4], const double q[4], double t, short spin, SlerpMode mode, double out[4])
+    {
+        double a, b;
+
+        SlerpSetup setup = slerpSetup(p, q, spin);
+        slerpWeights(setup, t, mode, a, b);
+
+        out[0] = a * p[0] + b * q[0];
+        out[1] = a * p[1] + b * q[1];
+        out[2] = a * p[2] + b * q[2];
+        out[3] = a * p[3] + b * q[3];
+    }
+
+    inline void slerp(const double p[4], const double q[4], double t, short spin, double out[4])
+    {
+        slerp(p, q, t, spin, kSlerpExact, out);
+    }
+
+    inline void axisAngleToQuat(const double axis[3], double angle, double out[4])
+    {
+        double length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+
+        if (length == 0.0)
+        {
+            out[0] = out[1] = out[2] = 0.0;
+            out[3] = 1.0;
+            return;
+        }
+
+        double k = std::sin(angle * 0.5) / length;
+
+        out[0] = axis[0] * k;
+        out[1] = axis[1] * k;
+        out[2] = axis[2] * k;
+        out[3] = std::cos(angle * 0.5);
+    }
+
+    inline bool quatToAxisAngle(const double q[4], double axis[3], double &angle)
+    {
+        double sinHalfAngle = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2]);
+
+        if (sinHalfAngle <= kAxisAngleEpsilon)
+        {
+            axis[0] = axis[1] = axis[2] = 0.0;
+            angle = 0.0;
+            return false;
+        }
+
+        double k = 1.0 / sinHalfAngle;
+
+        axis[0] = q[0] * k;
+        axis[1] = q[1] * k;
+        axis[2] = q[2] * k;
+        angle = 2.0 * std::atan2(sinHalfAngle, q[3]);
+
+        return true;
+    }
+
+    /*
+        out = a * b (Hamilton product); out may alias a or b.
+    */
+    inline void quatMultiply(const double a[4], const double b[4], double out[4])
+    {
+        double x = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+        double y = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+        double z = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+        double w = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+
+        out[0] = x;
+        out[1] = y;
+        out[2] = z;
+        out[3] = w;
+    }
+
+    inline void quatConjugate(const double q[4], double out[4])
+    {
+        out[0] = -q[0];
+        out[1] = -q[1];
+        out[2] = -q[2];
+        out[3] = q[3];
+    }
+
+    /*
+        Splits q into swing * twist, where twist is the part of q about axis
+        and swing the rest, about an axis perpendicular to it. axis need not
+        be normalized. Twist is kept in the w >= 0 hemisphere, so the twist
+        angle returned is in [-pi, pi] radians. When axis is zero, or q
+        turns 180 degrees about an axis perpendicular to it, the twist is
+        the identity and the swing is q.
+    */
+    inline double swingTwist(const double q[4], const double axis[3], double swing[4], double twist[4])
+    {
+        double length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+
+        double unit[3] = { 0.0, 0.0, 0.0 };
+
+        if (length > 0.0)
+        {
+            unit[0] = axis[0] / length;
+            unit[1] = axis[1] / length;
+            unit[2] = axis[2] / length;
+        }
+
+        double sign = q[3] < 0.0 ? -1.0 : 1.0;
+        double s = sign * (q[0] * unit[0] + q[1] * unit[1] + q[2] * unit[2]);
+        double c = sign * q[3];
+        double norm = std::sqrt(s * s + c * c);
+
+        if (length == 0.0 || norm <= kAxisAngleEpsilon)
+        {
+            twist[0] = twist[1] = twist[2] = 0.0;
+            twist[3] = 1.0;
+
+            for (int i = 0; i < 4; i++)
+                swing[i] = q[i];
+
+            return 0.0;
+        }
+
+        twist[0] = unit[0] * s / norm;
+        twist[1] = unit[1] * s / norm;
+        twist[2] = unit[2] * s / norm;
+        twist[3] = c / norm;
+
+        double inverseTwist[4];
+        quatConjugate(twist, inverseTwist);
+        quatMultiply(q, inverseTwist, swing);
+
+        return 2.0 * std::atan2(s, c);
+    }
+
+    enum RotateOrder
+    {
+        kRotateXYZ = 0,
+        kRotateYZX = 1,
+        kRotateZXY = 2,
+        kRotateXZY = 3,
+        kRotateYXZ = 4,
+        kRotateZYX = 5
+    };
+
+    // Axes in the order they are applied, and +1 where they are a cyclic
+    // permutation of x y z.
+    const int kRotateOrderAxes[6][3] = { { 0, 1, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 0, 2, 1 }, { 1, 0, 2 }, { 2, 1, 0 } };
+    const double kRotateOrderParity[6] = { 1.0, 1.0, 1.0, -1.0, -1.0, -1.0 };
+
+    // Below this cosine of the middle angle quatToEuler treats the rotation
+    // as gimbal locked.
+    const double kEulerGimbalEpsilon = 1.0e-12;
+
+    inline void eulerToQuat(const double euler[3], RotateOrder order, double out[4])
+    {
+        int i = kRotateOrderAxes[order][0];
+        int j = kRotateOrderAxes[order][1];
+        int k = kRotateOrderAxes[order][2];
+        double p = kRotateOrderParity[order];
+
+        double si = std::sin(euler[i] * 0.5), ci = std::cos(euler[i] * 0.5);
+        double sj = std::sin(euler[j] * 0.5), cj = std::cos(euler[j] * 0.5);
+        double sk = std::sin(euler[k] * 0.5), ck = std::cos(euler[k] * 0.5);
+
+        out[i] = si * cj * ck - p * ci * sj * sk;
+        out[j] = ci * sj * ck + p * si * cj * sk;
+        out[k] = ci * cj * sk - p * si * sj * ck;
+        out[3] = ci * cj * ck + p * si * sj * sk;
+    }
+
+    // Row a, column b of the rotation matrix of unit quaternion q, acting
+    // on column vectors.
+    inline double rotationElement(const double q[4], int a, int b)
+    {
+        if (a == b)
+        {
+            int c1 = (a + 1) % 3;
+            int c2 = (a + 2) % 3;
+
+            return 1.0 - 2.0 * (q[c1] * q[c1] + q[c2] * q[c2]);
+        }
+
+        double wc = q[3] * q[3 - a - b];
+
+        return 2.0 * (b == (a + 1) % 3 ? q[a] * q[b] - wc : q[a] * q[b] + wc);
+    }
+
+    inline void quatToEuler(const double q[4], RotateOrder order, double euler[3])
+    {
+        int i = kRotateOrderAxes[order][0];
+        int j = kRotateOrderAxes[order][1];
+        int k = kRotateOrderAxes[order][2];
+        double p = kRotateOrderParity[order];
+
+        double rii = rotationElement(q, i, i);
+        double rji = rotationElement(q, j, i);
+
+        double cosMiddle = std::sqrt(rii * rii + rji * rji);
+
+        euler[j] = std::atan2(-p * rotationElement(q, k, i), cosMiddle);
+
+        if (cosMiddle > kEulerGimbalEpsilon)
+        {
+            euler[i] = std::atan2(p * rotationElement(q, k, j), rotationElement(q, k, k));
+            euler[k] = std::atan2(p * rji, rii);
+        } else {
+            euler[i] = std::atan2(-p * rotationElement(q, j, k), rotationElement(q, j, j));
+            euler[k] = 0.0;
+        }
+    }
+
+    // angle plus the multiple of 2pi that brings it closest to target.
+    inline double closestAngle(double angle, double target)
+    {
+        return angle + 2.0 * kPi * std::floor((target - angle) / (2.0 * kPi) + 0.5);
+    }
+
+    /*
+        The rotation euler, written as the Euler angles closest to previous.
+        Besides whole turns on each axis, (a + pi, pi - b, c + pi) with b
+        the middle axis of the rotate order is the same rotation.
+    */
+    inline void eulerFilter(const double euler[3], const double previous[3], RotateOrder order, double out[3])
+    {
+        int middle = kRotateOrderAxes[order][1];
+
+        double a[3];
+        double b[3];
+        double distanceA = 0.0;
+        double distanceB = 0.0;
+
+        for (int i = 0; i < 3; i++)
+        {
+            a[i] = closestAngle(euler[i], previous[i]);
+            b[i] = closestAngle(i == middle ? kPi - euler[i] : euler[i] + kPi, previous[i]);
+
+            distanceA += std::fabs(a[i] - previous[i]);
+            distanceB += std::fabs(b[i] - previous[i]);
+        }
+
+        for (int i = 0; i < 3; i++)
+            out[i] = distanceB < distanceA ? b[i] : a[i];
+    }
+
+    /*
+        q or -q, whichever is on the hemisphere of reference: dot >= 0. At
+        exactly 90 degrees in 4D (180 degrees of rotation apart) q is kept.
+    */
+    inline void unflip(const double q[4], const double reference[4], double out[4])
+    {
+        double sign = dot(q, reference) < 0.0 ? -1.0 : 1.0;
+
+        for (int i = 0; i < 4; i++)
+            out[i] = sign * q[i];
+    }
+
+    /*
+        q or -q, whichever has a positive first non-zero component in the
+        order w, x, y, z; the zero quaternion is kept. The same rotation
+        always gives the same result, whatever the sign it came in with.
+    */
+    inline void canonicalHemisphere(const double q[4], double out[4])
+    {
+        double key = q[3] != 0.0 ? q[3] : (q[0] != 0.0 ? q[0] : (q[1] != 0.0 ? q[1] : q[2]));
+        double sign = key < 0.0 ? -1.0 : 1.0;
+
+        for (int i = 0; i < 4; i++)
+            out[i] = sign * q[i];
+    }
+
+    /*
+        Gram-Schmidt on the rows of m: normalize x, make y perpendicular to
+        it and normalize, then z = x cross y. Zero length rows stay zero
+        rather than dividing by zero.
+    */
+    inline void orthonormalizeRows(const double m[3][3], double out[3][3])
+    {
+        const double tiny = 1.0e-300;
+
+        double xLength = std::sqrt(m[0][0] * m[0][0] + m[0][1] * m[0][1] + m[0][2] * m[0][2]);
+
+        for (int c = 0; c < 3; c++)
+            out[0][c] = m[0][c] / std::max(xLength, tiny);
+
+        double d = m[1][0] * out[0][0] + m[1][1] * out[0][1] + m[1][2] * out[0][2];
+
+        for (int c = 0; c < 3; c++)
+            out[1][c] = m[1][c] - d * out[0][c];
+
+        double yLength = std::sqrt(out[1][0] * out[1][0] + out[1][1] * out[1][1] + out[1][2] * out[1][2]);
+
+        for (int c = 0; c < 3; c++)
+            out[1][c] /= std::max(yLength, tiny);
+
+        out[2][0] = out[0][1] * out[1][2] - out[0][2] * out[1][1];
+        out[2][1] = out[0][2] * out[1][0] - out[0][0] * out[1][2];
+        out[2][2] = out[0][0] * out[1][1] - out[0][1] * out[1][0];
+    }
+
+    inline void matrixToQuat(const double m[3][3], double out[4])
+    {
+        double r[3][3];
+        orthonormalizeRows(m, r);
+
+        // Four times the squares of x, y, z and w.
+        double t[4] = {
+            1.0 + r[0][0] - r[1][1] - r[2][2],
+            1.0 - r[0][0] + r[1][1] - r[2][2],
+            1.0 - r[0][0] - r[1][1] + r[2][2],
+            1.0 + r[0][0] + r[1][1] + r[2][2]
+        };
+
+        int largest = 3;
+
+        for (int i = 0; i < 3; i++)
+        {
+            if (t[i] > t[largest])
+                largest = i;
+        }
+
+        // Four times the products of pairs of components.
+        double wx = r[1][2] - r[2][1];
+        double wy = r[2][0] - r[0][2];
+        double wz = r[0][1] - r[1][0];
+        double xy = r[0][1] + r[1][0];
+        double xz = r[0][2] + r[2][0];
+        double yz = r[1][2] + r[2][1];
+
+        double s = std::sqrt(t[largest]);
+        double half = 0.5 * s;
+        double inv = 0.5 / s;
+
+        switch (largest)
+        {
+            case 0: out[0] = half; out[1] = xy * inv; out[2] = xz * inv; out[3] = wx * inv; break;
+            case 1: out[0] = xy * inv; out[1] = half; out[2] = yz * inv; out[3] = wy * inv; break;
+            case 2: out[0] = xz * inv; out[1] = yz * inv; out[2] = half; out[3] = wz * inv; break;
+            default: out[0] = wx * inv; out[1] = wy * inv; out[2] = wz * inv; out[3] = half; break;
+        }
+
+        if (out[3] < 0.0)
+        {
+            for (int i = 0; i < 4; i++)
+                out[i] = -out[i];
+        }
+    }
+
+    // Below this tangent of the half angle, quatLog and quatExp use Taylor
+    // series. Their truncation error there is under 1e-19.
+    const double kLogSeriesThreshold = 1.0e-3;
+
+    // atan(t) / t and sin(h) / h from t * t and h * h, for small t and h.
+    inline double atanOverXSeries(double t2) { return 1.0 + t2 * (-1.0 / 3.0 + t2 * 0.2); }
+    inline double sinOverXSeries(double h2) { return 1.0 + h2 * (-1.0 / 6.0 + h2 * (1.0 / 120.0)); }
+
+    inline void quatLog(const double q[4], double out[3])
+    {
+        double sinHalfAngle = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2]);
+
+        // halfAngle / sin(halfAngle), where tan(halfAngle) = sinHalfAngle / w.
+        double k;
+
+        if (q[3] > 0.0 && sinHalfAngle < kLogSeriesThreshold * q[3])
+        {
+            double t = sinHalfAngle / q[3];
+            k = atanOverXSeries(t * t) / q[3];
+        } else {
+            k = sinHalfAngle > 0.0 ? std::atan2(sinHalfAngle, q[3]) / sinHalfAngle : 0.0;
+        }
+
+        out[0] = q[0] * k;
+        out[1] = q[1] * k;
+        out[2] = q[2] * k;
+    }
+
+    inline void quatExp(const double v[3], double out[4])
+    {
+        double halfAngle = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+        double k = halfAngle < kLogSeriesThreshold ? sinOverXSeries(halfAngle * halfAngle) : std::sin(halfAngle) / halfAngle;
+
+        out[0] = v[0] * k;
+        out[1] = v[1] * k;
+        out[2] = v[2] * k;
+        out[3] = std::cos(halfAngle);
+    }
+
+    inline void quatToRotationVector(const double q[4], double out[3])
+    {
+        double sign = q[3] < 0.0 ? -1.0 : 1.0;
+        double folded[4] = { sign * q[0], sign * q[1], sign * q[2], sign * q[3] };
+
+        quatLog(folded, out);
+
+        out[0] *= 2.0;
+        out[1] *= 2.0;
+        out[2] *= 2.0;
+    }
+
+    inline void rotationVectorToQuat(const double v[3], double out[4])
+    {
+        double half[3] = { 0.5 * v[0], 0.5 * v[1], 0.5 * v[2] };
+        quatExp(half, out);
+    }
+
+    inline void quatPower(const double q[4], double power, double out[4])
+    {
+        double v[3];
+        quatToRotationVector(q, v);
+
+        v[0] *= power;
+        v[1] *= power;
+        v[2] *= power;
+
+        rotationVectorToQuat(v, out);
+    }
+}
+
+#endif
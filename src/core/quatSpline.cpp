@@ -0,0 +1,256 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "quatSpline.h"
+#include "quatBatch.h"
+#include "quatMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace quatExtras
+{
+    namespace
+    {
+        struct ParameterLess
+        {
+            const double *parameters;
+
+            bool operator()(size_t a, size_t b) const
+            {
+                return parameters[a] < parameters[b];
+            }
+        };
+
+        void get(ConstQuatArrayView view, size_t i, double out[4])
+        {
+            out[0] = view.x[i];
+            out[1] = view.y[i];
+            out[2] = view.z[i];
+            out[3] = view.w[i];
+        }
+
+        void put(QuatArrayView view, size_t i, const double q[4])
+        {
+            view.x[i] = q[0];
+            view.y[i] = q[1];
+            view.z[i] = q[2];
+            view.w[i] = q[3];
+        }
+
+        /*
+            spin[i] = -1 where p[i] and q[i] are on opposite hemispheres, so
+            slerpBatch takes the "long" way, which is the direct path
+            between them. SQUAD needs its slerps unflipped.
+        */
+        void noFlipSpin(ConstQuatArrayView p, ConstQuatArrayView q, short *spin, size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                double d = p.x[i] * q.x[i] + p.y[i] * q.y[i] + p.z[i] * q.z[i] + p.w[i] * q.w[i];
+                spin[i] = d < 0.0 ? -1 : 0;
+            }
+        }
+
+        /*
+            log(q^-1 r) for unit q and r.
+        */
+        void logRelative(const double q[4], const double r[4], double out[3])
+        {
+            double qInverse[4];
+            double relative[4];
+
+            quatConjugate(q, qInverse);
+            quatMultiply(qInverse, r, relative);
+            quatLog(relative, out);
+        }
+
+        /*
+            q exp(v)
+        */
+        void expRelative(const double q[4], const double v[3], double out[4])
+        {
+            double offset[4];
+
+            quatExp(v, offset);
+            quatMultiply(q, offset, out);
+        }
+    }
+
+    void QuatSpline::setKeys(ConstQuatArrayView keys, const double *parameters, size_t count)
+    {
+        std::vector<size_t> order(count);
+
+        for (size_t i = 0; i < count; i++)
+            order[i] = i;
+
+        ParameterLess less = { parameters };
+        std::stable_sort(order.begin(), order.end(), less);
+
+        parameters_.resize(count);
+        keys_.resize(count);
+        outControl_.resize(count);
+        inControl_.resize(count);
+
+        QuatArrayView sortedKeys = keys_.view();
+
+        double previous[4] = { 0.0, 0.0, 0.0, 1.0 };
+
+        for (size_t j = 0; j < count; j++)
+        {
+            double q[4];
+            get(keys, order[j], q);
+
+            // Normalized, with zero-length keys as the identity, and on the
+            // same hemisphere as the previous key.
+            double length = std::sqrt(dot(q, q));
+            double k = length > 0.0 ? 1.0 / length : 0.0;
+
+            if (dot(q, previous) < 0.0)
+                k = -k;
+
+            for (int c = 0; c < 4; c++)
+                q[c] *= k;
+
+            if (length == 0.0)
+                q[3] = 1.0;
+
+            put(sortedKeys, j, q);
+            parameters_[j] = parameters[order[j]];
+
+            for (int c = 0; c < 4; c++)
+                previous[c] = q[c];
+        }
+
+        QuatArrayView outControl = outControl_.view();
+        QuatArrayView inControl = inControl_.view();
+
+        for (size_t j = 0; j < count; j++)
+        {
+            double q[4];
+            get(sortedKeys, j, q);
+
+            if (j == 0 || j + 1 == count)
+            {
+                put(outControl, j, q);
+                put(inControl, j, q);
+                continue;
+            }
+
+            double prev[4], next[4];
+            get(sortedKeys, j - 1, prev);
+            get(sortedKeys, j + 1, next);
+
+            // Chords to the neighbours in the tangent space at q.
+            double toNext[3], toPrev[3];
+            logRelative(q, next, toNext);
+            logRelative(q, prev, toPrev);
+
+            double h0 = parameters_[j] - parameters_[j - 1];
+            double h1 = parameters_[j + 1] - parameters_[j];
+
+            double logOut[3], logIn[3];
+
+            for (int c = 0; c < 3; c++)
+            {
+                // Angular velocity of the parabola through the three keys.
+                double velocityIn = h0 > 0.0 ? -toPrev[c] / h0 : 0.0;
+                double velocityOut = h1 > 0.0 ? toNext[c] / h1 : 0.0;
+                double velocity = h0 + h1 > 0.0 ? (h1 * velocityIn + h0 * velocityOut) / (h0 + h1) : 0.0;
+
+                logOut[c] = 0.5 * (velocity * h1 - toNext[c]);
+                logIn[c] = -0.5 * (velocity * h0 + toPrev[c]);
+            }
+
+            double a[4], b[4];
+            expRelative(q, logOut, a);
+            expRelative(q, logIn, b);
+
+            put(outControl, j, a);
+            put(inControl, j, b);
+        }
+    }
+
+    size_t QuatSpline::segment(double parameter) const
+    {
+        // First key strictly after parameter, less one.
+        std::vector<double>::const_iterator after = std::upper_bound(parameters_.begin(), parameters_.end(), parameter);
+
+        size_t i = after == parameters_.begin() ? 0 : (size_t) (after - parameters_.begin()) - 1;
+
+        return std::min(i, parameters_.size() - 2);
+    }
+
+    void QuatSpline::evaluate(const double *parameters, QuatArrayView out, size_t count) const
+    {
+        size_t keyCount = size();
+
+        if (keyCount < 2)
+        {
+            double q[4] = { 0.0, 0.0, 0.0, 1.0 };
+
+            if (keyCount == 1)
+                get(keys_.view(), 0, q);
+
+            for (size_t i = 0; i < count; i++)
+                put(out, i, q);
+
+            return;
+        }
+
+        QuatArray from, to, fromControl, toControl;
+        from.resize(count);
+        to.resize(count);
+        fromControl.resize(count);
+        toControl.resize(count);
+
+        std::vector<double> u(count);
+        std::vector<double> blend(count);
+
+        ConstQuatArrayView keys = keys_.view();
+        ConstQuatArrayView outControl = outControl_.view();
+        ConstQuatArrayView inControl = inControl_.view();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t s = segment(parameters[i]);
+
+            double length = parameters_[s + 1] - parameters_[s];
+            double t = length > 0.0 ? (parameters[i] - parameters_[s]) / length : 0.0;
+
+            t = std::min(std::max(t, 0.0), 1.0);
+
+            u[i] = t;
+            blend[i] = 2.0 * t * (1.0 - t);
+
+            double q[4];
+
+            get(keys, s, q);
+            put(from.view(), i, q);
+
+            get(keys, s + 1, q);
+            put(to.view(), i, q);
+
+            get(outControl, s, q);
+            put(fromControl.view(), i, q);
+
+            get(inControl, s + 1, q);
+            put(toControl.view(), i, q);
+        }
+
+        std::vector<short> spin(count);
+
+        noFlipSpin(from.view(), to.view(), spin.data(), count);
+        slerpBatch(from.view(), to.view(), u.data(), spin.data(), from.view(), count);
+
+        noFlipSpin(fromControl.view(), toControl.view(), spin.data(), count);
+        slerpBatch(fromControl.view(), toControl.view(), u.data(), spin.data(), fromControl.view(), count);
+
+        noFlipSpin(from.view(), fromControl.view(), spin.data(), count);
+        slerpBatch(from.view(), fromControl.view(), blend.data(), spin.data(), out, count);
+    }
+}
@@ -0,0 +1,77 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatSpline
+    Maya-free SQUAD (spherical quadrangle) interpolation through a sequence
+    of key quaternions at increasing parameters.
+
+    Segment i runs from key i to key i + 1, with u the parameter remapped
+    to [0, 1] over the segment:
+
+        squad(u) = slerp(slerp(q[i], q[i+1], u), slerp(a[i], b[i+1], u), 2u(1 - u))
+
+    a[i] and b[i] are the outgoing and incoming control points of key i.
+    Shoemake's SQUAD uses one control point per key, which only gives a
+    continuous angular velocity when the keys are evenly spaced. Here each
+    key gets two, placed so both segments leave and enter the key with the
+    same angular velocity (per unit of parameter), taken from the parabola
+    through the key and its neighbours. For evenly spaced keys both control
+    points equal Shoemake's
+
+        s[i] = q[i] exp(-(log(q[i]^-1 q[i+1]) + log(q[i]^-1 q[i-1])) / 4)
+
+    The end keys have zero tangent corrections. All three slerps take the
+    direct path between their inputs rather than the shortest one, since
+    control points may be more than 90 degrees from their key.
+
+    setKeys sorts the keys by parameter and flips each one onto the
+    hemisphere of the one before, then computes all control points, so a
+    spline can be evaluated any number of times for the cost of a binary
+    search and three slerps per sample. Parameters outside the key range
+    clamp to the first or last key.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_QUAT_SPLINE_H
+#define QUAT_EXTRAS_QUAT_SPLINE_H
+
+#include "quatBatch.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace quatExtras
+{
+    class QuatSpline
+    {
+    public:
+        size_t              size() const { return parameters_.size(); }
+
+        /*
+            Replaces the keys. keys and parameters both hold count elements.
+        */
+        void                setKeys(ConstQuatArrayView keys, const double *parameters, size_t count);
+
+        /*
+            Index of the segment containing parameter, clamped to
+            [0, size() - 2]. Needs at least two keys.
+        */
+        size_t              segment(double parameter) const;
+
+        /*
+            out[i] = the spline at parameters[i] for i in [0, count). With
+            no keys the output is the identity; with one, that key.
+        */
+        void                evaluate(const double *parameters, QuatArrayView out, size_t count) const;
+
+    private:
+        std::vector<double> parameters_;
+        QuatArray           keys_;
+        QuatArray           outControl_;
+        QuatArray           inControl_;
+    };
+}
+
+#endif
@@ -0,0 +1,114 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "quatSpring.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace quatExtras
+{
+    namespace
+    {
+        // Elements taken through all the substeps of a step together.
+        const size_t kChunkSize = 256;
+    }
+
+    QuatSpring::QuatSpring()
+    {
+    }
+
+    ConstVectorArrayView QuatSpring::velocity() const
+    {
+        ConstVectorArrayView result = { velocity_[0].data(), velocity_[1].data(), velocity_[2].data() };
+        return result;
+    }
+
+    void QuatSpring::reset(ConstQuatArrayView target, size_t count)
+    {
+        rotation_.resize(count);
+
+        QuatArrayView q = rotation_.view();
+
+        std::copy(target.x, target.x + count, q.x);
+        std::copy(target.y, target.y + count, q.y);
+        std::copy(target.z, target.z + count, q.z);
+        std::copy(target.w, target.w + count, q.w);
+
+        for (int c = 0; c < 3; c++)
+            velocity_[c].assign(count, 0.0);
+    }
+
+    void QuatSpring::step(ConstQuatArrayView target, double stiffness, double damping, double h, size_t substeps)
+    {
+        double error[3][kChunkSize];
+        double scratch[4][kChunkSize];
+
+        VectorArrayView errorView = { error[0], error[1], error[2] };
+        QuatArrayView scratchView = { scratch[0], scratch[1], scratch[2], scratch[3] };
+
+        double pull = h * stiffness;
+        double drag = 1.0 / (1.0 + h * damping);
+
+        size_t count = size();
+        QuatArrayView rotation = rotation_.view();
+
+        for (size_t start = 0; start < count; start += kChunkSize)
+        {
+            size_t n = std::min(kChunkSize, count - start);
+
+            double *qx = rotation.x + start, *qy = rotation.y + start, *qz = rotation.z + start, *qw = rotation.w + start;
+            const double *tx = target.x + start, *ty = target.y + start, *tz = target.z + start, *tw = target.w + start;
+            double *wx = velocity_[0].data() + start, *wy = velocity_[1].data() + start, *wz = velocity_[2].data() + start;
+
+            for (size_t s = 0; s < substeps; s++)
+            {
+                // target * conjugate(q)
+                for (size_t k = 0; k < n; k++)
+                {
+                    scratch[0][k] = -tw[k] * qx[k] + tx[k] * qw[k] - ty[k] * qz[k] + tz[k] * qy[k];
+                    scratch[1][k] = -tw[k] * qy[k] + ty[k] * qw[k] - tz[k] * qx[k] + tx[k] * qz[k];
+                    scratch[2][k] = -tw[k] * qz[k] + tz[k] * qw[k] - tx[k] * qy[k] + ty[k] * qx[k];
+                    scratch[3][k] = tw[k] * qw[k] + tx[k] * qx[k] + ty[k] * qy[k] + tz[k] * qz[k];
+                }
+
+                quatToRotationVectorBatch(scratchView, errorView, n);
+
+                // The new velocity, then h times it, to turn by.
+                for (size_t k = 0; k < n; k++)
+                {
+                    wx[k] = (wx[k] + pull * error[0][k]) * drag;
+                    wy[k] = (wy[k] + pull * error[1][k]) * drag;
+                    wz[k] = (wz[k] + pull * error[2][k]) * drag;
+
+                    error[0][k] = h * wx[k];
+                    error[1][k] = h * wy[k];
+                    error[2][k] = h * wz[k];
+                }
+
+                rotationVectorToQuatBatch(errorView, scratchView, n);
+
+                // q = normalize(turn * q)
+                for (size_t k = 0; k < n; k++)
+                {
+                    double ax = scratch[0][k], ay = scratch[1][k], az = scratch[2][k], aw = scratch[3][k];
+                    double bx = qx[k], by = qy[k], bz = qz[k], bw = qw[k];
+
+                    double x = aw * bx + ax * bw + ay * bz - az * by;
+                    double y = aw * by - ax * bz + ay * bw + az * bx;
+                    double z = aw * bz + ax * by - ay * bx + az * bw;
+                    double w = aw * bw - ax * bx - ay * by - az * bz;
+
+                    double inverseLength = 1.0 / std::sqrt(x * x + y * y + z * z + w * w);
+
+                    qx[k] = x * inverseLength;
+                    qy[k] = y * inverseLength;
+                    qz[k] = z * inverseLength;
+                    qw[k] = w * inverseLength;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatSpring
+    Maya-free damped springs that pull rotations towards targets, for
+    jiggle and overlapping action on many joints at once.
+
+    Each element has a rotation q and an angular velocity w in parent
+    space. Per substep of h seconds, towards its target t:
+
+        e = quatToRotationVector(t * conjugate(q))
+        w = (w + h * stiffness * e) / (1 + h * damping)
+        q = normalize(rotationVectorToQuat(h * w) * q)
+
+    which is semi-implicit Euler in the tangent space at q, with the
+    damping taken implicitly so that no damping is too strong to be
+    stable. The spring itself is stable while h * sqrt(stiffness) stays
+    below 2; keep substeps short enough for that. Critical damping is
+    2 * sqrt(stiffness).
+
+    The elements are advanced a chunk at a time through every substep,
+    with the log and exp maps from the batch kernels, so a step costs a
+    few passes over a chunk per substep and no per-element branching. The
+    result depends only on the targets, the parameters and the number of
+    substeps, so the same sequence of steps always gives the same
+    rotations on the same SIMD level.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_QUAT_SPRING_H
+#define QUAT_EXTRAS_QUAT_SPRING_H
+
+#include "quatBatch.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace quatExtras
+{
+    class QuatSpring
+    {
+    public:
+                                QuatSpring();
+
+        size_t                  size() const { return rotation_.size(); }
+
+        // count elements at rest at target.
+        void                    reset(ConstQuatArrayView target, size_t count);
+
+        /*
+            Advances every element by substeps substeps of h seconds
+            towards target, which holds size() elements.
+        */
+        void                    step(ConstQuatArrayView target, double stiffness, double damping, double h, size_t substeps);
+
+        ConstQuatArrayView      rotation() const { return rotation_.view(); }
+        ConstVectorArrayView    velocity() const;
+
+    private:
+        QuatArray               rotation_;
+        std::vector<double>     velocity_[3];
+    };
+}
+
+#endif
@@ -0,0 +1,510 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    simd
+    Thin wrappers over the vector registers of each instruction set, all
+    with the same interface so one kernel body can be compiled once per
+    instruction set. Each has a double (D) and a single precision (F)
+    version; the float registers hold twice as many lanes.
+
+    ScalarD and ScalarF are always available. The SSE2, AVX2 and AVX-512
+    wrappers only exist when the translation unit is compiled for that
+    instruction set (see the quatBatch<ISA>.cpp files), so including this
+    header never pulls wider instructions into code that must run
+    everywhere. Everything here has internal linkage for the same reason:
+    the linker must not fold an AVX-compiled copy of an inline helper into
+    the scalar build.
+
+    Each wrapper type T provides
+        T::width            lanes per register
+        T::Real             element type, double or float
+        T(double)           broadcast, rounded to T::Real
+        T::load/store       unaligned memory access to T::Real
+        T::gather(p, index) p[index[lane]] per lane, from width ints (D only)
+        T::lookup(p, index) p[index] per lane, for a T holding whole numbers
+                            from 0 to INT_MAX
+        + - * /, unary -    lane-wise arithmetic
+        < <= > >= ==        lane-wise compares returning T's mask type
+        & | on masks        mask logic; andNot(a, b) is a & ~b
+        select(m, a, b)     m ? a : b per lane
+        fmadd(a, b, c)      a * b + c, fused where the hardware has it
+        abs, sqrt, min, max, round (to nearest), copysign(magnitude, sign)
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_SIMD_H
+#define QUAT_EXTRAS_SIMD_H
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define QUAT_EXTRAS_HAS_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+    #define QUAT_EXTRAS_HAS_AVX2 1
+    #include <immintrin.h>
+#endif
+
+#if defined(__AVX512F__)
+    #define QUAT_EXTRAS_HAS_AVX512 1
+    #include <immintrin.h>
+#endif
+
+namespace quatExtras
+{
+namespace
+{
+    /*-------------------------------------------------------------------------
+        Scalar
+    -------------------------------------------------------------------------*/
+    struct ScalarDMask
+    {
+        bool m;
+    };
+
+    struct ScalarD
+    {
+        enum { width = 1 };
+        typedef double Real;
+
+        double v;
+
+        ScalarD() {}
+        ScalarD(double s) : v(s) {}
+
+        static ScalarD load(const double *p) { return ScalarD(*p); }
+        static ScalarD gather(const double *p, const int *index) { return ScalarD(p[index[0]]); }
+        static ScalarD lookup(const double *p, ScalarD index) { return ScalarD(p[(int) index.v]); }
+        void store(double *p) const { *p = v; }
+    };
+
+    inline ScalarD operator+(ScalarD a, ScalarD b) { return a.v + b.v; }
+    inline ScalarD operator-(ScalarD a, ScalarD b) { return a.v - b.v; }
+    inline ScalarD operator*(ScalarD a, ScalarD b) { return a.v * b.v; }
+    inline ScalarD operator/(ScalarD a, ScalarD b) { return a.v / b.v; }
+    inline ScalarD operator-(ScalarD a) { return -a.v; }
+
+    inline ScalarDMask operator<(ScalarD a, ScalarD b) { ScalarDMask r = { a.v < b.v }; return r; }
+    inline ScalarDMask operator<=(ScalarD a, ScalarD b) { ScalarDMask r = { a.v <= b.v }; return r; }
+    inline ScalarDMask operator>(ScalarD a, ScalarD b) { ScalarDMask r = { a.v > b.v }; return r; }
+    inline ScalarDMask operator>=(ScalarD a, ScalarD b) { ScalarDMask r = { a.v >= b.v }; return r; }
+    inline ScalarDMask operator==(ScalarD a, ScalarD b) { ScalarDMask r = { a.v == b.v }; return r; }
+
+    inline ScalarDMask operator&(ScalarDMask a, ScalarDMask b) { ScalarDMask r = { a.m && b.m }; return r; }
+    inline ScalarDMask operator|(ScalarDMask a, ScalarDMask b) { ScalarDMask r = { a.m || b.m }; return r; }
+    inline ScalarDMask andNot(ScalarDMask a, ScalarDMask b) { ScalarDMask r = { a.m && !b.m }; return r; }
+
+    inline ScalarD select(ScalarDMask m, ScalarD a, ScalarD b) { return m.m ? a : b; }
+    inline ScalarD fmadd(ScalarD a, ScalarD b, ScalarD c) { return a.v * b.v + c.v; }
+    inline ScalarD abs(ScalarD a) { return std::fabs(a.v); }
+    inline ScalarD sqrt(ScalarD a) { return std::sqrt(a.v); }
+    inline ScalarD min(ScalarD a, ScalarD b) { return a.v < b.v ? a : b; }
+    inline ScalarD max(ScalarD a, ScalarD b) { return a.v > b.v ? a : b; }
+    inline ScalarD round(ScalarD a) { return std::floor(a.v + 0.5); }
+    inline ScalarD copysign(ScalarD a, ScalarD b) { return (b.v < 0.0 || (b.v == 0.0 && std::signbit(b.v))) ? -std::fabs(a.v) : std::fabs(a.v); }
+
+    struct ScalarFMask
+    {
+        bool m;
+    };
+
+    struct ScalarF
+    {
+        enum { width = 1 };
+        typedef float Real;
+
+        float v;
+
+        ScalarF() {}
+        ScalarF(double s) : v((float) s) {}
+
+        static ScalarF load(const float *p) { return ScalarF(*p); }
+        static ScalarF lookup(const float *p, ScalarF index) { return ScalarF(p[(int) index.v]); }
+        void store(float *p) const { *p = v; }
+    };
+
+    inline ScalarF operator+(ScalarF a, ScalarF b) { return a.v + b.v; }
+    inline ScalarF operator-(ScalarF a, ScalarF b) { return a.v - b.v; }
+    inline ScalarF operator*(ScalarF a, ScalarF b) { return a.v * b.v; }
+    inline ScalarF operator/(ScalarF a, ScalarF b) { return a.v / b.v; }
+    inline ScalarF operator-(ScalarF a) { return -a.v; }
+
+    inline ScalarFMask operator<(ScalarF a, ScalarF b) { ScalarFMask r = { a.v < b.v }; return r; }
+    inline ScalarFMask operator<=(ScalarF a, ScalarF b) { ScalarFMask r = { a.v <= b.v }; return r; }
+    inline ScalarFMask operator>(ScalarF a, ScalarF b) { ScalarFMask r = { a.v > b.v }; return r; }
+    inline ScalarFMask operator>=(ScalarF a, ScalarF b) { ScalarFMask r = { a.v >= b.v }; return r; }
+    inline ScalarFMask operator==(ScalarF a, ScalarF b) { ScalarFMask r = { a.v == b.v }; return r; }
+
+    inline ScalarFMask operator&(ScalarFMask a, ScalarFMask b) { ScalarFMask r = { a.m && b.m }; return r; }
+    inline ScalarFMask operator|(ScalarFMask a, ScalarFMask b) { ScalarFMask r = { a.m || b.m }; return r; }
+    inline ScalarFMask andNot(ScalarFMask a, ScalarFMask b) { ScalarFMask r = { a.m && !b.m }; return r; }
+
+    inline ScalarF select(ScalarFMask m, ScalarF a, ScalarF b) { return m.m ? a : b; }
+    inline ScalarF fmadd(ScalarF a, ScalarF b, ScalarF c) { return a.v * b.v + c.v; }
+    inline ScalarF abs(ScalarF a) { return std::fabs(a.v); }
+    inline ScalarF sqrt(ScalarF a) { return std::sqrt(a.v); }
+    inline ScalarF min(ScalarF a, ScalarF b) { return a.v < b.v ? a : b; }
+    inline ScalarF max(ScalarF a, ScalarF b) { return a.v > b.v ? a : b; }
+    inline ScalarF round(ScalarF a) { return std::floor(a.v + 0.5f); }
+    inline ScalarF copysign(ScalarF a, ScalarF b) { return std::signbit(b.v) ? -std::fabs(a.v) : std::fabs(a.v); }
+
+    /*-------------------------------------------------------------------------
+        SSE2
+    -------------------------------------------------------------------------*/
+#if defined(QUAT_EXTRAS_HAS_SSE2)
+    struct SSE2DMask
+    {
+        __m128d m;
+    };
+
+    struct SSE2D
+    {
+        enum { width = 2 };
+        typedef double Real;
+
+        __m128d v;
+
+        SSE2D() {}
+        SSE2D(__m128d r) : v(r) {}
+        SSE2D(double s) : v(_mm_set1_pd(s)) {}
+
+        static SSE2D load(const double *p) { return _mm_loadu_pd(p); }
+        static SSE2D gather(const double *p, const int *index) { return _mm_set_pd(p[index[1]], p[index[0]]); }
+
+        static SSE2D lookup(const double *p, SSE2D index)
+        {
+            __m128i i = _mm_cvttpd_epi32(index.v);
+            return _mm_set_pd(p[_mm_cvtsi128_si32(_mm_srli_si128(i, 4))], p[_mm_cvtsi128_si32(i)]);
+        }
+
+        void store(double *p) const { _mm_storeu_pd(p, v); }
+    };
+
+    inline SSE2D operator+(SSE2D a, SSE2D b) { return _mm_add_pd(a.v, b.v); }
+    inline SSE2D operator-(SSE2D a, SSE2D b) { return _mm_sub_pd(a.v, b.v); }
+    inline SSE2D operator*(SSE2D a, SSE2D b) { return _mm_mul_pd(a.v, b.v); }
+    inline SSE2D operator/(SSE2D a, SSE2D b) { return _mm_div_pd(a.v, b.v); }
+    inline SSE2D operator-(SSE2D a) { return _mm_xor_pd(a.v, _mm_set1_pd(-0.0)); }
+
+    inline SSE2DMask operator<(SSE2D a, SSE2D b) { SSE2DMask r = { _mm_cmplt_pd(a.v, b.v) }; return r; }
+    inline SSE2DMask operator<=(SSE2D a, SSE2D b) { SSE2DMask r = { _mm_cmple_pd(a.v, b.v) }; return r; }
+    inline SSE2DMask operator>(SSE2D a, SSE2D b) { SSE2DMask r = { _mm_cmpgt_pd(a.v, b.v) }; return r; }
+    inline SSE2DMask operator>=(SSE2D a, SSE2D b) { SSE2DMask r = { _mm_cmpge_pd(a.v, b.v) }; return r; }
+    inline SSE2DMask operator==(SSE2D a, SSE2D b) { SSE2DMask r = { _mm_cmpeq_pd(a.v, b.v) }; return r; }
+
+    inline SSE2DMask operator&(SSE2DMask a, SSE2DMask b) { SSE2DMask r = { _mm_and_pd(a.m, b.m) }; return r; }
+    inline SSE2DMask operator|(SSE2DMask a, SSE2DMask b) { SSE2DMask r = { _mm_or_pd(a.m, b.m) }; return r; }
+    inline SSE2DMask andNot(SSE2DMask a, SSE2DMask b) { SSE2DMask r = { _mm_andnot_pd(b.m, a.m) }; return r; }
+
+    inline SSE2D select(SSE2DMask m, SSE2D a, SSE2D b) { return _mm_or_pd(_mm_and_pd(m.m, a.v), _mm_andnot_pd(m.m, b.v)); }
+    inline SSE2D fmadd(SSE2D a, SSE2D b, SSE2D c) { return _mm_add_pd(_mm_mul_pd(a.v, b.v), c.v); }
+    inline SSE2D abs(SSE2D a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a.v); }
+    inline SSE2D sqrt(SSE2D a) { return _mm_sqrt_pd(a.v); }
+    inline SSE2D min(SSE2D a, SSE2D b) { return _mm_min_pd(a.v, b.v); }
+    inline SSE2D max(SSE2D a, SSE2D b) { return _mm_max_pd(a.v, b.v); }
+
+    inline SSE2D copysign(SSE2D a, SSE2D b)
+    {
+        __m128d signBit = _mm_set1_pd(-0.0);
+        return _mm_or_pd(_mm_andnot_pd(signBit, a.v), _mm_and_pd(signBit, b.v));
+    }
+
+    // SSE2 has no rounding instruction; adding and removing 1.5 * 2^52
+    // rounds to nearest for |a| < 2^51, which covers every caller.
+    inline SSE2D round(SSE2D a)
+    {
+        __m128d magic = _mm_set1_pd(6755399441055744.0);
+        return _mm_sub_pd(_mm_add_pd(a.v, magic), magic);
+    }
+    struct SSE2FMask
+    {
+        __m128 m;
+    };
+
+    struct SSE2F
+    {
+        enum { width = 4 };
+        typedef float Real;
+
+        __m128 v;
+
+        SSE2F() {}
+        SSE2F(__m128 r) : v(r) {}
+        SSE2F(double s) : v(_mm_set1_ps((float) s)) {}
+
+        static SSE2F load(const float *p) { return _mm_loadu_ps(p); }
+
+        static SSE2F lookup(const float *p, SSE2F index)
+        {
+            int i[4];
+            _mm_storeu_si128((__m128i *) i, _mm_cvttps_epi32(index.v));
+            return _mm_set_ps(p[i[3]], p[i[2]], p[i[1]], p[i[0]]);
+        }
+
+        void store(float *p) const { _mm_storeu_ps(p, v); }
+    };
+
+    inline SSE2F operator+(SSE2F a, SSE2F b) { return _mm_add_ps(a.v, b.v); }
+    inline SSE2F operator-(SSE2F a, SSE2F b) { return _mm_sub_ps(a.v, b.v); }
+    inline SSE2F operator*(SSE2F a, SSE2F b) { return _mm_mul_ps(a.v, b.v); }
+    inline SSE2F operator/(SSE2F a, SSE2F b) { return _mm_div_ps(a.v, b.v); }
+    inline SSE2F operator-(SSE2F a) { return _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)); }
+
+    inline SSE2FMask operator<(SSE2F a, SSE2F b) { SSE2FMask r = { _mm_cmplt_ps(a.v, b.v) }; return r; }
+    inline SSE2FMask operator<=(SSE2F a, SSE2F b) { SSE2FMask r = { _mm_cmple_ps(a.v, b.v) }; return r; }
+    inline SSE2FMask operator>(SSE2F a, SSE2F b) { SSE2FMask r = { _mm_cmpgt_ps(a.v, b.v) }; return r; }
+    inline SSE2FMask operator>=(SSE2F a, SSE2F b) { SSE2FMask r = { _mm_cmpge_ps(a.v, b.v) }; return r; }
+    inline SSE2FMask operator==(SSE2F a, SSE2F b) { SSE2FMask r = { _mm_cmpeq_ps(a.v, b.v) }; return r; }
+
+    inline SSE2FMask operator&(SSE2FMask a, SSE2FMask b) { SSE2FMask r = { _mm_and_ps(a.m, b.m) }; return r; }
+    inline SSE2FMask operator|(SSE2FMask a, SSE2FMask b) { SSE2FMask r = { _mm_or_ps(a.m, b.m) }; return r; }
+    inline SSE2FMask andNot(SSE2FMask a, SSE2FMask b) { SSE2FMask r = { _mm_andnot_ps(b.m, a.m) }; return r; }
+
+    inline SSE2F select(SSE2FMask m, SSE2F a, SSE2F b) { return _mm_or_ps(_mm_and_ps(m.m, a.v), _mm_andnot_ps(m.m, b.v)); }
+    inline SSE2F fmadd(SSE2F a, SSE2F b, SSE2F c) { return _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v); }
+    inline SSE2F abs(SSE2F a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+    inline SSE2F sqrt(SSE2F a) { return _mm_sqrt_ps(a.v); }
+    inline SSE2F min(SSE2F a, SSE2F b) { return _mm_min_ps(a.v, b.v); }
+    inline SSE2F max(SSE2F a, SSE2F b) { return _mm_max_ps(a.v, b.v); }
+
+    inline SSE2F copysign(SSE2F a, SSE2F b)
+    {
+        __m128 signBit = _mm_set1_ps(-0.0f);
+        return _mm_or_ps(_mm_andnot_ps(signBit, a.v), _mm_and_ps(signBit, b.v));
+    }
+
+    // The same trick as SSE2D with 1.5 * 2^23, for |a| < 2^22.
+    inline SSE2F round(SSE2F a)
+    {
+        __m128 magic = _mm_set1_ps(12582912.0f);
+        return _mm_sub_ps(_mm_add_ps(a.v, magic), magic);
+    }
+#endif
+
+    /*-------------------------------------------------------------------------
+        AVX2 + FMA
+    -------------------------------------------------------------------------*/
+#if defined(QUAT_EXTRAS_HAS_AVX2)
+    struct AVX2DMask
+    {
+        __m256d m;
+    };
+
+    struct AVX2D
+    {
+        enum { width = 4 };
+        typedef double Real;
+
+        __m256d v;
+
+        AVX2D() {}
+        AVX2D(__m256d r) : v(r) {}
+        AVX2D(double s) : v(_mm256_set1_pd(s)) {}
+
+        static AVX2D load(const double *p) { return _mm256_loadu_pd(p); }
+        static AVX2D gather(const double *p, const int *index) { return _mm256_i32gather_pd(p, _mm_loadu_si128((const __m128i *) index), 8); }
+        static AVX2D lookup(const double *p, AVX2D index) { return _mm256_i32gather_pd(p, _mm256_cvttpd_epi32(index.v), 8); }
+        void store(double *p) const { _mm256_storeu_pd(p, v); }
+    };
+
+    inline AVX2D operator+(AVX2D a, AVX2D b) { return _mm256_add_pd(a.v, b.v); }
+    inline AVX2D operator-(AVX2D a, AVX2D b) { return _mm256_sub_pd(a.v, b.v); }
+    inline AVX2D operator*(AVX2D a, AVX2D b) { return _mm256_mul_pd(a.v, b.v); }
+    inline AVX2D operator/(AVX2D a, AVX2D b) { return _mm256_div_pd(a.v, b.v); }
+    inline AVX2D operator-(AVX2D a) { return _mm256_xor_pd(a.v, _mm256_set1_pd(-0.0)); }
+
+    inline AVX2DMask operator<(AVX2D a, AVX2D b) { AVX2DMask r = { _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ) }; return r; }
+    inline AVX2DMask operator<=(AVX2D a, AVX2D b) { AVX2DMask r = { _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ) }; return r; }
+    inline AVX2DMask operator>(AVX2D a, AVX2D b) { AVX2DMask r = { _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ) }; return r; }
+    inline AVX2DMask operator>=(AVX2D a, AVX2D b) { AVX2DMask r = { _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ) }; return r; }
+    inline AVX2DMask operator==(AVX2D a, AVX2D b) { AVX2DMask r = { _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ) }; return r; }
+
+    inline AVX2DMask operator&(AVX2DMask a, AVX2DMask b) { AVX2DMask r = { _mm256_and_pd(a.m, b.m) }; return r; }
+    inline AVX2DMask operator|(AVX2DMask a, AVX2DMask b) { AVX2DMask r = { _mm256_or_pd(a.m, b.m) }; return r; }
+    inline AVX2DMask andNot(AVX2DMask a, AVX2DMask b) { AVX2DMask r = { _mm256_andnot_pd(b.m, a.m) }; return r; }
+
+    inline AVX2D select(AVX2DMask m, AVX2D a, AVX2D b) { return _mm256_blendv_pd(b.v, a.v, m.m); }
+    inline AVX2D fmadd(AVX2D a, AVX2D b, AVX2D c) { return _mm256_fmadd_pd(a.v, b.v, c.v); }
+    inline AVX2D abs(AVX2D a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v); }
+    inline AVX2D sqrt(AVX2D a) { return _mm256_sqrt_pd(a.v); }
+    inline AVX2D min(AVX2D a, AVX2D b) { return _mm256_min_pd(a.v, b.v); }
+    inline AVX2D max(AVX2D a, AVX2D b) { return _mm256_max_pd(a.v, b.v); }
+    inline AVX2D round(AVX2D a) { return _mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+    inline AVX2D copysign(AVX2D a, AVX2D b)
+    {
+        __m256d signBit = _mm256_set1_pd(-0.0);
+        return _mm256_or_pd(_mm256_andnot_pd(signBit, a.v), _mm256_and_pd(signBit, b.v));
+    }
+    struct AVX2FMask
+    {
+        __m256 m;
+    };
+
+    struct AVX2F
+    {
+        enum { width = 8 };
+        typedef float Real;
+
+        __m256 v;
+
+        AVX2F() {}
+        AVX2F(__m256 r) : v(r) {}
+        AVX2F(double s) : v(_mm256_set1_ps((float) s)) {}
+
+        static AVX2F load(const float *p) { return _mm256_loadu_ps(p); }
+        static AVX2F lookup(const float *p, AVX2F index) { return _mm256_i32gather_ps(p, _mm256_cvttps_epi32(index.v), 4); }
+        void store(float *p) const { _mm256_storeu_ps(p, v); }
+    };
+
+    inline AVX2F operator+(AVX2F a, AVX2F b) { return _mm256_add_ps(a.v, b.v); }
+    inline AVX2F operator-(AVX2F a, AVX2F b) { return _mm256_sub_ps(a.v, b.v); }
+    inline AVX2F operator*(AVX2F a, AVX2F b) { return _mm256_mul_ps(a.v, b.v); }
+    inline AVX2F operator/(AVX2F a, AVX2F b) { return _mm256_div_ps(a.v, b.v); }
+    inline AVX2F operator-(AVX2F a) { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)); }
+
+    inline AVX2FMask operator<(AVX2F a, AVX2F b) { AVX2FMask r = { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; return r; }
+    inline AVX2FMask operator<=(AVX2F a, AVX2F b) { AVX2FMask r = { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; return r; }
+    inline AVX2FMask operator>(AVX2F a, AVX2F b) { AVX2FMask r = { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; return r; }
+    inline AVX2FMask operator>=(AVX2F a, AVX2F b) { AVX2FMask r = { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; return r; }
+    inline AVX2FMask operator==(AVX2F a, AVX2F b) { AVX2FMask r = { _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ) }; return r; }
+
+    inline AVX2FMask operator&(AVX2FMask a, AVX2FMask b) { AVX2FMask r = { _mm256_and_ps(a.m, b.m) }; return r; }
+    inline AVX2FMask operator|(AVX2FMask a, AVX2FMask b) { AVX2FMask r = { _mm256_or_ps(a.m, b.m) }; return r; }
+    inline AVX2FMask andNot(AVX2FMask a, AVX2FMask b) { AVX2FMask r = { _mm256_andnot_ps(b.m, a.m) }; return r; }
+
+    inline AVX2F select(AVX2FMask m, AVX2F a, AVX2F b) { return _mm256_blendv_ps(b.v, a.v, m.m); }
+    inline AVX2F fmadd(AVX2F a, AVX2F b, AVX2F c) { return _mm256_fmadd_ps(a.v, b.v, c.v); }
+    inline AVX2F abs(AVX2F a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v); }
+    inline AVX2F sqrt(AVX2F a) { return _mm256_sqrt_ps(a.v); }
+    inline AVX2F min(AVX2F a, AVX2F b) { return _mm256_min_ps(a.v, b.v); }
+    inline AVX2F max(AVX2F a, AVX2F b) { return _mm256_max_ps(a.v, b.v); }
+    inline AVX2F round(AVX2F a) { return _mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+    inline AVX2F copysign(AVX2F a, AVX2F b)
+    {
+        __m256 signBit = _mm256_set1_ps(-0.0f);
+        return _mm256_or_ps(_mm256_andnot_ps(signBit, a.v), _mm256_and_ps(signBit, b.v));
+    }
+#endif
+
+    /*-------------------------------------------------------------------------
+        AVX-512F
+    -------------------------------------------------------------------------*/
+#if defined(QUAT_EXTRAS_HAS_AVX512)
+    struct AVX512DMask
+    {
+        __mmask8 m;
+    };
+
+    struct AVX512D
+    {
+        enum { width = 8 };
+        typedef double Real;
+
+        __m512d v;
+
+        AVX512D() {}
+        AVX512D(__m512d r) : v(r) {}
+        AVX512D(double s) : v(_mm512_set1_pd(s)) {}
+
+        static AVX512D load(const double *p) { return _mm512_loadu_pd(p); }
+        static AVX512D gather(const double *p, const int *index) { return _mm512_i32gather_pd(_mm256_loadu_si256((const __m256i *) index), p, 8); }
+        static AVX512D lookup(const double *p, AVX512D index) { return _mm512_i32gather_pd(_mm512_cvttpd_epi32(index.v), p, 8); }
+        void store(double *p) const { _mm512_storeu_pd(p, v); }
+    };
+
+    inline AVX512D operator+(AVX512D a, AVX512D b) { return _mm512_add_pd(a.v, b.v); }
+    inline AVX512D operator-(AVX512D a, AVX512D b) { return _mm512_sub_pd(a.v, b.v); }
+    inline AVX512D operator*(AVX512D a, AVX512D b) { return _mm512_mul_pd(a.v, b.v); }
+    inline AVX512D operator/(AVX512D a, AVX512D b) { return _mm512_div_pd(a.v, b.v); }
+    inline AVX512D operator-(AVX512D a) { return _mm512_sub_pd(_mm512_setzero_pd(), a.v); }
+
+    inline AVX512DMask operator<(AVX512D a, AVX512D b) { AVX512DMask r = { _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ) }; return r; }
+    inline AVX512DMask operator<=(AVX512D a, AVX512D b) { AVX512DMask r = { _mm512_cmp_pd_mask(a.v, b.v, _CMP_LE_OQ) }; return r; }
+    inline AVX512DMask operator>(AVX512D a, AVX512D b) { AVX512DMask r = { _mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ) }; return r; }
+    inline AVX512DMask operator>=(AVX512D a, AVX512D b) { AVX512DMask r = { _mm512_cmp_pd_mask(a.v, b.v, _CMP_GE_OQ) }; return r; }
+    inline AVX512DMask operator==(AVX512D a, AVX512D b) { AVX512DMask r = { _mm512_cmp_pd_mask(a.v, b.v, _CMP_EQ_OQ) }; return r; }
+
+    inline AVX512DMask operator&(AVX512DMask a, AVX512DMask b) { AVX512DMask r = { (__mmask8) (a.m & b.m) }; return r; }
+    inline AVX512DMask operator|(AVX512DMask a, AVX512DMask b) { AVX512DMask r = { (__mmask8) (a.m | b.m) }; return r; }
+    inline AVX512DMask andNot(AVX512DMask a, AVX512DMask b) { AVX512DMask r = { (__mmask8) (a.m & ~b.m) }; return r; }
+
+    inline AVX512D select(AVX512DMask m, AVX512D a, AVX512D b) { return _mm512_mask_blend_pd(m.m, b.v, a.v); }
+    inline AVX512D fmadd(AVX512D a, AVX512D b, AVX512D c) { return _mm512_fmadd_pd(a.v, b.v, c.v); }
+    inline AVX512D abs(AVX512D a) { return _mm512_abs_pd(a.v); }
+    inline AVX512D sqrt(AVX512D a) { return _mm512_sqrt_pd(a.v); }
+    inline AVX512D min(AVX512D a, AVX512D b) { return _mm512_min_pd(a.v, b.v); }
+    inline AVX512D max(AVX512D a, AVX512D b) { return _mm512_max_pd(a.v, b.v); }
+    inline AVX512D round(AVX512D a) { return _mm512_roundscale_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+    // AVX-512F has no floating point logic ops, so go through the integer
+    // domain.
+    inline AVX512D copysign(AVX512D a, AVX512D b)
+    {
+        __m512i signBit = _mm512_set1_epi64((long long) 0x8000000000000000ULL);
+        __m512i magnitude = _mm512_andnot_si512(signBit, _mm512_castpd_si512(a.v));
+        __m512i sign = _mm512_and_si512(signBit, _mm512_castpd_si512(b.v));
+        return _mm512_castsi512_pd(_mm512_or_si512(magnitude, sign));
+    }
+    struct AVX512FMask
+    {
+        __mmask16 m;
+    };
+
+    struct AVX512F
+    {
+        enum { width = 16 };
+        typedef float Real;
+
+        __m512 v;
+
+        AVX512F() {}
+        AVX512F(__m512 r) : v(r) {}
+        AVX512F(double s) : v(_mm512_set1_ps((float) s)) {}
+
+        static AVX512F load(const float *p) { return _mm512_loadu_ps(p); }
+        static AVX512F lookup(const float *p, AVX512F index) { return _mm512_i32gather_ps(_mm512_cvttps_epi32(index.v), p, 4); }
+        void store(float *p) const { _mm512_storeu_ps(p, v); }
+    };
+
+    inline AVX512F operator+(AVX512F a, AVX512F b) { return _mm512_add_ps(a.v, b.v); }
+    inline AVX512F operator-(AVX512F a, AVX512F b) { return _mm512_sub_ps(a.v, b.v); }
+    inline AVX512F operator*(AVX512F a, AVX512F b) { return _mm512_mul_ps(a.v, b.v); }
+    inline AVX512F operator/(AVX512F a, AVX512F b) { return _mm512_div_ps(a.v, b.v); }
+    inline AVX512F operator-(AVX512F a) { return _mm512_sub_ps(_mm512_setzero_ps(), a.v); }
+
+    inline AVX512FMask operator<(AVX512F a, AVX512F b) { AVX512FMask r = { _mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ) }; return r; }
+    inline AVX512FMask operator<=(AVX512F a, AVX512F b) { AVX512FMask r = { _mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ) }; return r; }
+    inline AVX512FMask operator>(AVX512F a, AVX512F b) { AVX512FMask r = { _mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ) }; return r; }
+    inline AVX512FMask operator>=(AVX512F a, AVX512F b) { AVX512FMask r = { _mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ) }; return r; }
+    inline AVX512FMask operator==(AVX512F a, AVX512F b) { AVX512FMask r = { _mm512_cmp_ps_mask(a.v, b.v, _CMP_EQ_OQ) }; return r; }
+
+    inline AVX512FMask operator&(AVX512FMask a, AVX512FMask b) { AVX512FMask r = { (__mmask16) (a.m & b.m) }; return r; }
+    inline AVX512FMask operator|(AVX512FMask a, AVX512FMask b) { AVX512FMask r = { (__mmask16) (a.m | b.m) }; return r; }
+    inline AVX512FMask andNot(AVX512FMask a, AVX512FMask b) { AVX512FMask r = { (__mmask16) (a.m & ~b.m) }; return r; }
+
+    inline AVX512F select(AVX512FMask m, AVX512F a, AVX512F b) { return _mm512_mask_blend_ps(m.m, b.v, a.v); }
+    inline AVX512F fmadd(AVX512F a, AVX512F b, AVX512F c) { return _mm512_fmadd_ps(a.v, b.v, c.v); }
+    inline AVX512F abs(AVX512F a) { return _mm512_abs_ps(a.v); }
+    inline AVX512F sqrt(AVX512F a) { return _mm512_sqrt_ps(a.v); }
+    inline AVX512F min(AVX512F a, AVX512F b) { return _mm512_min_ps(a.v, b.v); }
+    inline AVX512F max(AVX512F a, AVX512F b) { return _mm512_max_ps(a.v, b.v); }
+    inline AVX512F round(AVX512F a) { return _mm512_roundscale_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+    inline AVX512F copysign(AVX512F a, AVX512F b)
+    {
+        __m512i signBit = _mm512_set1_epi32((int) 0x80000000U);
+        __m512i magnitude = _mm512_andnot_si512(signBit, _mm512_castps_si512(a.v));
+        __m512i sign = _mm512_and_si512(signBit, _mm512_castps_si512(b.v));
+        return _mm512_castsi512_ps(_mm512_or_si512(magnitude, sign));
+    }
+#endif
+}
+}
+
+#endif
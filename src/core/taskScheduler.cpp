@@ -0,0 +1,312 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "taskScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace quatExtras
+{
+    namespace
+    {
+        const unsigned kMaxThreads = 64;
+
+        // Indices one participant still has to run. Owners take from the
+        // front, thieves from the back.
+        struct Range
+        {
+            std::mutex mutex;
+            size_t begin;
+            size_t end;
+        };
+
+        struct Job
+        {
+            const RangeTask *task;
+            size_t grain;
+            unsigned participants;
+            std::unique_ptr<Range[]> ranges;
+        };
+
+        // Set on pool workers, and on the calling thread for the whole of a
+        // run, so a parallelFor inside a task runs serially instead of
+        // trying runMutex again on the thread that holds it.
+        thread_local bool insideTask = false;
+
+        bool takeChunk(Job &job, unsigned self, size_t &begin, size_t &end)
+        {
+            Range &range = job.ranges[self];
+            std::lock_guard<std::mutex> lock(range.mutex);
+
+            if (range.begin >= range.end)
+                return false;
+
+            begin = range.begin;
+            end = std::min(range.begin + job.grain, range.end);
+            range.begin = end;
+
+            return true;
+        }
+
+        /*
+            Moves the back half of the largest range into self's range.
+            Returns false once every range is empty.
+        */
+        bool steal(Job &job, unsigned self)
+        {
+            for (;;)
+            {
+                unsigned victim = self;
+                size_t largest = 0;
+
+                for (unsigned i = 0; i < job.participants; i++)
+                {
+                    if (i == self)
+                        continue;
+
+                    Range &range = job.ranges[i];
+                    std::lock_guard<std::mutex> lock(range.mutex);
+
+                    size_t remaining = range.end - range.begin;
+
+                    if (range.begin < range.end && remaining > largest)
+                    {
+                        largest = remaining;
+                        victim = i;
+                    }
+                }
+
+                if (victim == self)
+                    return false;
+
+                size_t begin, end;
+
+                {
+                    Range &range = job.ranges[victim];
+                    std::lock_guard<std::mutex> lock(range.mutex);
+
+                    if (range.begin >= range.end)
+                        continue;
+
+                    size_t remaining = range.end - range.begin;
+
+                    begin = remaining > job.grain ? range.end - remaining / 2 : range.begin;
+                    end = range.end;
+                    range.end = begin;
+                }
+
+                Range &own = job.ranges[self];
+                std::lock_guard<std::mutex> lock(own.mutex);
+
+                own.begin = begin;
+                own.end = end;
+
+                return true;
+            }
+        }
+
+        void runJob(Job &job, unsigned self)
+        {
+            size_t begin, end;
+
+            do
+            {
+                while (takeChunk(job, self, begin, end))
+                    (*job.task)(begin, end);
+            } while (steal(job, self));
+        }
+
+        unsigned requestedThreads()
+        {
+            const char *value = std::getenv("QUATEXTRAS_THREADS");
+            int threads = value ? std::atoi(value) : 0;
+
+            if (threads <= 0)
+                threads = (int) std::thread::hardware_concurrency();
+
+            return (unsigned) std::max(1, std::min(threads, (int) kMaxThreads));
+        }
+
+        class Pool
+        {
+        public:
+            Pool() : running(0), job(NULL), generation(0), finished(0), stopping(false) {}
+
+            ~Pool() { stop(); }
+
+            unsigned threadCount() const
+            {
+                unsigned threads = running.load(std::memory_order_relaxed);
+                return threads ? threads : requestedThreads();
+            }
+
+            // Returns false if another parallelFor owns the pool.
+            bool run(size_t count, size_t grain, const RangeTask &task)
+            {
+                std::unique_lock<std::mutex> owner(runMutex, std::try_to_lock);
+
+                if (!owner.owns_lock())
+                    return false;
+
+                insideTask = true;
+
+                struct LeaveTask
+                {
+                    ~LeaveTask() { insideTask = false; }
+                } leaveTask;
+
+                start();
+
+                unsigned participants = (unsigned) workers.size() + 1;
+
+                Job current;
+                current.task = &task;
+                current.grain = grain;
+                current.participants = participants;
+                current.ranges.reset(new Range[participants]);
+
+                for (unsigned i = 0; i < participants; i++)
+                {
+                    current.ranges[i].begin = count * i / participants;
+                    current.ranges[i].end = count * (i + 1) / participants;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    job = &current;
+                    finished = 0;
+                    generation++;
+                }
+
+                wake.notify_all();
+
+                runJob(current, 0);
+
+                std::unique_lock<std::mutex> lock(mutex);
+                done.wait(lock, [&] { return finished == workers.size(); });
+                job = NULL;
+
+                return true;
+            }
+
+            void stop()
+            {
+                std::lock_guard<std::mutex> owner(runMutex);
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stopping = true;
+                }
+
+                wake.notify_all();
+
+                for (size_t i = 0; i < workers.size(); i++)
+                    workers[i].join();
+
+                workers.clear();
+                running = 0;
+                stopping = false;
+            }
+
+        private:
+            // Called with runMutex held.
+            void start()
+            {
+                if (!workers.empty())
+                    return;
+
+                unsigned threads = requestedThreads();
+
+                for (unsigned i = 1; i < threads; i++)
+                    workers.push_back(std::thread(&Pool::workerLoop, this, i, generation));
+
+                running = threads;
+            }
+
+            // seen is the generation of the last job run before this worker
+            // started, which it must not pick up.
+            void workerLoop(unsigned self, unsigned long long seen)
+            {
+                insideTask = true;
+
+                for (;;)
+                {
+                    Job *current;
+
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        wake.wait(lock, [&] { return stopping || generation != seen; });
+
+                        if (stopping)
+                            return;
+
+                        seen = generation;
+                        current = job;
+                    }
+
+                    runJob(*current, self);
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        finished++;
+                    }
+
+                    done.notify_one();
+                }
+            }
+
+            std::vector<std::thread> workers;
+            std::atomic<unsigned> running;
+
+            std::mutex runMutex;
+            std::mutex mutex;
+            std::condition_variable wake;
+            std::condition_variable done;
+
+            Job *job;
+            unsigned long long generation;
+            size_t finished;
+            bool stopping;
+        };
+
+        Pool& pool()
+        {
+            static Pool instance;
+            return instance;
+        }
+
+        void runSerial(size_t count, size_t grain, const RangeTask &task)
+        {
+            for (size_t begin = 0; begin < count; begin += grain)
+                task(begin, std::min(begin + grain, count));
+        }
+    }
+
+    void parallelFor(size_t count, size_t grain, const RangeTask &task)
+    {
+        if (grain == 0)
+            grain = 1;
+
+        if (count <= grain || insideTask || !pool().run(count, grain, task))
+            runSerial(count, grain, task);
+    }
+
+    unsigned schedulerThreadCount()
+    {
+        return pool().threadCount();
+    }
+
+    void shutdownScheduler()
+    {
+        pool().stop();
+    }
+}
@@ -0,0 +1,50 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    taskScheduler
+    A small work-stealing thread pool for spreading batch work over every
+    core.
+
+    parallelFor(count, grain, task) splits [0, count) evenly between the
+    workers and the calling thread. Each takes grain-sized chunks from the
+    front of its own range. One that runs out steals the back half of the
+    largest range left, so uneven chunks balance out without a shared
+    queue. Ranges are only locked one at a time, by their owner or a thief.
+
+    Workers start on first use: one fewer than the hardware threads, or
+    than QUATEXTRAS_THREADS when it is set. A parallelFor called while
+    another is running, or from inside a task, runs serially on the calling
+    thread, so Maya evaluating several nodes at once cannot deadlock the
+    pool. shutdownScheduler stops the workers; the plugin calls it before
+    it is unloaded.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_TASK_SCHEDULER_H
+#define QUAT_EXTRAS_TASK_SCHEDULER_H
+
+#include <cstddef>
+#include <functional>
+
+namespace quatExtras
+{
+    // Runs [begin, end) of a parallelFor.
+    typedef std::function<void(size_t begin, size_t end)> RangeTask;
+
+    /*
+        Calls task on chunks of at most grain indices covering [0, count)
+        once each, and returns when every chunk has run. Chunks run
+        concurrently and in no particular order.
+    */
+    void parallelFor(size_t count, size_t grain, const RangeTask &task);
+
+    // Threads a parallelFor runs on, including the calling thread.
+    unsigned schedulerThreadCount();
+
+    // Joins the workers. The next parallelFor starts them again.
+    void shutdownScheduler();
+}
+
+#endif
@@ -0,0 +1,548 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "trackCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace quatExtras
+{
+    namespace
+    {
+        const char kMagic[4] = { 'Q', 'X', 'T', 'C' };
+        const uint32_t kVersion = 1;
+        const uint64_t kDataAlignment = 64;
+
+        const double kSqrt2 = 1.41421356237309504880;
+        const double kSmallestThreeScale = 32767.0;
+
+        struct Header
+        {
+            char        magic[4];
+            uint32_t    version;
+            uint32_t    trackCount;
+            uint32_t    frameCount;
+            double      startFrame;
+            double      frameStep;
+            uint32_t    encoding;
+            uint32_t    layout;
+            double      framesPerSecond;
+            uint64_t    namesOffset;
+            uint64_t    dataOffset;
+        };
+
+        struct IndexEntry
+        {
+            uint64_t    dataOffset;
+            uint32_t    nameOffset;
+            uint32_t    nameLength;
+        };
+
+        static_assert(sizeof(Header) == 64, "trackCache header must be 64 bytes");
+        static_assert(sizeof(IndexEntry) == 16, "trackCache index entries must be 16 bytes");
+
+        size_t sampleSize(TrackEncoding encoding)
+        {
+            switch (encoding)
+            {
+                case kTrackFloat16:         return 8;
+                case kTrackSmallestThree:   return 6;
+                default:                    return 32;
+            }
+        }
+
+        // Round to nearest even. Quaternion components never overflow a half.
+        uint16_t floatToHalf(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            uint32_t sign = (bits >> 16) & 0x8000;
+            int exponent = (int) ((bits >> 23) & 0xff) - 127 + 15;
+            uint32_t mantissa = bits & 0x7fffff;
+
+            if (exponent <= 0)
+            {
+                if (exponent < -10)
+                    return (uint16_t) sign;
+
+                mantissa |= 0x800000;
+
+                uint32_t shift = (uint32_t) (14 - exponent);
+                uint32_t half = mantissa >> shift;
+                uint32_t remainder = mantissa & ((1u << shift) - 1);
+                uint32_t halfway = 1u << (shift - 1);
+
+                if (remainder > halfway || (remainder == halfway && (half & 1)))
+                    half++;
+
+                return (uint16_t) (sign | half);
+            }
+
+            if (exponent >= 31)
+                return (uint16_t) (sign | 0x7c00);
+
+            uint32_t half = sign | ((uint32_t) exponent << 10) | (mantissa >> 13);
+            uint32_t remainder = mantissa & 0x1fff;
+
+            if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+                half++;
+
+            return (uint16_t) half;
+        }
+
+        float halfToFloat(uint16_t half)
+        {
+            uint32_t sign = (uint32_t) (half & 0x8000) << 16;
+            uint32_t exponent = (half >> 10) & 0x1f;
+            uint32_t mantissa = half & 0x3ff;
+            uint32_t bits;
+
+            if (exponent == 0)
+            {
+                if (mantissa == 0)
+                {
+                    bits = sign;
+                } else {
+                    exponent = 127 - 15 + 1;
+
+                    while (!(mantissa & 0x400))
+                    {
+                        mantissa <<= 1;
+                        exponent--;
+                    }
+
+                    bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+                }
+            } else if (exponent == 31) {
+                bits = sign | 0x7f800000 | (mantissa << 13);
+            } else {
+                bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+            }
+
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        void encodeSample(TrackEncoding encoding, const double q[4], unsigned char *sample)
+        {
+            switch (encoding)
+            {
+                case kTrackFloat64:
+                    std::memcpy(sample, q, 32);
+                    break;
+
+                case kTrackFloat16:
+                    for (int i = 0; i < 4; i++)
+                    {
+                        uint16_t half = floatToHalf((float) q[i]);
+
+                        sample[i * 2] = (unsigned char) (half & 0xff);
+                        sample[i * 2 + 1] = (unsigned char) (half >> 8);
+                    }
+                    break;
+
+                case kTrackSmallestThree:
+                {
+                    double length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+                    double c[4] = { 0.0, 0.0, 0.0, 1.0 };
+
+                    if (length > 0.0)
+                    {
+                        for (int i = 0; i < 4; i++)
+                            c[i] = q[i] / length;
+                    }
+
+                    int largest = 0;
+
+                    for (int i = 1; i < 4; i++)
+                    {
+                        if (std::fabs(c[i]) > std::fabs(c[largest]))
+                            largest = i;
+                    }
+
+                    // q and -q are the same rotation, so the dropped
+                    // component is always made positive.
+                    double sign = c[largest] < 0.0 ? -1.0 : 1.0;
+
+                    uint64_t packed = (uint64_t) largest;
+                    int shift = 2;
+
+                    for (int i = 0; i < 4; i++)
+                    {
+                        if (i == largest)
+                            continue;
+
+                        double unit = (sign * c[i] * kSqrt2 + 1.0) * 0.5;
+                        double quantized = std::floor(std::min(std::max(unit, 0.0), 1.0) * kSmallestThreeScale + 0.5);
+
+                        packed |= (uint64_t) quantized << shift;
+                        shift += 15;
+                    }
+
+                    for (int i = 0; i < 6; i++)
+                        sample[i] = (unsigned char) (packed >> (i * 8));
+
+                    break;
+                }
+            }
+        }
+
+        template <TrackEncoding encoding>
+        inline void decodeSample(const unsigned char *sample, double q[4])
+        {
+            switch (encoding)
+            {
+                case kTrackFloat64:
+                    std::memcpy(q, sample, 32);
+                    break;
+
+                case kTrackFloat16:
+                {
+                    for (int i = 0; i < 4; i++)
+                        q[i] = halfToFloat((uint16_t) (sample[i * 2] | (sample[i * 2 + 1] << 8)));
+
+                    double length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+
+                    if (length > 0.0)
+                    {
+                        for (int i = 0; i < 4; i++)
+                            q[i] /= length;
+                    }
+
+                    break;
+                }
+
+                case kTrackSmallestThree:
+                {
+                    uint64_t packed = 0;
+
+                    for (int i = 0; i < 6; i++)
+                        packed |= (uint64_t) sample[i] << (i * 8);
+
+                    int largest = (int) (packed & 3);
+                    int shift = 2;
+                    double sum = 0.0;
+
+                    for (int i = 0; i < 4; i++)
+                    {
+                        if (i == largest)
+                            continue;
+
+                        double quantized = (double) ((packed >> shift) & 0x7fff);
+
+                        q[i] = (quantized / kSmallestThreeScale * 2.0 - 1.0) / kSqrt2;
+                        sum += q[i] * q[i];
+                        shift += 15;
+                    }
+
+                    q[largest] = std::sqrt(std::max(0.0, 1.0 - sum));
+                    break;
+                }
+            }
+        }
+
+        // The encoding is a template argument so the switch is resolved
+        // once per frame rather than once per track.
+        template <TrackEncoding encoding>
+        void decodeFrame(const unsigned char *frame, const uint64_t *trackOffsets, QuatArrayView out, size_t count)
+        {
+            for (size_t t = 0; t < count; t++)
+            {
+                double q[4];
+                decodeSample<encoding>(frame + trackOffsets[t], q);
+
+                out.x[t] = q[0];
+                out.y[t] = q[1];
+                out.z[t] = q[2];
+                out.w[t] = q[3];
+            }
+        }
+
+        bool fail(std::string *error, const std::string &message)
+        {
+            if (error)
+                *error = message;
+            return false;
+        }
+    }
+
+    bool writeTrackCache(
+        const std::string &path,
+        const std::vector<std::string> &names,
+        ConstQuatArrayView tracks,
+        size_t frameCount,
+        double startFrame,
+        double frameStep,
+        double framesPerSecond,
+        TrackEncoding encoding,
+        TrackLayout layout,
+        std::string *error
+    ) {
+        size_t trackCount = names.size();
+
+        if (trackCount == 0 || frameCount == 0)
+            return fail(error, "a track cache needs at least one track and one frame");
+
+        if (trackCount > 0xffffffffu || frameCount > 0xffffffffu)
+            return fail(error, "too many tracks or frames for a track cache");
+
+        if (!(frameStep > 0.0))
+            return fail(error, "the frames between samples must be positive");
+
+        if (!(framesPerSecond > 0.0))
+            return fail(error, "the frame rate must be positive");
+
+        size_t size = sampleSize(encoding);
+
+        std::string nameBlock;
+        std::vector<IndexEntry> index(trackCount);
+
+        Header header;
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.trackCount = (uint32_t) trackCount;
+        header.frameCount = (uint32_t) frameCount;
+        header.startFrame = startFrame;
+        header.frameStep = frameStep;
+        header.encoding = (uint32_t) encoding;
+        header.layout = (uint32_t) layout;
+        header.framesPerSecond = framesPerSecond;
+        header.namesOffset = sizeof(Header) + trackCount * sizeof(IndexEntry);
+
+        for (size_t t = 0; t < trackCount; t++)
+        {
+            index[t].nameOffset = (uint32_t) nameBlock.size();
+            index[t].nameLength = (uint32_t) names[t].size();
+            nameBlock += names[t];
+        }
+
+        header.dataOffset = (header.namesOffset + nameBlock.size() + kDataAlignment - 1) / kDataAlignment * kDataAlignment;
+
+        for (size_t t = 0; t < trackCount; t++)
+        {
+            uint64_t first = layout == kTrackFrameMajor ? t : (uint64_t) t * frameCount;
+            index[t].dataOffset = header.dataOffset + first * size;
+        }
+
+        std::ofstream file(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+        if (!file)
+            return fail(error, "cannot write to " + path);
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(index.data()), (std::streamsize) (index.size() * sizeof(IndexEntry)));
+        file.write(nameBlock.data(), (std::streamsize) nameBlock.size());
+
+        std::vector<char> padding((size_t) (header.dataOffset - header.namesOffset - nameBlock.size()), 0);
+        file.write(padding.data(), (std::streamsize) padding.size());
+
+        // One frame of every track, or every frame of one track, at a time.
+        size_t blockCount = layout == kTrackFrameMajor ? frameCount : trackCount;
+        size_t blockLength = layout == kTrackFrameMajor ? trackCount : frameCount;
+
+        std::vector<unsigned char> block(blockLength * size);
+
+        for (size_t b = 0; b < blockCount; b++)
+        {
+            for (size_t i = 0; i < blockLength; i++)
+            {
+                size_t element = layout == kTrackFrameMajor ? i * frameCount + b : b * frameCount + i;
+
+                double q[4] = { tracks.x[element], tracks.y[element], tracks.z[element], tracks.w[element] };
+                encodeSample(encoding, q, &block[i * size]);
+            }
+
+            file.write(reinterpret_cast<const char*>(block.data()), (std::streamsize) block.size());
+        }
+
+        if (!file)
+            return fail(error, "failed writing " + path);
+
+        return true;
+    }
+
+    TrackCache::TrackCache() :
+        frameCount_(0),
+        startFrame_(0.0),
+        frameStep_(1.0),
+        framesPerSecond_(0.0),
+        encoding_(kTrackFloat64),
+        layout_(kTrackFrameMajor),
+        frameStride_(0),
+        names_(NULL)
+    {
+    }
+
+    bool TrackCache::open(const std::string &path, std::string *error)
+    {
+        close();
+
+        if (!file_.open(path, error))
+            return false;
+
+        const unsigned char *data = file_.data();
+        uint64_t fileSize = file_.size();
+
+        Header header;
+
+        if (fileSize < sizeof(header))
+        {
+            close();
+            return fail(error, path + " is not a track cache");
+        }
+
+        std::memcpy(&header, data, sizeof(header));
+
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion)
+        {
+            close();
+            return fail(error, path + " is not a version 1 track cache");
+        }
+
+        // The track index follows the header.
+        uint64_t indexOffset = sizeof(Header);
+
+        if (header.encoding > kTrackSmallestThree || header.layout > kTrackTrackMajor ||
+            header.trackCount == 0 || header.frameCount == 0 || !(header.frameStep > 0.0) ||
+            !(header.framesPerSecond > 0.0))
+        {
+            close();
+            return fail(error, path + " has an invalid header");
+        }
+
+        TrackEncoding encoding = (TrackEncoding) header.encoding;
+        TrackLayout layout = (TrackLayout) header.layout;
+
+        uint64_t size = sampleSize(encoding);
+        uint64_t stride = layout == kTrackFrameMajor ? size * header.trackCount : size;
+        uint64_t samples = (uint64_t) header.trackCount * header.frameCount;
+
+        bool valid =
+            indexOffset + (uint64_t) header.trackCount * sizeof(IndexEntry) <= header.namesOffset &&
+            header.namesOffset <= header.dataOffset &&
+            header.dataOffset <= fileSize &&
+            samples <= (fileSize - header.dataOffset) / size;
+
+        if (!valid)
+        {
+            close();
+            return fail(error, path + " is truncated or has an invalid index");
+        }
+
+        uint64_t namesSize = header.dataOffset - header.namesOffset;
+        uint64_t lastSample = (uint64_t) (header.frameCount - 1) * stride + size;
+
+        trackOffsets_.resize(header.trackCount);
+        nameOffsets_.resize(header.trackCount);
+        nameLengths_.resize(header.trackCount);
+
+        for (uint32_t t = 0; t < header.trackCount; t++)
+        {
+            IndexEntry entry;
+            std::memcpy(&entry, data + indexOffset + t * sizeof(IndexEntry), sizeof(entry));
+
+            if (entry.dataOffset < header.dataOffset || entry.dataOffset > fileSize || lastSample > fileSize - entry.dataOffset ||
+                (uint64_t) entry.nameOffset + entry.nameLength > namesSize)
+            {
+                close();
+                return fail(error, path + " has an invalid index");
+            }
+
+            trackOffsets_[t] = entry.dataOffset;
+            nameOffsets_[t] = entry.nameOffset;
+            nameLengths_[t] = entry.nameLength;
+        }
+
+        frameCount_ = header.frameCount;
+        startFrame_ = header.startFrame;
+        frameStep_ = header.frameStep;
+        framesPerSecond_ = header.framesPerSecond;
+        encoding_ = encoding;
+        layout_ = layout;
+        frameStride_ = (size_t) stride;
+        names_ = reinterpret_cast<const char*>(data + header.namesOffset);
+
+        return true;
+    }
+
+    void TrackCache::close()
+    {
+        file_.close();
+
+        trackOffsets_.clear();
+        nameOffsets_.clear();
+        nameLengths_.clear();
+
+        frameCount_ = 0;
+        frameStride_ = 0;
+        names_ = NULL;
+    }
+
+    std::string TrackCache::trackName(size_t track) const
+    {
+        return std::string(names_ + nameOffsets_[track], nameLengths_[track]);
+    }
+
+    void TrackCache::readFrame(size_t frame, QuatArrayView out) const
+    {
+        const unsigned char *data = file_.data() + frame * frameStride_;
+
+        switch (encoding_)
+        {
+            case kTrackFloat64:
+                decodeFrame<kTrackFloat64>(data, trackOffsets_.data(), out, trackCount());
+                break;
+
+            case kTrackFloat16:
+                decodeFrame<kTrackFloat16>(data, trackOffsets_.data(), out, trackCount());
+                break;
+
+            case kTrackSmallestThree:
+                decodeFrame<kTrackSmallestThree>(data, trackOffsets_.data(), out, trackCount());
+                break;
+        }
+    }
+
+    void TrackCache::evaluate(double frame, QuatArray &out, SlerpMode mode)
+    {
+        size_t count = trackCount();
+        out.resize(count);
+
+        if (count == 0)
+            return;
+
+        double position = (frame - startFrame_) / frameStep_;
+
+        // Also catches NaN.
+        if (!(position > 0.0))
+            position = 0.0;
+
+        if (position >= (double) (frameCount_ - 1))
+        {
+            readFrame(frameCount_ - 1, out.view());
+            return;
+        }
+
+        size_t index = (size_t) position;
+        double tween = position - (double) index;
+
+        readFrame(index, out.view());
+
+        if (tween == 0.0)
+            return;
+
+        next_.resize(count);
+        readFrame(index + 1, next_.view());
+
+        tween_.assign(count, tween);
+
+        slerpBatch(out.view(), next_.view(), tween_.data(), NULL, out.view(), count, mode);
+    }
+}
@@ -0,0 +1,159 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    trackCache
+    On-disk quaternion tracks: many rotations sampled at evenly spaced
+    frames, read back through a memory map.
+
+    Frames are counted at the frame rate recorded in the header, so a
+    reader whose own frame rate differs converts through it, through
+    seconds, rather than lining up with the wrong samples.
+
+    Layout, little-endian:
+        header              64 bytes
+            char[4]             "QXTC"
+            uint32              version (1)
+            uint32              track count
+            uint32              frame count
+            double              first frame
+            double              frames between samples
+            uint32              encoding (TrackEncoding)
+            uint32              layout (TrackLayout)
+            double              frames per second
+            uint64              offset of the track names
+            uint64              offset of the samples, a multiple of 64
+        track index         16 bytes per track, straight after the header
+            uint64              offset of the track's first sample
+            uint32              offset of its name in the names block
+            uint32              length of its name
+        names               track names, not terminated
+        samples             frameCount * trackCount samples
+
+    kTrackFrameMajor stores every track's sample for a frame together,
+    which is what playback reads. kTrackTrackMajor stores each track's
+    frames together, which suits tools that read one track at a time.
+
+    Encodings, per sample:
+        kTrackFloat64       32 bytes, x y z w as doubles. Exact.
+        kTrackFloat16       8 bytes, x y z w as IEEE half floats,
+                            renormalized on read. Within 0.05 degrees.
+        kTrackSmallestThree 6 bytes. The largest component is dropped
+                            and rebuilt from the unit length; the other
+                            three are stored in 15 bits each. Within
+                            0.01 degrees.
+
+    Opening a cache maps the file and checks the header and index, without
+    reading any samples, so it takes the same time for any size. Reading a
+    frame decodes one sample per track at a computed address.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_TRACK_CACHE_H
+#define QUAT_EXTRAS_TRACK_CACHE_H
+
+#include "mappedFile.h"
+#include "quatBatch.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace quatExtras
+{
+    enum TrackEncoding
+    {
+        kTrackFloat64,
+        kTrackFloat16,
+        kTrackSmallestThree
+    };
+
+    enum TrackLayout
+    {
+        kTrackFrameMajor,
+        kTrackTrackMajor
+    };
+
+    /*
+        Writes a cache to path. tracks holds names.size() * frameCount
+        quaternions, each track's frames together: frame f of track t is
+        element t * frameCount + f. startFrame and frameStep are in frames
+        of framesPerSecond. On failure the reason is put in error.
+    */
+    bool writeTrackCache(
+        const std::string &path,
+        const std::vector<std::string> &names,
+        ConstQuatArrayView tracks,
+        size_t frameCount,
+        double startFrame,
+        double frameStep,
+        double framesPerSecond,
+        TrackEncoding encoding = kTrackFloat64,
+        TrackLayout layout = kTrackFrameMajor,
+        std::string *error = NULL
+    );
+
+    /*
+        Read-only view of a cache file. evaluate keeps scratch buffers, so
+        one TrackCache must not be evaluated from two threads at once.
+    */
+    class TrackCache
+    {
+    public:
+                            TrackCache();
+
+        // Maps path, closing any cache opened before. On failure the
+        // reason is put in error and the cache is left closed.
+        bool                open(const std::string &path, std::string *error = NULL);
+        void                close();
+
+        bool                isOpen() const          { return file_.isOpen(); }
+
+        size_t              trackCount() const      { return trackOffsets_.size(); }
+        size_t              frameCount() const      { return frameCount_; }
+        double              startFrame() const      { return startFrame_; }
+        double              frameStep() const       { return frameStep_; }
+
+        // Frame rate the frames are counted at.
+        double              framesPerSecond() const { return framesPerSecond_; }
+        TrackEncoding       encoding() const        { return encoding_; }
+        TrackLayout         layout() const          { return layout_; }
+
+        std::string         trackName(size_t track) const;
+
+        // Decodes every track at frame index frame into out.
+        void                readFrame(size_t frame, QuatArrayView out) const;
+
+        /*
+            Every track at frame, in the cache's frame units. Fractional
+            frames are interpolated with slerpBatch; frames outside the
+            cache hold the first or last sample.
+        */
+        void                evaluate(double frame, QuatArray &out, SlerpMode mode = kSlerpExact);
+
+    private:
+        MappedFile          file_;
+
+        size_t              frameCount_;
+        double              startFrame_;
+        double              frameStep_;
+        double              framesPerSecond_;
+        TrackEncoding       encoding_;
+        TrackLayout         layout_;
+
+        // Bytes from one frame of a track to the next.
+        size_t              frameStride_;
+
+        std::vector<uint64_t> trackOffsets_;
+        std::vector<uint32_t> nameOffsets_;
+        std::vector<uint32_t> nameLengths_;
+        const char          *names_;
+
+        QuatArray           next_;
+        std::vector<double> tween_;
+    };
+}
+
+#endif
@@ -0,0 +1,104 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+#include "unflipHistory.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace quatExtras
+{
+    UnflipHistory::UnflipHistory() :
+        capacity_(kDefaultCapacity),
+        trackCount_(0)
+    {
+    }
+
+    void UnflipHistory::clear()
+    {
+        frames_.clear();
+        trackCount_ = 0;
+    }
+
+    void UnflipHistory::setCapacity(size_t frames)
+    {
+        capacity_ = std::max<size_t>(frames, 1);
+    }
+
+    const QuatArray* UnflipHistory::reference(double time, double maxStep) const
+    {
+        std::map<double, QuatArray>::const_iterator after = frames_.lower_bound(time);
+
+        if (after != frames_.begin())
+        {
+            std::map<double, QuatArray>::const_iterator before = std::prev(after);
+
+            if (time - before->first <= maxStep)
+                return &before->second;
+        }
+
+        if (after != frames_.end() && after->first == time)
+            return &after->second;
+
+        if (after != frames_.end() && after->first - time <= maxStep)
+            return &after->second;
+
+        return NULL;
+    }
+
+    void UnflipHistory::trim(double time)
+    {
+        size_t frameBytes = std::max<size_t>(trackCount_ * 4 * sizeof(double), 1);
+        size_t limit = std::max<size_t>(std::min(capacity_, kMaxBytes / frameBytes), 1);
+
+        while (frames_.size() > limit)
+        {
+            std::map<double, QuatArray>::iterator first = frames_.begin();
+            std::map<double, QuatArray>::iterator last = std::prev(frames_.end());
+
+            if (time - first->first >= last->first - time)
+            {
+                frames_.erase(first);
+            } else {
+                frames_.erase(last);
+            }
+        }
+    }
+
+    bool UnflipHistory::unflip(double time, ConstQuatArrayView q, QuatArrayView out, size_t count, double maxStep, bool store)
+    {
+        if (count != trackCount_ && store)
+        {
+            frames_.clear();
+            trackCount_ = count;
+        }
+
+        const QuatArray *previous = count == trackCount_ ? reference(time, maxStep) : NULL;
+
+        if (previous)
+        {
+            unflipBatch(q, previous->view(), out, count);
+        } else {
+            canonicalHemisphereBatch(q, out, count);
+        }
+
+        if (!store)
+            return previous != NULL;
+
+        QuatArray &frame = frames_[time];
+        frame.resize(count);
+
+        QuatArrayView frameView = frame.view();
+
+        std::copy(out.x, out.x + count, frameView.x);
+        std::copy(out.y, out.y + count, frameView.y);
+        std::copy(out.z, out.z + count, frameView.z);
+        std::copy(out.w, out.w + count, frameView.w);
+
+        trim(time);
+
+        return previous != NULL;
+    }
+}
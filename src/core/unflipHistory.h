@@ -0,0 +1,79 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    unflipHistory
+    Maya-free state for keeping quaternion tracks on one hemisphere over
+    time. q and -q are the same rotation, so a source can change sign
+    between frames without changing the rotation, which breaks filtering
+    and sub-frame blending of its samples.
+
+    UnflipHistory stores the unflipped tracks of the frames it has seen,
+    keyed by time. Each new sample is flipped onto the hemisphere of a
+    stored frame near it, picked in this order:
+
+        1. the latest frame before time, no more than maxStep earlier
+        2. the frame at time itself, when it is evaluated again
+        3. the earliest frame after time, no more than maxStep later
+
+    and by canonicalHemisphere when none is stored, as on the first frame
+    or after a scrub. Preferring the frame before means that once a range
+    has been played forward, playing it again, or sampling it in any
+    order, gives the same signs, however it was first reached.
+
+    When more than capacity frames are stored, or more than kMaxBytes of
+    them, the one furthest in time from the newest sample is dropped. A
+    change in the number of tracks clears the history.
+-----------------------------------------------------------------------------*/
+
+#ifndef QUAT_EXTRAS_UNFLIP_HISTORY_H
+#define QUAT_EXTRAS_UNFLIP_HISTORY_H
+
+#include "quatBatch.h"
+
+#include <cstddef>
+#include <map>
+
+namespace quatExtras
+{
+    class UnflipHistory
+    {
+    public:
+        static const size_t     kDefaultCapacity = 100;
+
+        // Most bytes of samples kept, whatever the capacity: 64 MB, or 200
+        // frames of 10,000 tracks.
+        static const size_t     kMaxBytes = 64 << 20;
+
+                                UnflipHistory();
+
+        void                    clear();
+
+        // Frames kept; at least one.
+        size_t                  capacity() const { return capacity_; }
+        void                    setCapacity(size_t frames);
+
+        size_t                  frameCount() const { return frames_.size(); }
+
+        /*
+            Unflips the count tracks of q sampled at time into out and,
+            if store is set, stores the result as the frame at time.
+            Returns false if no stored frame was close enough and
+            canonicalHemisphere was used. out may alias q.
+        */
+        bool                    unflip(double time, ConstQuatArrayView q, QuatArrayView out, size_t count, double maxStep, bool store = true);
+
+    private:
+        const QuatArray*        reference(double time, double maxStep) const;
+        void                    trim(double time);
+
+        size_t                  capacity_;
+        size_t                  trackCount_;
+
+        std::map<double, QuatArray> frames_;
+    };
+}
+
+#endif
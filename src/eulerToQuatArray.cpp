@@ -0,0 +1,129 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    eulerToQuatArray node
+    Converts many Euler rotations to quaternions in a single evaluation.
+
+    inputRotate (ir)
+        Euler rotations, such as joints' rotate attributes.
+
+    rotateOrder (ro)
+        Order the rotations are applied in, shared by every element; the
+        same choices as a transform's rotateOrder. Defaults to xyz.
+
+    outputQuat  (oq)
+        One quaternion per logical index of inputRotate, matching
+        MEulerRotation::asQuaternion.
+
+    outputQuatData (oqd)
+        The same as quatArrayData, computed only when it is requested.
+
+-----------------------------------------------------------------------------*/
+
+#include "eulerToQuatArray.h"
+#include "quatArrayData.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnEnumAttribute.h>
+#include <maya/MPlug.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+VectorAttribute EulerToQuatArrayNode::inputRotate_attr;
+MObject EulerToQuatArrayNode::rotateOrder_attr;
+
+QuatAttribute EulerToQuatArrayNode::outputQuat_attr;
+MObject EulerToQuatArrayNode::outputQuatData_attr;
+
+EulerToQuatArrayNode::EulerToQuatArrayNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* EulerToQuatArrayNode::creator()
+{
+    return new EulerToQuatArrayNode();
+}
+
+MStatus EulerToQuatArrayNode::initialize()
+{
+    MStatus status;
+
+    MFnEnumAttribute e;
+
+    const double zeroRotate[3] = { 0.0, 0.0, 0.0 };
+
+    const char *const inputRotateNames[] = { "irx", "iry", "irz" };
+    status = inputRotate_attr.create("inputRotate", "ir", inputRotateNames, zeroRotate, kCompoundInput | kCompoundArray | kCompoundAngle);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    rotateOrder_attr = e.create("rotateOrder", "ro", kRotateXYZ, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(e);
+    e.addField("xyz", kRotateXYZ);
+    e.addField("yzx", kRotateYZX);
+    e.addField("zxy", kRotateZXY);
+    e.addField("xzy", kRotateXZY);
+    e.addField("yxz", kRotateYXZ);
+    e.addField("zyx", kRotateZYX);
+
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    outputQuatData_attr = createQuatArrayDataAttribute("outputQuatData", "oqd", true, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(inputRotate_attr);
+    addAttribute(rotateOrder_attr);
+    addAttribute(outputQuat_attr);
+    addAttribute(outputQuatData_attr);
+
+    attributeAffects(inputRotate_attr, outputQuat_attr);
+    attributeAffects(rotateOrder_attr, outputQuat_attr);
+
+    attributeAffects(inputRotate_attr, outputQuatData_attr);
+    attributeAffects(rotateOrder_attr, outputQuatData_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus EulerToQuatArrayNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputQuat_attr) && !isPlugFor(plug, outputQuatData_attr))
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    MArrayDataHandle inputHandle = data.inputArrayValue(inputRotate_attr);
+
+    unsigned count = logicalLength(inputHandle);
+    timer.setElements(count);
+
+    std::vector<double> rotateX(count, 0.0);
+    std::vector<double> rotateY(count, 0.0);
+    std::vector<double> rotateZ(count, 0.0);
+
+    VectorArrayView rotateView = { rotateX.data(), rotateY.data(), rotateZ.data() };
+
+    inputRotate_attr.inputArrayValue(inputHandle, rotateView, count);
+
+    RotateOrder order = (RotateOrder) data.inputValue(rotateOrder_attr).asShort();
+
+    QuatArrayOutput output(plug, outputQuat_attr, outputQuatData_attr);
+
+    eulerToQuatBatch(rotateView, order, output.allocate(count), count);
+
+    return output.write(data);
+}
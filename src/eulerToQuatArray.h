@@ -0,0 +1,33 @@
+#ifndef EULER_TO_QUAT_ARRAY_H
+#define EULER_TO_QUAT_ARRAY_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+class EulerToQuatArrayNode : public MPxNode, public ProfiledNode
+{
+public:
+                            EulerToQuatArrayNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static VectorAttribute  inputRotate_attr;
+    static MObject          rotateOrder_attr;
+
+    static QuatAttribute    outputQuat_attr;
+    static MObject          outputQuatData_attr;
+};
+
+#endif
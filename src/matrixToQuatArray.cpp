@@ -0,0 +1,190 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    matrixToQuatArray node
+    Extracts the rotations of many matrices as quaternions in a single
+    evaluation, in place of one decomposeMatrix per joint.
+
+    inputMatrix         (im)
+        Matrices to extract rotations from, such as joints' worldMatrix.
+        Scale and shear are ignored.
+
+    parentInverseMatrix (pim)
+        Optional. When connected, each rotation is taken from inputMatrix[i]
+        * parentInverseMatrix[i], so world matrices give local rotations.
+        Missing elements count as identity.
+
+    outputQuat          (oq)
+        One quaternion per logical index of inputMatrix, with w >= 0.
+
+    outputQuatData (oqd)
+        The same as quatArrayData, computed only when it is requested.
+
+    A matrix that mirrors gives the rotation with its z axis flipped back.
+    Arrays of kParallelThreshold elements or more are split across all
+    cores.
+
+-----------------------------------------------------------------------------*/
+
+#include "matrixToQuatArray.h"
+#include "quatArrayData.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+#include "core/taskScheduler.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnMatrixAttribute.h>
+#include <maya/MPlug.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+// Below this many matrices the work is too small to be worth waking the
+// workers.
+const size_t kParallelThreshold = 16384;
+const size_t kParallelGrain = 4096;
+
+MObject MatrixToQuatArrayNode::inputMatrix_attr;
+MObject MatrixToQuatArrayNode::parentInverseMatrix_attr;
+
+QuatAttribute MatrixToQuatArrayNode::outputQuat_attr;
+MObject MatrixToQuatArrayNode::outputQuatData_attr;
+
+namespace
+{
+    // Upper 3x3 of count matrices, one buffer per element. Identity until
+    // read.
+    struct MatrixBuffers
+    {
+        std::vector<double> elements[9];
+
+        explicit MatrixBuffers(unsigned count)
+        {
+            for (unsigned k = 0; k < 9; k++)
+                elements[k].assign(count, k % 4 == 0 ? 1.0 : 0.0);
+        }
+
+        void read(MArrayDataHandle &arrayHandle, unsigned count)
+        {
+            double *pointers[9];
+
+            for (unsigned k = 0; k < 9; k++)
+                pointers[k] = elements[k].data();
+
+            inputMatrixArrayValue(arrayHandle, pointers, count);
+        }
+
+        ConstMatrixArrayView view(size_t begin) const
+        {
+            ConstMatrixArrayView result;
+
+            for (unsigned k = 0; k < 9; k++)
+                result.m[k] = elements[k].data() + begin;
+
+            return result;
+        }
+    };
+}
+
+MatrixToQuatArrayNode::MatrixToQuatArrayNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* MatrixToQuatArrayNode::creator()
+{
+    return new MatrixToQuatArrayNode();
+}
+
+MStatus MatrixToQuatArrayNode::initialize()
+{
+    MStatus status;
+
+    MFnMatrixAttribute m;
+
+    inputMatrix_attr = m.create("inputMatrix", "im", MFnMatrixAttribute::kDouble, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(m);
+    m.setArray(true);
+
+    parentInverseMatrix_attr = m.create("parentInverseMatrix", "pim", MFnMatrixAttribute::kDouble, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(m);
+    m.setArray(true);
+
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    outputQuatData_attr = createQuatArrayDataAttribute("outputQuatData", "oqd", true, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(inputMatrix_attr);
+    addAttribute(parentInverseMatrix_attr);
+    addAttribute(outputQuat_attr);
+    addAttribute(outputQuatData_attr);
+
+    attributeAffects(inputMatrix_attr, outputQuat_attr);
+    attributeAffects(parentInverseMatrix_attr, outputQuat_attr);
+
+    attributeAffects(inputMatrix_attr, outputQuatData_attr);
+    attributeAffects(parentInverseMatrix_attr, outputQuatData_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus MatrixToQuatArrayNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputQuat_attr) && !isPlugFor(plug, outputQuatData_attr))
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    MArrayDataHandle inputHandle = data.inputArrayValue(inputMatrix_attr);
+    MArrayDataHandle parentInverseHandle = data.inputArrayValue(parentInverseMatrix_attr);
+
+    unsigned count = logicalLength(inputHandle);
+    timer.setElements(count);
+
+    MatrixBuffers matrix(count);
+    matrix.read(inputHandle, count);
+
+    // An unconnected parentInverseMatrix skips the product altogether.
+    bool hasParentInverse = parentInverseHandle.elementCount() != 0;
+
+    MatrixBuffers parentInverse(hasParentInverse ? count : 0);
+
+    if (hasParentInverse)
+        parentInverse.read(parentInverseHandle, count);
+
+    QuatArrayOutput output(plug, outputQuat_attr, outputQuatData_attr);
+    QuatArrayView outputView = output.allocate(count);
+
+    RangeTask extract = [&](size_t begin, size_t end) {
+        QuatArrayView out = { outputView.x + begin, outputView.y + begin, outputView.z + begin, outputView.w + begin };
+
+        if (hasParentInverse)
+        {
+            matrixToQuatBatch(matrix.view(begin), parentInverse.view(begin), out, end - begin);
+        } else {
+            matrixToQuatBatch(matrix.view(begin), out, end - begin);
+        }
+    };
+
+    if (count >= kParallelThreshold)
+    {
+        parallelFor(count, kParallelGrain, extract);
+    } else {
+        extract(0, count);
+    }
+
+    return output.write(data);
+}
@@ -0,0 +1,33 @@
+#ifndef MATRIX_TO_QUAT_ARRAY_H
+#define MATRIX_TO_QUAT_ARRAY_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+class MatrixToQuatArrayNode : public MPxNode, public ProfiledNode
+{
+public:
+                            MatrixToQuatArrayNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static MObject          inputMatrix_attr;
+    static MObject          parentInverseMatrix_attr;
+
+    static QuatAttribute    outputQuat_attr;
+    static MObject          outputQuatData_attr;
+};
+
+#endif
@@ -1,44 +1,247 @@
 #include "nodeUtils.h"
 
+#include <maya/MArrayDataBuilder.h>
+#include <maya/MAngle.h>
+#include <maya/MArrayDataHandle.h>
 #include <maya/MDataHandle.h>
 #include <maya/MDataBlock.h>
+#include <maya/MFnEnumAttribute.h>
+#include <maya/MMatrix.h>
 #include <maya/MObject.h>
-#include <maya/MQuaternion.h>
+#include <maya/MPlug.h>
 
-#define MAKE_INPUT(attr)        \
-    attr.setKeyable(true);      \
-    attr.setChannelBox(false);  \
-    attr.setStorable(true);     \
-    attr.setWritable(true);     
+/*
+    True if plug is attr itself, one of its elements, or a child of either.
+*/
+bool isPlugFor(const MPlug &plug, const MObject &attr)
+{
+    MPlug p(plug);
+
+    if (p.isChild())
+        p = p.parent();
+
+    if (p.isElement())
+        p = p.array();
+
+    return p == attr;
+}
+
+/*
+    One past the highest logical index present in the array, so sparse
+    arrays map onto dense buffers without losing their indices.
+*/
+unsigned logicalLength(MArrayDataHandle &arrayHandle)
+{
+    unsigned length = 0;
+    unsigned numElements = arrayHandle.elementCount();
+
+    for (unsigned i = 0; i < numElements; i++)
+    {
+        arrayHandle.jumpToArrayElement(i);
+
+        unsigned index = arrayHandle.elementIndex();
+
+        if (index >= length)
+            length = index + 1;
+    }
+
+    return length;
+}
+
+namespace
+{
+    template <class T>
+    void inputDoubleArrayValueT(MArrayDataHandle &arrayHandle, T *values, unsigned length)
+    {
+        unsigned numElements = arrayHandle.elementCount();
+
+        for (unsigned i = 0; i < numElements; i++)
+        {
+            arrayHandle.jumpToArrayElement(i);
+
+            unsigned index = arrayHandle.elementIndex();
+
+            if (index < length)
+                values[index] = T(arrayHandle.inputValue().asDouble());
+        }
+    }
+
+    template <class T>
+    void inputAngleArrayValueT(MArrayDataHandle &arrayHandle, T *radians, unsigned length)
+    {
+        unsigned numElements = arrayHandle.elementCount();
+
+        for (unsigned i = 0; i < numElements; i++)
+        {
+            arrayHandle.jumpToArrayElement(i);
+
+            unsigned index = arrayHandle.elementIndex();
+
+            if (index < length)
+                radians[index] = T(arrayHandle.inputValue().asAngle().asRadians());
+        }
+    }
+
+    inline void setElement(MDataHandle handle, double value)    { handle.setDouble(value); }
+    inline void setElement(MDataHandle handle, int value)       { handle.setInt(value); }
+
+    // Replaces the output array with length elements set from values.
+    template <class T>
+    MStatus outputArrayValueT(MDataBlock &data, const T *values, unsigned length, MObject &attr)
+    {
+        MStatus status;
+
+        MArrayDataHandle arrayHandle = data.outputArrayValue(attr, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        MArrayDataBuilder builder(&data, attr, length, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        for (unsigned i = 0; i < length; i++)
+        {
+            setElement(builder.addElement(i), values[i]);
+        }
+
+        arrayHandle.set(builder);
+        arrayHandle.setAllClean();
+
+        return MStatus::kSuccess;
+    }
+
+    template <class T>
+    MStatus outputAngleArrayValueT(MDataBlock &data, const T *radians, unsigned length, MObject &attr)
+    {
+        MStatus status;
+
+        MArrayDataHandle arrayHandle = data.outputArrayValue(attr, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        MArrayDataBuilder builder(&data, attr, length, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        for (unsigned i = 0; i < length; i++)
+        {
+            builder.addElement(i).setMAngle(MAngle(radians[i], MAngle::kRadians));
+        }
+
+        arrayHandle.set(builder);
+        arrayHandle.setAllClean();
+
+        return MStatus::kSuccess;
+    }
+
+    // Field values of the precision attribute.
+    enum PrecisionField
+    {
+        kPrecisionFieldDefault  = 0,
+        kPrecisionFieldDouble   = 1,
+        kPrecisionFieldFloat    = 2
+    };
+}
+
+void inputDoubleArrayValue(MArrayDataHandle &arrayHandle, double *values, unsigned length)
+{
+    inputDoubleArrayValueT(arrayHandle, values, length);
+}
 
-#define MAKE_OUTPUT(attr)       \
-    attr.setKeyable(false);     \
-    attr.setChannelBox(false);  \
-    attr.setStorable(false);    \
-    attr.setWritable(false);    
+void inputDoubleArrayValue(MArrayDataHandle &arrayHandle, float *values, unsigned length)
+{
+    inputDoubleArrayValueT(arrayHandle, values, length);
+}
 
-MQuaternion inputQuaternionValue(MDataBlock &data, MObject &attr,  MObject &attrX, MObject &attrY, MObject &attrZ, MObject &attrW)
+void inputShortArrayValue(MArrayDataHandle &arrayHandle, short *values, unsigned length)
 {
-    MDataHandle attrHandle = data.inputValue(attr);
-    
-    double x = attrHandle.child(attrX).asDouble();
-    double y = attrHandle.child(attrY).asDouble();
-    double z = attrHandle.child(attrZ).asDouble();
-    double w = attrHandle.child(attrW).asDouble();
+    unsigned numElements = arrayHandle.elementCount();
+
+    for (unsigned i = 0; i < numElements; i++)
+    {
+        arrayHandle.jumpToArrayElement(i);
 
-    return MQuaternion(x, y, z, w);
+        unsigned index = arrayHandle.elementIndex();
+
+        if (index < length)
+            values[index] = arrayHandle.inputValue().asShort();
+    }
 }
 
-MStatus outputQuaternionValue(MDataBlock &data, MQuaternion &value, MObject &attr,  MObject &attrX, MObject &attrY, MObject &attrZ, MObject &attrW)
+void inputAngleArrayValue(MArrayDataHandle &arrayHandle, double *radians, unsigned length)
 {
-    MDataHandle attrHandle = data.outputValue(attr);
-    
-    attrHandle.child(attrX).setDouble(value.x);
-    attrHandle.child(attrY).setDouble(value.y);
-    attrHandle.child(attrZ).setDouble(value.z);
-    attrHandle.child(attrW).setDouble(value.w);
+    inputAngleArrayValueT(arrayHandle, radians, length);
+}
+
+void inputAngleArrayValue(MArrayDataHandle &arrayHandle, float *radians, unsigned length)
+{
+    inputAngleArrayValueT(arrayHandle, radians, length);
+}
 
-    attrHandle.setClean();
-     
-    return MStatus::kSuccess;    
-}
\ No newline at end of file
+/*
+    Scatters the upper 3x3 of each matrix into nine buffers, one per
+    element: elements[3 * row + column][index].
+*/
+void inputMatrixArrayValue(MArrayDataHandle &arrayHandle, double *const elements[9], unsigned length)
+{
+    unsigned numElements = arrayHandle.elementCount();
+
+    for (unsigned i = 0; i < numElements; i++)
+    {
+        arrayHandle.jumpToArrayElement(i);
+
+        unsigned index = arrayHandle.elementIndex();
+
+        if (index >= length)
+            continue;
+
+        const MMatrix &m = arrayHandle.inputValue().asMatrix();
+
+        for (unsigned k = 0; k < 9; k++)
+            elements[k][index] = m(k / 3, k % 3);
+    }
+}
+
+MStatus outputAngleArrayValue(MDataBlock &data, const double *radians, unsigned length, MObject &attr)
+{
+    return outputAngleArrayValueT(data, radians, length, attr);
+}
+
+MStatus outputAngleArrayValue(MDataBlock &data, const float *radians, unsigned length, MObject &attr)
+{
+    return outputAngleArrayValueT(data, radians, length, attr);
+}
+
+MStatus outputDoubleArrayValue(MDataBlock &data, const double *values, unsigned length, MObject &attr)
+{
+    return outputArrayValueT(data, values, length, attr);
+}
+
+MStatus outputIntArrayValue(MDataBlock &data, const int *values, unsigned length, MObject &attr)
+{
+    return outputArrayValueT(data, values, length, attr);
+}
+
+/*
+    The precision (pr) enum shared by the nodes with float kernels:
+    default follows the plugin-wide setting (see defaultPrecision in
+    core/quatBatch.h), double and float override it for the node.
+*/
+MObject createPrecisionAttribute(MStatus *status)
+{
+    MFnEnumAttribute e;
+
+    MObject attr = e.create("precision", "pr", kPrecisionFieldDefault, status);
+    MAKE_INPUT(e);
+    e.addField("default", kPrecisionFieldDefault);
+    e.addField("double", kPrecisionFieldDouble);
+    e.addField("float", kPrecisionFieldFloat);
+
+    return attr;
+}
+
+quatExtras::Precision precisionValue(MDataBlock &data, const MObject &attr)
+{
+    switch (data.inputValue(attr).asShort())
+    {
+        case kPrecisionFieldDouble: return quatExtras::kPrecisionDouble;
+        case kPrecisionFieldFloat:  return quatExtras::kPrecisionFloat;
+        default:                    return quatExtras::defaultPrecision();
+    }
+}
@@ -1,10 +1,13 @@
 #ifndef NODE_UTILS_H
 #define NODE_UTILS_H
 
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataHandle.h>
 #include <maya/MDataHandle.h>
 #include <maya/MDataBlock.h>
 #include <maya/MObject.h>
-#include <maya/MQuaternion.h>
+#include <maya/MPlug.h>
 
 #define MAKE_INPUT(attr)        \
     attr.setKeyable(true);      \
@@ -18,6 +21,21 @@
     attr.setStorable(false);    \
     attr.setWritable(false);    
 
-MQuaternion inputQuaternionValue(MDataBlock &data, MObject &attr,  MObject &attrX, MObject &attrY, MObject &attrZ, MObject &attrW);
-MStatus outputQuaternionValue(MDataBlock &data, MQuaternion &value, MObject &attr,  MObject &attrX, MObject &attrY, MObject &attrZ, MObject &attrW);
+bool isPlugFor(const MPlug &plug, const MObject &attr);
+unsigned logicalLength(MArrayDataHandle &arrayHandle);
+
+void inputDoubleArrayValue(MArrayDataHandle &arrayHandle, double *values, unsigned length);
+void inputDoubleArrayValue(MArrayDataHandle &arrayHandle, float *values, unsigned length);
+void inputShortArrayValue(MArrayDataHandle &arrayHandle, short *values, unsigned length);
+void inputAngleArrayValue(MArrayDataHandle &arrayHandle, double *radians, unsigned length);
+void inputAngleArrayValue(MArrayDataHandle &arrayHandle, float *radians, unsigned length);
+void inputMatrixArrayValue(MArrayDataHandle &arrayHandle, double *const elements[9], unsigned length);
+
+MStatus outputAngleArrayValue(MDataBlock &data, const double *radians, unsigned length, MObject &attr);
+MStatus outputAngleArrayValue(MDataBlock &data, const float *radians, unsigned length, MObject &attr);
+MStatus outputDoubleArrayValue(MDataBlock &data, const double *values, unsigned length, MObject &attr);
+MStatus outputIntArrayValue(MDataBlock &data, const int *values, unsigned length, MObject &attr);
+
+MObject createPrecisionAttribute(MStatus *status);
+quatExtras::Precision precisionValue(MDataBlock &data, const MObject &attr);
 #endif
\ No newline at end of file
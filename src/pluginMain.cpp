@@ -35,18 +35,72 @@
 
     Nodes
         - axisAngleToQuat
+        - axisAngleToQuatArray
+        - eulerToQuatArray
+        - matrixToQuatArray
+        - quatAngularVelocity
+        - quatArrayPack
+        - quatArrayUnpack
+        - quatAverage
+        - quatCache
+        - quatDistribute
+        - quatExtrasDQSkin
+        - quatLogExp
+        - quatPoseReader
+        - quatPower
         - quatSlerp node
+        - quatSlerpArray
+        - quatSpline
+        - quatSpring
+        - quatSwingTwist
+        - quatSwingTwistArray
         - quatToAxisAngle
+        - quatToAxisAngleArray
+        - quatToEulerArray
+        - quatUnflip
+
+    Data
+        - quatArrayData
 
     Commands
-        - n/a
+        - quatExtrasBake
+        - quatExtrasStats
 */
 
 #include "axisAngleToQuat.h"
+#include "axisAngleToQuatArray.h"
+#include "eulerToQuatArray.h"
+#include "matrixToQuatArray.h"
+#include "quatAngularVelocity.h"
+#include "quatArrayData.h"
+#include "quatArrayPack.h"
+#include "quatArrayUnpack.h"
+#include "quatAverage.h"
+#include "quatCache.h"
+#include "quatDistribute.h"
+#include "quatExtrasBakeCmd.h"
+#include "quatExtrasDQSkin.h"
+#include "quatExtrasStatsCmd.h"
+#include "quatLogExp.h"
+#include "quatPoseReader.h"
+#include "quatPower.h"
 #include "quatToAxisAngle.h"
+#include "quatToAxisAngleArray.h"
+#include "quatToEulerArray.h"
+#include "quatUnflip.h"
 #include "quatSlerp.h"
+#include "quatSlerpArray.h"
+#include "quatSpline.h"
+#include "quatSpring.h"
+#include "quatSwingTwist.h"
+#include "quatSwingTwistArray.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+#include "core/taskScheduler.h"
 
 #include <maya/MFnPlugin.h>
+#include <maya/MGlobal.h>
 #include <maya/MTypeId.h>
 #include <maya/MString.h>
 
@@ -57,10 +111,57 @@ const char* kREQUIRED_API_VERSION = "Any";
 MTypeId AxisAngleToQuatNode::NODE_ID(0x00126b3d);
 MTypeId QuatToAxisAngleNode::NODE_ID(0x00126b3e);
 MTypeId QuatSlerpNode::NODE_ID(0x00126b3f);
+MTypeId QuatSlerpArrayNode::NODE_ID(0x00126b40);
+MTypeId AxisAngleToQuatArrayNode::NODE_ID(0x00126b41);
+MTypeId QuatToAxisAngleArrayNode::NODE_ID(0x00126b42);
+MTypeId QuatSplineNode::NODE_ID(0x00126b43);
+MTypeId QuatAverageNode::NODE_ID(0x00126b44);
+MTypeId QuatCacheNode::NODE_ID(0x00126b45);
+MTypeId QuatSwingTwistNode::NODE_ID(0x00126b46);
+MTypeId QuatSwingTwistArrayNode::NODE_ID(0x00126b47);
+MTypeId EulerToQuatArrayNode::NODE_ID(0x00126b48);
+MTypeId QuatToEulerArrayNode::NODE_ID(0x00126b49);
+MTypeId MatrixToQuatArrayNode::NODE_ID(0x00126b4a);
+MTypeId QuatLogExpNode::NODE_ID(0x00126b4b);
+MTypeId QuatPowerNode::NODE_ID(0x00126b4c);
+MTypeId QuatExtrasDQSkinNode::NODE_ID(0x00126b4d);
+MTypeId QuatUnflipNode::NODE_ID(0x00126b4e);
+MTypeId QuatDistributeNode::NODE_ID(0x00126b4f);
+MTypeId QuatPoseReaderNode::NODE_ID(0x00126b50);
+MTypeId QuatArrayData::TYPE_ID(0x00126b51);
+MTypeId QuatArrayPackNode::NODE_ID(0x00126b52);
+MTypeId QuatArrayUnpackNode::NODE_ID(0x00126b53);
+MTypeId QuatAngularVelocityNode::NODE_ID(0x00126b54);
+MTypeId QuatSpringNode::NODE_ID(0x00126b55);
 
 MString AxisAngleToQuatNode::NODE_NAME("axisAngleToQuat");
 MString QuatToAxisAngleNode::NODE_NAME("quatToAxisAngle");
 MString QuatSlerpNode::NODE_NAME("quatSlerp");
+MString QuatSlerpArrayNode::NODE_NAME("quatSlerpArray");
+MString AxisAngleToQuatArrayNode::NODE_NAME("axisAngleToQuatArray");
+MString QuatToAxisAngleArrayNode::NODE_NAME("quatToAxisAngleArray");
+MString QuatSplineNode::NODE_NAME("quatSpline");
+MString QuatAverageNode::NODE_NAME("quatAverage");
+MString QuatCacheNode::NODE_NAME("quatCache");
+MString QuatSwingTwistNode::NODE_NAME("quatSwingTwist");
+MString QuatSwingTwistArrayNode::NODE_NAME("quatSwingTwistArray");
+MString EulerToQuatArrayNode::NODE_NAME("eulerToQuatArray");
+MString QuatToEulerArrayNode::NODE_NAME("quatToEulerArray");
+MString MatrixToQuatArrayNode::NODE_NAME("matrixToQuatArray");
+MString QuatLogExpNode::NODE_NAME("quatLogExp");
+MString QuatPowerNode::NODE_NAME("quatPower");
+MString QuatExtrasDQSkinNode::NODE_NAME("quatExtrasDQSkin");
+MString QuatUnflipNode::NODE_NAME("quatUnflip");
+MString QuatDistributeNode::NODE_NAME("quatDistribute");
+MString QuatPoseReaderNode::NODE_NAME("quatPoseReader");
+MString QuatArrayData::TYPE_NAME("quatArrayData");
+MString QuatArrayPackNode::NODE_NAME("quatArrayPack");
+MString QuatArrayUnpackNode::NODE_NAME("quatArrayUnpack");
+MString QuatAngularVelocityNode::NODE_NAME("quatAngularVelocity");
+MString QuatSpringNode::NODE_NAME("quatSpring");
+
+MString QuatExtrasBakeCmd::COMMAND_NAME("quatExtrasBake");
+MString QuatExtrasStatsCmd::COMMAND_NAME("quatExtrasStats");
 
 
 #define REGISTER_NODE(NODE)                    \
@@ -71,6 +172,18 @@ MString QuatSlerpNode::NODE_NAME("quatSlerp");
         NODE::initialize                    \
     );                                        \
     CHECK_MSTATUS_AND_RETURN_IT(status);    \
+    quatExtras::registerStatsType(NODE::NODE_NAME.asChar()); \
+
+#define REGISTER_DEFORMER(NODE)                \
+    status = fnPlugin.registerNode(            \
+        NODE::NODE_NAME,                    \
+        NODE::NODE_ID,                        \
+        NODE::creator,                        \
+        NODE::initialize,                    \
+        MPxNode::kDeformerNode                \
+    );                                        \
+    CHECK_MSTATUS_AND_RETURN_IT(status);    \
+    quatExtras::registerStatsType(NODE::NODE_NAME.asChar()); \
 
 #define DEREGISTER_NODE(NODE)                \
     status = fnPlugin.deregisterNode(        \
@@ -78,14 +191,93 @@ MString QuatSlerpNode::NODE_NAME("quatSlerp");
     );                                        \
     CHECK_MSTATUS_AND_RETURN_IT(status);    \
 
+#define REGISTER_DATA(DATA)                    \
+    status = fnPlugin.registerData(            \
+        DATA::TYPE_NAME,                       \
+        DATA::TYPE_ID,                         \
+        DATA::creator                          \
+    );                                         \
+    CHECK_MSTATUS_AND_RETURN_IT(status);       \
+
+#define DEREGISTER_DATA(DATA)                  \
+    status = fnPlugin.deregisterData(          \
+        DATA::TYPE_ID                          \
+    );                                         \
+    CHECK_MSTATUS_AND_RETURN_IT(status);       \
+
+#define REGISTER_COMMAND(CMD)                  \
+    status = fnPlugin.registerCommand(         \
+        CMD::COMMAND_NAME,                     \
+        CMD::creator,                          \
+        CMD::newSyntax                         \
+    );                                         \
+    CHECK_MSTATUS_AND_RETURN_IT(status);       \
+
+#define DEREGISTER_COMMAND(CMD)                \
+    status = fnPlugin.deregisterCommand(       \
+        CMD::COMMAND_NAME                      \
+    );                                         \
+    CHECK_MSTATUS_AND_RETURN_IT(status);       \
+
+/*
+    The quatExtrasMathBackend optionVar, when set, takes precedence over
+    the QUATEXTRAS_MATH environment variable.
+*/
+static void applyMathBackendOptionVar()
+{
+    bool exists = false;
+    MString name = MGlobal::optionVarStringValue("quatExtrasMathBackend", &exists);
+
+    if (!exists)
+        return;
+
+    quatExtras::MathBackend backend;
+
+    if (quatExtras::parseMathBackend(name.asChar(), backend))
+    {
+        quatExtras::setDefaultMathBackend(backend);
+    } else {
+        MGlobal::displayWarning(MString("quatExtras: ignoring quatExtrasMathBackend \"") + name + "\"; expected libm, polynomial or table.");
+    }
+}
+
 MStatus initializePlugin(MObject obj)
 {
     MStatus status;
     MFnPlugin fnPlugin(obj, kAUTHOR, kVERSION, kREQUIRED_API_VERSION);
 
+    applyMathBackendOptionVar();
+
+    // Before the nodes, whose attributes refer to it.
+    REGISTER_DATA(QuatArrayData);
+
     REGISTER_NODE(AxisAngleToQuatNode);
     REGISTER_NODE(QuatToAxisAngleNode);
     REGISTER_NODE(QuatSlerpNode);
+    REGISTER_NODE(QuatSlerpArrayNode);
+    REGISTER_NODE(AxisAngleToQuatArrayNode);
+    REGISTER_NODE(QuatToAxisAngleArrayNode);
+    REGISTER_NODE(QuatSplineNode);
+    REGISTER_NODE(QuatAverageNode);
+    REGISTER_NODE(QuatCacheNode);
+    REGISTER_NODE(QuatSwingTwistNode);
+    REGISTER_NODE(QuatSwingTwistArrayNode);
+    REGISTER_NODE(EulerToQuatArrayNode);
+    REGISTER_NODE(QuatToEulerArrayNode);
+    REGISTER_NODE(MatrixToQuatArrayNode);
+    REGISTER_NODE(QuatLogExpNode);
+    REGISTER_NODE(QuatPowerNode);
+    REGISTER_NODE(QuatUnflipNode);
+    REGISTER_NODE(QuatDistributeNode);
+    REGISTER_NODE(QuatPoseReaderNode);
+    REGISTER_NODE(QuatArrayPackNode);
+    REGISTER_NODE(QuatArrayUnpackNode);
+    REGISTER_NODE(QuatAngularVelocityNode);
+    REGISTER_NODE(QuatSpringNode);
+    REGISTER_DEFORMER(QuatExtrasDQSkinNode);
+
+    REGISTER_COMMAND(QuatExtrasBakeCmd);
+    REGISTER_COMMAND(QuatExtrasStatsCmd);
 
     return MS::kSuccess;
 }
@@ -98,6 +290,34 @@ MStatus uninitializePlugin(MObject obj)
     DEREGISTER_NODE(AxisAngleToQuatNode);
     DEREGISTER_NODE(QuatToAxisAngleNode);
     DEREGISTER_NODE(QuatSlerpNode);
+    DEREGISTER_NODE(QuatSlerpArrayNode);
+    DEREGISTER_NODE(AxisAngleToQuatArrayNode);
+    DEREGISTER_NODE(QuatToAxisAngleArrayNode);
+    DEREGISTER_NODE(QuatSplineNode);
+    DEREGISTER_NODE(QuatAverageNode);
+    DEREGISTER_NODE(QuatCacheNode);
+    DEREGISTER_NODE(QuatSwingTwistNode);
+    DEREGISTER_NODE(QuatSwingTwistArrayNode);
+    DEREGISTER_NODE(EulerToQuatArrayNode);
+    DEREGISTER_NODE(QuatToEulerArrayNode);
+    DEREGISTER_NODE(MatrixToQuatArrayNode);
+    DEREGISTER_NODE(QuatLogExpNode);
+    DEREGISTER_NODE(QuatPowerNode);
+    DEREGISTER_NODE(QuatUnflipNode);
+    DEREGISTER_NODE(QuatDistributeNode);
+    DEREGISTER_NODE(QuatPoseReaderNode);
+    DEREGISTER_NODE(QuatArrayPackNode);
+    DEREGISTER_NODE(QuatArrayUnpackNode);
+    DEREGISTER_NODE(QuatAngularVelocityNode);
+    DEREGISTER_NODE(QuatSpringNode);
+    DEREGISTER_NODE(QuatExtrasDQSkinNode);
+
+    DEREGISTER_DATA(QuatArrayData);
+
+    DEREGISTER_COMMAND(QuatExtrasBakeCmd);
+    DEREGISTER_COMMAND(QuatExtrasStatsCmd);
+
+    quatExtras::shutdownScheduler();
 
     return MS::kSuccess;
 }
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef PROFILED_NODE_H
+#define PROFILED_NODE_H
+
+#include "core/computeStats.h"
+
+#include <maya/MString.h>
+
+/*
+    Base for nodes that report to the quatExtrasStats command. A node
+    derives from MPxNode and ProfiledNode, passes its NODE_NAME here, and
+    times its compute with
+
+        quatExtras::ComputeTimer timer(statsType, &instanceStats);
+*/
+class ProfiledNode
+{
+public:
+    explicit                    ProfiledNode(const MString &typeName) :
+                                    statsType(quatExtras::registerStatsType(typeName.asChar()))
+                                {
+                                }
+
+    const int                   statsType;
+    quatExtras::InstanceStats   instanceStats;
+};
+
+#endif
@@ -0,0 +1,364 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatAngularVelocity node
+    Angular velocity and acceleration of quaternion tracks, for motion blur
+    vectors, secondary motion and checking exported animation, without
+    evaluating the graph at neighbouring frames on every frame.
+
+    inputQuat   (iq)
+        Quaternions to differentiate, one track per logical index.
+
+    inputQuatData (iqd)
+        The same as quatArrayData, read in place of inputQuat when it holds
+        quaternions.
+
+    time        (tm)
+        Time of the evaluation, usually connected from time1.outTime.
+
+    timeStep    (ts)
+        Frames between the samples that are differenced. Defaults to 1.
+
+    space       (sp)
+        Space the outputs are in.
+            parent  The space the quaternions are expressed in (default).
+            local   The space of the rotated object.
+
+    historySize (hs)
+        Samples of the inputs kept. Defaults to 8; at least 3.
+
+    outputVelocity (ov)
+        Angular velocity of each track, as axis * radians per second.
+
+    outputAcceleration (oa)
+        Angular acceleration of each track, in radians per second squared.
+
+    Each sample is stored, keyed by time, in a ring buffer of recent
+    samples (core/angularVelocity.h), and differenced through the log map
+    against two stored neighbours: the frames timeStep before and after
+    time when both are stored, else the two before it, as in playback,
+    else the two after it. Only when none of those pairs is stored, as on
+    the first frame or after a scrub, are the inputs at time - timeStep
+    and time + timeStep evaluated, in their own contexts, and stored.
+
+    Velocity is second order accurate in timeStep either way; acceleration
+    is first order from the two frames before or after. Rotations of more
+    than 180 degrees per timeStep cannot be told from shorter ones the
+    other way round.
+
+    The samples are dropped when the number of elements changes, when the
+    inputs at a stored time change, and when the inputs are dirtied
+    without the time, as when the animation is edited at another frame.
+    Playback dirties the inputs and the time together and keeps them.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatAngularVelocity.h"
+#include "quatArrayData.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MDGContext.h>
+#include <maya/MFnEnumAttribute.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnPluginData.h>
+#include <maya/MFnUnitAttribute.h>
+#include <maya/MPlug.h>
+#include <maya/MTime.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace quatExtras;
+
+QuatAttribute QuatAngularVelocityNode::inputQuat_attr;
+MObject QuatAngularVelocityNode::inputQuatData_attr;
+MObject QuatAngularVelocityNode::time_attr;
+MObject QuatAngularVelocityNode::timeStep_attr;
+MObject QuatAngularVelocityNode::space_attr;
+MObject QuatAngularVelocityNode::historySize_attr;
+
+VectorAttribute QuatAngularVelocityNode::outputVelocity_attr;
+VectorAttribute QuatAngularVelocityNode::outputAcceleration_attr;
+
+namespace
+{
+    // Smallest timeStep, in frames; well above VelocityHistory::kTimeTolerance.
+    const double kMinTimeStep = 1.0e-3;
+}
+
+QuatAngularVelocityNode::QuatAngularVelocityNode() :
+    ProfiledNode(NODE_NAME),
+    inputsDirty(false),
+    timeDirty(false)
+{
+}
+
+void* QuatAngularVelocityNode::creator()
+{
+    return new QuatAngularVelocityNode();
+}
+
+MStatus QuatAngularVelocityNode::initialize()
+{
+    MStatus status;
+
+    MFnEnumAttribute e;
+    MFnNumericAttribute n;
+    MFnUnitAttribute u;
+
+    const char *const inputQuatNames[] = { "iqx", "iqy", "iqz", "iqw" };
+    status = inputQuat_attr.create("inputQuat", "iq", inputQuatNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    inputQuatData_attr = createQuatArrayDataAttribute("inputQuatData", "iqd", false, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    time_attr = u.create("time", "tm", MFnUnitAttribute::kTime, 0.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(u);
+
+    timeStep_attr = n.create("timeStep", "ts", MFnNumericData::kDouble, 1.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setMin(kMinTimeStep);
+
+    space_attr = e.create("space", "sp", kVelocityParent, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(e);
+    e.addField("parent", kVelocityParent);
+    e.addField("local", kVelocityLocal);
+
+    historySize_attr = n.create("historySize", "hs", MFnNumericData::kInt, (double) VelocityHistory::kDefaultCapacity, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setMin(3);
+
+    const double zeroVector[3] = { 0.0, 0.0, 0.0 };
+
+    const char *const outputVelocityNames[] = { "ovx", "ovy", "ovz" };
+    status = outputVelocity_attr.create("outputVelocity", "ov", outputVelocityNames, zeroVector, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const outputAccelerationNames[] = { "oax", "oay", "oaz" };
+    status = outputAcceleration_attr.create("outputAcceleration", "oa", outputAccelerationNames, zeroVector, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(inputQuat_attr);
+    addAttribute(inputQuatData_attr);
+    addAttribute(time_attr);
+    addAttribute(timeStep_attr);
+    addAttribute(space_attr);
+    addAttribute(historySize_attr);
+    addAttribute(outputVelocity_attr);
+    addAttribute(outputAcceleration_attr);
+
+    attributeAffects(inputQuat_attr, outputVelocity_attr);
+    attributeAffects(inputQuatData_attr, outputVelocity_attr);
+    attributeAffects(time_attr, outputVelocity_attr);
+    attributeAffects(timeStep_attr, outputVelocity_attr);
+    attributeAffects(space_attr, outputVelocity_attr);
+    attributeAffects(historySize_attr, outputVelocity_attr);
+
+    attributeAffects(inputQuat_attr, outputAcceleration_attr);
+    attributeAffects(inputQuatData_attr, outputAcceleration_attr);
+    attributeAffects(time_attr, outputAcceleration_attr);
+    attributeAffects(timeStep_attr, outputAcceleration_attr);
+    attributeAffects(space_attr, outputAcceleration_attr);
+    attributeAffects(historySize_attr, outputAcceleration_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatAngularVelocityNode::setDependentsDirty(const MPlug& plug, MPlugArray& affectedPlugs)
+{
+    MObject attr = plug.attribute();
+
+    if (inputQuat_attr.owns(attr) || attr == inputQuatData_attr)
+        inputsDirty = true;
+    else if (attr == time_attr)
+        timeDirty = true;
+
+    return MPxNode::setDependentsDirty(plug, affectedPlugs);
+}
+
+
+#if MAYA_API_VERSION >= 201600
+/*
+    The evaluation manager does not call setDependentsDirty, so read the
+    same from its dirty plugs before each evaluation instead.
+*/
+MStatus QuatAngularVelocityNode::preEvaluation(const MDGContext& context, const MEvaluationNode& evaluationNode)
+{
+    if (context.isNormal())
+    {
+        if (inputQuat_attr.dirtyPlugExists(evaluationNode) || evaluationNode.dirtyPlugExists(inputQuatData_attr))
+            inputsDirty = true;
+
+        if (evaluationNode.dirtyPlugExists(time_attr))
+            timeDirty = true;
+    }
+
+    return MPxNode::preEvaluation(context, evaluationNode);
+}
+#endif
+
+
+MStatus QuatAngularVelocityNode::evaluateAt(double frame, unsigned count, QuatArray &values)
+{
+    MStatus status;
+
+    MDGContext context(MTime(frame, MTime::uiUnit()));
+
+    values.resize(0);
+    values.resize(count);
+
+    QuatArrayView view = values.view();
+
+    MPlug dataPlug(thisMObject(), inputQuatData_attr);
+    MObject dataObject = dataPlug.asMObject(context, &status);
+
+    if (status && !dataObject.isNull())
+    {
+        MFnPluginData fnData(dataObject);
+        QuatArrayData *value = static_cast<QuatArrayData*>(fnData.data());
+
+        if (value != nullptr && value->buffer() && value->buffer()->size() != 0)
+        {
+            ConstQuatArrayView from = value->buffer()->view();
+            size_t length = std::min<size_t>(count, value->buffer()->size());
+
+            std::copy(from.x, from.x + length, view.x);
+            std::copy(from.y, from.y + length, view.y);
+            std::copy(from.z, from.z + length, view.z);
+            std::copy(from.w, from.w + length, view.w);
+
+            return MStatus::kSuccess;
+        }
+    }
+
+    MPlug arrayPlug(thisMObject(), inputQuat_attr);
+    unsigned numElements = arrayPlug.numElements();
+
+    for (unsigned e = 0; e < numElements; e++)
+    {
+        MPlug element = arrayPlug.elementByPhysicalIndex(e, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        unsigned i = element.logicalIndex();
+
+        if (i >= count)
+            continue;
+
+        view.x[i] = element.child(inputQuat_attr.child(0)).asDouble(context);
+        view.y[i] = element.child(inputQuat_attr.child(1)).asDouble(context);
+        view.z[i] = element.child(inputQuat_attr.child(2)).asDouble(context);
+        view.w[i] = element.child(inputQuat_attr.child(3)).asDouble(context);
+    }
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatAngularVelocityNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputVelocity_attr) && !isPlugFor(plug, outputAcceleration_attr))
+        return MStatus::kUnknownParameter;
+
+    MStatus status;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    QuatArrayInput input(data, inputQuat_attr, inputQuatData_attr);
+
+    unsigned count = input.length();
+    timer.setElements(count);
+
+    ConstQuatArrayView inputView = input.view(count);
+
+    double frame = data.inputValue(time_attr).asTime().as(MTime::uiUnit());
+    double step = std::max(data.inputValue(timeStep_attr).asDouble(), kMinTimeStep);
+    VelocitySpace space = (VelocitySpace) data.inputValue(space_attr).asShort();
+    int historySize = data.inputValue(historySize_attr).asInt();
+
+    // The history is keyed by frame; the outputs are per second.
+    double secondsPerFrame = MTime(1.0, MTime::uiUnit()).as(MTime::kSeconds);
+
+    std::vector<double> velocityX(count), velocityY(count), velocityZ(count);
+    std::vector<double> accelerationX(count), accelerationY(count), accelerationZ(count);
+
+    VectorArrayView velocityView = { velocityX.data(), velocityY.data(), velocityZ.data() };
+    VectorArrayView accelerationView = { accelerationX.data(), accelerationY.data(), accelerationZ.data() };
+
+    {
+        std::lock_guard<std::mutex> lock(historyMutex);
+
+        if (data.context().isNormal())
+        {
+            if (inputsDirty && !timeDirty)
+                history.clear();
+
+            inputsDirty = false;
+            timeDirty = false;
+        }
+
+        history.setCapacity((size_t) std::max(historySize, 3));
+        history.store(frame, inputView, count);
+
+        ConstQuatArrayView before, after, further;
+        bool hasBefore = history.find(frame - step, before);
+        bool hasAfter = history.find(frame + step, after);
+
+        if (hasBefore && hasAfter)
+        {
+            timer.cacheHit();
+            angularVelocityBatch(inputView, before, -step * secondsPerFrame, after, step * secondsPerFrame, space, velocityView, accelerationView, count);
+        } else if (hasBefore && history.find(frame - 2.0 * step, further)) {
+            timer.cacheHit();
+            angularVelocityBatch(inputView, before, -step * secondsPerFrame, further, -2.0 * step * secondsPerFrame, space, velocityView, accelerationView, count);
+        } else if (hasAfter && history.find(frame + 2.0 * step, further)) {
+            timer.cacheHit();
+            angularVelocityBatch(inputView, after, step * secondsPerFrame, further, 2.0 * step * secondsPerFrame, space, velocityView, accelerationView, count);
+        } else {
+            timer.cacheMiss();
+
+            // Evaluated before any is stored, so storing cannot overwrite
+            // a neighbour still to be used.
+            QuatArray beforeSample, afterSample;
+
+            if (!hasBefore)
+            {
+                status = evaluateAt(frame - step, count, beforeSample);
+                CHECK_MSTATUS_AND_RETURN_IT(status);
+                before = beforeSample.view();
+            }
+
+            if (!hasAfter)
+            {
+                status = evaluateAt(frame + step, count, afterSample);
+                CHECK_MSTATUS_AND_RETURN_IT(status);
+                after = afterSample.view();
+            }
+
+            angularVelocityBatch(inputView, before, -step * secondsPerFrame, after, step * secondsPerFrame, space, velocityView, accelerationView, count);
+
+            if (!hasBefore)
+                history.store(frame - step, before, count);
+
+            if (!hasAfter)
+                history.store(frame + step, after, count);
+        }
+    }
+
+    status = outputVelocity_attr.outputArrayValue(data, velocityView, count);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    return outputAcceleration_attr.outputArrayValue(data, accelerationView, count);
+}
@@ -0,0 +1,68 @@
+#ifndef QUAT_ANGULAR_VELOCITY_H
+#define QUAT_ANGULAR_VELOCITY_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include "core/angularVelocity.h"
+#include "core/quatBatch.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MDGContext.h>
+#include <maya/MPlug.h>
+#include <maya/MPlugArray.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+#if MAYA_API_VERSION >= 201600
+#include <maya/MEvaluationNode.h>
+#endif
+
+#include <mutex>
+
+class QuatAngularVelocityNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatAngularVelocityNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    virtual MStatus         setDependentsDirty(const MPlug& plug, MPlugArray& affectedPlugs);
+#if MAYA_API_VERSION >= 201600
+    virtual MStatus         preEvaluation(const MDGContext& context, const MEvaluationNode& evaluationNode);
+#endif
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    inputQuat_attr;
+    static MObject          inputQuatData_attr;
+    static MObject          time_attr;
+    static MObject          timeStep_attr;
+    static MObject          space_attr;
+    static MObject          historySize_attr;
+
+    static VectorAttribute  outputVelocity_attr;
+    static VectorAttribute  outputAcceleration_attr;
+
+private:
+    // The count input quaternions at frame, evaluated in its context.
+    MStatus                 evaluateAt(double frame, unsigned count, quatExtras::QuatArray &values);
+
+    // Input samples by time. Shared by every context, since it is keyed
+    // by the time each context evaluates at; the mutex covers contexts
+    // evaluated from several threads.
+    quatExtras::VelocityHistory history;
+    std::mutex              historyMutex;
+
+    // Set when the inputs, and the time, have been dirtied since the last
+    // compute. Inputs dirtied without the time are an edit, which may have
+    // changed any stored sample.
+    bool                    inputsDirty;
+    bool                    timeDirty;
+};
+
+#endif
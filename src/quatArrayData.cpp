@@ -0,0 +1,326 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatArrayData
+    Plugin data type carrying an array of quaternions between quatExtras
+    nodes in one attribute.
+
+    A compound array such as outputQuat costs a handle operation per
+    element and per component to write, and the same again to read. A
+    quatArrayData attribute instead holds a pointer to a shared, aligned
+    buffer (core/quatBuffer.h): the upstream node publishes the buffer once
+    and every downstream node reads its quaternions in place, handing them
+    straight to the batch kernels.
+
+    The nodes with quatArrayData attributes name them after the compound
+    they stand in for, with a Data suffix (inputQuatData, outputQuatData).
+    An input holding quaternions is used in place of its compound, which
+    is then ignored. quatArrayPack and quatArrayUnpack convert to and from
+    compound arrays for nodes without them.
+-----------------------------------------------------------------------------*/
+
+#include "quatArrayData.h"
+#include "nodeUtils.h"
+
+#include "core/quatBatch.h"
+#include "core/quatBuffer.h"
+
+#include <maya/MArgList.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnPluginData.h>
+#include <maya/MFnTypedAttribute.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+using namespace quatExtras;
+
+QuatArrayData::QuatArrayData()
+{
+}
+
+QuatArrayData::~QuatArrayData()
+{
+}
+
+void* QuatArrayData::creator()
+{
+    return new QuatArrayData();
+}
+
+MTypeId QuatArrayData::typeId() const
+{
+    return TYPE_ID;
+}
+
+MString QuatArrayData::name() const
+{
+    return TYPE_NAME;
+}
+
+void QuatArrayData::copy(const MPxData& other)
+{
+    if (other.typeId() == TYPE_ID)
+        buffer_ = static_cast<const QuatArrayData&>(other).buffer_;
+}
+
+MStatus QuatArrayData::readASCII(const MArgList& args, unsigned& lastElement)
+{
+    MStatus status;
+
+    int count = args.asInt(lastElement++, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    if (count < 0)
+        return MStatus::kFailure;
+
+    std::shared_ptr<QuatBuffer> buffer = std::make_shared<QuatBuffer>((size_t) count);
+    QuatArrayView view = buffer->view();
+
+    for (int i = 0; i < count; i++)
+    {
+        double *components[4] = { view.x + i, view.y + i, view.z + i, view.w + i };
+
+        for (int c = 0; c < 4; c++)
+        {
+            *components[c] = args.asDouble(lastElement++, &status);
+            CHECK_MSTATUS_AND_RETURN_IT(status);
+        }
+    }
+
+    buffer_ = count != 0 ? buffer : SharedQuatBuffer();
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatArrayData::writeASCII(std::ostream& out)
+{
+    size_t count = buffer_ ? buffer_->size() : 0;
+
+    out << count;
+
+    if (count != 0)
+    {
+        ConstQuatArrayView view = buffer_->view();
+
+        std::streamsize precision = out.precision(17);
+
+        for (size_t i = 0; i < count; i++)
+            out << " " << view.x[i] << " " << view.y[i] << " " << view.z[i] << " " << view.w[i];
+
+        out.precision(precision);
+    }
+
+    return out.fail() ? MStatus::kFailure : MStatus::kSuccess;
+}
+
+/*
+    A uint32 count, then the x, y, z and w planes in turn as doubles in
+    the machine's byte order.
+*/
+MStatus QuatArrayData::readBinary(std::istream& in, unsigned length)
+{
+    uint32_t count = 0;
+
+    if (length < sizeof(count) || !in.read(reinterpret_cast<char*>(&count), sizeof(count)))
+        return MStatus::kFailure;
+
+    if (length != sizeof(count) + 4 * sizeof(double) * (size_t) count)
+        return MStatus::kFailure;
+
+    std::shared_ptr<QuatBuffer> buffer = std::make_shared<QuatBuffer>((size_t) count);
+    QuatArrayView view = buffer->view();
+
+    double *planes[4] = { view.x, view.y, view.z, view.w };
+
+    for (int c = 0; c < 4; c++)
+    {
+        if (!in.read(reinterpret_cast<char*>(planes[c]), sizeof(double) * count))
+            return MStatus::kFailure;
+    }
+
+    buffer_ = count != 0 ? buffer : SharedQuatBuffer();
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatArrayData::writeBinary(std::ostream& out)
+{
+    uint32_t count = buffer_ ? (uint32_t) buffer_->size() : 0;
+
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+    if (count != 0)
+    {
+        ConstQuatArrayView view = buffer_->view();
+        const double *planes[4] = { view.x, view.y, view.z, view.w };
+
+        for (int c = 0; c < 4; c++)
+            out.write(reinterpret_cast<const char*>(planes[c]), sizeof(double) * count);
+    }
+
+    return out.fail() ? MStatus::kFailure : MStatus::kSuccess;
+}
+
+MObject createQuatArrayDataAttribute(const MString &longName, const MString &shortName, bool output, MStatus *status)
+{
+    MFnTypedAttribute t;
+
+    MObject attr = t.create(longName, shortName, QuatArrayData::TYPE_ID, MObject::kNullObj, status);
+
+    t.setKeyable(false);
+    t.setChannelBox(false);
+    t.setStorable(!output);
+    t.setWritable(!output);
+
+    return attr;
+}
+
+SharedQuatBuffer inputQuatArrayData(MDataBlock &data, const MObject &attr)
+{
+    MDataHandle handle = data.inputValue(attr);
+
+    QuatArrayData *value = static_cast<QuatArrayData*>(handle.asPluginData());
+
+    if (value == nullptr || !value->buffer() || value->buffer()->size() == 0)
+        return SharedQuatBuffer();
+
+    return value->buffer();
+}
+
+MStatus outputQuatArrayData(MDataBlock &data, const MObject &attr, const SharedQuatBuffer &buffer)
+{
+    MStatus status;
+
+    MFnPluginData fnData;
+    MObject dataObject = fnData.create(QuatArrayData::TYPE_ID, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    QuatArrayData *value = static_cast<QuatArrayData*>(fnData.data(&status));
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    value->setBuffer(buffer);
+
+    MDataHandle handle = data.outputValue(attr, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    status = handle.set(dataObject);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    handle.setClean();
+
+    return MStatus::kSuccess;
+}
+
+QuatArrayInput::QuatArrayInput(MDataBlock &data, const QuatAttribute &compound, const MObject &dataAttr) :
+    handle_(data.inputArrayValue(compound)),
+    compound_(compound),
+    buffer_(inputQuatArrayData(data, dataAttr))
+{
+    length_ = buffer_ ? (unsigned) buffer_->size() : logicalLength(handle_);
+}
+
+ConstQuatArrayView QuatArrayInput::view(unsigned count)
+{
+    if (buffer_ && buffer_->size() >= count)
+        return buffer_->view();
+
+    storage_.resize(count);
+    read(storage_.view(), count);
+
+    return storage_.view();
+}
+
+ConstQuatArrayViewF QuatArrayInput::viewF(unsigned count)
+{
+    storageF_.resize(count);
+    read(storageF_.view(), count);
+
+    return storageF_.view();
+}
+
+template <class T>
+void QuatArrayInput::read(const QuatArrayViewT<T> &values, unsigned count)
+{
+    if (!buffer_)
+    {
+        compound_.inputArrayValue(handle_, values, count);
+        return;
+    }
+
+    ConstQuatArrayView from = buffer_->view();
+    size_t length = std::min((size_t) count, buffer_->size());
+
+    for (size_t i = 0; i < length; i++)
+    {
+        values.x[i] = T(from.x[i]);
+        values.y[i] = T(from.y[i]);
+        values.z[i] = T(from.z[i]);
+        values.w[i] = T(from.w[i]);
+    }
+}
+
+QuatArrayOutput::QuatArrayOutput(const MPlug &plug, const QuatAttribute &compound, const MObject &dataAttr) :
+    compound_(compound),
+    dataAttr_(dataAttr),
+    toData_(isPlugFor(plug, dataAttr)),
+    count_(0),
+    single_(false)
+{
+}
+
+QuatArrayView QuatArrayOutput::allocate(unsigned count)
+{
+    count_ = count;
+    single_ = false;
+
+    if (toData_)
+    {
+        buffer_ = std::make_shared<QuatBuffer>((size_t) count);
+        return buffer_->view();
+    }
+
+    storage_.resize(count);
+    return storage_.view();
+}
+
+QuatArrayViewF QuatArrayOutput::allocateF(unsigned count)
+{
+    count_ = count;
+    single_ = true;
+
+    storageF_.resize(count);
+    return storageF_.view();
+}
+
+MStatus QuatArrayOutput::write(MDataBlock &data)
+{
+    if (!toData_)
+    {
+        if (single_)
+            return compound_.outputArrayValue(data, storageF_.view(), count_);
+
+        return compound_.outputArrayValue(data, storage_.view(), count_);
+    }
+
+    if (single_)
+    {
+        QuatArrayView wide = allocate(count_);
+        ConstQuatArrayViewF narrow = storageF_.view();
+
+        for (unsigned i = 0; i < count_; i++)
+        {
+            wide.x[i] = narrow.x[i];
+            wide.y[i] = narrow.y[i];
+            wide.z[i] = narrow.z[i];
+            wide.w[i] = narrow.w[i];
+        }
+    }
+
+    return outputQuatArrayData(data, dataAttr_, buffer_);
+}
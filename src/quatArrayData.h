@@ -0,0 +1,153 @@
+#ifndef QUAT_ARRAY_DATA_H
+#define QUAT_ARRAY_DATA_H
+
+#include "compoundAttribute.h"
+
+#include "core/quatBatch.h"
+#include "core/quatBuffer.h"
+
+#include <maya/MArgList.h>
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MObject.h>
+#include <maya/MPlug.h>
+#include <maya/MPxData.h>
+#include <maya/MStatus.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+#include <iostream>
+#include <memory>
+
+/*
+    A whole array of quaternions as one attribute value, held in a shared
+    QuatBuffer. Copies share the buffer, so passing the data along a
+    connection moves a pointer rather than the quaternions.
+
+    Saved as the count followed by the x, y, z and w of each quaternion.
+*/
+class QuatArrayData : public MPxData
+{
+public:
+                            QuatArrayData();
+    virtual                 ~QuatArrayData();
+
+    virtual MStatus         readASCII(const MArgList& args, unsigned& lastElement);
+    virtual MStatus         readBinary(std::istream& in, unsigned length);
+    virtual MStatus         writeASCII(std::ostream& out);
+    virtual MStatus         writeBinary(std::ostream& out);
+
+    virtual void            copy(const MPxData& other);
+
+    virtual MTypeId         typeId() const;
+    virtual MString         name() const;
+
+    static  void*           creator();
+
+    // Null when the data holds no quaternions.
+    const quatExtras::SharedQuatBuffer& buffer() const { return buffer_; }
+    void                    setBuffer(const quatExtras::SharedQuatBuffer &buffer) { buffer_ = buffer; }
+
+public:
+    static MTypeId          TYPE_ID;
+    static MString          TYPE_NAME;
+
+private:
+    quatExtras::SharedQuatBuffer buffer_;
+};
+
+/*
+    A quatArrayData attribute. Inputs are keyable and storable, like
+    MAKE_INPUT; outputs are neither.
+*/
+MObject createQuatArrayDataAttribute(const MString &longName, const MString &shortName, bool output, MStatus *status);
+
+// The buffer held by attr, or null when it holds no quaternions.
+quatExtras::SharedQuatBuffer inputQuatArrayData(MDataBlock &data, const MObject &attr);
+
+// Sets attr to a new quatArrayData holding buffer, and cleans it.
+MStatus outputQuatArrayData(MDataBlock &data, const MObject &attr, const quatExtras::SharedQuatBuffer &buffer);
+
+/*
+    An array of quaternions read from a quatArrayData attribute when it
+    holds any, and from its compound array otherwise.
+*/
+class QuatArrayInput
+{
+public:
+                            QuatArrayInput(MDataBlock &data, const QuatAttribute &compound, const MObject &dataAttr);
+
+    // Number of quaternions: the data's, or the compound's logical length.
+    unsigned                length() const { return length_; }
+
+    /*
+        The first count quaternions, count at least length(). In double,
+        from data holding at least count, this is the data's own buffer;
+        anything else is copied, past length() as identities.
+    */
+    quatExtras::ConstQuatArrayView  view(unsigned count);
+    quatExtras::ConstQuatArrayViewF viewF(unsigned count);
+
+    template <class T>
+    quatExtras::ConstQuatArrayViewT<T> viewAs(unsigned count);
+
+private:
+    template <class T>
+    void                    read(const quatExtras::QuatArrayViewT<T> &values, unsigned count);
+
+    MArrayDataHandle        handle_;
+    const QuatAttribute    &compound_;
+    quatExtras::SharedQuatBuffer buffer_;
+    unsigned                length_;
+
+    quatExtras::QuatArray   storage_;
+    quatExtras::QuatArrayF  storageF_;
+};
+
+template <>
+inline quatExtras::ConstQuatArrayView QuatArrayInput::viewAs<double>(unsigned count) { return view(count); }
+
+template <>
+inline quatExtras::ConstQuatArrayViewF QuatArrayInput::viewAs<float>(unsigned count) { return viewF(count); }
+
+/*
+    An array of quaternions written to a quatArrayData attribute when it
+    is the plug being computed, and to its compound array otherwise.
+*/
+class QuatArrayOutput
+{
+public:
+                            QuatArrayOutput(const MPlug &plug, const QuatAttribute &compound, const MObject &dataAttr);
+
+    /*
+        count identities to compute into, then written by write. In double,
+        for data, this is the buffer that is published, so nothing is
+        copied; float results are widened.
+    */
+    quatExtras::QuatArrayView   allocate(unsigned count);
+    quatExtras::QuatArrayViewF  allocateF(unsigned count);
+
+    template <class T>
+    quatExtras::QuatArrayViewT<T> allocateAs(unsigned count);
+
+    MStatus                 write(MDataBlock &data);
+
+private:
+    const QuatAttribute    &compound_;
+    MObject                 dataAttr_;
+    bool                    toData_;
+
+    unsigned                count_;
+    bool                    single_;
+    std::shared_ptr<quatExtras::QuatBuffer> buffer_;
+    quatExtras::QuatArray   storage_;
+    quatExtras::QuatArrayF  storageF_;
+};
+
+template <>
+inline quatExtras::QuatArrayView QuatArrayOutput::allocateAs<double>(unsigned count) { return allocate(count); }
+
+template <>
+inline quatExtras::QuatArrayViewF QuatArrayOutput::allocateAs<float>(unsigned count) { return allocateF(count); }
+
+#endif
@@ -0,0 +1,81 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatArrayPack node
+    Packs a compound array of quaternions into a single quatArrayData
+    value, for nodes that read inputQuatData.
+
+    inputQuat       (iq)
+        Quaternions to pack. Missing logical indices are packed as the
+        identity, so element i of the data is logical index i.
+
+    outputQuatData  (oqd)
+        The quaternions as quatArrayData.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatArrayPack.h"
+#include "quatArrayData.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+
+using namespace quatExtras;
+
+QuatAttribute QuatArrayPackNode::inputQuat_attr;
+
+MObject QuatArrayPackNode::outputQuatData_attr;
+
+QuatArrayPackNode::QuatArrayPackNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* QuatArrayPackNode::creator()
+{
+    return new QuatArrayPackNode();
+}
+
+MStatus QuatArrayPackNode::initialize()
+{
+    MStatus status;
+
+    const char *const inputQuatNames[] = { "iqx", "iqy", "iqz", "iqw" };
+    status = inputQuat_attr.create("inputQuat", "iq", inputQuatNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    outputQuatData_attr = createQuatArrayDataAttribute("outputQuatData", "oqd", true, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(inputQuat_attr);
+    addAttribute(outputQuatData_attr);
+
+    attributeAffects(inputQuat_attr, outputQuatData_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatArrayPackNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputQuatData_attr))
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    MArrayDataHandle inputHandle = data.inputArrayValue(inputQuat_attr);
+
+    unsigned count = logicalLength(inputHandle);
+    timer.setElements(count);
+
+    std::shared_ptr<QuatBuffer> buffer = std::make_shared<QuatBuffer>((size_t) count);
+    inputQuat_attr.inputArrayValue(inputHandle, buffer->view(), count);
+
+    return outputQuatArrayData(data, outputQuatData_attr, buffer);
+}
@@ -0,0 +1,31 @@
+#ifndef QUAT_ARRAY_PACK_H
+#define QUAT_ARRAY_PACK_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+class QuatArrayPackNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatArrayPackNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    inputQuat_attr;
+
+    static MObject          outputQuatData_attr;
+};
+
+#endif
@@ -0,0 +1,81 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatArrayUnpack node
+    Unpacks a quatArrayData value into a compound array of quaternions,
+    for nodes and attributes that only take compounds.
+
+    inputQuatData   (iqd)
+        Quaternions to unpack, such as a quatSlerpArray's outputQuatData.
+
+    outputQuat      (oq)
+        One element per quaternion of the data.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatArrayUnpack.h"
+#include "quatArrayData.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+#include "core/quatBuffer.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+
+using namespace quatExtras;
+
+MObject QuatArrayUnpackNode::inputQuatData_attr;
+
+QuatAttribute QuatArrayUnpackNode::outputQuat_attr;
+
+QuatArrayUnpackNode::QuatArrayUnpackNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* QuatArrayUnpackNode::creator()
+{
+    return new QuatArrayUnpackNode();
+}
+
+MStatus QuatArrayUnpackNode::initialize()
+{
+    MStatus status;
+
+    inputQuatData_attr = createQuatArrayDataAttribute("inputQuatData", "iqd", false, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(inputQuatData_attr);
+    addAttribute(outputQuat_attr);
+
+    attributeAffects(inputQuatData_attr, outputQuat_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatArrayUnpackNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputQuat_attr))
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    SharedQuatBuffer buffer = inputQuatArrayData(data, inputQuatData_attr);
+
+    unsigned count = buffer ? (unsigned) buffer->size() : 0;
+    timer.setElements(count);
+
+    if (count == 0)
+        return outputQuat_attr.outputArrayValue(data, ConstQuatArrayView(), 0);
+
+    return outputQuat_attr.outputArrayValue(data, buffer->view(), count);
+}
@@ -0,0 +1,31 @@
+#ifndef QUAT_ARRAY_UNPACK_H
+#define QUAT_ARRAY_UNPACK_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+class QuatArrayUnpackNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatArrayUnpackNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static MObject          inputQuatData_attr;
+
+    static QuatAttribute    outputQuat_attr;
+};
+
+#endif
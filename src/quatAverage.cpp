@@ -0,0 +1,141 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatAverage node
+    Computes the weighted average of any number of quaternions. The result
+    does not depend on the order of the inputs or on their signs, unlike a
+    chain of quatSlerp nodes.
+
+    inputQuat   (iq)
+        Quaternions to average. Missing elements are ignored.
+
+    weight      (w)
+        Weight of each quaternion. Missing elements default to 1.
+
+    outputQuat  (oq)
+        Weighted average rotation. The identity if every weight is zero.
+
+    The average is the dominant eigenvector of the weighted sum of the
+    inputs' 4x4 outer products (see core/quatAverage.h). When only a few
+    inputs change between evaluations the sum is corrected rather than
+    rebuilt, and the eigenvector search starts from the previous result.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatAverage.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatAverage.h"
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnNumericData.h>
+#include <maya/MPlug.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace quatExtras;
+
+QuatAttribute QuatAverageNode::inputQuat_attr;
+
+MObject QuatAverageNode::weight_attr;
+
+QuatAttribute QuatAverageNode::outputQuat_attr;
+
+QuatAverageNode::QuatAverageNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* QuatAverageNode::creator()
+{
+    return new QuatAverageNode();
+}
+
+
+MStatus QuatAverageNode::initialize()
+{
+    MStatus status;
+
+    MFnNumericAttribute n;
+
+    const char *const inputQuatNames[] = { "iqx", "iqy", "iqz", "iqw" };
+    status = inputQuat_attr.create("inputQuat", "iq", inputQuatNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    weight_attr = n.create("weight", "w", MFnNumericData::kDouble, 1.0, &status);
+    MAKE_INPUT(n);
+    n.setMin(0.0);
+    n.setArray(true);
+
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(inputQuat_attr);
+    addAttribute(weight_attr);
+    addAttribute(outputQuat_attr);
+
+    attributeAffects(inputQuat_attr, outputQuat_attr);
+    attributeAffects(weight_attr, outputQuat_attr);
+
+    return MStatus::kSuccess;
+}
+
+
+MStatus QuatAverageNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputQuat_attr))
+    {
+        return MStatus::kUnknownParameter;
+    }
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    MArrayDataHandle inputHandle = data.inputArrayValue(inputQuat_attr);
+    MArrayDataHandle weightHandle = data.inputArrayValue(weight_attr);
+
+    unsigned count = logicalLength(inputHandle);
+    timer.setElements(count);
+
+    // Missing elements stay zero-length, which adds nothing to the average.
+    QuatArray input;
+    input.resize(count);
+
+    for (unsigned i = 0; i < count; i++)
+        input.set(i, 0.0, 0.0, 0.0, 0.0);
+
+    QuatArrayView inputView = input.view();
+
+    inputQuat_attr.inputArrayValue(inputHandle, inputView, count);
+
+    std::vector<double> weight(count, 1.0);
+    inputDoubleArrayValue(weightHandle, weight.data(), count);
+
+    for (unsigned i = 0; i < count; i++)
+        weight[i] = std::max(weight[i], 0.0);
+
+    // The kept solution only describes the normal context.
+    QuatAverage contextAverage;
+    QuatAverage &solver = data.context().isNormal() ? average : contextAverage;
+
+    double result[4];
+
+    solver.update(input.view(), weight.data(), count);
+    solver.solve(result);
+
+    if (solver.lastUpdateIncremental())
+        timer.cacheHit();
+    else
+        timer.cacheMiss();
+
+    return outputQuat_attr.outputValue(data, result);
+}
@@ -0,0 +1,40 @@
+#ifndef QUAT_AVERAGE_H
+#define QUAT_AVERAGE_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include "core/quatAverage.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+class QuatAverageNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatAverageNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    inputQuat_attr;
+
+    static MObject          weight_attr;
+
+    static QuatAttribute    outputQuat_attr;
+
+private:
+    // Accumulated outer products and the previous average, reused while
+    // only a few inputs change.
+    quatExtras::QuatAverage average;
+};
+
+#endif
@@ -0,0 +1,154 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatCache node
+    Plays back the quaternion tracks of a track cache file, such as one
+    written by quatExtrasBake -trackCache.
+
+    cacheFile   (cf)
+        Path to the cache. The file is memory mapped, so opening it takes
+        the same time at any size and only the frames played are read.
+
+    time        (tm)
+        Time to sample, usually connected from time1.outTime. It is turned
+        into the cache's frames at the frame rate the cache was written at,
+        so a cache baked at 24 fps plays at the same speed in a 30 fps
+        scene.
+
+    interpolationMode  (im)
+        How samples are blended between cached frames; the same choices
+        as quatSlerp.
+            exact   Spherical linear interpolation (default).
+            nlerp   Normalized linear interpolation.
+            fast    Polynomial approximation of slerp.
+
+    outputQuat  (oq)
+        One element per track in the cache, in the order it was written.
+        Times before or after the cache hold its first or last frame.
+
+    See core/trackCache.h for the file layout and the accuracy of each
+    encoding.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatCache.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnData.h>
+#include <maya/MFnEnumAttribute.h>
+#include <maya/MFnTypedAttribute.h>
+#include <maya/MFnUnitAttribute.h>
+#include <maya/MGlobal.h>
+#include <maya/MPlug.h>
+#include <maya/MTime.h>
+
+#include <string>
+
+using namespace quatExtras;
+
+MObject QuatCacheNode::cacheFile_attr;
+MObject QuatCacheNode::time_attr;
+MObject QuatCacheNode::interpolationMode_attr;
+
+QuatAttribute QuatCacheNode::outputQuat_attr;
+
+QuatCacheNode::QuatCacheNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* QuatCacheNode::creator()
+{
+    return new QuatCacheNode();
+}
+
+
+MStatus QuatCacheNode::initialize()
+{
+    MStatus status;
+
+    MFnEnumAttribute e;
+    MFnTypedAttribute t;
+    MFnUnitAttribute u;
+
+    cacheFile_attr = t.create("cacheFile", "cf", MFnData::kString, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(t);
+    t.setUsedAsFilename(true);
+
+    time_attr = u.create("time", "tm", MFnUnitAttribute::kTime, 0.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(u);
+
+    interpolationMode_attr = e.create("interpolationMode", "im", kSlerpExact, &status);
+    MAKE_INPUT(e);
+    e.addField("exact", kSlerpExact);
+    e.addField("nlerp", kSlerpNlerp);
+    e.addField("fast", kSlerpFast);
+
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(cacheFile_attr);
+    addAttribute(time_attr);
+    addAttribute(interpolationMode_attr);
+
+    addAttribute(outputQuat_attr);
+
+    attributeAffects(cacheFile_attr, outputQuat_attr);
+    attributeAffects(time_attr, outputQuat_attr);
+    attributeAffects(interpolationMode_attr, outputQuat_attr);
+
+    return MStatus::kSuccess;
+}
+
+
+MStatus QuatCacheNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputQuat_attr))
+    {
+        return MStatus::kUnknownParameter;
+    }
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    MString path = data.inputValue(cacheFile_attr).asString();
+    MTime time = data.inputValue(time_attr).asTime();
+    SlerpMode mode = (SlerpMode) data.inputValue(interpolationMode_attr).asShort();
+
+    QuatArray output;
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+
+        if (path != openedPath)
+        {
+            openedPath = path;
+            cache.close();
+
+            std::string error;
+
+            if (path.length() != 0 && !cache.open(path.asChar(), &error))
+            {
+                MGlobal::displayError(name() + ": " + MString(error.c_str()));
+            }
+        }
+
+        double frame = time.as(MTime::kSeconds) * cache.framesPerSecond();
+
+        cache.evaluate(frame, output, mode);
+    }
+
+    unsigned count = (unsigned) output.size();
+    timer.setElements(count);
+
+    return outputQuat_attr.outputArrayValue(data, output.view(), count);
+}
@@ -0,0 +1,47 @@
+#ifndef QUAT_CACHE_H
+#define QUAT_CACHE_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include "core/quatBatch.h"
+#include "core/trackCache.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+#include <mutex>
+
+class QuatCacheNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatCacheNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static MObject          cacheFile_attr;
+    static MObject          time_attr;
+    static MObject          interpolationMode_attr;
+
+    static QuatAttribute    outputQuat_attr;
+
+private:
+    // Mapped cache for openedPath. Stays closed if that file failed to
+    // open, so the error is reported once rather than every frame. Both
+    // are only touched under cacheMutex, since TrackCache::evaluate keeps
+    // scratch buffers and another compute may reopen the file.
+    quatExtras::TrackCache  cache;
+    MString                 openedPath;
+    std::mutex              cacheMutex;
+};
+
+#endif
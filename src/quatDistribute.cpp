@@ -0,0 +1,183 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatDistribute node
+    Samples the slerp between two quaternions at many tweens, such as one
+    per joint of a spine, neck or forearm ribbon, in place of a quatSlerp
+    node per joint.
+
+    input1Quat  (i1q)
+        Quaternion to rotate from.
+
+    input2Quat  (i2q)
+        Quaternion to rotate to.
+
+    spin        (s)
+        Number of complete revolutions around the axis, as for quatSlerp.
+
+    sampleCount (sc)
+        Number of outputs. Sample i sits at i / (sampleCount - 1) along the
+        chain, so the first output is input1Quat and the last input2Quat.
+        A single sample sits in the middle. Defaults to 5.
+
+    falloff     (fo)
+        Curve mapping each sample's position along the chain to its tween.
+        With no points on the curve the tweens are the positions themselves,
+        evenly spaced.
+
+    outputQuat  (oq)
+        Interpolated rotations, one per sample.
+
+    outputQuatData (oqd)
+        The same as quatArrayData, computed only when it is requested.
+
+    The angle between the inputs is computed once per evaluation and shared
+    by every sample. With evenly spaced tweens the sin and cos each sample
+    needs are stepped from the previous sample's, so the whole chain costs
+    about as much trig as a single quatSlerp; with a falloff curve they are
+    evaluated together on the batch kernels. The results match quatSlerp to
+    within 2e-14 without spin, more loosely with a spin and endpoints close
+    together. See core/quatDistribute.h.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatDistribute.h"
+#include "quatArrayData.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+#include "core/quatDistribute.h"
+
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnNumericData.h>
+#include <maya/MPlug.h>
+#include <maya/MRampAttribute.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace quatExtras;
+
+QuatAttribute QuatDistributeNode::input1Quat_attr;
+QuatAttribute QuatDistributeNode::input2Quat_attr;
+
+MObject QuatDistributeNode::spin_attr;
+MObject QuatDistributeNode::sampleCount_attr;
+MObject QuatDistributeNode::falloff_attr;
+
+QuatAttribute QuatDistributeNode::outputQuat_attr;
+MObject QuatDistributeNode::outputQuatData_attr;
+
+QuatDistributeNode::QuatDistributeNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* QuatDistributeNode::creator()
+{
+    return new QuatDistributeNode();
+}
+
+MStatus QuatDistributeNode::initialize()
+{
+    MStatus status;
+
+    MFnNumericAttribute n;
+
+    const char *const input1QuatNames[] = { "i1x", "i1y", "i1z", "i1w" };
+    status = input1Quat_attr.create("input1Quat", "i1q", input1QuatNames, kIdentityQuatDefaults, kCompoundInput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const input2QuatNames[] = { "i2x", "i2y", "i2z", "i2w" };
+    status = input2Quat_attr.create("input2Quat", "i2q", input2QuatNames, kIdentityQuatDefaults, kCompoundInput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    spin_attr = n.create("spin", "s", MFnNumericData::kShort, 0.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+
+    sampleCount_attr = n.create("sampleCount", "sc", MFnNumericData::kInt, 5.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setMin(1);
+
+    falloff_attr = MRampAttribute::createCurveRamp("falloff", "fo", &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    outputQuatData_attr = createQuatArrayDataAttribute("outputQuatData", "oqd", true, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(input1Quat_attr);
+    addAttribute(input2Quat_attr);
+    addAttribute(spin_attr);
+    addAttribute(sampleCount_attr);
+    addAttribute(falloff_attr);
+    addAttribute(outputQuat_attr);
+    addAttribute(outputQuatData_attr);
+
+    attributeAffects(input1Quat_attr, outputQuat_attr);
+    attributeAffects(input2Quat_attr, outputQuat_attr);
+    attributeAffects(spin_attr, outputQuat_attr);
+    attributeAffects(sampleCount_attr, outputQuat_attr);
+    attributeAffects(falloff_attr, outputQuat_attr);
+
+    attributeAffects(input1Quat_attr, outputQuatData_attr);
+    attributeAffects(input2Quat_attr, outputQuatData_attr);
+    attributeAffects(spin_attr, outputQuatData_attr);
+    attributeAffects(sampleCount_attr, outputQuatData_attr);
+    attributeAffects(falloff_attr, outputQuatData_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatDistributeNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputQuat_attr) && !isPlugFor(plug, outputQuatData_attr))
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    double p[4], q[4];
+    input1Quat_attr.inputValue(data, p);
+    input2Quat_attr.inputValue(data, q);
+
+    short spin = data.inputValue(spin_attr).asShort();
+    unsigned count = (unsigned) std::max(data.inputValue(sampleCount_attr).asInt(), 1);
+
+    timer.setElements(count);
+
+    QuatArrayOutput output(plug, outputQuat_attr, outputQuatData_attr);
+    QuatArrayView outputView = output.allocate(count);
+
+    MRampAttribute falloff(thisMObject(), falloff_attr);
+
+    if (falloff.getNumEntries() == 0)
+    {
+        distributeSlerp(p, q, spin, outputView, count);
+    } else {
+        std::vector<double> tween(count);
+
+        for (unsigned i = 0; i < count; i++)
+        {
+            float position = count == 1 ? 0.5f : (float) i / (float) (count - 1);
+            float value = 0.0f;
+
+            falloff.getValueAtPosition(position, value);
+            tween[i] = value;
+        }
+
+        distributeSlerp(p, q, spin, tween.data(), outputView, count);
+    }
+
+    return output.write(data);
+}
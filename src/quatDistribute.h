@@ -0,0 +1,37 @@
+#ifndef QUAT_DISTRIBUTE_H
+#define QUAT_DISTRIBUTE_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+class QuatDistributeNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatDistributeNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    input1Quat_attr;
+    static QuatAttribute    input2Quat_attr;
+
+    static MObject          spin_attr;
+    static MObject          sampleCount_attr;
+    static MObject          falloff_attr;
+
+    static QuatAttribute    outputQuat_attr;
+    static MObject          outputQuatData_attr;
+};
+
+#endif
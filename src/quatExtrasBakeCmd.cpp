@@ -0,0 +1,640 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatExtrasBake command
+    Bakes the outputs of the selected quatSlerp, axisAngleToQuat and
+    quatToAxisAngle nodes over a frame range.
+
+    -startTime      (-st)   time
+    -endTime        (-et)   time
+        Frame range to bake. Defaults to the playback range.
+
+    -by             (-b)    double
+        Frames between samples. Defaults to 1.
+
+    -curves         (-c)
+        Keys every output onto a new animCurve named <node>_<attribute>.
+        The curves are not connected to anything. This is the default when
+        neither -file nor -trackCache is given, and it can be undone.
+
+    -file           (-f)    string
+        Writes every output to a flat binary file instead (see below).
+
+    -trackCache     (-tc)   string
+        Writes the outputQuat of each quatSlerp and axisAngleToQuat node
+        as one track of a track cache for the quatCache node to play back.
+        Tracks are named node.outputQuat and stored frame-major, with
+        the scene's frame rate so that playback at another rate still
+        lines up.
+
+    -encoding       (-enc)  string
+        Sample encoding for -trackCache: "float64" (default), "float16"
+        or "smallestThree". See core/trackCache.h.
+
+    The command reads each node's input plugs at every frame, then evaluates
+    all of the frames at once with the batch kernels in core/quatBatch.h,
+    split across every core by the scheduler in core/taskScheduler.h.
+    Reading the plugs stays on the calling thread since Maya does not
+    evaluate plugs in parallel, so upstream networks that are slow to pull
+    dominate the total. The command prints the time spent reading,
+    evaluating and writing, and returns the frames baked per second.
+
+    Binary layout, little-endian:
+        char[4]     "QXBK"
+        uint32      version (1)
+        uint32      frame count
+        uint32      channel count
+        double      first frame
+        double      frames between samples
+        uint32      length of the channel names
+        char[]      channel names as node.attribute, each ended by '\n'
+        double[]    values, one channel after another
+
+    Angles are in radians.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatExtrasBakeCmd.h"
+#include "axisAngleToQuat.h"
+#include "quatSlerp.h"
+#include "quatToAxisAngle.h"
+
+#include "core/quatBatch.h"
+#include "core/taskScheduler.h"
+#include "core/trackCache.h"
+
+#include <maya/MAnimControl.h>
+#include <maya/MArgDatabase.h>
+#include <maya/MDGContext.h>
+#include <maya/MFnAnimCurve.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MGlobal.h>
+#include <maya/MPlug.h>
+#include <maya/MSelectionList.h>
+#include <maya/MTime.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+using namespace quatExtras;
+
+#define START_TIME_FLAG         "-st"
+#define START_TIME_LONG_FLAG    "-startTime"
+#define END_TIME_FLAG           "-et"
+#define END_TIME_LONG_FLAG      "-endTime"
+#define BY_FLAG                 "-b"
+#define BY_LONG_FLAG            "-by"
+#define CURVES_FLAG             "-c"
+#define CURVES_LONG_FLAG        "-curves"
+#define FILE_FLAG               "-f"
+#define FILE_LONG_FLAG          "-file"
+#define TRACK_CACHE_FLAG        "-tc"
+#define TRACK_CACHE_LONG_FLAG   "-trackCache"
+#define ENCODING_FLAG           "-enc"
+#define ENCODING_LONG_FLAG      "-encoding"
+
+namespace
+{
+    // Frames per work item handed to the scheduler.
+    const size_t kFramesPerTask = 256;
+
+    enum BakeKind
+    {
+        kBakeSlerp,
+        kBakeAxisAngleToQuat,
+        kBakeQuatToAxisAngle
+    };
+
+    /*
+        A node being baked. Its inputs and outputs each own one row of
+        frameCount samples in the command's buffers, starting at
+        firstInput and firstOutput.
+    */
+    struct BakeNode
+    {
+        MString             name;
+        BakeKind            kind;
+
+        std::vector<MPlug>  inputs;
+        std::vector<MPlug>  outputs;
+        std::vector<bool>   outputIsAngle;
+
+        size_t              firstInput;
+        size_t              firstOutput;
+    };
+
+    void addChildren(const MObject &node, const QuatAttribute &attr, std::vector<MPlug> &plugs)
+    {
+        for (unsigned i = 0; i < 4; i++)
+            plugs.push_back(MPlug(node, attr.child(i)));
+    }
+
+    void addChildren(const MObject &node, const VectorAttribute &attr, std::vector<MPlug> &plugs)
+    {
+        for (unsigned i = 0; i < 3; i++)
+            plugs.push_back(MPlug(node, attr.child(i)));
+    }
+
+    // Returns false if the node is not a type the command can bake.
+    bool makeBakeNode(const MObject &node, BakeNode &bakeNode)
+    {
+        MFnDependencyNode fnNode(node);
+        MTypeId typeId = fnNode.typeId();
+
+        bakeNode.name = fnNode.name();
+
+        if (typeId == QuatSlerpNode::NODE_ID)
+        {
+            bakeNode.kind = kBakeSlerp;
+
+            addChildren(node, QuatSlerpNode::input1Quat_attr, bakeNode.inputs);
+            addChildren(node, QuatSlerpNode::input2Quat_attr, bakeNode.inputs);
+            bakeNode.inputs.push_back(MPlug(node, QuatSlerpNode::interpolationValue_attr));
+            bakeNode.inputs.push_back(MPlug(node, QuatSlerpNode::spin_attr));
+            bakeNode.inputs.push_back(MPlug(node, QuatSlerpNode::interpolationMode_attr));
+
+            addChildren(node, QuatSlerpNode::outputQuat_attr, bakeNode.outputs);
+            bakeNode.outputIsAngle.assign(4, false);
+        } else if (typeId == AxisAngleToQuatNode::NODE_ID) {
+            bakeNode.kind = kBakeAxisAngleToQuat;
+
+            addChildren(node, AxisAngleToQuatNode::inputAxis_attr, bakeNode.inputs);
+            bakeNode.inputs.push_back(MPlug(node, AxisAngleToQuatNode::inputAngle_attr));
+
+            addChildren(node, AxisAngleToQuatNode::outputQuat_attr, bakeNode.outputs);
+            bakeNode.outputIsAngle.assign(4, false);
+        } else if (typeId == QuatToAxisAngleNode::NODE_ID) {
+            bakeNode.kind = kBakeQuatToAxisAngle;
+
+            addChildren(node, QuatToAxisAngleNode::inputQuat_attr, bakeNode.inputs);
+
+            addChildren(node, QuatToAxisAngleNode::outputAxis_attr, bakeNode.outputs);
+            bakeNode.outputs.push_back(MPlug(node, QuatToAxisAngleNode::outputAngle_attr));
+            bakeNode.outputIsAngle.assign(3, false);
+            bakeNode.outputIsAngle.push_back(true);
+        } else {
+            return false;
+        }
+
+        return true;
+    }
+
+    /*
+        Channel-major sample buffer: row r holds frameCount values, so a
+        run of frames of one channel is contiguous and can be handed to
+        the batch kernels as is.
+    */
+    class ChannelBuffer
+    {
+    public:
+        ChannelBuffer(size_t rows, size_t frameCount) :
+            frameCount(frameCount),
+            values(rows * frameCount)
+        {
+        }
+
+        double*         row(size_t r)           { return &values[r * frameCount]; }
+        const double*   data() const            { return values.data(); }
+        size_t          size() const            { return values.size(); }
+
+        ConstQuatArrayView quat(size_t r, size_t frame)
+        {
+            ConstQuatArrayView result = { row(r) + frame, row(r + 1) + frame, row(r + 2) + frame, row(r + 3) + frame };
+            return result;
+        }
+
+        QuatArrayView outQuat(size_t r, size_t frame)
+        {
+            QuatArrayView result = { row(r) + frame, row(r + 1) + frame, row(r + 2) + frame, row(r + 3) + frame };
+            return result;
+        }
+
+        VectorArrayView vector(size_t r, size_t frame)
+        {
+            VectorArrayView result = { row(r) + frame, row(r + 1) + frame, row(r + 2) + frame };
+            return result;
+        }
+
+    private:
+        size_t              frameCount;
+        std::vector<double> values;
+    };
+
+    // Evaluates frames [begin, end) of one node.
+    void evaluate(const BakeNode &node, ChannelBuffer &inputs, ChannelBuffer &outputs, size_t begin, size_t end)
+    {
+        size_t in = node.firstInput;
+        size_t out = node.firstOutput;
+
+        switch (node.kind)
+        {
+            case kBakeSlerp:
+            {
+                const double *tween = inputs.row(in + 8);
+                const double *spinValues = inputs.row(in + 9);
+                const double *modeValues = inputs.row(in + 10);
+
+                short spin[kFramesPerTask];
+
+                for (size_t i = begin; i < end; i++)
+                    spin[i - begin] = (short) spinValues[i];
+
+                // The mode can be animated; each run of frames sharing a
+                // mode is one kernel call.
+                for (size_t i = begin; i < end;)
+                {
+                    size_t runEnd = i + 1;
+
+                    while (runEnd < end && modeValues[runEnd] == modeValues[i])
+                        runEnd++;
+
+                    slerpBatch(
+                        inputs.quat(in, i),
+                        inputs.quat(in + 4, i),
+                        tween + i,
+                        spin + (i - begin),
+                        outputs.outQuat(out, i),
+                        runEnd - i,
+                        (SlerpMode) (short) modeValues[i]
+                    );
+
+                    i = runEnd;
+                }
+
+                break;
+            }
+
+            case kBakeAxisAngleToQuat:
+                axisAngleToQuatBatch(inputs.vector(in, begin), inputs.row(in + 3) + begin, outputs.outQuat(out, begin), end - begin);
+                break;
+
+            case kBakeQuatToAxisAngle:
+                quatToAxisAngleBatch(inputs.quat(in, begin), outputs.vector(out, begin), outputs.row(out + 3) + begin, NULL, end - begin);
+                break;
+        }
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream &file, T value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+
+void* QuatExtrasBakeCmd::creator()
+{
+    return new QuatExtrasBakeCmd();
+}
+
+
+MSyntax QuatExtrasBakeCmd::newSyntax()
+{
+    MSyntax syntax;
+
+    syntax.addFlag(START_TIME_FLAG, START_TIME_LONG_FLAG, MSyntax::kTime);
+    syntax.addFlag(END_TIME_FLAG, END_TIME_LONG_FLAG, MSyntax::kTime);
+    syntax.addFlag(BY_FLAG, BY_LONG_FLAG, MSyntax::kDouble);
+    syntax.addFlag(CURVES_FLAG, CURVES_LONG_FLAG);
+    syntax.addFlag(FILE_FLAG, FILE_LONG_FLAG, MSyntax::kString);
+    syntax.addFlag(TRACK_CACHE_FLAG, TRACK_CACHE_LONG_FLAG, MSyntax::kString);
+    syntax.addFlag(ENCODING_FLAG, ENCODING_LONG_FLAG, MSyntax::kString);
+
+    syntax.setObjectType(MSyntax::kSelectionList, 1);
+    syntax.useSelectionAsDefault(true);
+
+    syntax.enableQuery(false);
+    syntax.enableEdit(false);
+
+    return syntax;
+}
+
+
+MStatus QuatExtrasBakeCmd::doIt(const MArgList& args)
+{
+    MStatus status;
+
+    MArgDatabase argData(syntax(), args, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    MTime startTime = MAnimControl::minTime();
+    MTime endTime = MAnimControl::maxTime();
+    double by = 1.0;
+
+    if (argData.isFlagSet(START_TIME_FLAG))
+        argData.getFlagArgument(START_TIME_FLAG, 0, startTime);
+
+    if (argData.isFlagSet(END_TIME_FLAG))
+        argData.getFlagArgument(END_TIME_FLAG, 0, endTime);
+
+    if (argData.isFlagSet(BY_FLAG))
+        argData.getFlagArgument(BY_FLAG, 0, by);
+
+    MTime::Unit unit = MTime::uiUnit();
+    double startFrame = startTime.as(unit);
+    double endFrame = endTime.as(unit);
+
+    if (by <= 0.0 || endFrame < startFrame)
+    {
+        MGlobal::displayError("quatExtrasBake: -by must be positive and -endTime must not be before -startTime.");
+        return MStatus::kInvalidParameter;
+    }
+
+    bool toFile = argData.isFlagSet(FILE_FLAG);
+    bool toTrackCache = argData.isFlagSet(TRACK_CACHE_FLAG);
+    bool toCurves = argData.isFlagSet(CURVES_FLAG) || !(toFile || toTrackCache);
+
+    TrackEncoding encoding = kTrackFloat64;
+
+    if (argData.isFlagSet(ENCODING_FLAG))
+    {
+        MString encodingName;
+        argData.getFlagArgument(ENCODING_FLAG, 0, encodingName);
+
+        if (encodingName == "float64")
+        {
+            encoding = kTrackFloat64;
+        } else if (encodingName == "float16") {
+            encoding = kTrackFloat16;
+        } else if (encodingName == "smallestThree") {
+            encoding = kTrackSmallestThree;
+        } else {
+            MGlobal::displayError("quatExtrasBake: -encoding must be \"float64\", \"float16\" or \"smallestThree\".");
+            return MStatus::kInvalidParameter;
+        }
+    }
+
+    MSelectionList selection;
+    argData.getObjects(selection);
+
+    std::vector<BakeNode> nodes;
+    size_t inputCount = 0;
+    size_t outputCount = 0;
+
+    for (unsigned i = 0; i < selection.length(); i++)
+    {
+        MObject node;
+
+        if (!selection.getDependNode(i, node))
+            continue;
+
+        BakeNode bakeNode;
+
+        if (!makeBakeNode(node, bakeNode))
+        {
+            MGlobal::displayWarning(MString("quatExtrasBake: skipping ") + bakeNode.name + ", which is not a quatSlerp, axisAngleToQuat or quatToAxisAngle node.");
+            continue;
+        }
+
+        bakeNode.firstInput = inputCount;
+        bakeNode.firstOutput = outputCount;
+
+        inputCount += bakeNode.inputs.size();
+        outputCount += bakeNode.outputs.size();
+
+        nodes.push_back(bakeNode);
+    }
+
+    if (nodes.empty())
+    {
+        MGlobal::displayError("quatExtrasBake: nothing to bake. Select quatSlerp, axisAngleToQuat or quatToAxisAngle nodes.");
+        return MStatus::kInvalidParameter;
+    }
+
+    size_t frameCount = (size_t) std::floor((endFrame - startFrame) / by + 1e-9) + 1;
+
+    MTimeArray times;
+    times.setLength((unsigned) frameCount);
+
+    for (size_t f = 0; f < frameCount; f++)
+        times[(unsigned) f] = MTime(startFrame + by * (double) f, unit);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    ChannelBuffer inputs(inputCount, frameCount);
+    ChannelBuffer outputs(outputCount, frameCount);
+
+    for (size_t f = 0; f < frameCount; f++)
+    {
+        MDGContext context(times[(unsigned) f]);
+
+        for (size_t n = 0; n < nodes.size(); n++)
+        {
+            const BakeNode &node = nodes[n];
+
+            for (size_t i = 0; i < node.inputs.size(); i++)
+                inputs.row(node.firstInput + i)[f] = node.inputs[i].asDouble(context);
+        }
+    }
+
+    double gatherSeconds = secondsSince(start);
+    std::chrono::steady_clock::time_point evaluateStart = std::chrono::steady_clock::now();
+
+    size_t tasksPerNode = (frameCount + kFramesPerTask - 1) / kFramesPerTask;
+
+    parallelFor(nodes.size() * tasksPerNode, 1, [&](size_t taskBegin, size_t taskEnd) {
+        for (size_t task = taskBegin; task < taskEnd; task++)
+        {
+            size_t begin = (task % tasksPerNode) * kFramesPerTask;
+            size_t end = std::min(begin + kFramesPerTask, frameCount);
+
+            evaluate(nodes[task / tasksPerNode], inputs, outputs, begin, end);
+        }
+    });
+
+    double evaluateSeconds = secondsSince(evaluateStart);
+    std::chrono::steady_clock::time_point writeStart = std::chrono::steady_clock::now();
+
+    if (toFile)
+    {
+        MString path;
+        argData.getFlagArgument(FILE_FLAG, 0, path);
+
+        std::string names;
+
+        for (size_t n = 0; n < nodes.size(); n++)
+        {
+            for (size_t i = 0; i < nodes[n].outputs.size(); i++)
+            {
+                names += nodes[n].outputs[i].partialName(true, false, false, false, false, true).asChar();
+                names += '\n';
+            }
+        }
+
+        std::ofstream file(path.asChar(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+        if (!file)
+        {
+            MGlobal::displayError(MString("quatExtrasBake: cannot write to ") + path);
+            return MStatus::kFailure;
+        }
+
+        file.write("QXBK", 4);
+        writeValue<uint32_t>(file, 1);
+        writeValue<uint32_t>(file, (uint32_t) frameCount);
+        writeValue<uint32_t>(file, (uint32_t) outputCount);
+        writeValue<double>(file, startFrame);
+        writeValue<double>(file, by);
+        writeValue<uint32_t>(file, (uint32_t) names.size());
+        file.write(names.data(), (std::streamsize) names.size());
+        file.write(reinterpret_cast<const char*>(outputs.data()), (std::streamsize) (outputs.size() * sizeof(double)));
+
+        if (!file)
+        {
+            MGlobal::displayError(MString("quatExtrasBake: failed writing ") + path);
+            return MStatus::kFailure;
+        }
+    }
+
+    if (toTrackCache)
+    {
+        MString path;
+        argData.getFlagArgument(TRACK_CACHE_FLAG, 0, path);
+
+        std::vector<std::string> names;
+        std::vector<size_t> firstRows;
+
+        for (size_t n = 0; n < nodes.size(); n++)
+        {
+            if (nodes[n].kind == kBakeQuatToAxisAngle)
+            {
+                MGlobal::displayWarning(MString("quatExtrasBake: ") + nodes[n].name + " has no quaternion output and is left out of the track cache.");
+                continue;
+            }
+
+            names.push_back(nodes[n].outputs[0].parent().partialName(true, false, false, false, false, true).asChar());
+            firstRows.push_back(nodes[n].firstOutput);
+        }
+
+        // The writer takes each track's frames together, one track after
+        // another.
+        QuatArray tracks;
+        tracks.resize(names.size() * frameCount);
+
+        QuatArrayView trackView = tracks.view();
+
+        for (size_t t = 0; t < names.size(); t++)
+        {
+            std::copy(outputs.row(firstRows[t]), outputs.row(firstRows[t]) + frameCount, trackView.x + t * frameCount);
+            std::copy(outputs.row(firstRows[t] + 1), outputs.row(firstRows[t] + 1) + frameCount, trackView.y + t * frameCount);
+            std::copy(outputs.row(firstRows[t] + 2), outputs.row(firstRows[t] + 2) + frameCount, trackView.z + t * frameCount);
+            std::copy(outputs.row(firstRows[t] + 3), outputs.row(firstRows[t] + 3) + frameCount, trackView.w + t * frameCount);
+        }
+
+        // Recorded so that quatCache finds the same frames at any scene rate.
+        double framesPerSecond = 1.0 / MTime(1.0, unit).as(MTime::kSeconds);
+
+        std::string error;
+
+        if (names.empty())
+        {
+            MGlobal::displayWarning("quatExtrasBake: no quaternion outputs to write to the track cache.");
+        } else if (!writeTrackCache(path.asChar(), names, trackView, frameCount, startFrame, by, framesPerSecond, encoding, kTrackFrameMajor, &error)) {
+            MGlobal::displayError(MString("quatExtrasBake: ") + MString(error.c_str()));
+            return MStatus::kFailure;
+        }
+    }
+
+    if (toCurves)
+    {
+        curveTimes = times;
+
+        for (size_t n = 0; n < nodes.size(); n++)
+        {
+            const BakeNode &node = nodes[n];
+
+            for (size_t i = 0; i < node.outputs.size(); i++)
+            {
+                MObject curve = dgMod.createNode(node.outputIsAngle[i] ? "animCurveTA" : "animCurveTU", &status);
+                CHECK_MSTATUS_AND_RETURN_IT(status);
+
+                dgMod.renameNode(curve, node.name + "_" + node.outputs[i].partialName(false, false, false, false, false, true));
+
+                const double *values = outputs.row(node.firstOutput + i);
+
+                MDoubleArray curveValue((unsigned) frameCount);
+
+                for (size_t f = 0; f < frameCount; f++)
+                    curveValue[(unsigned) f] = values[f];
+
+                curves.push_back(curve);
+                curveValues.push_back(curveValue);
+            }
+        }
+
+        status = redoIt();
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    double writeSeconds = secondsSince(writeStart);
+    double totalSeconds = secondsSince(start);
+
+    double framesPerSecond = totalSeconds > 0.0 ? (double) frameCount / totalSeconds : 0.0;
+
+    MString message("quatExtrasBake: ");
+    message += (int) nodes.size();
+    message += " nodes x ";
+    message += (int) frameCount;
+    message += " frames in ";
+    message += totalSeconds;
+    message += "s, ";
+    message += framesPerSecond;
+    message += " frames/sec (read ";
+    message += gatherSeconds;
+    message += "s, evaluate ";
+    message += evaluateSeconds;
+    message += "s on ";
+    message += (int) schedulerThreadCount();
+    message += " threads, write ";
+    message += writeSeconds;
+    message += "s).";
+
+    MGlobal::displayInfo(message);
+
+    setResult(framesPerSecond);
+
+    return MStatus::kSuccess;
+}
+
+
+MStatus QuatExtrasBakeCmd::redoIt()
+{
+    MStatus status = dgMod.doIt();
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    MFnAnimCurve fnCurve;
+
+    for (size_t i = 0; i < curves.size(); i++)
+    {
+        fnCurve.setObject(curves[i]);
+
+        status = fnCurve.addKeys(&curveTimes, &curveValues[i], MFnAnimCurve::kTangentLinear, MFnAnimCurve::kTangentLinear);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+    }
+
+    return MStatus::kSuccess;
+}
+
+
+MStatus QuatExtrasBakeCmd::undoIt()
+{
+    return dgMod.undoIt();
+}
+
+
+bool QuatExtrasBakeCmd::isUndoable() const
+{
+    return !curves.empty();
+}
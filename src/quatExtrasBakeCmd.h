@@ -0,0 +1,38 @@
+#ifndef QUAT_EXTRAS_BAKE_CMD_H
+#define QUAT_EXTRAS_BAKE_CMD_H
+
+#include <maya/MArgList.h>
+#include <maya/MDGModifier.h>
+#include <maya/MDoubleArray.h>
+#include <maya/MObject.h>
+#include <maya/MPxCommand.h>
+#include <maya/MString.h>
+#include <maya/MSyntax.h>
+#include <maya/MTimeArray.h>
+
+#include <vector>
+
+class QuatExtrasBakeCmd : public MPxCommand
+{
+public:
+    virtual MStatus         doIt(const MArgList& args);
+    virtual MStatus         redoIt();
+    virtual MStatus         undoIt();
+    virtual bool            isUndoable() const;
+
+    static  void*           creator();
+    static  MSyntax         newSyntax();
+
+public:
+    static MString          COMMAND_NAME;
+
+private:
+    MDGModifier             dgMod;
+
+    // Curves made by -curves and the keys to put back on them on redo.
+    std::vector<MObject>    curves;
+    std::vector<MDoubleArray> curveValues;
+    MTimeArray              curveTimes;
+};
+
+#endif
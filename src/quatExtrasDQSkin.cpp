@@ -0,0 +1,335 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatExtrasDQSkin node
+    Deforms geometry by dual quaternion skinning, as skinCluster does with
+    its dual quaternion method, connected the same way.
+
+    matrix              (ma)
+        World matrix of each influence. Missing elements count as identity.
+
+    bindPreMatrix       (pm)
+        Inverse world matrix of each influence at bind time. Missing
+        elements count as identity.
+
+    geomMatrix          (gm)
+        World matrix of the geometry at bind time.
+
+    influenceWeightList (iwl)
+        One element per vertex, at the vertex's index.
+
+        influenceWeights    (iw)
+            Weight of each influence on the vertex, at the influence's
+            index in matrix.
+
+    maxInfluences       (mi)
+        Influences kept per vertex. The largest weights are kept and
+        normalized to sum to one; the rest are dropped.
+
+    Each point moves to p * geomMatrix * bindPreMatrix[i] * matrix[i],
+    blended across its influences as dual quaternions, then toward that
+    from its input position by the envelope. Scale and shear in the
+    skinning matrices are dropped. Vertices with no weights, or past the
+    end of influenceWeightList, are left in place.
+
+    The weights are kept in compressed sparse row layout between
+    evaluations and read again only when influenceWeightList or
+    maxInfluences changes. Every geometry the node deforms shares the one
+    weight list. Meshes of kParallelThreshold points or more are split
+    across all cores.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatExtrasDQSkin.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/dqSkin.h"
+#include "core/quatBatch.h"
+#include "core/taskScheduler.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnCompoundAttribute.h>
+#include <maya/MFnMatrixAttribute.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MPointArray.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace quatExtras;
+
+// Below this many points the work is too small to be worth waking the
+// workers.
+const size_t kParallelThreshold = 16384;
+const size_t kParallelGrain = 4096;
+
+MObject QuatExtrasDQSkinNode::matrix_attr;
+MObject QuatExtrasDQSkinNode::bindPreMatrix_attr;
+MObject QuatExtrasDQSkinNode::geomMatrix_attr;
+
+MObject QuatExtrasDQSkinNode::influenceWeightList_attr;
+MObject QuatExtrasDQSkinNode::influenceWeights_attr;
+MObject QuatExtrasDQSkinNode::maxInfluences_attr;
+
+namespace
+{
+    // Matrices of a matrix array by logical index, identity where missing.
+    void readMatrices(MArrayDataHandle &arrayHandle, std::vector<MMatrix> &matrices, unsigned count)
+    {
+        matrices.assign(count, MMatrix::identity);
+
+        unsigned numElements = arrayHandle.elementCount();
+
+        for (unsigned i = 0; i < numElements; i++)
+        {
+            arrayHandle.jumpToArrayElement(i);
+
+            unsigned index = arrayHandle.elementIndex();
+
+            if (index < count)
+                matrices[index] = arrayHandle.inputValue().asMatrix();
+        }
+    }
+}
+
+QuatExtrasDQSkinNode::QuatExtrasDQSkinNode() :
+    ProfiledNode(NODE_NAME),
+    weightsDirty(true)
+{
+}
+
+void* QuatExtrasDQSkinNode::creator()
+{
+    return new QuatExtrasDQSkinNode();
+}
+
+MStatus QuatExtrasDQSkinNode::initialize()
+{
+    MStatus status;
+
+    MFnMatrixAttribute m;
+    MFnNumericAttribute n;
+    MFnCompoundAttribute c;
+
+    matrix_attr = m.create("matrix", "ma", MFnMatrixAttribute::kDouble, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(m);
+    m.setArray(true);
+
+    bindPreMatrix_attr = m.create("bindPreMatrix", "pm", MFnMatrixAttribute::kDouble, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(m);
+    m.setArray(true);
+
+    geomMatrix_attr = m.create("geomMatrix", "gm", MFnMatrixAttribute::kDouble, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(m);
+
+    influenceWeights_attr = n.create("influenceWeights", "iw", MFnNumericData::kDouble, 0.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setArray(true);
+    n.setUsesArrayDataBuilder(true);
+
+    influenceWeightList_attr = c.create("influenceWeightList", "iwl", &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    c.addChild(influenceWeights_attr);
+    MAKE_INPUT(c);
+    c.setArray(true);
+    c.setUsesArrayDataBuilder(true);
+
+    maxInfluences_attr = n.create("maxInfluences", "mi", MFnNumericData::kInt, (double) SkinWeights::kDefaultMaxInfluences, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setMin(1);
+
+    addAttribute(matrix_attr);
+    addAttribute(bindPreMatrix_attr);
+    addAttribute(geomMatrix_attr);
+    addAttribute(influenceWeightList_attr);
+    addAttribute(maxInfluences_attr);
+
+    attributeAffects(matrix_attr, outputGeom);
+    attributeAffects(bindPreMatrix_attr, outputGeom);
+    attributeAffects(geomMatrix_attr, outputGeom);
+    attributeAffects(influenceWeightList_attr, outputGeom);
+    attributeAffects(influenceWeights_attr, outputGeom);
+    attributeAffects(maxInfluences_attr, outputGeom);
+
+    return MStatus::kSuccess;
+}
+
+
+MStatus QuatExtrasDQSkinNode::setDependentsDirty(const MPlug& plug, MPlugArray& affectedPlugs)
+{
+    MObject attr = plug.attribute();
+
+    if (attr == influenceWeightList_attr || attr == influenceWeights_attr || attr == maxInfluences_attr)
+        weightsDirty = true;
+
+    return MPxDeformerNode::setDependentsDirty(plug, affectedPlugs);
+}
+
+
+#if MAYA_API_VERSION >= 201600
+/*
+    The evaluation manager does not call setDependentsDirty, so check the
+    weights against its dirty plugs before each evaluation instead.
+*/
+MStatus QuatExtrasDQSkinNode::preEvaluation(const MDGContext& context, const MEvaluationNode& evaluationNode)
+{
+    if (context.isNormal() && !weightsDirty)
+    {
+        weightsDirty = evaluationNode.dirtyPlugExists(influenceWeightList_attr) ||
+                       evaluationNode.dirtyPlugExists(influenceWeights_attr) ||
+                       evaluationNode.dirtyPlugExists(maxInfluences_attr);
+    }
+
+    return MPxDeformerNode::preEvaluation(context, evaluationNode);
+}
+#endif
+
+
+void QuatExtrasDQSkinNode::readWeights(MDataBlock& data, SkinWeights &weights)
+{
+    int maxInfluences = data.inputValue(maxInfluences_attr).asInt();
+
+    weights.clear((unsigned) std::max(maxInfluences, 1));
+
+    MArrayDataHandle listHandle = data.inputArrayValue(influenceWeightList_attr);
+
+    unsigned vertexElements = listHandle.elementCount();
+
+    std::vector<int> influence;
+    std::vector<double> weight;
+
+    // Elements come in logical index order, which addVertex needs.
+    for (unsigned i = 0; i < vertexElements; i++)
+    {
+        listHandle.jumpToArrayElement(i);
+
+        unsigned vertex = listHandle.elementIndex();
+
+        MArrayDataHandle weightHandle = listHandle.inputValue().child(influenceWeights_attr);
+
+        unsigned influenceElements = weightHandle.elementCount();
+
+        influence.resize(influenceElements);
+        weight.resize(influenceElements);
+
+        for (unsigned k = 0; k < influenceElements; k++)
+        {
+            weightHandle.jumpToArrayElement(k);
+
+            influence[k] = (int) weightHandle.elementIndex();
+            weight[k] = weightHandle.inputValue().asDouble();
+        }
+
+        weights.addVertex(vertex, influence.data(), weight.data(), influenceElements);
+    }
+}
+
+
+void QuatExtrasDQSkinNode::readJoints(MDataBlock& data, int influenceCount)
+{
+    MArrayDataHandle matrixHandle = data.inputArrayValue(matrix_attr);
+    MArrayDataHandle bindPreMatrixHandle = data.inputArrayValue(bindPreMatrix_attr);
+
+    unsigned count = std::max(logicalLength(matrixHandle), (unsigned) influenceCount);
+
+    readMatrices(matrixHandle, jointMatrices, count);
+    readMatrices(bindPreMatrixHandle, bindPreMatrices, count);
+
+    joints.resize(count);
+
+    for (unsigned i = 0; i < count; i++)
+    {
+        MMatrix skinMatrix = bindPreMatrices[i] * jointMatrices[i];
+        joints.set(i, skinMatrix.matrix);
+    }
+}
+
+
+MStatus QuatExtrasDQSkinNode::deform(MDataBlock& data, MItGeometry& iter, const MMatrix& /* localToWorld */, unsigned /* multiIndex */)
+{
+    ComputeTimer timer(statsType, &instanceStats);
+
+    double envelopeValue = (double) data.inputValue(envelope).asFloat();
+
+    if (envelopeValue == 0.0)
+        return MStatus::kSuccess;
+
+    // The cache only describes the normal context; evaluations in any
+    // other context read weights of their own.
+    bool normalContext = data.context().isNormal();
+
+    SkinWeights contextWeights;
+    SkinWeights &weights = normalContext ? cachedWeights : contextWeights;
+
+    if (weightsDirty || !normalContext)
+    {
+        readWeights(data, weights);
+        timer.cacheMiss();
+
+        if (normalContext)
+            weightsDirty = false;
+    } else {
+        timer.cacheHit();
+    }
+
+    readJoints(data, weights.influenceCount());
+
+    MMatrix geomMatrix = data.inputValue(geomMatrix_attr).asMatrix();
+
+    MPointArray points;
+    iter.allPositions(points);
+
+    size_t count = std::min((size_t) points.length(), weights.vertexCount());
+    timer.setElements((unsigned) count);
+
+    for (unsigned k = 0; k < 3; k++)
+        pointBuffers[k].resize(count);
+
+    VectorArrayView buffer = { pointBuffers[0].data(), pointBuffers[1].data(), pointBuffers[2].data() };
+    ConstDualQuatArrayView jointView = joints.view();
+
+    RangeTask skin = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            const MPoint &p = points[(unsigned) i];
+
+            buffer.x[i] = p.x * geomMatrix.matrix[0][0] + p.y * geomMatrix.matrix[1][0] + p.z * geomMatrix.matrix[2][0] + geomMatrix.matrix[3][0];
+            buffer.y[i] = p.x * geomMatrix.matrix[0][1] + p.y * geomMatrix.matrix[1][1] + p.z * geomMatrix.matrix[2][1] + geomMatrix.matrix[3][1];
+            buffer.z[i] = p.x * geomMatrix.matrix[0][2] + p.y * geomMatrix.matrix[1][2] + p.z * geomMatrix.matrix[2][2] + geomMatrix.matrix[3][2];
+        }
+
+        ConstVectorArrayView in = { buffer.x + begin, buffer.y + begin, buffer.z + begin };
+        VectorArrayView out = { buffer.x + begin, buffer.y + begin, buffer.z + begin };
+
+        dqSkinBatch(jointView, weights.view(begin), in, out, end - begin);
+
+        for (size_t i = begin; i < end; i++)
+        {
+            MPoint &p = points[(unsigned) i];
+
+            p.x += envelopeValue * (buffer.x[i] - p.x);
+            p.y += envelopeValue * (buffer.y[i] - p.y);
+            p.z += envelopeValue * (buffer.z[i] - p.z);
+        }
+    };
+
+    if (count >= kParallelThreshold)
+    {
+        parallelFor(count, kParallelGrain, skin);
+    } else {
+        skin(0, count);
+    }
+
+    return iter.setAllPositions(points);
+}
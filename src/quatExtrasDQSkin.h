@@ -0,0 +1,66 @@
+#ifndef QUAT_EXTRAS_DQ_SKIN_NODE_H
+#define QUAT_EXTRAS_DQ_SKIN_NODE_H
+
+#include "profiledNode.h"
+
+#include "core/dqSkin.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MDGContext.h>
+#include <maya/MItGeometry.h>
+#include <maya/MMatrix.h>
+#include <maya/MPlug.h>
+#include <maya/MPlugArray.h>
+#include <maya/MPxDeformerNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+#include <maya/MTypes.h>
+
+#if MAYA_API_VERSION >= 201600
+#include <maya/MEvaluationNode.h>
+#endif
+
+#include <vector>
+
+class QuatExtrasDQSkinNode : public MPxDeformerNode, public ProfiledNode
+{
+public:
+                            QuatExtrasDQSkinNode();
+
+    virtual MStatus         deform(MDataBlock& data, MItGeometry& iter, const MMatrix& localToWorld, unsigned multiIndex);
+    virtual MStatus         setDependentsDirty(const MPlug& plug, MPlugArray& affectedPlugs);
+#if MAYA_API_VERSION >= 201600
+    virtual MStatus         preEvaluation(const MDGContext& context, const MEvaluationNode& evaluationNode);
+#endif
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static MObject          matrix_attr;
+    static MObject          bindPreMatrix_attr;
+    static MObject          geomMatrix_attr;
+
+    static MObject          influenceWeightList_attr;
+    static MObject          influenceWeights_attr;
+    static MObject          maxInfluences_attr;
+
+private:
+    void                    readWeights(MDataBlock& data, quatExtras::SkinWeights &weights);
+    void                    readJoints(MDataBlock& data, int influenceCount);
+
+    // Weights in CSR layout, kept until a weight or maxInfluences is
+    // dirtied.
+    bool                    weightsDirty;
+    quatExtras::SkinWeights cachedWeights;
+
+    // Per evaluation, kept to avoid reallocating.
+    quatExtras::DualQuatArray   joints;
+    std::vector<MMatrix>        jointMatrices;
+    std::vector<MMatrix>        bindPreMatrices;
+    std::vector<double>         pointBuffers[3];
+};
+
+#endif
@@ -0,0 +1,229 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatExtrasStats command
+    Reports how often quatExtras nodes computed and how long it took.
+
+    -enable         (-e)    bool
+        Turns collection on or off. Off by default, unless the
+        QUATEXTRAS_STATS environment variable is non-zero. Queried with
+        -q -e.
+
+    -reset          (-r)
+        Zeroes every counter, per type and per node.
+
+    -instances      (-i)
+        Adds one row per node after the per-type rows.
+
+    -format         (-f)    string
+        "csv" (default) or "json".
+
+    -outputFile     (-of)   string
+        Writes the report to this file instead of returning it.
+
+    With -enable or -reset alone the command returns nothing; otherwise it
+    returns the report. Each row has the node type, the node name (empty for
+    a type total), compute calls, total and average wall time, elements
+    processed by array nodes, and cache hits and misses on nodes that cache.
+
+    Counting happens per thread without locks; see core/computeStats.h.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatExtrasStatsCmd.h"
+#include "profiledNode.h"
+
+#include "core/computeStats.h"
+
+#include <maya/MArgDatabase.h>
+#include <maya/MArgList.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MGlobal.h>
+#include <maya/MItDependencyNodes.h>
+#include <maya/MObject.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MSyntax.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace quatExtras;
+
+#define ENABLE_FLAG             "-e"
+#define ENABLE_LONG_FLAG        "-enable"
+#define RESET_FLAG              "-r"
+#define RESET_LONG_FLAG         "-reset"
+#define INSTANCES_FLAG          "-i"
+#define INSTANCES_LONG_FLAG     "-instances"
+#define FORMAT_FLAG             "-f"
+#define FORMAT_LONG_FLAG        "-format"
+#define OUTPUT_FILE_FLAG        "-of"
+#define OUTPUT_FILE_LONG_FLAG   "-outputFile"
+
+namespace
+{
+    /*
+        Collects every node in the scene that reports to quatExtrasStats
+        and, if rows is given, a row with each one's counters.
+    */
+    void profiledNodes(std::vector<ProfiledNode*> &nodes, std::vector<StatsRow> *rows)
+    {
+        for (MItDependencyNodes it; !it.isDone(); it.next())
+        {
+            MStatus status;
+            MFnDependencyNode fnNode(it.thisNode());
+
+            MPxNode *userNode = fnNode.userNode(&status);
+
+            if (!status || !userNode)
+                continue;
+
+            ProfiledNode *node = dynamic_cast<ProfiledNode*>(userNode);
+
+            if (!node)
+                continue;
+
+            nodes.push_back(node);
+
+            if (rows)
+            {
+                StatsRow row;
+                row.type = fnNode.typeName().asChar();
+                row.node = fnNode.name().asChar();
+                row.counters = node->instanceStats.read();
+
+                rows->push_back(row);
+            }
+        }
+    }
+}
+
+
+void* QuatExtrasStatsCmd::creator()
+{
+    return new QuatExtrasStatsCmd();
+}
+
+
+MSyntax QuatExtrasStatsCmd::newSyntax()
+{
+    MSyntax syntax;
+
+    syntax.addFlag(ENABLE_FLAG, ENABLE_LONG_FLAG, MSyntax::kBoolean);
+    syntax.addFlag(RESET_FLAG, RESET_LONG_FLAG);
+    syntax.addFlag(INSTANCES_FLAG, INSTANCES_LONG_FLAG);
+    syntax.addFlag(FORMAT_FLAG, FORMAT_LONG_FLAG, MSyntax::kString);
+    syntax.addFlag(OUTPUT_FILE_FLAG, OUTPUT_FILE_LONG_FLAG, MSyntax::kString);
+
+    syntax.enableQuery(true);
+    syntax.enableEdit(false);
+
+    return syntax;
+}
+
+
+MStatus QuatExtrasStatsCmd::doIt(const MArgList& args)
+{
+    MStatus status;
+
+    MArgDatabase argData(syntax(), args, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    if (argData.isQuery())
+    {
+        if (!argData.isFlagSet(ENABLE_FLAG))
+        {
+            MGlobal::displayError("quatExtrasStats: only -enable can be queried.");
+            return MStatus::kInvalidParameter;
+        }
+
+        setResult((int) statsEnabled());
+        return MStatus::kSuccess;
+    }
+
+    MString format = "csv";
+
+    if (argData.isFlagSet(FORMAT_FLAG))
+    {
+        argData.getFlagArgument(FORMAT_FLAG, 0, format);
+
+        if (format != "csv" && format != "json")
+        {
+            MGlobal::displayError("quatExtrasStats: -format must be \"csv\" or \"json\".");
+            return MStatus::kInvalidParameter;
+        }
+    }
+
+    bool report = argData.isFlagSet(INSTANCES_FLAG) || argData.isFlagSet(FORMAT_FLAG) || argData.isFlagSet(OUTPUT_FILE_FLAG);
+
+    if (argData.isFlagSet(ENABLE_FLAG))
+    {
+        bool enabled;
+        argData.getFlagArgument(ENABLE_FLAG, 0, enabled);
+        setStatsEnabled(enabled);
+    } else if (!argData.isFlagSet(RESET_FLAG)) {
+        report = true;
+    }
+
+    if (argData.isFlagSet(RESET_FLAG))
+    {
+        std::vector<ProfiledNode*> nodes;
+        profiledNodes(nodes, NULL);
+
+        for (size_t i = 0; i < nodes.size(); i++)
+            nodes[i]->instanceStats.reset();
+
+        resetStats();
+    }
+
+    if (!report)
+        return MStatus::kSuccess;
+
+    std::vector<StatsRow> rows;
+
+    std::vector<std::string> names;
+    std::vector<ComputeCounters> totals;
+    statsTypeTotals(names, totals);
+
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        StatsRow row;
+        row.type = names[i];
+        row.counters = totals[i];
+
+        rows.push_back(row);
+    }
+
+    if (argData.isFlagSet(INSTANCES_FLAG))
+    {
+        std::vector<ProfiledNode*> nodes;
+        profiledNodes(nodes, &rows);
+    }
+
+    std::string text = format == "json" ? statsToJson(rows) : statsToCsv(rows);
+
+    if (argData.isFlagSet(OUTPUT_FILE_FLAG))
+    {
+        MString path;
+        argData.getFlagArgument(OUTPUT_FILE_FLAG, 0, path);
+
+        std::ofstream file(path.asChar(), std::ios::out | std::ios::trunc);
+
+        if (!file)
+        {
+            MGlobal::displayError(MString("quatExtrasStats: cannot write to ") + path);
+            return MStatus::kFailure;
+        }
+
+        file << text;
+    } else {
+        setResult(MString(text.c_str()));
+    }
+
+    return MStatus::kSuccess;
+}
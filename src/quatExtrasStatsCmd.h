@@ -0,0 +1,20 @@
+#ifndef QUAT_EXTRAS_STATS_CMD_H
+#define QUAT_EXTRAS_STATS_CMD_H
+
+#include <maya/MArgList.h>
+#include <maya/MPxCommand.h>
+#include <maya/MString.h>
+#include <maya/MSyntax.h>
+
+class QuatExtrasStatsCmd : public MPxCommand
+{
+public:
+    virtual MStatus         doIt(const MArgList& args);
+    static  void*           creator();
+    static  MSyntax         newSyntax();
+
+public:
+    static MString          COMMAND_NAME;
+};
+
+#endif
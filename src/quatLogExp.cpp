@@ -0,0 +1,193 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatLogExp node
+    Blends rotations in log space. Each rotation is mapped to its rotation
+    vector (axis * angle, in radians), where scaling and adding are
+    meaningful, and the weighted sum is mapped back to a rotation.
+
+    inputQuat   (iq)
+        Rotations to blend.
+
+    weight      (w)
+        Weight of each inputQuat element. Missing elements default to 1.
+
+    inputLog    (il)
+        Rotation vectors added to the sum as they are, such as outputLog
+        elements that have been processed by other nodes.
+
+    outputLog   (ol)
+        The rotation vector of each inputQuat element, unweighted, with an
+        angle between 0 and 180 degrees.
+
+    outputLogSum (ols)
+        sum(weight[i] * outputLog[i]) + sum(inputLog[j]).
+
+    outputQuat  (oq)
+        The rotation outputLogSum describes.
+
+    With a single input, outputQuat is inputQuat turned weight times as
+    far; quatPower does the same for many rotations at once. Near the
+    identity the conversions use series expansions, so small rotations
+    keep their full precision; see core/quatMath.h.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatLogExp.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+#include "core/quatMath.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnNumericData.h>
+#include <maya/MPlug.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+QuatAttribute QuatLogExpNode::inputQuat_attr;
+MObject QuatLogExpNode::weight_attr;
+VectorAttribute QuatLogExpNode::inputLog_attr;
+
+VectorAttribute QuatLogExpNode::outputLog_attr;
+VectorAttribute QuatLogExpNode::outputLogSum_attr;
+QuatAttribute QuatLogExpNode::outputQuat_attr;
+
+QuatLogExpNode::QuatLogExpNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* QuatLogExpNode::creator()
+{
+    return new QuatLogExpNode();
+}
+
+MStatus QuatLogExpNode::initialize()
+{
+    MStatus status;
+
+    MFnNumericAttribute n;
+
+    const double zeroVector[3] = { 0.0, 0.0, 0.0 };
+
+    const char *const inputQuatNames[] = { "iqx", "iqy", "iqz", "iqw" };
+    status = inputQuat_attr.create("inputQuat", "iq", inputQuatNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    weight_attr = n.create("weight", "w", MFnNumericData::kDouble, 1.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setArray(true);
+
+    const char *const inputLogNames[] = { "ilx", "ily", "ilz" };
+    status = inputLog_attr.create("inputLog", "il", inputLogNames, zeroVector, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const outputLogNames[] = { "olx", "oly", "olz" };
+    status = outputLog_attr.create("outputLog", "ol", outputLogNames, zeroVector, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const outputLogSumNames[] = { "olsx", "olsy", "olsz" };
+    status = outputLogSum_attr.create("outputLogSum", "ols", outputLogSumNames, zeroVector, kCompoundOutput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(inputQuat_attr);
+    addAttribute(weight_attr);
+    addAttribute(inputLog_attr);
+    addAttribute(outputLog_attr);
+    addAttribute(outputLogSum_attr);
+    addAttribute(outputQuat_attr);
+
+    attributeAffects(inputQuat_attr, outputLog_attr);
+    attributeAffects(inputQuat_attr, outputLogSum_attr);
+    attributeAffects(inputQuat_attr, outputQuat_attr);
+    attributeAffects(weight_attr, outputLogSum_attr);
+    attributeAffects(weight_attr, outputQuat_attr);
+    attributeAffects(inputLog_attr, outputLogSum_attr);
+    attributeAffects(inputLog_attr, outputQuat_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatLogExpNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputLog_attr) && !isPlugFor(plug, outputLogSum_attr) && !isPlugFor(plug, outputQuat_attr))
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    MArrayDataHandle inputHandle = data.inputArrayValue(inputQuat_attr);
+    MArrayDataHandle weightHandle = data.inputArrayValue(weight_attr);
+    MArrayDataHandle inputLogHandle = data.inputArrayValue(inputLog_attr);
+
+    unsigned count = logicalLength(inputHandle);
+    unsigned logCount = logicalLength(inputLogHandle);
+    timer.setElements(count + logCount);
+
+    QuatArray input;
+    input.resize(count);
+
+    QuatArrayView inputView = input.view();
+
+    inputQuat_attr.inputArrayValue(inputHandle, inputView, count);
+
+    std::vector<double> weight(count, 1.0);
+    inputDoubleArrayValue(weightHandle, weight.data(), count);
+
+    std::vector<double> logX(count);
+    std::vector<double> logY(count);
+    std::vector<double> logZ(count);
+
+    VectorArrayView logView = { logX.data(), logY.data(), logZ.data() };
+
+    quatToRotationVectorBatch(inputView, logView, count);
+
+    double sum[3] = { 0.0, 0.0, 0.0 };
+
+    for (unsigned i = 0; i < count; i++)
+    {
+        sum[0] += weight[i] * logX[i];
+        sum[1] += weight[i] * logY[i];
+        sum[2] += weight[i] * logZ[i];
+    }
+
+    std::vector<double> inputLogX(logCount, 0.0);
+    std::vector<double> inputLogY(logCount, 0.0);
+    std::vector<double> inputLogZ(logCount, 0.0);
+
+    VectorArrayView inputLogView = { inputLogX.data(), inputLogY.data(), inputLogZ.data() };
+
+    inputLog_attr.inputArrayValue(inputLogHandle, inputLogView, logCount);
+
+    for (unsigned i = 0; i < logCount; i++)
+    {
+        sum[0] += inputLogX[i];
+        sum[1] += inputLogY[i];
+        sum[2] += inputLogZ[i];
+    }
+
+    double outputQuat[4];
+    rotationVectorToQuat(sum, outputQuat);
+
+    MStatus status = outputLog_attr.outputArrayValue(data, logView, count);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    status = outputLogSum_attr.outputValue(data, sum);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    return outputQuat_attr.outputValue(data, outputQuat);
+}
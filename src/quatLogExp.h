@@ -0,0 +1,35 @@
+#ifndef QUAT_LOG_EXP_H
+#define QUAT_LOG_EXP_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+class QuatLogExpNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatLogExpNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    inputQuat_attr;
+    static MObject          weight_attr;
+    static VectorAttribute  inputLog_attr;
+
+    static VectorAttribute  outputLog_attr;
+    static VectorAttribute  outputLogSum_attr;
+    static QuatAttribute    outputQuat_attr;
+};
+
+#endif
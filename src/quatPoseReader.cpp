@@ -0,0 +1,297 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatPoseReader node
+    Finds the sculpted poses nearest a rotation, for driving corrective
+    shapes from a large pose library.
+
+    inputQuat   (iq)
+        Rotation to read, such as a joint's rotation relative to its rest
+        pose.
+
+    pose        (ps)
+        Library of pose rotations. The sign of a pose does not matter.
+
+    neighborCount (nc)
+        Number of nearest poses output. Defaults to 4.
+
+    kernel      (krn)
+        How the angle to a pose becomes its weight, with r the radius:
+            gaussian    exp(-(angle / r)^2) (default).
+            cone        1 - angle / r, and zero beyond the radius.
+
+    radius      (rad)
+        Angle at which the kernel falls off. Defaults to 45 degrees.
+
+    normalize   (nrm)
+        Scale the weights of the nearest poses to sum to one, unless they
+        are all zero. On by default.
+
+    nearestPose   (np)
+    nearestAngle  (na)
+    nearestWeight (nw)
+        Logical index in pose of each of the nearest poses, nearest first,
+        the angle of the rotation from inputQuat to it, and its weight.
+        Fewer than neighborCount elements when there are fewer poses.
+
+    The poses are kept in a vantage-point tree that is rebuilt only when
+    the pose array is dirtied, so an evaluation where only inputQuat or the
+    weighting changed visits a small part of the library: about 120 of
+    10,000 poses for 4 neighbours, compared with every pose for a scan.
+    quatExtrasStats counts the poses visited by each query as its
+    elements. See core/poseIndex.h.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatPoseReader.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/poseIndex.h"
+#include "core/quatBatch.h"
+
+#include <maya/MAngle.h>
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnEnumAttribute.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnNumericData.h>
+#include <maya/MFnUnitAttribute.h>
+#include <maya/MPlug.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace quatExtras;
+
+QuatAttribute QuatPoseReaderNode::inputQuat_attr;
+QuatAttribute QuatPoseReaderNode::pose_attr;
+
+MObject QuatPoseReaderNode::neighborCount_attr;
+MObject QuatPoseReaderNode::kernel_attr;
+MObject QuatPoseReaderNode::radius_attr;
+MObject QuatPoseReaderNode::normalize_attr;
+
+MObject QuatPoseReaderNode::nearestPose_attr;
+MObject QuatPoseReaderNode::nearestAngle_attr;
+MObject QuatPoseReaderNode::nearestWeight_attr;
+
+namespace
+{
+    /*
+        Reads every element of the pose array into poses, with its logical
+        index in ids, so missing indices are not read as identity poses.
+    */
+    void readPoses(MDataBlock &data, const QuatAttribute &attr, QuatArray &poses, std::vector<unsigned> &ids)
+    {
+        MArrayDataHandle arrayHandle = data.inputArrayValue(attr);
+
+        unsigned count = arrayHandle.elementCount();
+
+        poses.resize(count);
+        ids.resize(count);
+
+        for (unsigned i = 0; i < count; i++)
+        {
+            arrayHandle.jumpToArrayElement(i);
+
+            MDataHandle element = arrayHandle.inputValue();
+
+            double value[4];
+            attr.get(element, value);
+
+            poses.set(i, value[0], value[1], value[2], value[3]);
+            ids[i] = arrayHandle.elementIndex();
+        }
+    }
+}
+
+QuatPoseReaderNode::QuatPoseReaderNode() :
+    ProfiledNode(NODE_NAME),
+    posesDirty(true)
+{
+}
+
+void* QuatPoseReaderNode::creator()
+{
+    return new QuatPoseReaderNode();
+}
+
+MStatus QuatPoseReaderNode::initialize()
+{
+    MStatus status;
+
+    MFnEnumAttribute e;
+    MFnNumericAttribute n;
+    MFnUnitAttribute u;
+
+    const char *const inputQuatNames[] = { "iqx", "iqy", "iqz", "iqw" };
+    status = inputQuat_attr.create("inputQuat", "iq", inputQuatNames, kIdentityQuatDefaults, kCompoundInput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const poseNames[] = { "psx", "psy", "psz", "psw" };
+    status = pose_attr.create("pose", "ps", poseNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    neighborCount_attr = n.create("neighborCount", "nc", MFnNumericData::kInt, 4.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setMin(1);
+
+    kernel_attr = e.create("kernel", "krn", kPoseGaussian, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(e);
+    e.addField("gaussian", kPoseGaussian);
+    e.addField("cone", kPoseCone);
+
+    radius_attr = u.create("radius", "rad", MFnUnitAttribute::kAngle, MAngle(45.0, MAngle::kDegrees).asRadians(), &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(u);
+    u.setMin(0.0);
+
+    normalize_attr = n.create("normalize", "nrm", MFnNumericData::kBoolean, 1.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+
+    nearestPose_attr = n.create("nearestPose", "np", MFnNumericData::kInt, 0.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_OUTPUT(n);
+    n.setArray(true);
+    n.setUsesArrayDataBuilder(true);
+
+    nearestAngle_attr = u.create("nearestAngle", "na", MFnUnitAttribute::kAngle, 0.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_OUTPUT(u);
+    u.setArray(true);
+    u.setUsesArrayDataBuilder(true);
+
+    nearestWeight_attr = n.create("nearestWeight", "nw", MFnNumericData::kDouble, 0.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_OUTPUT(n);
+    n.setArray(true);
+    n.setUsesArrayDataBuilder(true);
+
+    addAttribute(inputQuat_attr);
+    addAttribute(pose_attr);
+    addAttribute(neighborCount_attr);
+    addAttribute(kernel_attr);
+    addAttribute(radius_attr);
+    addAttribute(normalize_attr);
+    addAttribute(nearestPose_attr);
+    addAttribute(nearestAngle_attr);
+    addAttribute(nearestWeight_attr);
+
+    attributeAffects(inputQuat_attr, nearestPose_attr);
+    attributeAffects(pose_attr, nearestPose_attr);
+    attributeAffects(neighborCount_attr, nearestPose_attr);
+
+    attributeAffects(inputQuat_attr, nearestAngle_attr);
+    attributeAffects(pose_attr, nearestAngle_attr);
+    attributeAffects(neighborCount_attr, nearestAngle_attr);
+
+    attributeAffects(inputQuat_attr, nearestWeight_attr);
+    attributeAffects(pose_attr, nearestWeight_attr);
+    attributeAffects(neighborCount_attr, nearestWeight_attr);
+    attributeAffects(kernel_attr, nearestWeight_attr);
+    attributeAffects(radius_attr, nearestWeight_attr);
+    attributeAffects(normalize_attr, nearestWeight_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatPoseReaderNode::setDependentsDirty(const MPlug& plug, MPlugArray& affectedPlugs)
+{
+    if (pose_attr.owns(plug.attribute()))
+        posesDirty = true;
+
+    return MPxNode::setDependentsDirty(plug, affectedPlugs);
+}
+
+#if MAYA_API_VERSION >= 201600
+/*
+    The evaluation manager does not call setDependentsDirty, so check the
+    poses against its dirty plugs before each evaluation instead.
+*/
+MStatus QuatPoseReaderNode::preEvaluation(const MDGContext& context, const MEvaluationNode& evaluationNode)
+{
+    if (context.isNormal() && !posesDirty)
+        posesDirty = pose_attr.dirtyPlugExists(evaluationNode);
+
+    return MPxNode::preEvaluation(context, evaluationNode);
+}
+#endif
+
+MStatus QuatPoseReaderNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, nearestPose_attr) &&
+        !isPlugFor(plug, nearestAngle_attr) &&
+        !isPlugFor(plug, nearestWeight_attr))
+    {
+        return MStatus::kUnknownParameter;
+    }
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    // The index only describes the normal context; evaluations in any
+    // other context build one of their own and leave it alone.
+    bool normalContext = data.context().isNormal();
+
+    PoseIndex contextIndex;
+    PoseIndex &poses = normalContext ? index : contextIndex;
+
+    if (posesDirty || !normalContext)
+    {
+        QuatArray values;
+        std::vector<unsigned> ids;
+
+        readPoses(data, pose_attr, values, ids);
+        poses.build(values.view(), ids.data(), ids.size());
+
+        timer.cacheMiss();
+
+        if (normalContext)
+            posesDirty = false;
+    } else {
+        timer.cacheHit();
+    }
+
+    double q[4];
+    inputQuat_attr.inputValue(data, q);
+
+    size_t k = (size_t) std::max(data.inputValue(neighborCount_attr).asInt(), 1);
+    PoseKernel kernel = (PoseKernel) data.inputValue(kernel_attr).asShort();
+    double radius = data.inputValue(radius_attr).asAngle().asRadians();
+    bool normalize = data.inputValue(normalize_attr).asBool();
+
+    std::vector<unsigned> nearest(k);
+    std::vector<double> angle(k);
+    std::vector<double> weight(k);
+
+    unsigned found = (unsigned) poses.nearest(q, k, nearest.data(), angle.data());
+    timer.setElements(poses.lastDistanceCount());
+
+    poseWeights(angle.data(), found, radius, kernel, normalize, weight.data());
+
+    std::vector<int> nearestIndex(nearest.begin(), nearest.begin() + found);
+
+    MStatus status;
+
+    status = outputIntArrayValue(data, nearestIndex.data(), found, nearestPose_attr);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    status = outputAngleArrayValue(data, angle.data(), found, nearestAngle_attr);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    status = outputDoubleArrayValue(data, weight.data(), found, nearestWeight_attr);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    data.setClean(nearestPose_attr);
+    data.setClean(nearestAngle_attr);
+    data.setClean(nearestWeight_attr);
+
+    return MStatus::kSuccess;
+}
@@ -0,0 +1,58 @@
+#ifndef QUAT_POSE_READER_H
+#define QUAT_POSE_READER_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include "core/poseIndex.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MDGContext.h>
+#include <maya/MPlug.h>
+#include <maya/MPlugArray.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+#include <maya/MTypes.h>
+
+#if MAYA_API_VERSION >= 201600
+#include <maya/MEvaluationNode.h>
+#endif
+
+class QuatPoseReaderNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatPoseReaderNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    virtual MStatus         setDependentsDirty(const MPlug& plug, MPlugArray& affectedPlugs);
+#if MAYA_API_VERSION >= 201600
+    virtual MStatus         preEvaluation(const MDGContext& context, const MEvaluationNode& evaluationNode);
+#endif
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    inputQuat_attr;
+    static QuatAttribute    pose_attr;
+
+    static MObject          neighborCount_attr;
+    static MObject          kernel_attr;
+    static MObject          radius_attr;
+    static MObject          normalize_attr;
+
+    static MObject          nearestPose_attr;
+    static MObject          nearestAngle_attr;
+    static MObject          nearestWeight_attr;
+
+private:
+    // Index of the pose array, rebuilt when any pose is dirtied. Valid
+    // unless posesDirty is set.
+    bool                    posesDirty;
+    quatExtras::PoseIndex   index;
+};
+
+#endif
@@ -0,0 +1,131 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatPower node
+    Scales many rotations in a single evaluation: each output turns about
+    the same axis as its input, power * weight times as far. Replaces a
+    quatToAxisAngle, multiply and axisAngleToQuat chain per value.
+
+    inputQuat   (iq)
+        Rotations to scale.
+
+    power       (pw)
+        Factor shared by every element. 0 gives the identity, 1 the input
+        and -1 its inverse. Defaults to 1.
+
+    weight      (w)
+        Factor for each element, multiplied with power. Missing elements
+        default to 1.
+
+    outputQuat  (oq)
+        One quaternion per logical index of inputQuat.
+
+    Rotations are scaled the shorter way round, as if the angle were
+    between 0 and 180 degrees. Small rotations keep their full precision;
+    see core/quatMath.h.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatPower.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnNumericData.h>
+#include <maya/MPlug.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+QuatAttribute QuatPowerNode::inputQuat_attr;
+MObject QuatPowerNode::power_attr;
+MObject QuatPowerNode::weight_attr;
+
+QuatAttribute QuatPowerNode::outputQuat_attr;
+
+QuatPowerNode::QuatPowerNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* QuatPowerNode::creator()
+{
+    return new QuatPowerNode();
+}
+
+MStatus QuatPowerNode::initialize()
+{
+    MStatus status;
+
+    MFnNumericAttribute n;
+
+    const char *const inputQuatNames[] = { "iqx", "iqy", "iqz", "iqw" };
+    status = inputQuat_attr.create("inputQuat", "iq", inputQuatNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    power_attr = n.create("power", "pw", MFnNumericData::kDouble, 1.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+
+    weight_attr = n.create("weight", "w", MFnNumericData::kDouble, 1.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setArray(true);
+
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(inputQuat_attr);
+    addAttribute(power_attr);
+    addAttribute(weight_attr);
+    addAttribute(outputQuat_attr);
+
+    attributeAffects(inputQuat_attr, outputQuat_attr);
+    attributeAffects(power_attr, outputQuat_attr);
+    attributeAffects(weight_attr, outputQuat_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatPowerNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputQuat_attr))
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    MArrayDataHandle inputHandle = data.inputArrayValue(inputQuat_attr);
+    MArrayDataHandle weightHandle = data.inputArrayValue(weight_attr);
+
+    unsigned count = logicalLength(inputHandle);
+    timer.setElements(count);
+
+    QuatArray quats;
+    quats.resize(count);
+
+    QuatArrayView quatView = quats.view();
+
+    inputQuat_attr.inputArrayValue(inputHandle, quatView, count);
+
+    std::vector<double> power(count, 1.0);
+    inputDoubleArrayValue(weightHandle, power.data(), count);
+
+    double sharedPower = data.inputValue(power_attr).asDouble();
+
+    for (unsigned i = 0; i < count; i++)
+        power[i] *= sharedPower;
+
+    quatPowerBatch(quatView, power.data(), quatView, count);
+
+    return outputQuat_attr.outputArrayValue(data, quatView, count);
+}
@@ -0,0 +1,33 @@
+#ifndef QUAT_POWER_H
+#define QUAT_POWER_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+class QuatPowerNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatPowerNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    inputQuat_attr;
+    static MObject          power_attr;
+    static MObject          weight_attr;
+
+    static QuatAttribute    outputQuat_attr;
+};
+
+#endif
@@ -20,43 +20,65 @@ You may use, distribute, or modify this code under the terms of the MIT license.
         Number of complete revolutions around the axis. If spin is negative, 
         the interpolation will take the "long" path on the quaternion sphere.
 
+    interpolationMode  (im)
+        How the interpolation weights are computed.
+            exact   Spherical linear interpolation (default).
+            nlerp   Normalized linear interpolation. Cheapest; exact at the
+                    ends and the middle of the blend but not constant speed,
+                    drifting by up to 8 degrees when the inputs are 180
+                    degrees apart.
+            fast    Polynomial approximation of slerp, within 0.001 degrees
+                    of exact.
+        Elements with a non-zero spin always use exact.
+
     outputQuat  (oq)
         Interpolated quaternion rotation.
 
+    The node keeps the endpoints and the angle between them until
+    input1Quat, input2Quat or spin is dirtied, so an evaluation where only
+    tween or interpolationMode changed costs a single sin/cos pair.
+    quatExtrasStats counts the evaluations that reused the endpoints as
+    cache hits, and those that read them again as misses. Unlike
+    quatSlerpArray it evaluates one slerp at a time, taking the sin, cos and
+    atan2 from the plugin's math backend (see MathBackend in
+    core/quatBatch.h); every backend agrees with the batch kernels to within
+    1e-15 per component, or more loosely with a spin and endpoints close
+    together.
+
 -----------------------------------------------------------------------------*/
 
 
 #include "quatSlerp.h"
 #include "nodeUtils.h"
 
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+#include "core/quatMath.h"
+
 #include <maya/MDataHandle.h>
 #include <maya/MDataBlock.h>
-#include <maya/MFnCompoundAttribute.h>
+#include <maya/MFnEnumAttribute.h>
 #include <maya/MFnNumericAttribute.h>
 #include <maya/MFnNumericData.h>
 #include <maya/MPlug.h>
-#include <maya/MQuaternion.h>
 
-MObject QuatSlerpNode::input1Quat_attr;
-    MObject QuatSlerpNode::input1QuatX_attr;
-    MObject QuatSlerpNode::input1QuatY_attr;
-    MObject QuatSlerpNode::input1QuatZ_attr;
-    MObject QuatSlerpNode::input1QuatW_attr;
+using namespace quatExtras;
 
-MObject QuatSlerpNode::input2Quat_attr;
-    MObject QuatSlerpNode::input2QuatX_attr;
-    MObject QuatSlerpNode::input2QuatY_attr;
-    MObject QuatSlerpNode::input2QuatZ_attr;
-    MObject QuatSlerpNode::input2QuatW_attr;
+QuatAttribute QuatSlerpNode::input1Quat_attr;
+QuatAttribute QuatSlerpNode::input2Quat_attr;
 
 MObject QuatSlerpNode::interpolationValue_attr;
 MObject QuatSlerpNode::spin_attr;
+MObject QuatSlerpNode::interpolationMode_attr;
+
+QuatAttribute QuatSlerpNode::outputQuat_attr;
 
-MObject QuatSlerpNode::outputQuat_attr;
-    MObject QuatSlerpNode::outputQuatX_attr;
-    MObject QuatSlerpNode::outputQuatY_attr;
-    MObject QuatSlerpNode::outputQuatZ_attr;
-    MObject QuatSlerpNode::outputQuatW_attr;
+
+QuatSlerpNode::QuatSlerpNode() :
+    ProfiledNode(NODE_NAME),
+    endpointsDirty(true)
+{
+}
 
 void* QuatSlerpNode::creator()
 {
@@ -68,44 +90,16 @@ MStatus QuatSlerpNode::initialize()
 {
     MStatus status;
 
-    MFnCompoundAttribute c;
+    MFnEnumAttribute e;
     MFnNumericAttribute n;
 
-    input1QuatX_attr = n.create("input1QuatX", "i1x", MFnNumericData::kDouble, 0.0, &status);
-    MAKE_INPUT(n)
-
-    input1QuatY_attr = n.create("input1QuatY", "i1y", MFnNumericData::kDouble, 0.0, &status);
-    MAKE_INPUT(n);
-
-    input1QuatZ_attr = n.create("input1QuatZ", "i1z", MFnNumericData::kDouble, 0.0, &status); 
-    MAKE_INPUT(n);
-
-    input1QuatW_attr = n.create("input1QuatW", "i1w", MFnNumericData::kDouble, 1.0, &status);
-    MAKE_INPUT(n);
-
-    input1Quat_attr = c.create("input1Quat", "i1q", &status);
-    c.addChild(input1QuatX_attr);
-    c.addChild(input1QuatY_attr);
-    c.addChild(input1QuatZ_attr);
-    c.addChild(input1QuatW_attr);
-
-    input2QuatX_attr = n.create("input2QuatX", "i2x", MFnNumericData::kDouble, 0.0, &status);
-    MAKE_INPUT(n);
+    const char *const input1QuatNames[] = { "i1x", "i1y", "i1z", "i1w" };
+    status = input1Quat_attr.create("input1Quat", "i1q", input1QuatNames, kIdentityQuatDefaults, kCompoundInput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
-    input2QuatY_attr = n.create("input2QuatY", "i2y", MFnNumericData::kDouble, 0.0, &status);
-    MAKE_INPUT(n);
-
-    input2QuatZ_attr = n.create("input2QuatZ", "i2z", MFnNumericData::kDouble, 0.0, &status);
-    MAKE_INPUT(n);
-
-    input2QuatW_attr = n.create("input2QuatW", "i2w", MFnNumericData::kDouble, 1.0, &status);
-    MAKE_INPUT(n);
-
-    input2Quat_attr = c.create("input2Quat", "i2q", &status);
-    c.addChild(input2QuatX_attr);
-    c.addChild(input2QuatY_attr);
-    c.addChild(input2QuatZ_attr);
-    c.addChild(input2QuatW_attr);
+    const char *const input2QuatNames[] = { "i2x", "i2y", "i2z", "i2w" };
+    status = input2Quat_attr.create("input2Quat", "i2q", input2QuatNames, kIdentityQuatDefaults, kCompoundInput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
     interpolationValue_attr = n.create("tween", "t", MFnNumericData::kDouble, 0.0, &status);
     MAKE_INPUT(n);
@@ -115,28 +109,21 @@ MStatus QuatSlerpNode::initialize()
     spin_attr = n.create("spin", "s", MFnNumericData::kShort, 0.0, &status);
     MAKE_INPUT(n);
 
-    outputQuatX_attr = n.create("outputQuatX", "oqx", MFnNumericData::kDouble, 0.0, &status);
-    MAKE_OUTPUT(n);
-
-    outputQuatY_attr = n.create("outputQuatY", "oqy", MFnNumericData::kDouble, 0.0, &status);
-    MAKE_OUTPUT(n);
+    interpolationMode_attr = e.create("interpolationMode", "im", kSlerpExact, &status);
+    MAKE_INPUT(e);
+    e.addField("exact", kSlerpExact);
+    e.addField("nlerp", kSlerpNlerp);
+    e.addField("fast", kSlerpFast);
 
-    outputQuatZ_attr = n.create("outputQuatZ", "oqz", MFnNumericData::kDouble, 0.0, &status);
-    MAKE_OUTPUT(n);
-
-    outputQuatW_attr = n.create("outputQuatW", "oqw", MFnNumericData::kDouble, 1.0, &status);
-    MAKE_OUTPUT(n);
-
-    outputQuat_attr = c.create("outputQuat", "oq", &status);
-    c.addChild(outputQuatX_attr);
-    c.addChild(outputQuatY_attr);
-    c.addChild(outputQuatZ_attr);
-    c.addChild(outputQuatW_attr);
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
     addAttribute(input1Quat_attr);
     addAttribute(input2Quat_attr);
     addAttribute(interpolationValue_attr);
     addAttribute(spin_attr);
+    addAttribute(interpolationMode_attr);
 
     addAttribute(outputQuat_attr);
 
@@ -144,11 +131,42 @@ MStatus QuatSlerpNode::initialize()
     attributeAffects(input2Quat_attr, outputQuat_attr);
     attributeAffects(interpolationValue_attr, outputQuat_attr);
     attributeAffects(spin_attr, outputQuat_attr);
+    attributeAffects(interpolationMode_attr, outputQuat_attr);
 
     return MStatus::kSuccess;
 }
 
 
+MStatus QuatSlerpNode::setDependentsDirty(const MPlug& plug, MPlugArray& affectedPlugs)
+{
+    MObject attr = plug.attribute();
+
+    if (input1Quat_attr.owns(attr) || input2Quat_attr.owns(attr) || attr == spin_attr)
+        endpointsDirty = true;
+
+    return MPxNode::setDependentsDirty(plug, affectedPlugs);
+}
+
+
+#if MAYA_API_VERSION >= 201600
+/*
+    The evaluation manager does not call setDependentsDirty, so check the
+    endpoints against its dirty plugs before each evaluation instead.
+*/
+MStatus QuatSlerpNode::preEvaluation(const MDGContext& context, const MEvaluationNode& evaluationNode)
+{
+    if (context.isNormal() && !endpointsDirty)
+    {
+        endpointsDirty = input1Quat_attr.dirtyPlugExists(evaluationNode) ||
+                         input2Quat_attr.dirtyPlugExists(evaluationNode) ||
+                         evaluationNode.dirtyPlugExists(spin_attr);
+    }
+
+    return MPxNode::preEvaluation(context, evaluationNode);
+}
+#endif
+
+
 MStatus QuatSlerpNode::compute(const MPlug& plug, MDataBlock& data)
 {
     if (plug != outputQuat_attr && plug.parent() != outputQuat_attr)
@@ -156,38 +174,52 @@ MStatus QuatSlerpNode::compute(const MPlug& plug, MDataBlock& data)
         return MStatus::kUnknownParameter;
     }
 
-    MQuaternion p = inputQuaternionValue(
-        data,
-        input1Quat_attr,
-        input1QuatX_attr,
-        input1QuatY_attr,
-        input1QuatZ_attr,
-        input1QuatW_attr 
-    );
-
-    MQuaternion q = inputQuaternionValue(
-        data,
-        input2Quat_attr,
-        input2QuatX_attr,
-        input2QuatY_attr,
-        input2QuatZ_attr,
-        input2QuatW_attr 
-    );
+    ComputeTimer timer(statsType, &instanceStats);
+    timer.setElements(1);
+
+    // The cache only describes the normal context; evaluations in any
+    // other context read the endpoints into locals and leave it alone.
+    bool normalContext = data.context().isNormal();
+
+    double contextP[4], contextQ[4];
+    SlerpSetup contextSetup;
+
+    double *p = normalContext ? cachedP : contextP;
+    double *q = normalContext ? cachedQ : contextQ;
+    SlerpSetup &setup = normalContext ? cachedSetup : contextSetup;
+
+    if (endpointsDirty || !normalContext)
+    {
+        input1Quat_attr.inputValue(data, p);
+        input2Quat_attr.inputValue(data, q);
+
+        short s = data.inputValue(spin_attr).asShort();
+
+        setup = slerpSetup(p, q, s, defaultMathBackend());
+
+        timer.cacheMiss();
+
+        if (normalContext)
+            endpointsDirty = false;
+    } else {
+        timer.cacheHit();
+    }
 
     double t = data.inputValue(interpolationValue_attr).asDouble();
-    short s = data.inputValue(spin_attr).asShort();
-
-    MQuaternion output = slerp(p, q, t, s);
-
-    outputQuaternionValue(
-        data,
-        output,
-        outputQuat_attr,
-        outputQuatX_attr,
-        outputQuatY_attr,
-        outputQuatZ_attr,
-        outputQuatW_attr
-    );
+    SlerpMode mode = (SlerpMode) data.inputValue(interpolationMode_attr).asShort();
+
+    double a, b;
+    slerpWeights(setup, t, mode, defaultMathBackend(), a, b);
+
+    double output[4] = {
+        a * p[0] + b * q[0],
+        a * p[1] + b * q[1],
+        a * p[2] + b * q[2],
+        a * p[3] + b * q[3]
+    };
+
+    MStatus status = outputQuat_attr.outputValue(data, output);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
     return MStatus::kSuccess;   
 }
\ No newline at end of file
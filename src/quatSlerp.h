@@ -1,16 +1,34 @@
 #ifndef QUAT_SLERP_H
 #define QUAT_SLERP_H
 
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include "core/quatMath.h"
+
 #include <maya/MDataBlock.h>
+#include <maya/MDGContext.h>
 #include <maya/MPlug.h>
+#include <maya/MPlugArray.h>
 #include <maya/MPxNode.h>
 #include <maya/MString.h>
 #include <maya/MTypeId.h>
+#include <maya/MTypes.h>
+
+#if MAYA_API_VERSION >= 201600
+#include <maya/MEvaluationNode.h>
+#endif
 
-class QuatSlerpNode : public MPxNode
+class QuatSlerpNode : public MPxNode, public ProfiledNode
 {
 public:
+                            QuatSlerpNode();
+
     virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    virtual MStatus         setDependentsDirty(const MPlug& plug, MPlugArray& affectedPlugs);
+#if MAYA_API_VERSION >= 201600
+    virtual MStatus         preEvaluation(const MDGContext& context, const MEvaluationNode& evaluationNode);
+#endif
     static  void*           creator();
     static  MStatus         initialize();
 
@@ -18,26 +36,22 @@ public:
     static MTypeId          NODE_ID;
     static MString          NODE_NAME;
 
-    static MObject          input1Quat_attr;
-        static MObject          input1QuatX_attr;
-        static MObject          input1QuatY_attr;
-        static MObject          input1QuatZ_attr;
-        static MObject          input1QuatW_attr;
-
-    static MObject          input2Quat_attr;
-        static MObject          input2QuatX_attr;
-        static MObject          input2QuatY_attr;
-        static MObject          input2QuatZ_attr;
-        static MObject          input2QuatW_attr;
+    static QuatAttribute    input1Quat_attr;
+    static QuatAttribute    input2Quat_attr;
 
     static MObject          interpolationValue_attr;
     static MObject          spin_attr;
+    static MObject          interpolationMode_attr;
+
+    static QuatAttribute    outputQuat_attr;
 
-    static MObject          outputQuat_attr;
-        static MObject          outputQuatX_attr;
-        static MObject          outputQuatY_attr;
-        static MObject          outputQuatZ_attr;
-        static MObject          outputQuatW_attr;
+private:
+    // Endpoints and everything slerp derives from them, kept while only the
+    // tween changes. Valid unless endpointsDirty is set.
+    bool                    endpointsDirty;
+    double                  cachedP[4];
+    double                  cachedQ[4];
+    quatExtras::SlerpSetup  cachedSetup;
 };
 
 #endif
\ No newline at end of file
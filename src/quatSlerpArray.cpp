@@ -0,0 +1,244 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatSlerpArray node
+    Computes the spherical linear interpolation of many pairs of quaternions
+    in a single evaluation. Element i of each input array drives element i
+    of the output; missing elements use the attribute defaults.
+
+    input1Quat  (i1q)
+        Quaternions to rotate from.
+
+    input2Quat  (i2q)
+        Quaternions to rotate to.
+
+    input1QuatData  (i1qd)
+    input2QuatData  (i2qd)
+        The same as quatArrayData. Either, when it holds quaternions, is
+        read in place of its compound, with no per-element copy in double
+        precision.
+
+    tween       (t)
+        Percent of the interpolation between the two inputs.
+
+    spin        (s)
+        Number of complete revolutions around the axis. If spin is negative,
+        the interpolation will take the "long" path on the quaternion sphere.
+
+    interpolationMode  (im)
+        How the interpolation weights are computed.
+            exact   Spherical linear interpolation (default).
+            nlerp   Normalized linear interpolation. Cheapest; exact at the
+                    ends and the middle of the blend but not constant speed,
+                    drifting by up to 8 degrees when the inputs are 180
+                    degrees apart.
+            fast    Polynomial approximation of slerp, within 0.001 degrees
+                    of exact.
+        Elements with a non-zero spin always use exact.
+
+    precision  (pr)
+        Component type the interpolation is computed in.
+            default Follows the plugin-wide setting, double unless the
+                    QUATEXTRAS_PRECISION environment variable is "float".
+            double  Full precision.
+            float   Twice as many elements per instruction, within 3.1e-7
+                    of double per component. With a spin the error grows
+                    as the inputs get closer; see quatBatch.h.
+
+    outputQuat  (oq)
+        Interpolated quaternion rotations. Has one element per logical index
+        of input1Quat/input2Quat, whichever is longer.
+
+    outputQuatData  (oqd)
+        The same as quatArrayData, computed only when it is requested.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatSlerpArray.h"
+#include "quatArrayData.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnEnumAttribute.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnNumericData.h>
+#include <maya/MPlug.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace quatExtras;
+
+QuatAttribute QuatSlerpArrayNode::input1Quat_attr;
+QuatAttribute QuatSlerpArrayNode::input2Quat_attr;
+MObject QuatSlerpArrayNode::input1QuatData_attr;
+MObject QuatSlerpArrayNode::input2QuatData_attr;
+
+MObject QuatSlerpArrayNode::interpolationValue_attr;
+MObject QuatSlerpArrayNode::spin_attr;
+MObject QuatSlerpArrayNode::interpolationMode_attr;
+MObject QuatSlerpArrayNode::precision_attr;
+
+QuatAttribute QuatSlerpArrayNode::outputQuat_attr;
+MObject QuatSlerpArrayNode::outputQuatData_attr;
+
+QuatSlerpArrayNode::QuatSlerpArrayNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* QuatSlerpArrayNode::creator()
+{
+    return new QuatSlerpArrayNode();
+}
+
+
+MStatus QuatSlerpArrayNode::initialize()
+{
+    MStatus status;
+
+    MFnEnumAttribute e;
+    MFnNumericAttribute n;
+
+    const char *const input1QuatNames[] = { "i1x", "i1y", "i1z", "i1w" };
+    status = input1Quat_attr.create("input1Quat", "i1q", input1QuatNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const input2QuatNames[] = { "i2x", "i2y", "i2z", "i2w" };
+    status = input2Quat_attr.create("input2Quat", "i2q", input2QuatNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    input1QuatData_attr = createQuatArrayDataAttribute("input1QuatData", "i1qd", false, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    input2QuatData_attr = createQuatArrayDataAttribute("input2QuatData", "i2qd", false, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    interpolationValue_attr = n.create("tween", "t", MFnNumericData::kDouble, 0.0, &status);
+    MAKE_INPUT(n);
+    n.setMin(0.0);
+    n.setMax(1.0);
+    n.setArray(true);
+
+    spin_attr = n.create("spin", "s", MFnNumericData::kShort, 0.0, &status);
+    MAKE_INPUT(n);
+    n.setArray(true);
+
+    interpolationMode_attr = e.create("interpolationMode", "im", kSlerpExact, &status);
+    MAKE_INPUT(e);
+    e.addField("exact", kSlerpExact);
+    e.addField("nlerp", kSlerpNlerp);
+    e.addField("fast", kSlerpFast);
+
+    precision_attr = createPrecisionAttribute(&status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    outputQuatData_attr = createQuatArrayDataAttribute("outputQuatData", "oqd", true, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(input1Quat_attr);
+    addAttribute(input2Quat_attr);
+    addAttribute(input1QuatData_attr);
+    addAttribute(input2QuatData_attr);
+    addAttribute(interpolationValue_attr);
+    addAttribute(spin_attr);
+    addAttribute(interpolationMode_attr);
+    addAttribute(precision_attr);
+
+    addAttribute(outputQuat_attr);
+    addAttribute(outputQuatData_attr);
+
+    attributeAffects(input1Quat_attr, outputQuat_attr);
+    attributeAffects(input2Quat_attr, outputQuat_attr);
+    attributeAffects(input1QuatData_attr, outputQuat_attr);
+    attributeAffects(input2QuatData_attr, outputQuat_attr);
+    attributeAffects(interpolationValue_attr, outputQuat_attr);
+    attributeAffects(spin_attr, outputQuat_attr);
+    attributeAffects(interpolationMode_attr, outputQuat_attr);
+    attributeAffects(precision_attr, outputQuat_attr);
+
+    attributeAffects(input1Quat_attr, outputQuatData_attr);
+    attributeAffects(input2Quat_attr, outputQuatData_attr);
+    attributeAffects(input1QuatData_attr, outputQuatData_attr);
+    attributeAffects(input2QuatData_attr, outputQuatData_attr);
+    attributeAffects(interpolationValue_attr, outputQuatData_attr);
+    attributeAffects(spin_attr, outputQuatData_attr);
+    attributeAffects(interpolationMode_attr, outputQuatData_attr);
+    attributeAffects(precision_attr, outputQuatData_attr);
+
+    return MStatus::kSuccess;
+}
+
+
+namespace
+{
+    /*
+        Reads the quaternions and tweens into T buffers, runs the T kernel and
+        writes the result; T is double or float. In double, data inputs are
+        read in place.
+    */
+    template <class T>
+    MStatus computeSlerp(
+        MDataBlock &data,
+        QuatArrayInput &input1,
+        QuatArrayInput &input2,
+        MArrayDataHandle &tweenHandle,
+        const short *spin,
+        SlerpMode mode,
+        QuatArrayOutput &output,
+        unsigned count
+    ) {
+        std::vector<T> tween(count, T(0));
+        inputDoubleArrayValue(tweenHandle, tween.data(), count);
+
+        ConstQuatArrayViewT<T> p = input1.viewAs<T>(count);
+        ConstQuatArrayViewT<T> q = input2.viewAs<T>(count);
+
+        slerpBatch(p, q, tween.data(), spin, output.allocateAs<T>(count), count, mode);
+
+        return output.write(data);
+    }
+}
+
+
+MStatus QuatSlerpArrayNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputQuat_attr) && !isPlugFor(plug, outputQuatData_attr))
+    {
+        return MStatus::kUnknownParameter;
+    }
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    QuatArrayInput input1(data, input1Quat_attr, input1QuatData_attr);
+    QuatArrayInput input2(data, input2Quat_attr, input2QuatData_attr);
+    QuatArrayOutput output(plug, outputQuat_attr, outputQuatData_attr);
+
+    MArrayDataHandle tweenHandle = data.inputArrayValue(interpolationValue_attr);
+    MArrayDataHandle spinHandle = data.inputArrayValue(spin_attr);
+
+    unsigned count = std::max(input1.length(), input2.length());
+    timer.setElements(count);
+
+    std::vector<short> spin(count, 0);
+    inputShortArrayValue(spinHandle, spin.data(), count);
+
+    SlerpMode mode = (SlerpMode) data.inputValue(interpolationMode_attr).asShort();
+
+    if (precisionValue(data, precision_attr) == kPrecisionFloat)
+        return computeSlerp<float>(data, input1, input2, tweenHandle, spin.data(), mode, output, count);
+
+    return computeSlerp<double>(data, input1, input2, tweenHandle, spin.data(), mode, output, count);
+}
@@ -0,0 +1,40 @@
+#ifndef QUAT_SLERP_ARRAY_H
+#define QUAT_SLERP_ARRAY_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+class QuatSlerpArrayNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatSlerpArrayNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    input1Quat_attr;
+    static QuatAttribute    input2Quat_attr;
+    static MObject          input1QuatData_attr;
+    static MObject          input2QuatData_attr;
+
+    static MObject          interpolationValue_attr;
+    static MObject          spin_attr;
+    static MObject          interpolationMode_attr;
+    static MObject          precision_attr;
+
+    static QuatAttribute    outputQuat_attr;
+    static MObject          outputQuatData_attr;
+};
+
+#endif
@@ -0,0 +1,204 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatSpline node
+    Smoothly interpolates through a sequence of key quaternions with SQUAD,
+    evaluating any number of sample parameters at once. The rotation and
+    its angular velocity are continuous through every key, even when the
+    keys are unevenly spaced.
+
+    keyQuat     (kq)
+        Key quaternions. The spline passes through every key.
+
+    keyParameter (kp)
+        Parameter of each key. Missing elements default to their index, so
+        unset keys are spaced one unit apart. Keys are sorted by parameter.
+
+    parameter   (p)
+        Parameters to evaluate the spline at. Values outside the key range
+        hold the first or last key.
+
+    outputQuat  (oq)
+        Interpolated quaternion rotations, one per logical index of
+        parameter. With no keys the output is the identity.
+
+    The control points are computed once per change to keyQuat or
+    keyParameter and reused while only parameter changes. See
+    core/quatSpline.h for the interpolation itself.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatSpline.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+#include "core/quatSpline.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnNumericData.h>
+#include <maya/MPlug.h>
+
+#include <cstddef>
+#include <vector>
+
+using namespace quatExtras;
+
+QuatAttribute QuatSplineNode::keyQuat_attr;
+
+MObject QuatSplineNode::keyParameter_attr;
+MObject QuatSplineNode::parameter_attr;
+
+QuatAttribute QuatSplineNode::outputQuat_attr;
+
+QuatSplineNode::QuatSplineNode() :
+    ProfiledNode(NODE_NAME),
+    keysDirty(true)
+{
+}
+
+void* QuatSplineNode::creator()
+{
+    return new QuatSplineNode();
+}
+
+
+MStatus QuatSplineNode::initialize()
+{
+    MStatus status;
+
+    MFnNumericAttribute n;
+
+    const char *const keyQuatNames[] = { "kqx", "kqy", "kqz", "kqw" };
+    status = keyQuat_attr.create("keyQuat", "kq", keyQuatNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    keyParameter_attr = n.create("keyParameter", "kp", MFnNumericData::kDouble, 0.0, &status);
+    MAKE_INPUT(n);
+    n.setArray(true);
+
+    parameter_attr = n.create("parameter", "p", MFnNumericData::kDouble, 0.0, &status);
+    MAKE_INPUT(n);
+    n.setArray(true);
+
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(keyQuat_attr);
+    addAttribute(keyParameter_attr);
+    addAttribute(parameter_attr);
+    addAttribute(outputQuat_attr);
+
+    attributeAffects(keyQuat_attr, outputQuat_attr);
+    attributeAffects(keyParameter_attr, outputQuat_attr);
+    attributeAffects(parameter_attr, outputQuat_attr);
+
+    return MStatus::kSuccess;
+}
+
+
+MStatus QuatSplineNode::setDependentsDirty(const MPlug& plug, MPlugArray& affectedPlugs)
+{
+    MObject attr = plug.attribute();
+
+    if (keyQuat_attr.owns(attr) || attr == keyParameter_attr)
+        keysDirty = true;
+
+    return MPxNode::setDependentsDirty(plug, affectedPlugs);
+}
+
+
+#if MAYA_API_VERSION >= 201600
+/*
+    The evaluation manager does not call setDependentsDirty, so check the
+    keys against its dirty plugs before each evaluation instead.
+*/
+MStatus QuatSplineNode::preEvaluation(const MDGContext& context, const MEvaluationNode& evaluationNode)
+{
+    if (context.isNormal() && !keysDirty)
+    {
+        keysDirty = keyQuat_attr.dirtyPlugExists(evaluationNode) ||
+                    evaluationNode.dirtyPlugExists(keyParameter_attr);
+    }
+
+    return MPxNode::preEvaluation(context, evaluationNode);
+}
+#endif
+
+
+void QuatSplineNode::readKeys(MDataBlock& data, QuatSpline &spline)
+{
+    MArrayDataHandle keyHandle = data.inputArrayValue(keyQuat_attr);
+    MArrayDataHandle keyParameterHandle = data.inputArrayValue(keyParameter_attr);
+
+    unsigned count = logicalLength(keyHandle);
+
+    QuatArray keys;
+    keys.resize(count);
+
+    QuatArrayView keyView = keys.view();
+
+    keyQuat_attr.inputArrayValue(keyHandle, keyView, count);
+
+    std::vector<double> keyParameters(count);
+
+    for (unsigned i = 0; i < count; i++)
+        keyParameters[i] = (double) i;
+
+    inputDoubleArrayValue(keyParameterHandle, keyParameters.data(), count);
+
+    spline.setKeys(keys.view(), keyParameters.data(), count);
+}
+
+
+MStatus QuatSplineNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputQuat_attr))
+    {
+        return MStatus::kUnknownParameter;
+    }
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    // The cache only describes the normal context; evaluations in any
+    // other context build a spline of their own.
+    bool normalContext = data.context().isNormal();
+
+    QuatSpline contextSpline;
+    QuatSpline &spline = normalContext ? cachedSpline : contextSpline;
+
+    if (keysDirty || !normalContext)
+    {
+        readKeys(data, spline);
+        timer.cacheMiss();
+
+        if (normalContext)
+            keysDirty = false;
+    } else {
+        timer.cacheHit();
+    }
+
+    MArrayDataHandle parameterHandle = data.inputArrayValue(parameter_attr);
+
+    unsigned count = logicalLength(parameterHandle);
+    timer.setElements(count);
+
+    std::vector<double> parameters(count, 0.0);
+    inputDoubleArrayValue(parameterHandle, parameters.data(), count);
+
+    QuatArray output;
+    output.resize(count);
+
+    QuatArrayView outputView = output.view();
+
+    spline.evaluate(parameters.data(), outputView, count);
+
+    return outputQuat_attr.outputArrayValue(data, outputView, count);
+}
@@ -0,0 +1,54 @@
+#ifndef QUAT_SPLINE_H
+#define QUAT_SPLINE_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include "core/quatSpline.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MDGContext.h>
+#include <maya/MPlug.h>
+#include <maya/MPlugArray.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+#include <maya/MTypes.h>
+
+#if MAYA_API_VERSION >= 201600
+#include <maya/MEvaluationNode.h>
+#endif
+
+class QuatSplineNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatSplineNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    virtual MStatus         setDependentsDirty(const MPlug& plug, MPlugArray& affectedPlugs);
+#if MAYA_API_VERSION >= 201600
+    virtual MStatus         preEvaluation(const MDGContext& context, const MEvaluationNode& evaluationNode);
+#endif
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    keyQuat_attr;
+
+    static MObject          keyParameter_attr;
+    static MObject          parameter_attr;
+
+    static QuatAttribute    outputQuat_attr;
+
+private:
+    void                    readKeys(MDataBlock& data, quatExtras::QuatSpline &spline);
+
+    // Keys and their control points, kept until a key is dirtied.
+    bool                    keysDirty;
+    quatExtras::QuatSpline  cachedSpline;
+};
+
+#endif
@@ -0,0 +1,253 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatSpring node
+    Damped springs that pull rotations towards target rotations over time,
+    for jiggle and overlapping action on many joints in one node.
+
+    inputQuat   (iq)
+        Target rotations, one spring per logical index.
+
+    inputQuatData (iqd)
+        The same as quatArrayData, read in place of inputQuat when it holds
+        quaternions.
+
+    time        (tm)
+        Time of the evaluation, usually connected from time1.outTime.
+
+    startFrame  (sf)
+        Frame at which, and before which, every spring is at rest on its
+        target. Defaults to 1.
+
+    stiffness   (st)
+        Angular acceleration towards the target per radian away from it,
+        per second squared. Defaults to 100, which swings back and forth
+        about 1.6 times a second when undamped.
+
+    damping     (dmp)
+        Angular acceleration against the angular velocity per radian per
+        second, per second. Defaults to 20, critical damping for the
+        default stiffness (2 * sqrt(stiffness)); less overshoots.
+
+    substeps    (ss)
+        Integration steps per frame. Defaults to 4. The springs are stable
+        while sqrt(stiffness) * seconds per substep stays below 2.
+
+    maxFrameStep (mfs)
+        Most frames integrated by one evaluation. Defaults to 100. A longer
+        step forward, such as a jump far ahead, integrates only its last
+        maxFrameStep frames, so the work per evaluation stays bounded at
+        maxFrameStep * substeps substeps.
+
+    outputQuat  (oq)
+        The rotation of each spring.
+
+    outputQuatData (oqd)
+        The same as quatArrayData, computed only when it is requested.
+
+    The springs keep their rotations and angular velocities from one
+    evaluation to the next, and are integrated in the tangent space of
+    their rotations with a fixed number of substeps per frame, so playing
+    forward from startFrame always gives the same result. See
+    core/quatSpring.h.
+
+    Going forward in time advances the springs towards the current
+    targets by the time elapsed, up to maxFrameStep frames, so a jump
+    forward is simulated as if the targets had held still. Going back,
+    and changing the number of elements, puts them at rest on their
+    targets again. Evaluating the same frame again gives the same
+    rotations, whatever the targets. Other
+    contexts, such as evaluations at other times, read the springs
+    without advancing them.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatSpring.h"
+#include "quatArrayData.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MDGContext.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnUnitAttribute.h>
+#include <maya/MPlug.h>
+#include <maya/MTime.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace quatExtras;
+
+QuatAttribute QuatSpringNode::inputQuat_attr;
+MObject QuatSpringNode::inputQuatData_attr;
+MObject QuatSpringNode::time_attr;
+MObject QuatSpringNode::startFrame_attr;
+MObject QuatSpringNode::stiffness_attr;
+MObject QuatSpringNode::damping_attr;
+MObject QuatSpringNode::substeps_attr;
+MObject QuatSpringNode::maxFrameStep_attr;
+
+QuatAttribute QuatSpringNode::outputQuat_attr;
+MObject QuatSpringNode::outputQuatData_attr;
+
+QuatSpringNode::QuatSpringNode() :
+    ProfiledNode(NODE_NAME),
+    lastFrame(0.0)
+{
+}
+
+void* QuatSpringNode::creator()
+{
+    return new QuatSpringNode();
+}
+
+MStatus QuatSpringNode::initialize()
+{
+    MStatus status;
+
+    MFnNumericAttribute n;
+    MFnUnitAttribute u;
+
+    const char *const inputQuatNames[] = { "iqx", "iqy", "iqz", "iqw" };
+    status = inputQuat_attr.create("inputQuat", "iq", inputQuatNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    inputQuatData_attr = createQuatArrayDataAttribute("inputQuatData", "iqd", false, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    time_attr = u.create("time", "tm", MFnUnitAttribute::kTime, 0.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(u);
+
+    startFrame_attr = n.create("startFrame", "sf", MFnNumericData::kDouble, 1.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+
+    stiffness_attr = n.create("stiffness", "st", MFnNumericData::kDouble, 100.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setMin(0.0);
+
+    damping_attr = n.create("damping", "dmp", MFnNumericData::kDouble, 20.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setMin(0.0);
+
+    substeps_attr = n.create("substeps", "ss", MFnNumericData::kInt, 4.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setMin(1);
+
+    maxFrameStep_attr = n.create("maxFrameStep", "mfs", MFnNumericData::kDouble, 100.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setMin(1.0);
+
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    outputQuatData_attr = createQuatArrayDataAttribute("outputQuatData", "oqd", true, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(inputQuat_attr);
+    addAttribute(inputQuatData_attr);
+    addAttribute(time_attr);
+    addAttribute(startFrame_attr);
+    addAttribute(stiffness_attr);
+    addAttribute(damping_attr);
+    addAttribute(substeps_attr);
+    addAttribute(maxFrameStep_attr);
+    addAttribute(outputQuat_attr);
+    addAttribute(outputQuatData_attr);
+
+    attributeAffects(inputQuat_attr, outputQuat_attr);
+    attributeAffects(inputQuatData_attr, outputQuat_attr);
+    attributeAffects(time_attr, outputQuat_attr);
+    attributeAffects(startFrame_attr, outputQuat_attr);
+    attributeAffects(stiffness_attr, outputQuat_attr);
+    attributeAffects(damping_attr, outputQuat_attr);
+    attributeAffects(substeps_attr, outputQuat_attr);
+    attributeAffects(maxFrameStep_attr, outputQuat_attr);
+
+    attributeAffects(inputQuat_attr, outputQuatData_attr);
+    attributeAffects(inputQuatData_attr, outputQuatData_attr);
+    attributeAffects(time_attr, outputQuatData_attr);
+    attributeAffects(startFrame_attr, outputQuatData_attr);
+    attributeAffects(stiffness_attr, outputQuatData_attr);
+    attributeAffects(damping_attr, outputQuatData_attr);
+    attributeAffects(substeps_attr, outputQuatData_attr);
+    attributeAffects(maxFrameStep_attr, outputQuatData_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatSpringNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputQuat_attr) && !isPlugFor(plug, outputQuatData_attr))
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    QuatArrayInput input(data, inputQuat_attr, inputQuatData_attr);
+    QuatArrayOutput output(plug, outputQuat_attr, outputQuatData_attr);
+
+    unsigned count = input.length();
+    timer.setElements(count);
+
+    ConstQuatArrayView target = input.view(count);
+    QuatArrayView outputView = output.allocate(count);
+
+    double frame = data.inputValue(time_attr).asTime().as(MTime::uiUnit());
+    double startFrame = data.inputValue(startFrame_attr).asDouble();
+    double stiffness = data.inputValue(stiffness_attr).asDouble();
+    double damping = data.inputValue(damping_attr).asDouble();
+    int substeps = std::max(data.inputValue(substeps_attr).asInt(), 1);
+    double maxFrameStep = std::max(data.inputValue(maxFrameStep_attr).asDouble(), 1.0);
+
+    double secondsPerFrame = MTime(1.0, MTime::uiUnit()).as(MTime::kSeconds);
+
+    bool normalContext = data.context().isNormal();
+
+    {
+        std::lock_guard<std::mutex> lock(springMutex);
+
+        if (normalContext)
+        {
+            if (spring.size() != count || frame <= startFrame || frame < lastFrame)
+            {
+                spring.reset(target, count);
+                timer.cacheMiss();
+            } else {
+                if (frame > lastFrame)
+                {
+                    double frames = std::min(frame - lastFrame, maxFrameStep);
+                    size_t steps = (size_t) std::max(std::lround(frames * substeps), 1L);
+
+                    spring.step(target, stiffness, damping, frames * secondsPerFrame / (double) steps, steps);
+                }
+
+                timer.cacheHit();
+            }
+
+            lastFrame = frame;
+        }
+
+        ConstQuatArrayView state = spring.size() == count ? spring.rotation() : target;
+
+        std::copy(state.x, state.x + count, outputView.x);
+        std::copy(state.y, state.y + count, outputView.y);
+        std::copy(state.z, state.z + count, outputView.z);
+        std::copy(state.w, state.w + count, outputView.w);
+    }
+
+    return output.write(data);
+}
@@ -0,0 +1,50 @@
+#ifndef QUAT_SPRING_H
+#define QUAT_SPRING_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include "core/quatSpring.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+#include <mutex>
+
+class QuatSpringNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatSpringNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    inputQuat_attr;
+    static MObject          inputQuatData_attr;
+    static MObject          time_attr;
+    static MObject          startFrame_attr;
+    static MObject          stiffness_attr;
+    static MObject          damping_attr;
+    static MObject          substeps_attr;
+    static MObject          maxFrameStep_attr;
+
+    static QuatAttribute    outputQuat_attr;
+    static MObject          outputQuatData_attr;
+
+private:
+    // The simulation, advanced only in the normal context; the mutex
+    // covers other contexts reading it from other threads.
+    quatExtras::QuatSpring  spring;
+    double                  lastFrame;
+    std::mutex              springMutex;
+};
+
+#endif
@@ -0,0 +1,141 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatSwingTwist node
+    Splits a quaternion into a twist about an axis and the swing that
+    remains, so that inputQuat = swing * twist.
+
+    inputQuat   (iq)
+        Quaternion to decompose.
+
+    twistAxis   (ta)
+        Axis to measure the twist about, usually the bone axis. Need not be
+        normalized. Defaults to X.
+
+    swing       (sw)
+        Rotation about an axis perpendicular to twistAxis.
+
+    twist       (tw)
+        Rotation about twistAxis.
+
+    twistAngle  (twa)
+        Angle of the twist, between -180 and 180 degrees.
+
+    When inputQuat turns 180 degrees about an axis perpendicular to
+    twistAxis, the twist is undefined and comes back as the identity.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatSwingTwist.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+
+#include <maya/MAngle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnUnitAttribute.h>
+#include <maya/MPlug.h>
+
+using namespace quatExtras;
+
+QuatAttribute QuatSwingTwistNode::inputQuat_attr;
+VectorAttribute QuatSwingTwistNode::twistAxis_attr;
+
+QuatAttribute QuatSwingTwistNode::outputSwing_attr;
+QuatAttribute QuatSwingTwistNode::outputTwist_attr;
+MObject QuatSwingTwistNode::outputTwistAngle_attr;
+
+QuatSwingTwistNode::QuatSwingTwistNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* QuatSwingTwistNode::creator()
+{
+    return new QuatSwingTwistNode();
+}
+
+MStatus QuatSwingTwistNode::initialize()
+{
+    MStatus status;
+
+    MFnUnitAttribute u;
+
+    const char *const inputQuatNames[] = { "iqx", "iqy", "iqz", "iqw" };
+    status = inputQuat_attr.create("inputQuat", "iq", inputQuatNames, kIdentityQuatDefaults, kCompoundInput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const twistAxisNames[] = { "tax", "tay", "taz" };
+    status = twistAxis_attr.create("twistAxis", "ta", twistAxisNames, kXAxisDefaults, kCompoundInput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const swingNames[] = { "swx", "swy", "swz", "sww" };
+    status = outputSwing_attr.create("swing", "sw", swingNames, kIdentityQuatDefaults, kCompoundOutput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const twistNames[] = { "twx", "twy", "twz", "tww" };
+    status = outputTwist_attr.create("twist", "tw", twistNames, kIdentityQuatDefaults, kCompoundOutput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    outputTwistAngle_attr = u.create("twistAngle", "twa", MFnUnitAttribute::kAngle, 0.0);
+    MAKE_OUTPUT(u);
+
+    addAttribute(inputQuat_attr);
+    addAttribute(twistAxis_attr);
+    addAttribute(outputSwing_attr);
+    addAttribute(outputTwist_attr);
+    addAttribute(outputTwistAngle_attr);
+
+    attributeAffects(inputQuat_attr, outputSwing_attr);
+    attributeAffects(inputQuat_attr, outputTwist_attr);
+    attributeAffects(inputQuat_attr, outputTwistAngle_attr);
+    attributeAffects(twistAxis_attr, outputSwing_attr);
+    attributeAffects(twistAxis_attr, outputTwist_attr);
+    attributeAffects(twistAxis_attr, outputTwistAngle_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatSwingTwistNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputSwing_attr) && !isPlugFor(plug, outputTwist_attr) && plug != outputTwistAngle_attr)
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+    timer.setElements(1);
+
+    double inputQuat[4];
+    inputQuat_attr.inputValue(data, inputQuat);
+
+    double axis[3];
+    twistAxis_attr.inputValue(data, axis);
+
+    double swing[4];
+    double twist[4];
+    double angle;
+
+    ConstQuatArrayView inputView = { &inputQuat[0], &inputQuat[1], &inputQuat[2], &inputQuat[3] };
+    ConstVectorArrayView axisView = { &axis[0], &axis[1], &axis[2] };
+    QuatArrayView swingView = { &swing[0], &swing[1], &swing[2], &swing[3] };
+    QuatArrayView twistView = { &twist[0], &twist[1], &twist[2], &twist[3] };
+
+    swingTwistBatch(inputView, axisView, swingView, twistView, &angle, 1);
+
+    MStatus status = outputSwing_attr.outputValue(data, swing);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    status = outputTwist_attr.outputValue(data, twist);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    MDataHandle angleHandle = data.outputValue(outputTwistAngle_attr);
+
+    angleHandle.setMAngle(MAngle(angle, MAngle::kRadians));
+    angleHandle.setClean();
+
+    return MStatus::kSuccess;
+}
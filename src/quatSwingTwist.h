@@ -0,0 +1,34 @@
+#ifndef QUAT_SWING_TWIST_H
+#define QUAT_SWING_TWIST_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+class QuatSwingTwistNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatSwingTwistNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    inputQuat_attr;
+    static VectorAttribute  twistAxis_attr;
+
+    static QuatAttribute    outputSwing_attr;
+    static QuatAttribute    outputTwist_attr;
+    static MObject          outputTwistAngle_attr;
+};
+
+#endif
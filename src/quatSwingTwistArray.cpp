@@ -0,0 +1,154 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatSwingTwistArray node
+    Splits many quaternions into twists about one axis and the swings that
+    remain in a single evaluation, so that inputQuat[i] = swing[i] *
+    twist[i]. Suited to a limb's twist joints, which share a bone axis.
+
+    inputQuat   (iq)
+        Quaternions to decompose.
+
+    twistAxis   (ta)
+        Axis to measure every twist about. Need not be normalized. Defaults
+        to X.
+
+    swing       (sw)
+        Rotations about axes perpendicular to twistAxis.
+
+    twist       (tw)
+        Rotations about twistAxis.
+
+    twistAngle  (twa)
+        Angles of the twists, between -180 and 180 degrees.
+
+    Each output has one element per logical index of inputQuat. See
+    quatSwingTwist for the case where the twist is undefined.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatSwingTwistArray.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnUnitAttribute.h>
+#include <maya/MPlug.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+QuatAttribute QuatSwingTwistArrayNode::inputQuat_attr;
+VectorAttribute QuatSwingTwistArrayNode::twistAxis_attr;
+
+QuatAttribute QuatSwingTwistArrayNode::outputSwing_attr;
+QuatAttribute QuatSwingTwistArrayNode::outputTwist_attr;
+MObject QuatSwingTwistArrayNode::outputTwistAngle_attr;
+
+QuatSwingTwistArrayNode::QuatSwingTwistArrayNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* QuatSwingTwistArrayNode::creator()
+{
+    return new QuatSwingTwistArrayNode();
+}
+
+MStatus QuatSwingTwistArrayNode::initialize()
+{
+    MStatus status;
+
+    MFnUnitAttribute u;
+
+    const char *const inputQuatNames[] = { "iqx", "iqy", "iqz", "iqw" };
+    status = inputQuat_attr.create("inputQuat", "iq", inputQuatNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const twistAxisNames[] = { "tax", "tay", "taz" };
+    status = twistAxis_attr.create("twistAxis", "ta", twistAxisNames, kXAxisDefaults, kCompoundInput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const swingNames[] = { "swx", "swy", "swz", "sww" };
+    status = outputSwing_attr.create("swing", "sw", swingNames, kIdentityQuatDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const twistNames[] = { "twx", "twy", "twz", "tww" };
+    status = outputTwist_attr.create("twist", "tw", twistNames, kIdentityQuatDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    outputTwistAngle_attr = u.create("twistAngle", "twa", MFnUnitAttribute::kAngle, 0.0);
+    MAKE_OUTPUT(u);
+    u.setArray(true);
+    u.setUsesArrayDataBuilder(true);
+
+    addAttribute(inputQuat_attr);
+    addAttribute(twistAxis_attr);
+    addAttribute(outputSwing_attr);
+    addAttribute(outputTwist_attr);
+    addAttribute(outputTwistAngle_attr);
+
+    attributeAffects(inputQuat_attr, outputSwing_attr);
+    attributeAffects(inputQuat_attr, outputTwist_attr);
+    attributeAffects(inputQuat_attr, outputTwistAngle_attr);
+    attributeAffects(twistAxis_attr, outputSwing_attr);
+    attributeAffects(twistAxis_attr, outputTwist_attr);
+    attributeAffects(twistAxis_attr, outputTwistAngle_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatSwingTwistArrayNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputSwing_attr) && !isPlugFor(plug, outputTwist_attr) && !isPlugFor(plug, outputTwistAngle_attr))
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    MArrayDataHandle inputHandle = data.inputArrayValue(inputQuat_attr);
+
+    unsigned count = logicalLength(inputHandle);
+    timer.setElements(count);
+
+    QuatArray input;
+    input.resize(count);
+
+    QuatArrayView inputView = input.view();
+
+    inputQuat_attr.inputArrayValue(inputHandle, inputView, count);
+
+    double axis[3];
+    twistAxis_attr.inputValue(data, axis);
+
+    std::vector<double> axisX(count, axis[0]);
+    std::vector<double> axisY(count, axis[1]);
+    std::vector<double> axisZ(count, axis[2]);
+
+    ConstVectorArrayView axisView = { axisX.data(), axisY.data(), axisZ.data() };
+
+    QuatArray twist;
+    twist.resize(count);
+
+    QuatArrayView twistView = twist.view();
+
+    std::vector<double> angle(count);
+
+    // The swing overwrites the input, which is no longer needed.
+    swingTwistBatch(inputView, axisView, inputView, twistView, angle.data(), count);
+
+    MStatus status = outputSwing_attr.outputArrayValue(data, inputView, count);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    status = outputTwist_attr.outputArrayValue(data, twistView, count);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    return outputAngleArrayValue(data, angle.data(), count, outputTwistAngle_attr);
+}
@@ -21,30 +21,28 @@ You may use, distribute, or modify this code under the terms of the MIT license.
 #include "quatToAxisAngle.h"
 #include "nodeUtils.h"
 
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+
 #include <maya/MAngle.h>
 #include <maya/MDataHandle.h>
 #include <maya/MDataBlock.h>
-#include <maya/MFnCompoundAttribute.h>
-#include <maya/MFnNumericAttribute.h>
-#include <maya/MFnNumericData.h>
 #include <maya/MFnUnitAttribute.h>
 #include <maya/MPlug.h>
-#include <maya/MQuaternion.h>
-#include <maya/MVector.h>
 
-MObject QuatToAxisAngleNode::inputQuat_attr;
-    MObject QuatToAxisAngleNode::inputQuatX_attr;
-    MObject QuatToAxisAngleNode::inputQuatY_attr;
-    MObject QuatToAxisAngleNode::inputQuatZ_attr;
-    MObject QuatToAxisAngleNode::inputQuatW_attr;
+using namespace quatExtras;
+
+QuatAttribute QuatToAxisAngleNode::inputQuat_attr;
 
-MObject QuatToAxisAngleNode::outputAxis_attr;
-    MObject QuatToAxisAngleNode::outputAxisX_attr;
-    MObject QuatToAxisAngleNode::outputAxisY_attr;
-    MObject QuatToAxisAngleNode::outputAxisZ_attr;
+VectorAttribute QuatToAxisAngleNode::outputAxis_attr;
 
 MObject QuatToAxisAngleNode::outputAngle_attr;
 
+QuatToAxisAngleNode::QuatToAxisAngleNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
 void* QuatToAxisAngleNode::creator()
 {
     return new QuatToAxisAngleNode();
@@ -55,41 +53,15 @@ MStatus QuatToAxisAngleNode::initialize()
 {
     MStatus status;
 
-    MFnCompoundAttribute c;
-    MFnNumericAttribute n;
     MFnUnitAttribute u;
 
-    inputQuatX_attr = n.create("inputQuatX", "iqx", MFnNumericData::kDouble, 0.0, &status);
-    MAKE_INPUT(n)
-
-    inputQuatY_attr = n.create("inputQuatY", "iqy", MFnNumericData::kDouble, 0.0, &status);
-    MAKE_INPUT(n);
-
-    inputQuatZ_attr = n.create("inputQuatZ", "iqz", MFnNumericData::kDouble, 0.0, &status); 
-    MAKE_INPUT(n);
-
-    inputQuatW_attr = n.create("inputQuatW", "iw", MFnNumericData::kDouble, 1.0, &status);
-    MAKE_INPUT(n);
+    const char *const inputQuatNames[] = { "iqx", "iqy", "iqz", "iw" };
+    status = inputQuat_attr.create("inputQuat", "iq", inputQuatNames, kIdentityQuatDefaults, kCompoundInput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
-    inputQuat_attr = c.create("inputQuat", "iq", &status);
-    c.addChild(inputQuatX_attr);
-    c.addChild(inputQuatY_attr);
-    c.addChild(inputQuatZ_attr);
-    c.addChild(inputQuatW_attr);
-
-    outputAxisX_attr = n.create("axisX", "asx", MFnNumericData::kDouble, 1.0, &status);
-    MAKE_OUTPUT(n);
-
-    outputAxisY_attr = n.create("axisY", "asy", MFnNumericData::kDouble, 1.0, &status);
-    MAKE_OUTPUT(n);
-
-    outputAxisZ_attr = n.create("axisZ", "asz", MFnNumericData::kDouble, 1.0, &status);
-    MAKE_OUTPUT(n);
-
-    outputAxis_attr = c.create("axis", "as", &status);
-    c.addChild(outputAxisX_attr);
-    c.addChild(outputAxisY_attr);
-    c.addChild(outputAxisZ_attr);
+    const char *const axisNames[] = { "asx", "asy", "asz" };
+    status = outputAxis_attr.create("axis", "as", axisNames, kUnitAxisDefaults, kCompoundOutput);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
     outputAngle_attr = u.create("angle", "an", MFnUnitAttribute::kAngle, 0.0);
     MAKE_OUTPUT(u);
@@ -110,25 +82,25 @@ MStatus QuatToAxisAngleNode::compute(const MPlug& plug, MDataBlock& data)
     if (plug != outputAxis_attr && plug != outputAngle_attr && plug.parent() != outputAxis_attr)
         return MStatus::kUnknownParameter;
 
-    MQuaternion inputQuat = inputQuaternionValue(
-        data, 
-        inputQuat_attr,
-        inputQuatX_attr,
-        inputQuatY_attr,
-        inputQuatZ_attr,
-        inputQuatW_attr 
-    );
+    ComputeTimer timer(statsType, &instanceStats);
+    timer.setElements(1);
+
+    double inputQuat[4];
+    inputQuat_attr.inputValue(data, inputQuat);
 
     double angle = 0.0;
-    MVector axis;
+    double axis[3];
 
-    bool nonZero = inputQuat.getAxisAngle(axis, angle);
+    // A zero rotation (nonZero false) comes back as a zero axis and angle.
+    ConstQuatArrayView inputView = { &inputQuat[0], &inputQuat[1], &inputQuat[2], &inputQuat[3] };
+    VectorArrayView axisView = { &axis[0], &axis[1], &axis[2] };
 
-    MDataHandle axisHandle = data.outputValue(outputAxis_attr);
-    MDataHandle angleHandle = data.outputValue(outputAngle_attr);
+    quatToAxisAngleBatch(inputView, axisView, &angle, NULL, 1);
 
-    axisHandle.set(axis.x, axis.y, axis.z);
-    axisHandle.setClean();
+    MStatus status = outputAxis_attr.outputValue(data, axis);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    MDataHandle angleHandle = data.outputValue(outputAngle_attr);
 
     angleHandle.setMAngle(MAngle(angle, MAngle::kRadians));
     angleHandle.setClean();
@@ -0,0 +1,157 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatToAxisAngleArray node
+    Converts many quaternions to pivot vectors and rotations around those
+    vectors in a single evaluation.
+
+    inputQuat  (iq)
+        Quaternions to be converted.
+
+    inputQuatData  (iqd)
+        The same as quatArrayData, read in place of inputQuat when it holds
+        quaternions.
+
+    precision  (pr)
+        Component type the conversion is computed in.
+            default Follows the plugin-wide setting, double unless the
+                    QUATEXTRAS_PRECISION environment variable is "float".
+            double  Full precision.
+            float   Twice as many elements per instruction, within 1.6e-7
+                    of double per axis component and 5.7e-7 radians.
+
+    axis  (axis)
+        The axes about which the rotations occur. Zero rotations produce a
+        zero axis.
+
+    angle (an)
+        The angles of rotation about the axes.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatToAxisAngleArray.h"
+#include "quatArrayData.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnUnitAttribute.h>
+#include <maya/MPlug.h>
+
+#include <vector>
+
+using namespace quatExtras;
+
+QuatAttribute QuatToAxisAngleArrayNode::inputQuat_attr;
+MObject QuatToAxisAngleArrayNode::inputQuatData_attr;
+MObject QuatToAxisAngleArrayNode::precision_attr;
+
+VectorAttribute QuatToAxisAngleArrayNode::outputAxis_attr;
+
+MObject QuatToAxisAngleArrayNode::outputAngle_attr;
+
+QuatToAxisAngleArrayNode::QuatToAxisAngleArrayNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* QuatToAxisAngleArrayNode::creator()
+{
+    return new QuatToAxisAngleArrayNode();
+}
+
+
+MStatus QuatToAxisAngleArrayNode::initialize()
+{
+    MStatus status;
+
+    MFnUnitAttribute u;
+
+    const char *const inputQuatNames[] = { "iqx", "iqy", "iqz", "iw" };
+    status = inputQuat_attr.create("inputQuat", "iq", inputQuatNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    inputQuatData_attr = createQuatArrayDataAttribute("inputQuatData", "iqd", false, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    precision_attr = createPrecisionAttribute(&status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    const char *const axisNames[] = { "asx", "asy", "asz" };
+    status = outputAxis_attr.create("axis", "as", axisNames, kUnitAxisDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    outputAngle_attr = u.create("angle", "an", MFnUnitAttribute::kAngle, 0.0);
+    MAKE_OUTPUT(u);
+    u.setArray(true);
+    u.setUsesArrayDataBuilder(true);
+
+    addAttribute(inputQuat_attr);
+    addAttribute(inputQuatData_attr);
+    addAttribute(precision_attr);
+    addAttribute(outputAxis_attr);
+    addAttribute(outputAngle_attr);
+
+    attributeAffects(inputQuat_attr, outputAngle_attr);
+    attributeAffects(inputQuat_attr, outputAxis_attr);
+    attributeAffects(inputQuatData_attr, outputAngle_attr);
+    attributeAffects(inputQuatData_attr, outputAxis_attr);
+    attributeAffects(precision_attr, outputAngle_attr);
+    attributeAffects(precision_attr, outputAxis_attr);
+
+    return MStatus::kSuccess;
+}
+
+
+namespace
+{
+    /*
+        Reads the inputs into T buffers, runs the T kernel and writes both
+        outputs; T is double or float.
+    */
+    template <class T>
+    MStatus computeAxisAngle(MDataBlock &data, QuatArrayInput &input, unsigned count)
+    {
+        ConstQuatArrayViewT<T> inputView = input.viewAs<T>(count);
+
+        std::vector<T> axisX(count);
+        std::vector<T> axisY(count);
+        std::vector<T> axisZ(count);
+        std::vector<T> angle(count);
+
+        VectorArrayViewT<T> axisView = { axisX.data(), axisY.data(), axisZ.data() };
+
+        quatToAxisAngleBatch(inputView, axisView, angle.data(), NULL, count);
+
+        MStatus status = QuatToAxisAngleArrayNode::outputAxis_attr.outputArrayValue(data, axisView, count);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        return outputAngleArrayValue(data, angle.data(), count, QuatToAxisAngleArrayNode::outputAngle_attr);
+    }
+}
+
+
+MStatus QuatToAxisAngleArrayNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputAxis_attr) && !isPlugFor(plug, outputAngle_attr))
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    QuatArrayInput input(data, inputQuat_attr, inputQuatData_attr);
+
+    unsigned count = input.length();
+    timer.setElements(count);
+
+    if (precisionValue(data, precision_attr) == kPrecisionFloat)
+        return computeAxisAngle<float>(data, input, count);
+
+    return computeAxisAngle<double>(data, input, count);
+}
@@ -0,0 +1,34 @@
+#ifndef QUAT_TO_AXIS_ANGLE_ARRAY_H
+#define QUAT_TO_AXIS_ANGLE_ARRAY_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+class QuatToAxisAngleArrayNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatToAxisAngleArrayNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    inputQuat_attr;
+    static MObject          inputQuatData_attr;
+    static MObject          precision_attr;
+
+    static MObject          outputAngle_attr;
+    static VectorAttribute  outputAxis_attr;
+};
+
+#endif
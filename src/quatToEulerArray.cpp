@@ -0,0 +1,160 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatToEulerArray node
+    Converts many quaternions to Euler rotations in a single evaluation.
+
+    inputQuat   (iq)
+        Quaternions to convert.
+
+    inputQuatData (iqd)
+        The same as quatArrayData, read in place of inputQuat when it holds
+        quaternions.
+
+    rotateOrder (ro)
+        Order the output rotations are applied in, shared by every element;
+        the same choices as a transform's rotateOrder. Defaults to xyz.
+
+    eulerFilter (ef)
+        When on, each rotation is written as the equivalent Euler angles
+        closest to the node's previous output, so that animation driven by
+        it does not flip as it crosses 180 degrees. Off by default, which
+        gives the middle rotation between -90 and 90 degrees and the others
+        between -180 and 180 degrees.
+
+    outputRotate (or)
+        One rotation per logical index of inputQuat, ready to connect to a
+        rotate attribute with the same rotateOrder.
+
+    The filter starts again from the unfiltered rotations whenever the
+    number of elements changes.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatToEulerArray.h"
+#include "quatArrayData.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MFnEnumAttribute.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MPlug.h>
+
+using namespace quatExtras;
+
+QuatAttribute QuatToEulerArrayNode::inputQuat_attr;
+MObject QuatToEulerArrayNode::inputQuatData_attr;
+MObject QuatToEulerArrayNode::rotateOrder_attr;
+MObject QuatToEulerArrayNode::eulerFilter_attr;
+
+VectorAttribute QuatToEulerArrayNode::outputRotate_attr;
+
+QuatToEulerArrayNode::QuatToEulerArrayNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* QuatToEulerArrayNode::creator()
+{
+    return new QuatToEulerArrayNode();
+}
+
+MStatus QuatToEulerArrayNode::initialize()
+{
+    MStatus status;
+
+    MFnEnumAttribute e;
+    MFnNumericAttribute n;
+
+    const char *const inputQuatNames[] = { "iqx", "iqy", "iqz", "iqw" };
+    status = inputQuat_attr.create("inputQuat", "iq", inputQuatNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    inputQuatData_attr = createQuatArrayDataAttribute("inputQuatData", "iqd", false, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    rotateOrder_attr = e.create("rotateOrder", "ro", kRotateXYZ, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(e);
+    e.addField("xyz", kRotateXYZ);
+    e.addField("yzx", kRotateYZX);
+    e.addField("zxy", kRotateZXY);
+    e.addField("xzy", kRotateXZY);
+    e.addField("yxz", kRotateYXZ);
+    e.addField("zyx", kRotateZYX);
+
+    eulerFilter_attr = n.create("eulerFilter", "ef", MFnNumericData::kBoolean, false, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+
+    const double zeroRotate[3] = { 0.0, 0.0, 0.0 };
+
+    const char *const outputRotateNames[] = { "orx", "ory", "orz" };
+    status = outputRotate_attr.create("outputRotate", "or", outputRotateNames, zeroRotate, kCompoundOutput | kCompoundArray | kCompoundAngle);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(inputQuat_attr);
+    addAttribute(inputQuatData_attr);
+    addAttribute(rotateOrder_attr);
+    addAttribute(eulerFilter_attr);
+    addAttribute(outputRotate_attr);
+
+    attributeAffects(inputQuat_attr, outputRotate_attr);
+    attributeAffects(inputQuatData_attr, outputRotate_attr);
+    attributeAffects(rotateOrder_attr, outputRotate_attr);
+    attributeAffects(eulerFilter_attr, outputRotate_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatToEulerArrayNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputRotate_attr))
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    QuatArrayInput input(data, inputQuat_attr, inputQuatData_attr);
+
+    unsigned count = input.length();
+    timer.setElements(count);
+
+    ConstQuatArrayView inputView = input.view(count);
+
+    RotateOrder order = (RotateOrder) data.inputValue(rotateOrder_attr).asShort();
+    bool filter = data.inputValue(eulerFilter_attr).asBool();
+
+    // The previous rotations are only a valid reference for the same
+    // elements.
+    bool hasPrevious = previousX.size() == count;
+
+    std::vector<double> rotateX(count);
+    std::vector<double> rotateY(count);
+    std::vector<double> rotateZ(count);
+
+    VectorArrayView rotateView = { rotateX.data(), rotateY.data(), rotateZ.data() };
+
+    quatToEulerBatch(inputView, order, rotateView, count);
+
+    if (filter && hasPrevious)
+    {
+        ConstVectorArrayView previousView = { previousX.data(), previousY.data(), previousZ.data() };
+        eulerFilterBatch(rotateView, previousView, order, rotateView, count);
+    }
+
+    previousX.swap(rotateX);
+    previousY.swap(rotateY);
+    previousZ.swap(rotateZ);
+
+    ConstVectorArrayView outputView = { previousX.data(), previousY.data(), previousZ.data() };
+
+    return outputRotate_attr.outputArrayValue(data, outputView, count);
+}
@@ -0,0 +1,43 @@
+#ifndef QUAT_TO_EULER_ARRAY_H
+#define QUAT_TO_EULER_ARRAY_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+#include <vector>
+
+class QuatToEulerArrayNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatToEulerArrayNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    inputQuat_attr;
+    static MObject          inputQuatData_attr;
+    static MObject          rotateOrder_attr;
+    static MObject          eulerFilter_attr;
+
+    static VectorAttribute  outputRotate_attr;
+
+private:
+    // Rotations from the last compute, which the Euler filter keeps the
+    // next ones close to.
+    std::vector<double>     previousX;
+    std::vector<double>     previousY;
+    std::vector<double>     previousZ;
+};
+
+#endif
@@ -0,0 +1,193 @@
+/**
+Copyright (c) 2016 Ryan Porter - arrayNodes
+You may use, distribute, or modify this code under the terms of the MIT license.
+*/
+
+/*-----------------------------------------------------------------------------
+    quatUnflip node
+    Keeps quaternion tracks on a consistent hemisphere over time. q and -q
+    are the same rotation, so sources such as quatSlerp can change sign
+    from one frame to the next; downstream filtering and motion blur
+    sampling see that as a jump.
+
+    inputQuat   (iq)
+        Quaternions to unflip, one track per logical index.
+
+    inputQuatData (iqd)
+        The same as quatArrayData, read in place of inputQuat when it holds
+        quaternions.
+
+    time        (tm)
+        Time of the evaluation, usually connected from time1.outTime.
+        Frames are in the scene's time unit.
+
+    maxTimeStep (mts)
+        Furthest, in frames, that a stored frame can be from time and still
+        be used as the reference. Defaults to 1, so playback with a frame
+        step of 1 or less stays continuous and larger jumps start again.
+
+    historySize (hs)
+        Frames of unflipped output kept. Defaults to 100, and never more
+        than 64 MB of them, which is 200 frames of 10,000 elements.
+
+    outputQuat  (oq)
+        Each input, negated where that puts it on the hemisphere of the
+        same track in the reference frame. The rotations are unchanged.
+
+    outputQuatData (oqd)
+        The same as quatArrayData, computed only when it is requested.
+
+    The reference is the latest stored frame before time within
+    maxTimeStep, else the frame at time itself, else the earliest after
+    it. With none of those, as on the first frame or after a scrub, each
+    quaternion is given a positive w (or first non-zero component when w
+    is zero). Frames already played keep their signs however they are
+    reached again, so playing a range forward once makes every later
+    evaluation of it, in any order or context, agree with that playback.
+    Only normal evaluations store frames; evaluations in other contexts,
+    such as a bake or another node sampling other times, read the history
+    without changing it.
+
+    The history starts again when the number of elements changes. It is
+    not cleared when inputs change at a stored frame: the stored frames
+    only choose signs, never rotations.
+
+    See core/unflipHistory.h.
+
+-----------------------------------------------------------------------------*/
+
+#include "quatUnflip.h"
+#include "quatArrayData.h"
+#include "nodeUtils.h"
+
+#include "core/computeStats.h"
+#include "core/quatBatch.h"
+
+#include <maya/MArrayDataHandle.h>
+#include <maya/MDataHandle.h>
+#include <maya/MDataBlock.h>
+#include <maya/MDGContext.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnUnitAttribute.h>
+#include <maya/MPlug.h>
+#include <maya/MTime.h>
+
+#include <algorithm>
+
+using namespace quatExtras;
+
+QuatAttribute QuatUnflipNode::inputQuat_attr;
+MObject QuatUnflipNode::inputQuatData_attr;
+MObject QuatUnflipNode::time_attr;
+MObject QuatUnflipNode::maxTimeStep_attr;
+MObject QuatUnflipNode::historySize_attr;
+
+QuatAttribute QuatUnflipNode::outputQuat_attr;
+MObject QuatUnflipNode::outputQuatData_attr;
+
+QuatUnflipNode::QuatUnflipNode() :
+    ProfiledNode(NODE_NAME)
+{
+}
+
+void* QuatUnflipNode::creator()
+{
+    return new QuatUnflipNode();
+}
+
+MStatus QuatUnflipNode::initialize()
+{
+    MStatus status;
+
+    MFnNumericAttribute n;
+    MFnUnitAttribute u;
+
+    const char *const inputQuatNames[] = { "iqx", "iqy", "iqz", "iqw" };
+    status = inputQuat_attr.create("inputQuat", "iq", inputQuatNames, kIdentityQuatDefaults, kCompoundInput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    inputQuatData_attr = createQuatArrayDataAttribute("inputQuatData", "iqd", false, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    time_attr = u.create("time", "tm", MFnUnitAttribute::kTime, 0.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(u);
+
+    maxTimeStep_attr = n.create("maxTimeStep", "mts", MFnNumericData::kDouble, 1.0, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setMin(0.0);
+
+    historySize_attr = n.create("historySize", "hs", MFnNumericData::kInt, (double) UnflipHistory::kDefaultCapacity, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    MAKE_INPUT(n);
+    n.setMin(1);
+
+    const char *const outputQuatNames[] = { "oqx", "oqy", "oqz", "oqw" };
+    status = outputQuat_attr.create("outputQuat", "oq", outputQuatNames, kIdentityQuatDefaults, kCompoundOutput | kCompoundArray);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    outputQuatData_attr = createQuatArrayDataAttribute("outputQuatData", "oqd", true, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
+    addAttribute(inputQuat_attr);
+    addAttribute(inputQuatData_attr);
+    addAttribute(time_attr);
+    addAttribute(maxTimeStep_attr);
+    addAttribute(historySize_attr);
+    addAttribute(outputQuat_attr);
+    addAttribute(outputQuatData_attr);
+
+    attributeAffects(inputQuat_attr, outputQuat_attr);
+    attributeAffects(inputQuatData_attr, outputQuat_attr);
+    attributeAffects(time_attr, outputQuat_attr);
+    attributeAffects(maxTimeStep_attr, outputQuat_attr);
+    attributeAffects(historySize_attr, outputQuat_attr);
+
+    attributeAffects(inputQuat_attr, outputQuatData_attr);
+    attributeAffects(inputQuatData_attr, outputQuatData_attr);
+    attributeAffects(time_attr, outputQuatData_attr);
+    attributeAffects(maxTimeStep_attr, outputQuatData_attr);
+    attributeAffects(historySize_attr, outputQuatData_attr);
+
+    return MStatus::kSuccess;
+}
+
+MStatus QuatUnflipNode::compute(const MPlug& plug, MDataBlock& data)
+{
+    if (!isPlugFor(plug, outputQuat_attr) && !isPlugFor(plug, outputQuatData_attr))
+        return MStatus::kUnknownParameter;
+
+    ComputeTimer timer(statsType, &instanceStats);
+
+    QuatArrayInput input(data, inputQuat_attr, inputQuatData_attr);
+    QuatArrayOutput output(plug, outputQuat_attr, outputQuatData_attr);
+
+    unsigned count = input.length();
+    timer.setElements(count);
+
+    ConstQuatArrayView inputView = input.view(count);
+    QuatArrayView outputView = output.allocate(count);
+
+    double frame = data.inputValue(time_attr).asTime().as(MTime::uiUnit());
+    double maxTimeStep = data.inputValue(maxTimeStep_attr).asDouble();
+    int historySize = data.inputValue(historySize_attr).asInt();
+
+    bool continued;
+
+    {
+        std::lock_guard<std::mutex> lock(historyMutex);
+
+        history.setCapacity((size_t) std::max(historySize, 1));
+        continued = history.unflip(frame, inputView, outputView, count, maxTimeStep, data.context().isNormal());
+    }
+
+    if (continued)
+    {
+        timer.cacheHit();
+    } else {
+        timer.cacheMiss();
+    }
+
+    return output.write(data);
+}
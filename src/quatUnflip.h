@@ -0,0 +1,47 @@
+#ifndef QUAT_UNFLIP_H
+#define QUAT_UNFLIP_H
+
+#include "compoundAttribute.h"
+#include "profiledNode.h"
+
+#include "core/unflipHistory.h"
+
+#include <maya/MDataBlock.h>
+#include <maya/MPlug.h>
+#include <maya/MPxNode.h>
+#include <maya/MString.h>
+#include <maya/MTypeId.h>
+
+#include <mutex>
+
+class QuatUnflipNode : public MPxNode, public ProfiledNode
+{
+public:
+                            QuatUnflipNode();
+
+    virtual MStatus         compute(const MPlug& plug, MDataBlock& data);
+    static  void*           creator();
+    static  MStatus         initialize();
+
+public:
+    static MTypeId          NODE_ID;
+    static MString          NODE_NAME;
+
+    static QuatAttribute    inputQuat_attr;
+    static MObject          inputQuatData_attr;
+    static MObject          time_attr;
+    static MObject          maxTimeStep_attr;
+    static MObject          historySize_attr;
+
+    static QuatAttribute    outputQuat_attr;
+    static MObject          outputQuatData_attr;
+
+private:
+    // Unflipped outputs by time. Shared by every context, since it is
+    // keyed by the time each context evaluates at; the mutex covers
+    // contexts evaluated from several threads.
+    quatExtras::UnflipHistory   history;
+    std::mutex                  historyMutex;
+};
+
+#endif